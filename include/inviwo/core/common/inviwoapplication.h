@@ -63,6 +63,9 @@ class CommandLineParser;
 struct AppResourceManagerObserver;
 
 class ResourceManager;
+class RepresentationPool;
+class RepresentationRegistry;
+class DecodedVolumeCache;
 class CameraFactory;
 class DataReaderFactory;
 class DataWriterFactory;
@@ -265,6 +268,27 @@ public:
      */
     ResourceManager* getResourceManager();
 
+    /**
+     * Returns the RepresentationPool owned the InviwoApplication
+     *
+     * @see RepresentationPool
+     */
+    RepresentationPool* getRepresentationPool();
+
+    /**
+     * Returns the RepresentationRegistry owned the InviwoApplication
+     *
+     * @see RepresentationRegistry
+     */
+    RepresentationRegistry* getRepresentationRegistry();
+
+    /**
+     * Returns the DecodedVolumeCache owned the InviwoApplication
+     *
+     * @see DecodedVolumeCache
+     */
+    DecodedVolumeCache* getDecodedVolumeCache();
+
     /** @name Factories */
     ///@{
 
@@ -462,12 +486,16 @@ protected:
     std::locale uiLocale_{};
     std::function<void(LongWait)> poolResizeCallback_;
     std::function<void()> processEventsCallback_;
+    // Declared before everything that can hold Data, since Data unregisters on destruction
+    std::unique_ptr<RepresentationRegistry> representationRegistry_;
     ThreadPool pool_;
     Queue queue_;  // "Interaction/GUI" queue
 
     util::OnScopeExit clearAllSingeltons_;
 
     std::unique_ptr<ResourceManager> resourceManager_;
+    std::unique_ptr<RepresentationPool> representationPool_;
+    std::unique_ptr<DecodedVolumeCache> decodedVolumeCache_;
 
     // Factories
     std::unique_ptr<CameraFactory> cameraFactory_;
@@ -578,6 +606,18 @@ auto InviwoApplication::dispatchFront(F&& f, Args&&... args)
 
 inline ResourceManager* InviwoApplication::getResourceManager() { return resourceManager_.get(); }
 
+inline RepresentationPool* InviwoApplication::getRepresentationPool() {
+    return representationPool_.get();
+}
+
+inline RepresentationRegistry* InviwoApplication::getRepresentationRegistry() {
+    return representationRegistry_.get();
+}
+
+inline DecodedVolumeCache* InviwoApplication::getDecodedVolumeCache() {
+    return decodedVolumeCache_.get();
+}
+
 inline CameraFactory* InviwoApplication::getCameraFactory() const { return cameraFactory_.get(); }
 
 inline DataReaderFactory* InviwoApplication::getDataReaderFactory() const {
@@ -151,6 +151,14 @@ public:
         const;
     const std::vector<Settings*>& getSettings() const;
 
+    /**
+     * True if the module only registers processors, processor widgets, data readers, and data
+     * writers. Such a module can be constructed on first use of one of them, anything else it
+     * registers would be missing from the other factories until then.
+     * @see ModuleManager::setLazyRegistration
+     */
+    bool hasOnlyDeferrableRegistrations() const;
+
     void registerCapabilities(std::unique_ptr<Capabilities> info);
 
     void registerCamera(std::unique_ptr<CameraFactoryObject> camera);
@@ -37,12 +37,17 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/common/inviwomodulelibraryobserver.h>
+#include <inviwo/core/common/modulemanifest.h>
+#include <inviwo/core/util/clock.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
+#include <atomic>
 #include <set>
 #include <vector>
 #include <memory>
+#include <string_view>
+#include <thread>
 #include <warn/pop>
 
 namespace inviwo {
@@ -135,8 +140,87 @@ public:
     static std::function<bool(std::string_view)> getEnabledFilter();
     void reloadModules();
 
+    /**
+     * \brief Enable or disable lazy module registration.
+     *
+     * With lazy registration, registerModules defers the construction of modules that have a valid
+     * entry in the module manifest listing at least one processor, data reader or data writer.
+     * Protected modules, and modules without an entry, are constructed as usual. A deferred
+     * module is constructed, after its dependencies, the first time one of its processors or file
+     * extensions is requested from the ProcessorFactory, DataReaderFactory or DataWriterFactory,
+     * or when it is looked up by identifier or type. Modules that register anything else, like
+     * properties, ports, metadata, converters or settings, are never deferred since those
+     * factories have no way of constructing them on demand. The manifest is stored in the
+     * settings folder and updated whenever a module is constructed.
+     *
+     * Has to be set before registerModules, it is enabled by the `--lazy-modules` command line
+     * flag.
+     * @see ModuleManifest
+     */
+    void setLazyRegistration(bool enable);
+    bool isLazyRegistrationEnabled() const;
+
+    /**
+     * Identifiers of the modules that are deferred and not yet constructed.
+     */
+    std::vector<std::string> getDeferredModules() const;
+
+    /**
+     * \brief Construct the deferred module that provides the processor `classIdentifier`.
+     * If no deferred module lists the processor, all deferred modules are constructed since the
+     * manifest might be outdated.
+     * @return true if any module was constructed
+     */
+    bool loadDeferredModulesForProcessor(std::string_view classIdentifier);
+
+    /**
+     * \brief Construct the deferred modules with a data reader matching `filePathOrExtension`.
+     * An empty string constructs all deferred modules that have any data reader.
+     * @return true if any module was constructed
+     */
+    bool loadDeferredModulesForReader(std::string_view filePathOrExtension);
+
+    /**
+     * \brief Construct the deferred modules with a data writer matching `filePathOrExtension`.
+     * An empty string constructs all deferred modules that have any data writer.
+     * @return true if any module was constructed
+     */
+    bool loadDeferredModulesForWriter(std::string_view filePathOrExtension);
+
+    /**
+     * \brief Construct all deferred modules.
+     */
+    void loadDeferredModules();
+
+    struct Timing {
+        std::string name;
+        Clock::duration duration;
+    };
+
+    /**
+     * The time spent in each phase of module registration, in order: loading the module libraries,
+     * constructing each module, and retrieving the capabilities. Deferred modules are added when
+     * they are constructed.
+     */
+    const std::vector<Timing>& getRegistrationTimings() const;
+
+    /**
+     * Log the registration timings, slowest first. Called after registerModules when the
+     * `--startup-timing` command line flag is given.
+     */
+    void logRegistrationTimings() const;
+
 private:
     void registerModule(std::unique_ptr<InviwoModule> module);
+    InviwoModule* findModule(std::string_view identifier) const;
+    bool isDeferred(std::string_view identifier) const;
+    bool canDefer(const InviwoModuleFactoryObject& obj) const;
+    InviwoModule* createModule(InviwoModuleFactoryObject& obj);
+    InviwoModule* loadDeferredModule(std::string_view identifier);
+    bool loadDeferredModulesIf(const std::function<bool(const ModuleManifest::Entry*)>& predicate);
+    void retrieveCapabilities(InviwoModule& module);
+    void saveManifest();
+    std::string getManifestPath() const;
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
         const std::vector<std::string>& toDeregister);
@@ -157,11 +241,25 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+
+    bool lazy_ = false;
+    ModuleManifest manifest_;
+    std::vector<InviwoModuleFactoryObject*> deferred_;
+    std::atomic<bool> hasDeferred_{false};  //!< Can be checked from any thread, unlike deferred_
+    std::vector<Timing> timings_;
+    std::thread::id mainThread_;
 };
 
 template <class T>
 T* ModuleManager::getModuleByType() const {
-    return getTypeFromVector<T>(modules_);
+    if (auto* module = getTypeFromVector<T>(modules_)) return module;
+    if (hasDeferred_) {
+        // The type of a deferred module is only known once it has been constructed. Constructing
+        // it does not change the set of available modules, only when they are materialized.
+        const_cast<ModuleManager*>(this)->loadDeferredModules();
+        return getTypeFromVector<T>(modules_);
+    }
+    return nullptr;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/serializable.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+class InviwoModule;
+class InviwoModuleFactoryObject;
+
+/**
+ * \brief A cache of what each module registers, stored between runs of the application.
+ *
+ * For each module the manifest lists the class identifiers of its processors and the file
+ * extensions of its data readers and writers, together with the module and core version it was
+ * recorded for. This lets the ModuleManager defer the construction of a module until one of the
+ * things it provides is requested. Only modules that register nothing but processors, readers,
+ * and writers are marked as deferrable.
+ * @see ModuleManager::setLazyRegistration
+ */
+class IVW_CORE_API ModuleManifest : public Serializable {
+public:
+    struct IVW_CORE_API Entry : public Serializable {
+        std::string version;
+        std::string inviwoCoreVersion;
+        std::vector<std::string> processors;
+        std::vector<std::string> readerExtensions;
+        std::vector<std::string> writerExtensions;
+        bool deferrable = false;  //!< @see InviwoModule::hasOnlyDeferrableRegistrations
+
+        virtual void serialize(Serializer& s) const override;
+        virtual void deserialize(Deserializer& d) override;
+
+        bool operator==(const Entry& rhs) const;
+        bool operator!=(const Entry& rhs) const;
+    };
+
+    ModuleManifest() = default;
+    virtual ~ModuleManifest() = default;
+
+    /**
+     * The entry of module `obj`, or nullptr if there is none or if it was recorded for a different
+     * version of the module or of the core.
+     */
+    const Entry* find(const InviwoModuleFactoryObject& obj) const;
+
+    /**
+     * Record what `module` has registered. Marks the manifest as modified if the entry changed.
+     */
+    void update(const InviwoModuleFactoryObject& obj, const InviwoModule& module);
+
+    void erase(std::string_view moduleName);
+    void clear();
+    bool empty() const;
+
+    /**
+     * True if the manifest has changed since it was last loaded or saved
+     */
+    bool isModified() const;
+
+    /**
+     * Load the manifest from `filePath`. A missing or broken file results in an empty manifest.
+     */
+    void load(std::string_view filePath);
+    /**
+     * Save the manifest to `filePath`.
+     * @throw Exception if the file could not be written
+     */
+    void save(std::string_view filePath);
+
+    virtual void serialize(Serializer& s) const override;
+    virtual void deserialize(Deserializer& d) override;
+
+    /**
+     * Check if `filePathOrExtension` ends with any of the `extensions`, case insensitive.
+     */
+    static bool matchesExtension(const std::vector<std::string>& extensions,
+                                 std::string_view filePathOrExtension);
+
+private:
+    std::map<std::string, Entry, CaseInsensitiveCompare> entries_;
+    bool modified_ = false;
+};
+
+}  // namespace inviwo
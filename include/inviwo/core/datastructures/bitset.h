@@ -52,6 +52,10 @@ namespace inviwo {
 
 /**
  * \brief represents a bitset based on roaring bitmaps provided by the CRoaring library
+ *
+ * Copies are cheap, a copied BitSet shares its bitmap with the original until either of them is
+ * modified (copy-on-write). Hence, a BitSet can be handed around by value without duplicating large
+ * bitmaps.
  */
 class IVW_CORE_API BitSet : public Serializable {
 public:
@@ -406,8 +410,13 @@ private:
 
     void addSingle(uint32_t value_);
     void addMany(size_t size, const uint32_t* data);
+    /**
+     * Access the bitmap for modification, making a private copy first if it is shared with
+     * other BitSets.
+     */
+    roaring::Roaring& mutableRoaring();
 
-    std::unique_ptr<roaring::Roaring> roaring_;
+    std::shared_ptr<roaring::Roaring> roaring_;
 };
 
 }  // namespace inviwo
@@ -57,6 +57,8 @@ public:
     BufferUsage getBufferUsage() const;
     BufferTarget getBufferTarget() const;
 
+    virtual size_t getResidentBytes() const override;
+
 protected:
     BufferRepresentation(const DataFormatBase* format, BufferUsage usage = BufferUsage::Static,
                          BufferTarget target = BufferTarget::Data);
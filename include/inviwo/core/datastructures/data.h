@@ -33,16 +33,25 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/datastructures/representationregistry.h>
 
 #include <inviwo/core/util/demangle.h>
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 #include <typeindex>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
+#include <utility>
 
 namespace inviwo {
 
+class LayerRepresentation;
+
 /**
  * \defgroup datastructures Datastructures
  */
@@ -84,10 +93,15 @@ namespace inviwo {
  *
  *
  *
+ * The memory of all representations is accounted for in the RepresentationRegistry, that might
+ * release representations of volumes and buffers that can be regenerated when over its budget.
+ * Layer representations are never released, image representations like ImageGL and ImageRAM
+ * refer to them by raw pointers.
+ *
  * @note Do not use the same representation in different Data objects.
  * This can cause inconsistencies since the Data objects cannot know if
  * another one has edited the representation.
- * @see Representation and RepresentationConverter
+ * @see Representation, RepresentationConverter, and RepresentationRegistry
  */
 template <typename Self, typename Repr>
 class Data {
@@ -96,7 +110,7 @@ public:
     using repr = Repr;
 
     virtual Data<Self, Repr>* clone() const = 0;
-    virtual ~Data() = default;
+    virtual ~Data();
 
     /**
      * Get a representation of type T. If there already is a valid representation of type T, just
@@ -130,12 +144,25 @@ public:
     template <typename T>
     bool hasRepresentation() const;
 
+    /**
+     * Check if a valid representation of type T exists, i.e. one that can be used without
+     * updating it from another representation.
+     */
+    template <typename T>
+    bool hasValidRepresentation() const;
+
     /**
      * Check if the Data object has any representation.
      * @return true if any representation exist, false otherwise.
      */
     bool hasRepresentations() const;
 
+    /**
+     * Memory in bytes held by all representations
+     * @see DataRepresentation::getResidentBytes
+     */
+    size_t getResidentBytes() const;
+
     /**
      * Add the representation and set it as last valid.
      * The owner of the representation will be set to this object.
@@ -171,6 +198,23 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * A counter that is increased every time the data might have been edited, i.e. on
+     * getEditableRepresentation, invalidateAllOther, and when representations are added, removed,
+     * or replaced.
+     */
+    size_t getEditVersion() const;
+
+    /**
+     * Get a value derived from the data, like statistics, that is cached until the data is edited.
+     * If there is no up to date value stored under \p key, \p compute is called to create one.
+     * Note that \p compute is called without holding any lock, hence two threads might end up
+     * computing the same value.
+     * @see getEditVersion
+     */
+    template <typename T, typename F>
+    std::shared_ptr<const T> getDerived(std::string_view key, F&& compute) const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
@@ -195,9 +239,19 @@ private:
     void copyRepresentationsTo(Data<Self, Repr>* targetData) const;
     std::shared_ptr<Repr> addRepresentationInternal(std::shared_ptr<Repr> representation) const;
     void invalidateAllOtherInternal(const Repr* repr);
+    void edited() const;
     template <typename T, typename D>
     static std::shared_ptr<T> getReprInternal(D& data);
 
+    // Memory accounting in the RepresentationRegistry, track when a representation is added or
+    // replaced and touch when it is used.
+    static constexpr bool evictable = !std::is_same_v<Repr, LayerRepresentation>;
+    void track(const std::shared_ptr<Repr>& repr) const;
+    void touch(const std::shared_ptr<Repr>& repr) const;
+    void untrack(const Repr* repr) const;
+    void untrackAll() const;
+    static bool evict(const void* owner, const void* repr);
+
     std::shared_ptr<Repr> findRepr(std::type_index idx) const {
         if (auto it = representations_.find(idx); it != representations_.end()) {
             return it->second;
@@ -210,6 +264,10 @@ private:
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+
+    mutable size_t editVersion_ = 0;
+    mutable std::unordered_map<std::string, std::pair<size_t, std::shared_ptr<const void>>>
+        derived_;
 };
 
 /*
@@ -224,6 +282,11 @@ Data<Self, Repr>::Data(const Data<Self, Repr>& rhs) : lastValidRepresentation_{n
     rhs.copyRepresentationsTo(this);
 }
 
+template <typename Self, typename Repr>
+Data<Self, Repr>::~Data() {
+    untrackAll();
+}
+
 template <typename Self, typename Repr>
 Data<Self, Repr>& Data<Self, Repr>::operator=(const Data<Self, Repr>& that) {
     if (this != &that) {
@@ -247,6 +310,7 @@ std::shared_ptr<T> Data<Self, Repr>::getReprInternal(D& data) {
 
     if (auto repr = data.findRepr(requestedType); repr && repr->isValid()) {
         data.lastValidRepresentation_ = repr;
+        data.touch(repr);
         return std::dynamic_pointer_cast<T>(repr);
     } else {
         auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
@@ -261,6 +325,7 @@ std::shared_ptr<T> Data<Self, Repr>::getReprInternal(D& data) {
                     converter->update(srcRepr, dstRepr);
                     data.lastValidRepresentation_ = dstRepr;
                     data.lastValidRepresentation_->setValid(true);
+                    data.touch(dstRepr);
                 } else {  // No representation found, create it
                     dstRepr = converter->createFrom(srcRepr);
                     if (!dstRepr)
@@ -319,13 +384,54 @@ bool Data<Self, Repr>::hasRepresentation() const {
     return util::has_key(representations_, std::type_index(typeid(T)));
 }
 
+template <typename Self, typename Repr>
+template <typename T>
+bool Data<Self, Repr>::hasValidRepresentation() const {
+    std::scoped_lock lock(mutex_);
+    const auto repr = findRepr(std::type_index(typeid(T)));
+    return repr && repr->isValid();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
     std::scoped_lock lock(mutex_);
     invalidateAllOtherInternal(repr);
 }
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getEditVersion() const {
+    std::scoped_lock lock(mutex_);
+    return editVersion_;
+}
+
+template <typename Self, typename Repr>
+template <typename T, typename F>
+std::shared_ptr<const T> Data<Self, Repr>::getDerived(std::string_view key, F&& compute) const {
+    const std::string name{key};
+    size_t version = 0;
+    {
+        std::scoped_lock lock(mutex_);
+        version = editVersion_;
+        if (auto it = derived_.find(name); it != derived_.end() && it->second.first == version) {
+            return std::static_pointer_cast<const T>(it->second.second);
+        }
+    }
+
+    auto value = std::make_shared<const T>(std::invoke(std::forward<F>(compute)));
+
+    std::scoped_lock lock(mutex_);
+    if (version == editVersion_) derived_[name] = {version, value};
+    return value;
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::edited() const {
+    ++editVersion_;
+    derived_.clear();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOtherInternal(const Repr* repr) {
+    edited();
     bool found = false;
     for (auto& elem : representations_) {
         if (elem.second.get() != repr) {
@@ -342,12 +448,16 @@ void Data<Self, Repr>::invalidateAllOtherInternal(const Repr* repr) {
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::scoped_lock lock(mutex_);
+    edited();
+    untrackAll();
     representations_.clear();
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::copyRepresentationsTo(Data<Self, Repr>* target) const {
     std::scoped_lock targetLock(mutex_, target->mutex_);
+    target->edited();
+    target->untrackAll();
     target->representations_.clear();
 
     if (lastValidRepresentation_) {
@@ -361,22 +471,87 @@ std::shared_ptr<Repr> Data<Self, Repr>::addRepresentationInternal(
     std::shared_ptr<Repr> repr) const {
     repr->setValid(true);
     repr->setOwner(static_cast<const Self*>(this));
-    representations_[repr->getTypeIndex()] = repr;
+    auto& slot = representations_[repr->getTypeIndex()];
+    if (slot && slot != repr) untrack(slot.get());
+    slot = repr;
+    track(repr);
     return repr;
 }
 
+template <typename Self, typename Repr>
+void Data<Self, Repr>::track(const std::shared_ptr<Repr>& repr) const {
+    if (auto registry = util::getRepresentationRegistry()) {
+        registry->add(this, evictable ? &Data::evict : nullptr, repr.get(), repr->getTypeIndex(),
+                      repr->getResidentBytes());
+    }
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::touch(const std::shared_ptr<Repr>& repr) const {
+    if (auto registry = util::getRepresentationRegistry()) {
+        registry->touch(this, repr.get(), repr->getResidentBytes());
+    }
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::untrack(const Repr* repr) const {
+    if (auto registry = util::getRepresentationRegistry()) {
+        registry->remove(this, repr);
+    }
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::untrackAll() const {
+    if (auto registry = util::getRepresentationRegistry()) {
+        registry->removeOwner(this);
+    }
+}
+
+template <typename Self, typename Repr>
+bool Data<Self, Repr>::evict(const void* owner, const void* repr) {
+    const auto& data = *static_cast<const Data<Self, Repr>*>(owner);
+    // Never wait for the data here, the registry lock is held
+    std::unique_lock lock(data.mutex_, std::try_to_lock);
+    if (!lock) return false;
+
+    auto it = std::find_if(data.representations_.begin(), data.representations_.end(),
+                           [&](const auto& elem) { return elem.second.get() == repr; });
+    if (it == data.representations_.end()) return false;
+
+    // Only release representations that nobody but this object references
+    const bool isLastValid = it->second == data.lastValidRepresentation_;
+    if (it->second.use_count() != (isLastValid ? 2 : 1)) return false;
+
+    if (isLastValid) {
+        // Keep the data regenerable, preferably from a representation that does not occupy
+        // memory, like a disk representation.
+        std::shared_ptr<Repr> source;
+        for (const auto& elem : data.representations_) {
+            if (elem.second == it->second || !elem.second->isValid()) continue;
+            if (!source || elem.second->getResidentBytes() == 0) source = elem.second;
+        }
+        if (!source) return false;
+        data.lastValidRepresentation_ = source;
+    }
+    data.representations_.erase(it);
+    return true;
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::scoped_lock lock(mutex_);
+    edited();
     lastValidRepresentation_ = addRepresentationInternal(representation);
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
     std::scoped_lock lock(mutex_);
+    edited();
 
     for (auto& elem : representations_) {
         if (elem.second.get() == representation) {
+            untrack(representation);
             representations_.erase(elem.first);
             break;
         }
@@ -412,6 +587,8 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
         }
     }
     std::swap(repr, representations_);
+    untrackAll();
+    for (auto& elem : representations_) track(elem.second);
 }
 
 template <typename Self, typename Repr>
@@ -420,4 +597,14 @@ bool Data<Self, Repr>::hasRepresentations() const {
     return !representations_.empty();
 }
 
+template <typename Self, typename Repr>
+size_t Data<Self, Repr>::getResidentBytes() const {
+    std::scoped_lock lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& elem : representations_) {
+        bytes += elem.second->getResidentBytes();
+    }
+    return bytes;
+}
+
 }  // namespace inviwo
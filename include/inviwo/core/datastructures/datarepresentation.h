@@ -66,6 +66,13 @@ public:
     bool isValid() const;
     void setValid(bool valid);
 
+    /**
+     * Memory in bytes held by the representation, used for memory accounting.
+     * Representations that do not keep their data in memory, like disk representations,
+     * return 0.
+     */
+    virtual size_t getResidentBytes() const { return 0; }
+
 protected:
     DataRepresentation() = default;
     DataRepresentation(const DataFormatBase* format);
@@ -32,16 +32,52 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/cloneableptr.h>
 #include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glmvec.h>
 
 #include <string>
 #include <string_view>
 #include <memory>
+#include <type_traits>
 
 namespace inviwo {
 
 template <typename Repr>
 class DiskRepresentationLoader;
 
+/**
+ * \ingroup datastructures
+ * A box of elements of a DiskRepresentation, of which every stride:th element along each axis is
+ * read. Two dimensional data uses an offset of 0 and a size of 1 along z.
+ */
+struct DiskRegion {
+    size3_t offset{0};
+    size3_t dimensions{0};  //!< Size of the box in elements of the source
+    size3_t stride{1};
+
+    /**
+     * Dimensions of the representation created for the region
+     */
+    size3_t getOutputDimensions() const {
+        size3_t res{0};
+        for (int i = 0; i < 3; ++i) {
+            if (stride[i] > 0) res[i] = (dimensions[i] + stride[i] - 1) / stride[i];
+        }
+        return res;
+    }
+
+    /**
+     * Check that the region is non-empty and fits within data of dimensions \p dims
+     */
+    bool isValidFor(size3_t dims) const {
+        for (int i = 0; i < 3; ++i) {
+            if (dimensions[i] == 0 || stride[i] == 0 || offset[i] + dimensions[i] > dims[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
 /**
  * \ingroup datastructures
  * Base class for all DiskRepresentations \see Data, DataRepresentation
@@ -64,6 +100,20 @@ public:
     std::shared_ptr<Repr> createRepresentation() const;
     void updateRepresentation(std::shared_ptr<Repr> dest) const;
 
+    /**
+     * Check if the loader can create representations of parts of the data, reading only what is
+     * needed for the part.
+     * @see createRepresentation(const DiskRegion&)
+     */
+    bool supportsRegions() const;
+
+    /**
+     * Create a representation of \p region of the data, with the dimensions
+     * DiskRegion::getOutputDimensions.
+     * @throw Exception if the loader does not support regions or the region is not valid
+     */
+    std::shared_ptr<Repr> createRepresentation(const DiskRegion& region) const;
+
 private:
     std::string sourceFile_;
 
@@ -108,6 +158,31 @@ void DiskRepresentation<Repr, Self>::updateRepresentation(std::shared_ptr<Repr>
     loader_->updateRepresentation(dest, *static_cast<const Self*>(this));
 }
 
+template <typename Repr, typename Self>
+bool DiskRepresentation<Repr, Self>::supportsRegions() const {
+    return loader_ && loader_->supportsRegions();
+}
+
+template <typename Repr, typename Self>
+std::shared_ptr<Repr> DiskRepresentation<Repr, Self>::createRepresentation(
+    const DiskRegion& region) const {
+    if (!supportsRegions()) {
+        throw Exception("No loader available to create a representation of a region",
+                        IVW_CONTEXT);
+    }
+    const auto toSize3 = [](const auto& dims) {
+        if constexpr (std::decay_t<decltype(dims)>::length() == 2) {
+            return size3_t{dims, 1};
+        } else {
+            return size3_t{dims};
+        }
+    };
+    if (!region.isValidFor(toSize3(static_cast<const Self*>(this)->getDimensions()))) {
+        throw Exception("Region is empty or outside of the data", IVW_CONTEXT);
+    }
+    return loader_->createRegionRepresentation(*static_cast<const Self*>(this), region);
+}
+
 template <typename Repr>
 class DiskRepresentationLoader {
 public:
@@ -115,6 +190,23 @@ public:
     virtual DiskRepresentationLoader* clone() const = 0;
     virtual std::shared_ptr<Repr> createRepresentation(const Repr&) const = 0;
     virtual void updateRepresentation(std::shared_ptr<Repr> dest, const Repr&) const = 0;
+
+    /**
+     * Loaders that can read parts of the data without reading all of it should return true, and
+     * implement createRegionRepresentation.
+     */
+    virtual bool supportsRegions() const { return false; }
+
+    /**
+     * Create a representation of \p region of \p src, with the dimensions
+     * DiskRegion::getOutputDimensions. The region has been checked against the dimensions of
+     * \p src. Only called if supportsRegions returns true.
+     */
+    virtual std::shared_ptr<Repr> createRegionRepresentation(const Repr&,
+                                                             const DiskRegion&) const {
+        throw Exception("Loader does not support regions",
+                        IVW_CONTEXT_CUSTOM("DiskRepresentationLoader"));
+    }
 };
 
 }  // namespace inviwo
@@ -33,10 +33,13 @@
 #include <inviwo/core/util/glmvec.h>
 #include <inviwo/core/util/glmutils.h>
 #include <inviwo/core/util/glmcomp.h>
+#include <inviwo/core/util/quantilesketch.h>
 
 #include <glm/common.hpp>
 
+#include <algorithm>
 #include <iterator>
+#include <limits>
 #include <vector>
 #include <bitset>
 
@@ -65,6 +68,13 @@ public:
     NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min, double max,
                         double mean, double standardDeviation);
 
+    /**
+     * The percentiles of stats_ are taken from the sketch, instead of being estimated from the
+     * bins. The sketch is kept for further quantile queries.
+     */
+    NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min, double max,
+                        double mean, double standardDeviation, util::QuantileSketch sketch);
+
     std::vector<double>& getData();
     const std::vector<double>& getData() const;
     double& operator[](size_t i);
@@ -75,17 +85,100 @@ public:
     Stats stats_;
     Stats histStats_;
     dvec2 dataRange_;
+    util::QuantileSketch quantiles_;
 
 protected:
     std::vector<double> data_;
     double maximumBinCount_;
 };
 
+/**
+ * \brief Accumulates histogram counts and statistics of data, one set per channel.
+ * Accumulators of disjoint parts of the data can be combined with merge(), and the counts and sums
+ * of a part can be removed again with subtract(). This makes it possible to update histograms
+ * incrementally when only a part of the data changes.
+ */
+class IVW_CORE_API HistogramAccumulator {
+public:
+    struct Channel {
+        std::vector<double> counts;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+        double sum2 = 0.0;
+        util::QuantileSketch sketch;
+    };
+
+    HistogramAccumulator() = default;
+    /**
+     * @param dataRange the range covered by the bins
+     * @param bins the number of bins
+     * @param quantiles also feed all values into a QuantileSketch per channel. This makes adding
+     *        values several times slower, so only enable it when the quantiles are needed.
+     */
+    HistogramAccumulator(dvec2 dataRange, size_t bins, bool quantiles = false);
+
+    /**
+     * \brief The number of bins to use for data of type T, integral types get at most one bin per
+     * value in the data range.
+     */
+    template <typename T>
+    static size_t binsFor(dvec2 dataRange, size_t bins);
+
+    /**
+     * \brief Add all values in [begin, end), the number of channels is given by the value type
+     */
+    template <typename FirstIter, typename LastIter>
+    void add(FirstIter begin, LastIter end);
+
+    /**
+     * \brief Add the counts, sums, extrema and quantiles of other
+     */
+    void merge(const HistogramAccumulator& other);
+    /**
+     * \brief Remove the counts and sums of other, which must be a part of the data accumulated
+     * into this. Extrema and quantiles can not be removed and are left unchanged.
+     */
+    void subtract(const HistogramAccumulator& other);
+    /**
+     * \brief Reset the extrema and quantiles, use mergeExtrema() to rebuild them from parts
+     */
+    void clearExtrema();
+    /**
+     * \brief Add the extrema and quantiles of other, but not the counts and sums
+     */
+    void mergeExtrema(const HistogramAccumulator& other);
+
+    size_t getCount() const { return count_; }
+    size_t getBins() const { return bins_; }
+    dvec2 getDataRange() const { return dataRange_; }
+    bool hasQuantiles() const { return quantiles_; }
+    const std::vector<Channel>& getChannels() const { return channels_; }
+
+    /**
+     * \brief Create a NormalizedHistogram for each channel
+     */
+    std::vector<NormalizedHistogram> toHistograms() const;
+
+private:
+    dvec2 dataRange_{0.0, 1.0};
+    size_t bins_ = 0;
+    size_t count_ = 0;
+    bool quantiles_ = false;
+    std::vector<Channel> channels_;
+};
+
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
+    /**
+     * Compute histograms of [begin, end), if \p quantiles is true the percentiles of the stats
+     * are computed with a QuantileSketch, see HistogramAccumulator.
+     */
     template <typename FirstIter, typename LastIter>
-    HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
+    HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end,
+                       bool quantiles = false);
 
     const NormalizedHistogram& operator[](size_t i) const;
     const NormalizedHistogram& get(size_t i) const;
@@ -102,9 +195,18 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
+template <typename T>
+size_t HistogramAccumulator::binsFor(dvec2 dataRange, size_t bins) {
+    // check whether number of bins exceeds the data range only if it is an integral type
+    if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
+        return std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
+    } else {
+        return bins;
+    }
+}
+
 template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
+void HistogramAccumulator::add(FirstIter begin, LastIter end) {
     using T = typename std::iterator_traits<FirstIter>::value_type;
 
     // a double type with the same extent as T
@@ -114,14 +216,8 @@ HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter b
 
     constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
 
-    // check whether number of bins exceeds the data range only if it is an integral type
-    if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
-    }
-
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+    if (channels_.size() != extent) {
+        channels_.assign(extent, Channel{std::vector<double>(bins_, 0.0)});
     }
 
     D min(std::numeric_limits<double>::max());
@@ -130,8 +226,8 @@ HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter b
     D sum2(0);
     size_t count(0);
 
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
+    const D rangeMin(dataRange_.x);
+    const D rangeScaleFactor(static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x));
 
     for (; begin != end; ++begin) {
 
@@ -144,22 +240,37 @@ HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter b
         count++;
 
         const auto ind = static_cast<I>(
-            glm::clamp((val - rangeMin) * rangeScaleFactor, D{0.0}, static_cast<D>(bins - 1)));
+            glm::clamp((val - rangeMin) * rangeScaleFactor, D{0.0}, static_cast<D>(bins_ - 1)));
         for (size_t i = 0; i < extent; ++i) {
             const auto v = util::glmcomp(ind, i);
-            ++histData[i][v];
+            ++channels_[i].counts[v];
+        }
+        if (quantiles_) {
+            for (size_t i = 0; i < extent; ++i) {
+                channels_[i].sketch.add(util::glmcomp(val, i));
+            }
         }
     }
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
-
+    count_ += count;
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        auto& channel = channels_[i];
+        channel.min = std::min(channel.min, util::glmcomp(min, i));
+        channel.max = std::max(channel.max, util::glmcomp(max, i));
+        channel.sum += util::glmcomp(sum, i);
+        channel.sum2 += util::glmcomp(sum2, i);
     }
 }
 
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin, LastIter end,
+                                       bool quantiles) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+
+    HistogramAccumulator accumulator(dataRange, HistogramAccumulator::binsFor<T>(dataRange, bins),
+                                     quantiles);
+    accumulator.add(begin, end);
+    histograms_ = accumulator.toHistograms();
+}
+
 }  // namespace inviwo
@@ -42,6 +42,44 @@ namespace inviwo {
 
 class HistogramSupplier;
 
+/**
+ * \brief Histograms of a VolumeRAM that are kept per region of the volume, such that regions
+ * that are modified can be updated without processing the whole volume.
+ * The regions are groups of the bricks used for modification tracking in VolumeRAM, the group
+ * size is chosen to keep the number of regions, and hence the memory use, bounded.
+ * HistogramSupplier only creates them for volumes that have been edited, i.e. that have a
+ * modification version larger than zero.
+ * @see VolumeRAM::markModified
+ */
+class IVW_CORE_API BrickedHistogram {
+public:
+    static constexpr size_t maxRegions = 512;
+
+    BrickedHistogram(const VolumeRAM& volumeRam, dvec2 dataRange, size_t bins);
+
+    /**
+     * \brief Update the regions containing the given modification bricks. The old contributions
+     * of the regions are subtracted and the new ones added.
+     * @see VolumeRAM::getModifiedBricks
+     */
+    void update(const VolumeRAM& volumeRam, const std::vector<size_t>& modifiedBricks);
+
+    HistogramContainer getHistograms() const;
+
+    const size3_t& getDimensions() const { return dims_; }
+
+private:
+    HistogramAccumulator calculate(const VolumeRAM& volumeRam, size_t region) const;
+
+    dvec2 dataRange_;
+    size_t bins_;
+    size3_t dims_;
+    size_t regionSize_;  //!< Size of a region in voxels along each axis
+    size3_t regions_;
+    HistogramAccumulator total_;
+    std::vector<HistogramAccumulator> regionHistograms_;
+};
+
 class IVW_CORE_API HistogramCalculationState {
 public:
     friend HistogramSupplier;
@@ -87,18 +125,40 @@ public:
     void invalidateHistogram() {
         histograms_->clear();
         calculation_.reset();
+        incremental_.reset();
     }
 
 protected:
+    /**
+     * Start a calculation of the histograms unless there is one for the same volumeRam, data range
+     * and bins already. If only parts of the volumeRam have been modified since the last
+     * calculation, and the modifications were marked with VolumeRAM::markModified, only those
+     * parts are processed again. The histograms per region needed for that are only kept for
+     * volumes that have been modified, and are released when the histograms are invalidated or
+     * calculated for another volumeRam.
+     */
     std::shared_ptr<HistogramCalculationState> startCalculation(
         std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const;
 
+    /**
+     * Returns true if \p volumeRam has been marked as modified since the histograms were
+     * calculated. A new calculation will then update the histograms.
+     */
+    bool histogramsOutdated(const VolumeRAM& volumeRam) const;
+
 private:
+    struct Incremental;
+
+    static void enqueueCalculation(std::shared_ptr<HistogramCalculationState> state,
+                                   std::shared_ptr<Incremental> incremental,
+                                   std::shared_ptr<const VolumeRAM> volumeRam,
+                                   std::vector<size_t> modifiedBricks);
     static void done(std::shared_ptr<HistogramCalculationState> state,
                      HistogramContainer histograms);
 
     mutable std::shared_ptr<HistogramCalculationState> calculation_;
     mutable std::shared_ptr<HistogramContainer> histograms_;
+    mutable std::shared_ptr<Incremental> incremental_;
 };
 
 }  // namespace inviwo
@@ -87,6 +87,8 @@ public:
     virtual void setWrapping(const Wrapping2D& wrapping) override;
     virtual Wrapping2D getWrapping() const override;
 
+    virtual size_t getResidentBytes() const override;
+
 private:
     // clang-format off
     [[deprecated("does not work for DiskRepresentation (deprecated since 2019-06-27)")]]
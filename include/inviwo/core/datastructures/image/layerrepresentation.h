@@ -87,6 +87,8 @@ public:
 
     LayerType getLayerType() const;
 
+    virtual size_t getResidentBytes() const override;
+
 protected:
     LayerRepresentation(LayerType type = LayerType::Color,
                         const DataFormatBase* format = DataVec4UInt8::get());
@@ -0,0 +1,167 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \brief A thread safe pool of RAM representations that can be reused.
+ *
+ * Processors that create a new output every evaluation can get their RAM representations from
+ * the pool instead of allocating new ones. The pool keeps a reference to every representation it
+ * hands out, once all other references are gone, i.e. the previous output has been replaced and
+ * released, the representation is handed out again for the next request with the same type and
+ * dimensions. This avoids the page faults and zeroing of fresh allocations for large data.
+ *
+ * Idle representations are evicted, least recently used first, when the memory held by the pool
+ * exceeds the budget. A budget of zero disables pooling.
+ *
+ * \note The content of a reused representation is whatever the previous user left in it, the
+ * caller has to overwrite all of it. The bookkeeping state, i.e. the owner, the valid flag, and for
+ * volumes the modification tracking, is reset before it is handed out.
+ *
+ * Example Usage:
+ * \code{.cpp}
+ * auto ram = util::makePooledRepresentation<VolumeRAMPrecision<float>>(dims);
+ * auto volume = std::make_shared<Volume>(ram);
+ * \endcode
+ */
+class IVW_CORE_API RepresentationPool {
+public:
+    struct Stats {
+        size_t hits = 0;           //!< Requests served by reusing a representation
+        size_t misses = 0;         //!< Requests that needed a new allocation
+        size_t evictions = 0;      //!< Idle representations released to stay within the budget
+        size_t bytesHeld = 0;      //!< Memory of all representations referenced by the pool
+        size_t bytesIdle = 0;      //!< Memory of representations ready for reuse
+        size_t highWaterMark = 0;  //!< Largest value of bytesHeld so far
+    };
+
+    explicit RepresentationPool(size_t budget = 0);
+
+    /**
+     * \brief Get a representation of type Repr with the given dimensions
+     * Repr is a precision RAM representation like VolumeRAMPrecision<T>, LayerRAMPrecision<T>,
+     * or BufferRAMPrecision<T>, constructible from its dimensions.
+     */
+    template <typename Repr, typename Dims>
+    std::shared_ptr<Repr> get(const Dims& dims);
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    Stats getStats() const;
+
+    /**
+     * \brief Release all idle representations
+     */
+    void clear();
+
+private:
+    struct Entry {
+        std::shared_ptr<void> repr;
+        size_t bytes;
+        size_t lastUse;
+    };
+    // Representation type and dimensions
+    using Key = std::tuple<std::type_index, size_t, size_t, size_t>;
+    static Key makeKey(std::type_index type, size3_t dims) {
+        return Key{type, dims.x, dims.y, dims.z};
+    }
+
+    static size3_t toKey(size_t size) { return size3_t{size, 1, 1}; }
+    static size3_t toKey(size2_t dims) { return size3_t{dims, 1}; }
+    static size3_t toKey(size3_t dims) { return dims; }
+
+    std::shared_ptr<void> reuse(std::type_index type, size3_t dims);
+    void track(std::shared_ptr<void> repr, std::type_index type, size3_t dims, size_t bytes);
+    void trim();
+
+    mutable std::mutex mutex_;
+    size_t budget_;
+    size_t clock_ = 0;
+    Stats stats_;
+    std::multimap<Key, Entry> entries_;
+};
+
+template <typename Repr, typename Dims>
+std::shared_ptr<Repr> RepresentationPool::get(const Dims& dims) {
+    const auto key = toKey(dims);
+    if (auto reused = reuse(typeid(Repr), key)) {
+        auto repr = std::static_pointer_cast<Repr>(reused);
+        repr->setOwner(nullptr);
+        repr->setValid(true);
+        if constexpr (std::is_base_of_v<VolumeRAM, Repr>) {
+            repr->resetModifications();
+        }
+        return repr;
+    }
+    auto repr = std::make_shared<Repr>(dims);
+    track(repr, typeid(Repr), key, sizeof(typename Repr::type) * key.x * key.y * key.z);
+    return repr;
+}
+
+namespace util {
+
+/**
+ * \brief Returns the pool of the InviwoApplication, or nullptr if there is no application
+ */
+IVW_CORE_API RepresentationPool* getRepresentationPool();
+
+/**
+ * \brief Get a representation from the application's RepresentationPool. Falls back to a new
+ * allocation if there is no application.
+ * \note The content of the representation is undefined, the caller has to overwrite all of it.
+ * @see RepresentationPool
+ */
+template <typename Repr, typename Dims>
+std::shared_ptr<Repr> makePooledRepresentation(const Dims& dims) {
+    if (auto pool = getRepresentationPool()) {
+        return pool->template get<Repr>(dims);
+    }
+    return std::make_shared<Repr>(dims);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,155 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief Thread safe accounting of the memory held by data representations.
+ *
+ * Every representation added to a Data object (Volume, Layer, BufferBase) is registered here with
+ * its size, the kind of representation and the processor that was being evaluated when it was
+ * created, see Scope. Accessing a representation updates its size and marks it as recently used.
+ *
+ * When a budget is set, enforceBudget() releases representations, least recently used first,
+ * until the total is within the budget again. Only representations that can be regenerated are
+ * released, i.e. ones that are not the last valid representation of their Data, or the last valid
+ * one if the Data also has a valid representation that does not occupy memory, like a disk
+ * representation. Representations referenced outside of their Data are never released, neither
+ * are representations added without an EvictFunction, like the ones of layers.
+ * A budget of zero disables eviction.
+ *
+ * \note Raw pointers from Data::getRepresentation are not tracked. Eviction should only be done
+ * when no processor is running, the ProcessorNetworkEvaluator does it after each evaluation.
+ */
+class IVW_CORE_API RepresentationRegistry {
+public:
+    /**
+     * Releases \p repr from \p owner. Must return false without blocking if the owner is busy or
+     * the representation can not be regenerated, and must not call back into the registry.
+     * Owners passing nullptr in add() are only accounted for.
+     */
+    using EvictFunction = bool (*)(const void* owner, const void* repr);
+
+    struct Usage {
+        size_t bytes = 0;
+        size_t count = 0;
+    };
+
+    struct Stats {
+        Usage total;
+        std::map<std::string, Usage> kinds;       //!< Per representation type, i.e. VolumeRAM
+        std::map<std::string, Usage> processors;  //!< Per processor creating the representation
+        size_t budget = 0;
+        size_t evictions = 0;     //!< Representations released to stay within the budget
+        size_t evictedBytes = 0;  //!< Memory released to stay within the budget
+    };
+
+    /**
+     * \brief Attribute representations added on this thread to \p source while the scope is alive
+     */
+    class IVW_CORE_API Scope {
+    public:
+        explicit Scope(std::string_view source);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        std::string previous_;
+    };
+
+    explicit RepresentationRegistry(size_t budget = 0);
+
+    void add(const void* owner, EvictFunction evict, const void* repr, std::type_index kind,
+             size_t bytes);
+    /**
+     * \brief Mark an added representation as used and update its size, does nothing for unknown
+     * representations
+     */
+    void touch(const void* owner, const void* repr, size_t bytes);
+    void remove(const void* owner, const void* repr);
+    void removeOwner(const void* owner);
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    size_t getTotalBytes() const;
+    Stats getStats() const;
+
+    /**
+     * \brief Release representations until the total is within the budget
+     * @return the number of bytes released
+     */
+    size_t enforceBudget();
+
+private:
+    struct Entry {
+        const void* repr;
+        std::type_index kind;
+        std::string source;
+        size_t bytes;
+        size_t lastUse;
+    };
+    struct Owner {
+        EvictFunction evict;
+        std::vector<Entry> reprs;
+    };
+
+    mutable std::mutex mutex_;
+    size_t budget_;
+    size_t totalBytes_ = 0;
+    size_t clock_ = 0;
+    size_t evictions_ = 0;
+    size_t evictedBytes_ = 0;
+    std::unordered_map<const void*, Owner> owners_;
+};
+
+namespace util {
+
+/**
+ * \brief Returns the registry of the InviwoApplication, or nullptr if there is no application
+ */
+IVW_CORE_API RepresentationRegistry* getRepresentationRegistry();
+
+}  // namespace util
+
+}  // namespace inviwo
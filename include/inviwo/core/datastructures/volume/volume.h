@@ -158,6 +158,13 @@ public:
 
     std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
 
+    /**
+     * Returns true if the VolumeRAM has been marked as modified since the histograms were
+     * calculated, calculateHistograms will then only process the modified parts.
+     * @see VolumeRAM::markModified
+     */
+    bool hasOutdatedHistograms() const;
+
 protected:
     size3_t defaultDimensions_;
     const DataFormatBase* defaultDataFormat_;
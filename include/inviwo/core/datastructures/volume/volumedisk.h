@@ -76,6 +76,8 @@ public:
     virtual void setWrapping(const Wrapping3D& wrapping) override;
     virtual Wrapping3D getWrapping() const override;
 
+    virtual size_t getResidentBytes() const override;
+
 private:
     size3_t dimensions_;
     SwizzleMask swizzleMask_;
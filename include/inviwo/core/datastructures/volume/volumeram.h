@@ -89,6 +89,38 @@ public:
 
     virtual size_t getNumberOfBytes() const = 0;
 
+    /**
+     * \brief Size of the bricks used to track modifications, see markModified.
+     */
+    static constexpr size_t modificationBrickSize = 32;
+
+    /**
+     * \brief Mark the voxels in the box [offset, offset + extent) as modified.
+     * Users of the data that support incremental updates, like the histograms of a Volume, will
+     * only reprocess the bricks that were modified since they last looked at the data.
+     * Modifications that are not marked are not detected, in that case
+     * Volume::invalidateHistogram() has to be called.
+     * The tracking is not thread safe, mark modifications from the thread that modifies the data.
+     */
+    void markModified(const size3_t& offset, const size3_t& extent);
+    /**
+     * \brief Mark all voxels as modified
+     */
+    void markModified();
+    /**
+     * \brief A counter that is incremented by every call to markModified
+     */
+    size_t getModificationVersion() const { return modificationVersion_; }
+    /**
+     * \brief Get the indices of the bricks modified after \p version.
+     * The bricks are of size modificationBrickSize and are indexed with x fastest.
+     */
+    std::vector<size_t> getModifiedBricks(size_t version) const;
+    /**
+     * \brief Forget all tracked modifications and reset the modification version to zero
+     */
+    void resetModifications();
+
     template <typename T>
     static T posToIndex(const glm::tvec3<T, glm::defaultp>& pos,
                         const glm::tvec3<T, glm::defaultp>& dim);
@@ -152,6 +184,11 @@ public:
     template <typename Result, template <class> class Predicate = dispatching::filter::All,
               typename Callable, typename... Args>
     auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+
+private:
+    size_t modificationVersion_ = 0;
+    size3_t modificationBricks_{0};
+    std::vector<size_t> brickVersions_;  //!< Version of the last modification of each brick
 };
 
 class Volume;
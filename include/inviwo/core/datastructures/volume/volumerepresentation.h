@@ -51,6 +51,8 @@ public:
     virtual void setDimensions(size3_t dimensions) = 0;
     virtual const size3_t& getDimensions() const = 0;
 
+    virtual size_t getResidentBytes() const override;
+
     /**
      * \brief update the swizzle mask of the color channels when sampling the volume
      *
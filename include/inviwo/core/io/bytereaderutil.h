@@ -30,14 +30,27 @@
 #pragma once
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
 #include <string_view>
 
 namespace inviwo {
 
+struct DiskRegion;
+
 namespace util {
 
 void IVW_CORE_API readBytesIntoBuffer(std::string_view file, size_t offset, size_t bytes,
                                       bool littleEndian, size_t elementSize, void* dest);
+
+/**
+ * Read \p region of a block of \p dims elements, stored x fastest from \p offset in \p file,
+ * into \p dest. Only the part of each row covered by the region is read, and rows or slices
+ * skipped by the stride are never read. \p dest has to fit region.getOutputDimensions()
+ * elements.
+ */
+void IVW_CORE_API readBytesIntoBuffer(std::string_view file, size_t offset, size3_t dims,
+                                      const DiskRegion& region, bool littleEndian,
+                                      size_t elementSize, void* dest);
 }  // namespace util
 
 }  // namespace inviwo
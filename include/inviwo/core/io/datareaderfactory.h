@@ -34,6 +34,7 @@
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/io/datareader.h>
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -50,6 +51,15 @@ public:
 
     bool registerObject(DataReader* reader);
     bool unRegisterObject(DataReader* reader);
+
+    /**
+     * Set a callback that is called with the file path or extension of each look up, before
+     * the registered readers are searched. An empty string means that all readers are requested.
+     * Used by the ModuleManager to construct deferred modules that provide a matching reader.
+     * @see ModuleManager::setLazyRegistration
+     */
+    void setLookupCallback(std::function<void(std::string_view)> callback);
+
     virtual std::unique_ptr<DataReader> create(const FileExtension& key) const override;
     virtual std::unique_ptr<DataReader> create(std::string_view key) const override;
     virtual bool hasKey(std::string_view key) const override;
@@ -100,11 +110,15 @@ public:
     }
 
 protected:
+    void lookup(std::string_view filePathOrExtension) const;
+
     std::map<FileExtension, DataReader*> map_;
+    std::function<void(std::string_view)> lookupCallback_;
 };
 
 template <typename T>
 std::vector<FileExtension> DataReaderFactory::getExtensionsForType() const {
+    lookup("");
     std::vector<FileExtension> ext;
 
     for (auto reader : map_) {
@@ -118,6 +132,7 @@ std::vector<FileExtension> DataReaderFactory::getExtensionsForType() const {
 template <typename T>
 std::unique_ptr<DataReaderType<T>> DataReaderFactory::getReaderForTypeAndExtension(
     std::string_view path) const {
+    lookup(path);
     std::vector<std::pair<size_t, DataReaderType<T>*>> candidates;
     for (auto& [ext, reader] : map_) {
         if (util::iCaseEndsWith(path, ext.extension_)) {
@@ -140,6 +155,7 @@ std::unique_ptr<DataReaderType<T>> DataReaderFactory::getReaderForTypeAndExtensi
 template <typename T>
 std::unique_ptr<DataReaderType<T>> DataReaderFactory::getReaderForTypeAndExtension(
     const FileExtension& ext) const {
+    lookup(ext.extension_);
     return util::map_find_or_null(map_, ext, [](DataReader* o) {
         if (auto r = dynamic_cast<DataReaderType<T>*>(o)) {
             return std::unique_ptr<DataReaderType<T>>(r->clone());
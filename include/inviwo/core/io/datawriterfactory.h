@@ -37,6 +37,7 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 #include <memory>
 
 namespace inviwo {
@@ -54,6 +55,14 @@ public:
     bool registerObject(DataWriter* writer);
     bool unRegisterObject(DataWriter* writer);
 
+    /**
+     * Set a callback that is called with the file path or extension of each look up, before
+     * the registered writers are searched. An empty string means that all writers are requested.
+     * Used by the ModuleManager to construct deferred modules that provide a matching writer.
+     * @see ModuleManager::setLazyRegistration
+     */
+    void setLookupCallback(std::function<void(std::string_view)> callback);
+
     virtual std::unique_ptr<DataWriter> create(std::string_view key) const override;
     virtual std::unique_ptr<DataWriter> create(const FileExtension& key) const override;
 
@@ -106,11 +115,15 @@ public:
     }
 
 protected:
+    void lookup(std::string_view filePathOrExtension) const;
+
     std::map<FileExtension, DataWriter*> map_;
+    std::function<void(std::string_view)> lookupCallback_;
 };
 
 template <typename T>
 std::vector<FileExtension> DataWriterFactory::getExtensionsForType() const {
+    lookup("");
     std::vector<FileExtension> ext;
 
     for (auto& writer : map_) {
@@ -124,6 +137,7 @@ std::vector<FileExtension> DataWriterFactory::getExtensionsForType() const {
 template <typename T>
 std::unique_ptr<DataWriterType<T>> DataWriterFactory::getWriterForTypeAndExtension(
     std::string_view path) const {
+    lookup(path);
     std::vector<std::pair<size_t, DataWriterType<T>*>> candidates;
     for (auto& [ext, writer] : map_) {
         if (util::iCaseEndsWith(path, ext.extension_)) {
@@ -146,6 +160,7 @@ std::unique_ptr<DataWriterType<T>> DataWriterFactory::getWriterForTypeAndExtensi
 template <typename T>
 std::unique_ptr<DataWriterType<T>> DataWriterFactory::getWriterForTypeAndExtension(
     const FileExtension& ext) const {
+    lookup(ext.extension_);
     return util::map_find_or_null(map_, ext, [](DataWriter* o) {
         if (auto r = dynamic_cast<DataWriterType<T>*>(o)) {
             return std::unique_ptr<DataWriterType<T>>(r->clone());
@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace inviwo {
+
+class Serializer;
+class Volume;
+class VolumeRAM;
+class VolumeRepresentation;
+
+/**
+ * \brief A persistent on-disk cache of decoded volume data.
+ *
+ * Readers of compressed formats (pvm, nii.gz, compressed tiff stacks, chunked hdf5) spend most of
+ * their time decoding. The cache stores the decoded voxels as raw data in a local directory
+ * together with a small xml header, so the next load of the same file can read the raw data
+ * directly instead. Other importers can store their converted data as files in the cache as well.
+ *
+ * Entries are keyed by the source file path and a reader specific settings string, i.e. whatever
+ * apart from the file affects the decoded result, like the time step or the dataset path within
+ * a file. The size and modification time of the source file is recorded as well, a changed source
+ * file invalidates the entry.
+ *
+ * There are three kinds of entries:
+ *   - Volume entries, see load(std::string_view, std::string_view) and store(std::string_view,
+ *     std::string_view, const Volume&). The header holds the full volume description and a hit
+ *     returns a Volume with a VolumeDisk representation that lazily reads the raw data using a
+ *     RawVolumeRAMLoader. The VolumeDisk keeps the source file as its path. Meant for readers
+ *     that have to decode the file to get the header.
+ *   - Representation entries, see loadRepresentation and store(std::string_view,
+ *     std::string_view, const VolumeRAM&). Meant for DiskRepresentationLoaders that only decode
+ *     the data.
+ *   - File entries, see loadFile and storeFile. The entry holds a file in any format written by
+ *     the caller, like a mesh converted to the ivm format. Meant for non volume data that is
+ *     expensive to import.
+ *
+ * The total size of the raw data is kept below the budget by removing the least recently used
+ * entries. Entries are kept as long as a VolumeDisk handed out by load(), or any copy of it, is
+ * alive, since it might still read the raw data. A budget of zero disables the cache.
+ *
+ * Example usage in a reader:
+ * \code{.cpp}
+ * auto cache = util::getDecodedVolumeCache();
+ * if (cache && cache->isEnabled()) {
+ *     if (auto volume = cache->load(filePath)) return volume;
+ * }
+ * auto volume = decode(filePath);
+ * if (cache && cache->isEnabled()) cache->store(filePath, {}, *volume);
+ * \endcode
+ */
+class IVW_CORE_API DecodedVolumeCache {
+public:
+    struct Stats {
+        size_t hits = 0;       //!< Loads served from the cache
+        size_t misses = 0;     //!< Loads without a valid entry
+        size_t stores = 0;     //!< Entries written
+        size_t evictions = 0;  //!< Entries removed to stay within the budget
+        size_t bytesHeld = 0;  //!< Size of the raw data of all entries
+    };
+
+    explicit DecodedVolumeCache(std::string_view directory = {}, size_t budget = 0);
+
+    /**
+     * \brief Look for a volume entry for the given source file and settings
+     * @return The cached volume, or nullptr if there is no valid entry.
+     */
+    std::shared_ptr<Volume> load(std::string_view sourceFile, std::string_view settings = {});
+
+    /**
+     * \brief Look for a representation entry matching the dimensions and format of src
+     * @return The cached data read into a new VolumeRAM, or nullptr if there is no valid entry.
+     */
+    std::shared_ptr<VolumeRAM> loadRepresentation(std::string_view sourceFile,
+                                                  std::string_view settings,
+                                                  const VolumeRepresentation& src);
+
+    /**
+     * \brief Look for a file entry for the given source file and settings
+     * The entry is kept until the returned pin is released, hold on to it while reading the file.
+     * @return The path of the cached file and a pin, or an empty path if there is no valid entry.
+     */
+    std::pair<std::string, std::shared_ptr<const void>> loadFile(std::string_view sourceFile,
+                                                                 std::string_view settings);
+
+    /**
+     * \brief Store a file derived from sourceFile
+     * @param sourceFile the file the data was derived from
+     * @param settings whatever apart from the source file affects the content
+     * @param writer writes the content of the file to the given binary stream, may throw
+     */
+    void storeFile(std::string_view sourceFile, std::string_view settings,
+                   const std::function<void(std::ostream&)>& writer);
+
+    /**
+     * \brief Store the volume, including its header, as decoded from sourceFile
+     * Will get the VolumeRAM representation of the volume.
+     */
+    void store(std::string_view sourceFile, std::string_view settings, const Volume& volume);
+
+    /**
+     * \brief Store the data of the representation as decoded from sourceFile
+     */
+    void store(std::string_view sourceFile, std::string_view settings, const VolumeRAM& ram);
+
+    bool isEnabled() const;
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    void setDirectory(std::string_view directory);
+    std::string getDirectory() const;
+
+    Stats getStats() const;
+
+    /**
+     * \brief Remove all entries that are not in use
+     */
+    void clear();
+
+private:
+    struct Entry {
+        size_t bytes = 0;
+        size_t lastUse = 0;
+        size_t readers = 0;
+        std::weak_ptr<const void> pin;  //!< Held by the loaders of the volumes handed out
+
+        bool inUse() const;
+        std::shared_ptr<const void> lock();
+    };
+
+    std::string entryName(std::string_view sourceFile, std::string_view settings) const;
+    std::string headerPath(const std::string& name) const;
+    std::string rawPath(const std::string& name) const;
+
+    void write(std::string_view sourceFile, std::string_view settings, size_t bytes,
+               const std::function<void(std::ostream&)>& writeData,
+               const std::function<void(Serializer&)>& writeHeader);
+    void touch(const std::string& name);
+
+    void scan();
+    void remove(const std::string& name);
+    void trim();
+
+    mutable std::mutex mutex_;
+    std::string directory_;
+    size_t budget_;
+    bool scanned_ = false;
+    size_t clock_ = 0;
+    Stats stats_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+namespace util {
+
+/**
+ * \brief Returns the cache of the InviwoApplication, or nullptr if there is no application
+ */
+IVW_CORE_API DecodedVolumeCache* getDecodedVolumeCache();
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/geometry/geometrytype.h>
+#include <inviwo/core/io/serialization/deserializer.h>
+#include <inviwo/core/io/serialization/serializer.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace inviwo {
+
+/**
+ * Constants and header entries of the Inviwo binary mesh format shared by IvmMeshReader and
+ * IvmMeshWriter
+ */
+namespace ivm {
+
+constexpr std::array<char, 8> magic = {'I', 'V', 'W', 'M', 'E', 'S', 'H', '\0'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+/// Alignment of the buffer data relative to the start of the file
+constexpr std::size_t alignment = 64;
+
+constexpr std::size_t align(std::size_t pos) {
+    return (pos + alignment - 1) / alignment * alignment;
+}
+
+/// Size of the fixed part of the file: magic, version, byte order mark and header size
+constexpr std::size_t preambleSize =
+    magic.size() + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+/// Position and size of the raw data of a buffer, offset relative to the start of the data
+struct DataBlock {
+    std::size_t size = 0;  //!< number of elements
+    std::size_t offset = 0;
+};
+
+struct BufferEntry {
+    BufferType type = BufferType::PositionAttrib;
+    int location = 0;
+    std::string format;
+    BufferUsage usage = BufferUsage::Static;
+    DataBlock data;
+
+    void serialize(Serializer& s) const {
+        s.serialize("type", type);
+        s.serialize("location", location);
+        s.serialize("format", format);
+        s.serialize("usage", usage);
+        s.serialize("size", data.size);
+        s.serialize("offset", data.offset);
+    }
+    void deserialize(Deserializer& d) {
+        d.deserialize("type", type);
+        d.deserialize("location", location);
+        d.deserialize("format", format);
+        d.deserialize("usage", usage);
+        d.deserialize("size", data.size);
+        d.deserialize("offset", data.offset);
+    }
+};
+
+struct IndexEntry {
+    DrawType dt = DrawType::NotSpecified;
+    ConnectivityType ct = ConnectivityType::None;
+    DataBlock data;
+
+    void serialize(Serializer& s) const {
+        s.serialize("drawType", dt);
+        s.serialize("connectivityType", ct);
+        s.serialize("size", data.size);
+        s.serialize("offset", data.offset);
+    }
+    void deserialize(Deserializer& d) {
+        d.deserialize("drawType", dt);
+        d.deserialize("connectivityType", ct);
+        d.deserialize("size", data.size);
+        d.deserialize("offset", data.offset);
+    }
+};
+
+}  // namespace ivm
+
+}  // namespace inviwo
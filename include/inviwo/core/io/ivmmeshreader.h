@@ -0,0 +1,69 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/io/datareader.h>
+
+#include <istream>
+#include <string_view>
+
+namespace inviwo {
+
+/**
+ * \brief Reader for the Inviwo binary mesh format (ivm)
+ * @see IvmMeshWriter for a description of the format
+ */
+class IVW_CORE_API IvmMeshReader : public DataReaderType<Mesh> {
+public:
+    IvmMeshReader();
+    IvmMeshReader(const IvmMeshReader&) = default;
+    IvmMeshReader& operator=(const IvmMeshReader&) = default;
+    virtual IvmMeshReader* clone() const override;
+    virtual ~IvmMeshReader() = default;
+
+    virtual std::shared_ptr<Mesh> readData(std::string_view filePath) override;
+};
+
+namespace util {
+
+/**
+ * \brief Read a mesh in the ivm format from the stream, the stream has to be binary and seekable
+ * @param is the stream to read from
+ * @param key if not empty, the key stored by writeIvmMesh has to match
+ * @throws DataReaderException if the stream does not contain a valid ivm mesh, or if the key
+ * does not match
+ * @see IvmMeshReader
+ */
+IVW_CORE_API std::shared_ptr<Mesh> readIvmMesh(std::istream& is, std::string_view key = {});
+
+}  // namespace util
+
+}  // namespace inviwo
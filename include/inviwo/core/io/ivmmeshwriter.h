@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/io/datawriter.h>
+
+#include <ostream>
+#include <string_view>
+
+namespace inviwo {
+
+/**
+ * \brief Writer for the Inviwo binary mesh format (ivm)
+ *
+ * The format stores all buffers of a Mesh, with their BufferType, location, format and usage,
+ * all index buffers with their MeshInfo, the transformations and the meta data. The layout is
+ *   - an 8 byte magic "IVWMESH", a 32 bit version, and a 32 bit byte order mark
+ *   - the 64 bit size of a xml header followed by the header. The header describes the mesh and
+ *     the position and size of the data of every buffer
+ *   - the raw data of every buffer, each aligned to 64 bytes
+ *
+ * Reading the buffers is a single read each directly into the BufferRAM, without any parsing.
+ * @see IvmMeshReader
+ */
+class IVW_CORE_API IvmMeshWriter : public DataWriterType<Mesh> {
+public:
+    IvmMeshWriter();
+    IvmMeshWriter(const IvmMeshWriter&) = default;
+    IvmMeshWriter& operator=(const IvmMeshWriter&) = default;
+    virtual IvmMeshWriter* clone() const override;
+    virtual ~IvmMeshWriter() = default;
+
+    virtual void writeData(const Mesh* data, std::string_view filePath) const override;
+    virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
+        const Mesh* data, std::string_view fileExtension) const override;
+};
+
+namespace util {
+
+/**
+ * \brief Write the mesh in the ivm format to the stream, the stream has to be binary
+ * @param mesh the mesh to write
+ * @param os the stream to write to
+ * @param key optional identifier stored in the header, lets caches verify what they read
+ * @see IvmMeshWriter
+ */
+IVW_CORE_API void writeIvmMesh(const Mesh& mesh, std::ostream& os, std::string_view key = {});
+
+}  // namespace util
+
+}  // namespace inviwo
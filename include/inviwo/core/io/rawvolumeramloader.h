@@ -55,6 +55,13 @@ public:
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
 
+    virtual bool supportsRegions() const override;
+    /**
+     * Reads only the rows of the raw file that intersect the region.
+     */
+    virtual std::shared_ptr<VolumeRepresentation> createRegionRepresentation(
+        const VolumeRepresentation& src, const DiskRegion& region) const override;
+
 private:
     std::string rawFile_;
     size_t offset_;
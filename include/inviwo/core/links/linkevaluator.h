@@ -60,6 +60,14 @@ public:
 
     void evaluateLinksFromProperty(Property*);
 
+    /**
+     * Evaluate the links of several modified properties in one pass, using the union of their
+     * cached links. Each link is converted at most once. The properties are assumed to have been
+     * modified in the given order, hence a link into a property that is modified later in the
+     * list is skipped, since that value would have been overwritten anyway.
+     */
+    void evaluateLinksFromProperties(const std::vector<Property*>& modifiedProperties);
+
     /**
      * Properties that are linked to the given property where the given property is a source
      * property
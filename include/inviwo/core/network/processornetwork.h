@@ -43,8 +43,11 @@
 #include <inviwo/core/util/iterrange.h>
 #include <inviwo/core/util/transformiterator.h>
 
+#include <functional>
 #include <string_view>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace inviwo {
 
@@ -418,6 +421,30 @@ public:
     void unlock();
     bool islocked() const;
 
+    /**
+     * Start a property transaction. While a transaction is open, modified properties are only
+     * recorded, the network is locked, and on change callbacks, link evaluation, and
+     * invalidation are postponed until the outermost transaction ends. Transactions can be nested.
+     * Prefer the RAII helper PropertyTransaction over calling this directly.
+     * @see PropertyTransaction
+     */
+    void beginTransaction();
+    /**
+     * End a property transaction. When the outermost transaction ends, all recorded properties are
+     * committed: the on change callbacks of each property are invoked once, the links of all
+     * modified properties are evaluated together, each property owner is invalidated once with
+     * the highest requested level, and the network is unlocked, triggering a single evaluation.
+     * Properties are committed in the order they were first modified.
+     */
+    void endTransaction();
+    bool isInTransaction() const;
+    /**
+     * Called by Property::propertyModified. If a transaction is open, `property` is recorded to be
+     * committed when the transaction ends and true is returned. Otherwise nothing happens and
+     * false is returned.
+     */
+    bool deferPropertyModified(Property* property);
+
     virtual void serialize(Serializer& s) const override;
     virtual void deserialize(Deserializer& d) override;
     bool isDeserializing() const;
@@ -460,6 +487,9 @@ private:
     void addPropertyOwnerObservation(PropertyOwner*);
     void removePropertyOwnerObservation(PropertyOwner*);
 
+    void commitTransaction();
+    void removePendingChanges(const std::function<bool(Property*)>& predicate);
+
     static const int processorNetworkVersion_;
 
     unsigned int locked_ = 0;
@@ -479,6 +509,15 @@ private:
     std::vector<Processor*> processorsInvalidating_;
 
     std::unordered_map<Processor*, Processor::NameDispatcherHandle> onIdChange_;
+
+    struct PendingChange {
+        Property* property;
+        bool evaluateLinks;  // false if the change came from evaluating a link
+    };
+    unsigned int transactions_ = 0;
+    std::vector<PendingChange> pendingChanges_;
+    std::unordered_map<Property*, size_t> pendingIndex_;
+    std::vector<PendingChange> committingChanges_;
 };
 
 template <class T>
@@ -34,6 +34,7 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/network/processoroutputcache.h>
 
 namespace inviwo {
 
@@ -50,6 +51,13 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * The cache used for processors with output memoization enabled
+     * @see Processor::setOutputMemoization
+     */
+    ProcessorOutputCache& getOutputCache();
+    const ProcessorOutputCache& getOutputCache() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -72,6 +80,7 @@ private:
     bool needsSorting_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    ProcessorOutputCache outputCache_;
 };
 
 }  // namespace inviwo
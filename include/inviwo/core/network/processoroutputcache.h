@@ -0,0 +1,156 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+class Outport;
+
+/**
+ * \brief A LRU cache of processor outputs.
+ *
+ * For processors that have output memoization enabled, the outport data is stored after each
+ * process call, keyed by the serialized property state of the processor and by the identity of
+ * the data on its inports. When the same state occurs again, for example when toggling an option
+ * back and forth, the stored outport data is restored instead of calling Processor::process.
+ *
+ * The identity of inport data is the data object itself, not its content. To detect data that is
+ * edited in place, the cache tracks the data of every processed outport, if an outport still
+ * holds the same object after its processor has been processed, the object is considered modified
+ * and entries depending on it will not match anymore. Cached entries only hold weak references to
+ * the inport data, hence entries for released data never match.
+ *
+ * The size of the cache is bounded by the memory of the stored outputs, as reported by
+ * Outport::getResidentBytes when they are stored, and by a maximum number of entries for outputs
+ * of unknown size. The least recently used entries are removed first.
+ *
+ * Only outports that support Outport::getSharedData can be cached, i.e. DataOutports but not
+ * ImageOutports. For PoolProcessors the outputs are stored when the background jobs deliver
+ * their results, see PoolProcessor::newResults.
+ *
+ * @see Processor::setOutputMemoization
+ * @see ProcessorTraits
+ * @see ProcessorNetworkEvaluator
+ */
+class IVW_CORE_API ProcessorOutputCache {
+public:
+    /**
+     * @param budget the maximum number of bytes held by the stored outputs, over all processors
+     * @param capacity the maximum number of stored entries, over all processors
+     */
+    explicit ProcessorOutputCache(size_t budget = size_t{512} * 1024 * 1024, size_t capacity = 64);
+
+    /**
+     * Look up stored outputs for the current state of \p processor and set them on its outports.
+     * On a miss the state is remembered, so that a following call to store can use it.
+     * @return true if the outputs were restored, in that case process should not be called.
+     */
+    bool restore(Processor* processor);
+
+    /**
+     * Store the current outport data of \p processor, using the state recorded by the last call
+     * to restore. Does nothing if no state was recorded or if some outport can not be cached.
+     */
+    void store(Processor* processor);
+
+    /**
+     * Should be called after each Processor::process call. Updates the tracking of the outport
+     * data and stores the outputs of memoized processors that are not PoolProcessors.
+     */
+    void processed(Processor* processor);
+
+    /**
+     * Remove all entries and state of \p processor, should be called when it is removed from the
+     * network.
+     */
+    void remove(const Processor* processor);
+    void clear();
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+    /**
+     * The number of bytes held by the stored outputs
+     */
+    size_t getBytes() const;
+
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+    size_t size() const;
+
+    size_t getHits() const;
+    size_t getMisses() const;
+
+private:
+    struct Input {
+        std::weak_ptr<const void> data;
+        const void* ptr;
+        size_t version;
+    };
+    struct Key {
+        size_t hash;
+        std::string state;
+        std::vector<Input> inputs;
+    };
+    struct Entry {
+        const Processor* processor;
+        Key key;
+        std::vector<std::shared_ptr<const void>> outputs;
+        size_t bytes;
+    };
+
+    std::optional<Key> makeKey(Processor* processor);
+    static bool matches(const Key& a, const Key& b);
+    void track(const Outport* outport, bool processed);
+    std::list<Entry>::iterator erase(std::list<Entry>::iterator it);
+    void shrink();
+
+    size_t budget_;
+    size_t capacity_;
+    size_t bytes_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<const Processor*, Key> pending_;
+    std::unordered_map<const Outport*, std::pair<const void*, size_t>> versions_;
+    size_t hits_;
+    size_t misses_;
+};
+
+}  // namespace inviwo
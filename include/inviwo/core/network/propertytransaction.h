@@ -0,0 +1,76 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+namespace inviwo {
+
+class ProcessorNetwork;
+class Processor;
+class Property;
+
+/**
+ * \brief A RAII utility for batching property changes.
+ *
+ * While a PropertyTransaction is alive, property changes in the network are recorded instead of
+ * being propagated one by one. When the last transaction goes out of scope, the on change
+ * callbacks of every modified property are invoked once, all links are evaluated in a single
+ * pass, each property owner is invalidated once, and the network is evaluated once. Use it when
+ * setting many properties at once, e.g. from a script or when applying a preset.
+ *
+ * \code{.cpp}
+ * {
+ *     PropertyTransaction transaction(network);
+ *     for (auto& [property, value] : values) property->set(value);
+ * } // changes are committed here
+ * \endcode
+ *
+ * A transaction also locks the network, hence a NetworkLock is not needed in addition.
+ * @see ProcessorNetwork::beginTransaction
+ * @see NetworkLock
+ */
+struct IVW_CORE_API PropertyTransaction {
+    PropertyTransaction();
+    PropertyTransaction(ProcessorNetwork* network);
+    PropertyTransaction(Processor* processor);
+    PropertyTransaction(Property* property);
+    ~PropertyTransaction();
+
+    PropertyTransaction(PropertyTransaction const&) = delete;
+    PropertyTransaction& operator=(PropertyTransaction const& that) = delete;
+    PropertyTransaction(PropertyTransaction&& rhs) noexcept;
+    PropertyTransaction& operator=(PropertyTransaction&& that);
+
+private:
+    ProcessorNetwork* network_;
+};
+
+}  // namespace inviwo
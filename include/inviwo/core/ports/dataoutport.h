@@ -35,6 +35,7 @@
 #include <inviwo/core/ports/outportiterable.h>
 #include <inviwo/core/ports/porttraits.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/detected.h>
 #include <inviwo/core/util/document.h>
 
 #include <glm/fwd.hpp>
@@ -89,6 +90,10 @@ public:
 
     virtual bool hasData() const override;
 
+    virtual std::shared_ptr<const void> getSharedData() const override;
+    virtual bool setSharedData(std::shared_ptr<const void> data) override;
+    virtual size_t getResidentBytes() const override;
+
 protected:
     std::shared_ptr<const T> data_;
 };
@@ -157,6 +162,31 @@ bool DataOutport<T>::hasData() const {
     return data_.get() != nullptr;
 }
 
+template <typename T>
+std::shared_ptr<const void> DataOutport<T>::getSharedData() const {
+    return getData();
+}
+
+template <typename T>
+bool DataOutport<T>::setSharedData(std::shared_ptr<const void> data) {
+    setData(std::static_pointer_cast<const T>(data));
+    return true;
+}
+
+namespace detail {
+template <typename T>
+using residentBytesType = decltype(std::declval<const T&>().getResidentBytes());
+}  // namespace detail
+
+template <typename T>
+size_t DataOutport<T>::getResidentBytes() const {
+    if constexpr (util::is_detected_v<detail::residentBytesType, T>) {
+        return data_ ? data_->getResidentBytes() : 0;
+    } else {
+        return 0;
+    }
+}
+
 template <typename T>
 void DataOutport<T>::clear() {
     data_.reset();
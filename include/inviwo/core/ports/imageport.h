@@ -230,6 +230,16 @@ public:
      */
     virtual void clear() override;
 
+    /**
+     * Images are usually reused as render targets, hence they can not be cached.
+     * @return nullptr
+     */
+    virtual std::shared_ptr<const void> getSharedData() const override;
+    /**
+     * @return false, images can not be cached
+     */
+    virtual bool setSharedData(std::shared_ptr<const void> data) override;
+
     bool hasEditableData() const;
     std::shared_ptr<Image> getEditableData() const;
 
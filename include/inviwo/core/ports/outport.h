@@ -37,6 +37,7 @@
 
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace inviwo {
 
@@ -105,6 +106,27 @@ public:
      */
     virtual void clear() = 0;
 
+    /**
+     * Type erased access to the data of the port, used by the ProcessorOutputCache to store the
+     * outputs of a processor. Returns nullptr if the port has no data or if the port does not
+     * support caching its data. The default implementation does not support caching.
+     * @see setSharedData
+     */
+    virtual std::shared_ptr<const void> getSharedData() const;
+
+    /**
+     * Restore data previously returned by getSharedData.
+     * @return false if the port does not support it
+     * @see getSharedData
+     */
+    virtual bool setSharedData(std::shared_ptr<const void> data);
+
+    /**
+     * Memory in bytes held by the data of the port, used by the ProcessorOutputCache to bound its
+     * size. Returns 0 if there is no data or if the size is not known.
+     */
+    virtual size_t getResidentBytes() const;
+
 protected:
     /**
      * @note The internal isReady_ lambda function must be set by derived class, e.g.,
@@ -125,8 +125,11 @@ enum class Option {
                  ///< queued and submitted when the current one is finished
     DelayDispatch =
         1 << 2,  ///< Wait for a small delay (500ms) of inactivity before submitting a job
-    DelayInvalidation = 1 << 3  ///< Delay invalidation of outports until the job is finished. This
-                                ///< will override the default processor invalidation.
+    DelayInvalidation = 1 << 3,  ///< Delay invalidation of outports until the job is finished.
+                                 ///< This will override the default processor invalidation.
+    Preemptible = 1 << 4  ///< Allow the thread pool to stop running Background priority jobs to
+                          ///< make room for interactive work. A stopped job is discarded and the
+                          ///< processor invalidated, hence process has to dispatch the job again.
 };
 
 }  // namespace pool
@@ -279,6 +282,25 @@ public:
      *  \see pool::Option::DelayInvalidation
      */
     bool delayInvalidation() const { return options_.contains(pool::Option::DelayInvalidation); }
+    /**
+     *  \see pool::Option::Preemptible
+     */
+    bool preemptible() const { return options_.contains(pool::Option::Preemptible); }
+
+    /**
+     * Set the thread pool priority of jobs dispatched after this call, Normal by default.
+     * @see ThreadPool::Priority
+     */
+    void setPriority(ThreadPool::Priority priority);
+    ThreadPool::Priority getPriority() const;
+
+    /**
+     * Limit the number of jobs of this processor that run at the same time, 0 means no limit,
+     * which is the default. Applies to jobs dispatched after this call.
+     * @see ThreadPool::TaskInfo
+     */
+    void setConcurrencyLimit(size_t maxConcurrentJobs);
+    size_t getConcurrencyLimit() const;
 
 private:
     friend pool::detail::State;
@@ -310,6 +332,8 @@ private:
                          std::shared_ptr<pool::detail::StateTemplate<Result, Done>> state);
 
     pool::Options options_;
+    ThreadPool::Priority priority_;
+    size_t concurrencyLimit_;
     std::vector<std::shared_ptr<pool::detail::State>> states_;
     util::OnScopeExit notifyRemainingJobsFinish_;
     std::shared_ptr<pool::detail::Wrapper> wrapper_;
@@ -326,11 +350,17 @@ struct IVW_CORE_API Wrapper {
 
 struct IVW_CORE_API State {
     State(std::weak_ptr<Wrapper> processor, size_t count)
-        : processor(processor), count{count}, stop{false}, progress(count), nJobs{count} {}
+        : processor(processor)
+        , count{count}
+        , stop{false}
+        , preempted{false}
+        , progress(count)
+        , nJobs{count} {}
 
     std::weak_ptr<Wrapper> processor;
     std::atomic<size_t> count;
     std::atomic<bool> stop;
+    std::atomic<bool> preempted;
     std::vector<std::atomic<float>> progress;
     std::future<void> progressUpdate;
     size_t nJobs;
@@ -418,7 +448,13 @@ inline void PoolProcessor::callDone(
 
                 p.notifyObserversFinishBackgroundWork(&p, state->nJobs);
 
-                if (state->stop) return;
+                if (state->stop) {
+                    // The job was stopped by the thread pool, not replaced, process it again
+                    if (state->preempted && isLast) {
+                        p.invalidate(InvalidationLevel::InvalidOutput);
+                    }
+                    return;
+                }
 
                 if (isLast || p.keepOldJobs()) {
                     done(p, state);
@@ -286,6 +286,19 @@ public:
      */
     bool isReady() const;
 
+    /**
+     * Enable or disable memoization of the outputs of this processor. When enabled, the
+     * ProcessorNetworkEvaluator will store the outport data after each process call, keyed by the
+     * property state and the identity of the inport data, and restore it instead of calling
+     * process when an identical state occurs again. This is only valid if process only depends on
+     * the property state and the inport data, and if new data objects are set on the outports
+     * each time. Processors opt in by default by setting ProcessorTraits::memoizeOutputs.
+     * @see ProcessorOutputCache
+     * @see ProcessorTraits
+     */
+    void setOutputMemoization(bool enable);
+    bool getOutputMemoization() const;
+
     /**
      * Deriving classes should override this function to do the main work of the processor.
      * This function is called by the ProcessorNetworkEvaluator when the network is evaluated and
@@ -459,6 +472,7 @@ private:
     std::unordered_map<Port*, std::string> portGroups_;
 
     ProcessorNetwork* network_;
+    bool outputMemoization_;
 
     NameDispatcher identifierDispatcher_;
     NameDispatcher displayNameDispatcher_;
@@ -103,6 +103,7 @@ public:
 
         if (p->getIdentifier().empty()) p->setIdentifier(util::stripIdentifier(getDisplayName()));
         if (p->getDisplayName().empty()) p->setDisplayName(getDisplayName());
+        if constexpr (memoizeOutputs<T>()) p->setOutputMemoization(true);
         return p;
     }
 };
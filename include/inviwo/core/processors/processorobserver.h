@@ -64,6 +64,13 @@ public:
     virtual void onProcessorAboutToProcess(Processor*){};
     virtual void onProcessorFinishedProcess(Processor*){};
 
+    /**
+     * Called by the evaluator before and after Processor::initializeResources, the finished
+     * notification is sent also if initializeResources throws.
+     */
+    virtual void onProcessorAboutToInitializeResources(Processor*){};
+    virtual void onProcessorFinishedInitializeResources(Processor*){};
+
     /**
      * Called after the processor has changed its source state.
      */
@@ -129,6 +136,13 @@ protected:
     void notifyObserversFinishedProcess(Processor* p) {
         forEachObserver([&](ProcessorObserver* o) { o->onProcessorFinishedProcess(p); });
     }
+    void notifyObserversAboutToInitializeResources(Processor* p) {
+        forEachObserver([&](ProcessorObserver* o) { o->onProcessorAboutToInitializeResources(p); });
+    }
+    void notifyObserversFinishedInitializeResources(Processor* p) {
+        forEachObserver(
+            [&](ProcessorObserver* o) { o->onProcessorFinishedInitializeResources(p); });
+    }
     void notifyObserversSourceChange(Processor* p) {
         forEachObserver([&](ProcessorObserver* o) { o->onProcessorSourceChanged(p); });
     }
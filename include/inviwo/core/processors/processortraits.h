@@ -32,6 +32,8 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/processors/processorinfo.h>
 
+#include <type_traits>
+
 namespace inviwo {
 
 namespace detail {
@@ -57,6 +59,13 @@ ProcessorInfo processorInfo() {
     return ProcessorInfo(T::CLASS_IDENTIFIER, T::DISPLAY_NAME, T::CATEGORY, T::CODE_STATE, T::TAGS);
 }
 
+template <typename Traits, typename = void>
+struct traitsMemoizeOutputs : std::false_type {};
+
+template <typename Traits>
+struct traitsMemoizeOutputs<Traits, std::void_t<decltype(Traits::memoizeOutputs)>>
+    : std::bool_constant<Traits::memoizeOutputs> {};
+
 }  // namespace detail
 
 /**
@@ -74,9 +83,28 @@ ProcessorInfo processorInfo() {
  *\endcode
  * The default behaviour returns the static member processorInfo_;
  *
+ * The traits can also be used to opt in to output memoization, for processors where process
+ * only depends on the property state and the inport data:
+ *\code{.cpp}
+ *     template <>
+ *     struct ProcessorTraits<MyProcessor> {
+ *        static ProcessorInfo getProcessorInfo() { return MyProcessor::processorInfo_; }
+ *        static constexpr bool memoizeOutputs = true;
+ *     };
+ *\endcode
+ * @see Processor::setOutputMemoization
  */
 template <typename T>
 struct ProcessorTraits {
     static ProcessorInfo getProcessorInfo() { return detail::processorInfo<T>(); }
+    static constexpr bool memoizeOutputs = false;
 };
+
+/**
+ * Returns ProcessorTraits<T>::memoizeOutputs, or false if the traits do not define it.
+ */
+template <typename T>
+constexpr bool memoizeOutputs() {
+    return detail::traitsMemoizeOutputs<ProcessorTraits<T>>::value;
+}
 }  // namespace inviwo
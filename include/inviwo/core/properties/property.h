@@ -431,6 +431,9 @@ protected:
     PropertySerializationMode serializationMode_;
 
 private:
+    // Commits transactions by invoking the on change callbacks directly
+    friend class ProcessorNetwork;
+
     std::string identifier_;
     mutable std::string path_;  // To avoid having to create a string here all the time.
 
@@ -109,6 +109,8 @@ public:
     bool getLogToFile() const;
     bool getLogToConsole() const;
     bool getDisableResourceManager() const;
+    bool getLazyModuleRegistration() const;
+    bool getLogStartupTiming() const;
 
     int getARGC() const;
     char** getARGV() const;
@@ -135,6 +137,8 @@ private:
     TCLAP::SwitchArg helpQuiet_;
     TCLAP::SwitchArg versionQuiet_;
     TCLAP::SwitchArg disableResourceManager_;
+    TCLAP::SwitchArg lazyModules_;
+    TCLAP::SwitchArg startupTiming_;
 
     std::vector<std::tuple<int, TCLAP::Arg*, std::function<void()>>> callbacks_;
 };
@@ -0,0 +1,181 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/glmutils.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace inviwo {
+
+class DataFormatBase;
+class VolumeRAM;
+class LayerRAM;
+class BufferRAM;
+
+namespace util {
+
+/**
+ * \brief A linear map of values, `value * scale + offset`
+ */
+struct LinearMap {
+    double scale = 1.0;
+    double offset = 0.0;
+
+    /**
+     * \brief The map taking the range `from` to the range `to`
+     */
+    static LinearMap fromRanges(dvec2 from, dvec2 to) {
+        const auto scale = (to.y - to.x) / (from.y - from.x);
+        return {scale, to.x - from.x * scale};
+    }
+};
+
+namespace detail {
+
+/**
+ * Compute in float when that is exact enough, i.e. for sources of at most 16 bits, and
+ * destinations that are not 32 or 64 bit integers or doubles. Float gives twice the vector width.
+ */
+template <typename D, typename S>
+using ConversionComputeType =
+    std::conditional_t<(sizeof(S) <= 2 && (sizeof(D) <= 2 || std::is_same_v<D, float>)), float,
+                       double>;
+
+}  // namespace detail
+
+/**
+ * \brief Convert `count` values from `src` to `dst`.
+ * Src and Dst can be scalars or glm vectors, and must have the same number of components. Without
+ * a map the values are just cast. With a map, the values are mapped using a precomputed scale and
+ * offset, then rounded to the nearest value and clamped to the limits of integral destination
+ * types. The loop works on the flattened components and has no branches, so it is vectorized
+ * by the compiler.
+ */
+template <typename Dst, typename Src>
+void convertValues(const Src* src, Dst* dst, size_t count,
+                   std::optional<LinearMap> map = std::nullopt) {
+    static_assert(util::extent_v<Src> == util::extent_v<Dst>,
+                  "Src and Dst must have the same number of components");
+    using S = typename util::value_type<Src>::type;
+    using D = typename util::value_type<Dst>::type;
+
+    const auto* s = reinterpret_cast<const S*>(src);
+    auto* d = reinterpret_cast<D*>(dst);
+    const auto size = count * util::extent_v<Src>;
+
+    if (!map) {
+        for (size_t i = 0; i < size; ++i) d[i] = static_cast<D>(s[i]);
+        return;
+    }
+
+    using C = detail::ConversionComputeType<D, S>;
+    const auto scale = static_cast<C>(map->scale);
+    const auto offset = static_cast<C>(map->offset);
+
+    if constexpr (std::is_integral_v<D>) {
+        // The largest value of C that still fits in D, for 64 bit types max() rounds up when
+        // converted to double
+        const auto lo = static_cast<C>(std::numeric_limits<D>::lowest());
+        auto hi = static_cast<C>(std::numeric_limits<D>::max());
+        if (hi >= std::ldexp(C{1}, std::numeric_limits<D>::digits)) hi = std::nextafter(hi, C{0});
+
+        for (size_t i = 0; i < size; ++i) {
+            auto v = static_cast<C>(s[i]) * scale + offset + C{0.5};
+            // Written such that NaN ends up as lo
+            v = v > lo ? v : lo;
+            v = v < hi ? v : hi;
+            d[i] = static_cast<D>(std::floor(v));
+        }
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            d[i] = static_cast<D>(static_cast<C>(s[i]) * scale + offset);
+        }
+    }
+}
+
+/**
+ * \brief Same as convertValues but splits the values into chunks that are converted in parallel
+ * on the thread pool.
+ */
+template <typename Dst, typename Src>
+void convertValuesParallel(const Src* src, Dst* dst, size_t count,
+                           std::optional<LinearMap> map = std::nullopt) {
+    constexpr size_t chunkSize = size_t{1} << 16;
+    const auto chunks = (count + chunkSize - 1) / chunkSize;
+    util::forEachIndexParallel(chunks, [&](size_t chunk) {
+        const auto begin = chunk * chunkSize;
+        const auto end = std::min(count, begin + chunkSize);
+        convertValues(src + begin, dst + begin, end - begin, map);
+    });
+}
+
+/**
+ * \brief Create a copy of `src` with the values converted to `format`, in parallel.
+ * The format must have the same number of components as the format of src. Swizzle mask,
+ * interpolation and wrapping are copied.
+ * @see convertValues
+ * @throw Exception if the number of components differ
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> convertVolumeRAM(
+    const VolumeRAM& src, const DataFormatBase* format,
+    std::optional<LinearMap> map = std::nullopt);
+
+/**
+ * \copydoc convertVolumeRAM
+ * The layer type is copied as well.
+ */
+IVW_CORE_API std::shared_ptr<LayerRAM> convertLayerRAM(const LayerRAM& src,
+                                                       const DataFormatBase* format,
+                                                       std::optional<LinearMap> map = std::nullopt);
+
+/**
+ * \brief Create a copy of `src` with the values converted to `format`, in parallel.
+ * The format must have the same number of components as the format of src. Buffer usage and
+ * target are copied.
+ * @see convertValues
+ * @throw Exception if the number of components differ
+ */
+IVW_CORE_API std::shared_ptr<BufferRAM> convertBufferRAM(
+    const BufferRAM& src, const DataFormatBase* format,
+    std::optional<LinearMap> map = std::nullopt);
+
+}  // namespace util
+
+}  // namespace inviwo
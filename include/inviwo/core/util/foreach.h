@@ -33,6 +33,12 @@
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/threadutil.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 namespace inviwo {
@@ -140,6 +146,76 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     }
 }
 
+/**
+ * Call `callback(i)` for each index i in [0, size) using multiple threads. Indices are handed out
+ * one at a time from a shared counter, so it works well for items with uneven cost, like decoding
+ * slices or chunks of a file.
+ * The calling thread takes part in the work and only waits for indices that another thread has
+ * started to process. Jobs that have not started when all indices are taken just return. This
+ * makes it safe to call from within a job that is already running on the thread pool.
+ * If the callback throws, the remaining indices are skipped, and the first exception is rethrown
+ * once all started callbacks are done.
+ *
+ * @param size the number of indices
+ * @param callback to call for each index, `[](size_t i){}`
+ * @param jobs optional parameter specifying how many pool jobs to create, if jobs==0 (default) it
+ * will create one job per pool thread
+ */
+template <typename Callback>
+void forEachIndexParallel(size_t size, Callback&& callback, size_t jobs = 0) {
+    if (size == 0) return;
+
+    const auto poolSize = util::getPoolSize();
+    if (poolSize == 0 || size == 1) {
+        for (size_t i = 0; i < size; ++i) callback(i);
+        return;
+    }
+    if (jobs == 0) jobs = poolSize;
+    jobs = std::min(jobs, size - 1);
+
+    struct State {
+        explicit State(size_t aSize) : size{aSize} {}
+        const size_t size;
+        std::atomic<size_t> next{0};
+        std::atomic<bool> abort{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t done = 0;
+        std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>(size);
+
+    // The state is shared with the pool jobs, which might start after we have returned. In that
+    // case they will not find any index left, and will not touch the callback.
+    const auto work = [state, cb = &callback]() {
+        for (auto i = state->next.fetch_add(1); i < state->size; i = state->next.fetch_add(1)) {
+            std::exception_ptr exception;
+            if (!state->abort.load()) {
+                try {
+                    (*cb)(i);
+                } catch (...) {
+                    exception = std::current_exception();
+                    state->abort.store(true);
+                }
+            }
+            std::scoped_lock lock{state->mutex};
+            if (exception && !state->exception) state->exception = exception;
+            if (++state->done == state->size) state->cv.notify_all();
+        }
+    };
+
+    for (size_t job = 0; job < jobs; ++job) {
+        getThreadPool().enqueueRaw(work);
+    }
+    // Here we will claim all remaining indices, so we only have to wait for the ones that other
+    // threads are still working on.
+    work();
+
+    std::unique_lock lock{state->mutex};
+    state->cv.wait(lock, [&]() { return state->done == state->size; });
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -146,6 +146,12 @@ struct IVW_CORE_API NetworkDebugObserver : ProcessorNetworkObserver,
     virtual void onProcessorFinishedProcess(Processor* p) override {
         log(IVW_SOURCE_LOCATION, p->getIdentifier());
     };
+    virtual void onProcessorAboutToInitializeResources(Processor* p) override {
+        log(IVW_SOURCE_LOCATION, p->getIdentifier());
+    };
+    virtual void onProcessorFinishedInitializeResources(Processor* p) override {
+        log(IVW_SOURCE_LOCATION, p->getIdentifier());
+    };
     virtual void onProcessorSourceChanged(Processor* p) override {
         log(IVW_SOURCE_LOCATION, p->getIdentifier());
     };
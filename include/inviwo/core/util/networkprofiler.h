@@ -0,0 +1,185 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <inviwo/core/network/processornetworkevaluationobserver.h>
+#include <inviwo/core/network/processornetworkobserver.h>
+#include <inviwo/core/processors/processorobserver.h>
+#include <inviwo/core/util/clock.h>
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+class ProcessorNetwork;
+class ProcessorNetworkEvaluator;
+
+/**
+ * \brief Records per processor timings and memory usage of network evaluations
+ *
+ * The profiler observes the network, its evaluator, and all processors in it and measures the
+ * wall time of every Processor::initializeResources and Processor::process call. Background work
+ * of e.g. PoolProcessors is measured from the first job being started to the last one finishing.
+ * Measurements are accumulated into "runs" delimited by beginRun() and endRun(), a run can span
+ * several evaluations, which is the case when processors deliver results from background jobs.
+ *
+ * Heap allocations can only be counted by replacing the global operator new, which is up to the
+ * executable. If a MemorySource is given, the profiler will query it around each call to record
+ * the number of allocations, allocated bytes, and the peak heap usage. The counters are process
+ * wide, hence allocations made by concurrently running background jobs are included.
+ *
+ * The recorded runs can be written as JSON or as CSV, the CSV uses the column layout of Google
+ * Benchmark with a "<processor>/<run>" name such that tools/bm-plot.py can plot it.
+ */
+class IVW_CORE_API NetworkProfiler : public ProcessorNetworkObserver,
+                                     public ProcessorNetworkEvaluationObserver,
+                                     public ProcessorObserver {
+public:
+    struct MemoryCounters {
+        size_t allocations = 0;     ///< Number of allocations since start up
+        size_t allocatedBytes = 0;  ///< Number of bytes allocated since start up
+        size_t liveBytes = 0;       ///< Number of bytes currently allocated
+        size_t peakBytes = 0;       ///< Max of liveBytes since the last call to resetPeak
+    };
+    struct MemorySource {
+        std::function<MemoryCounters()> sample;
+        std::function<void()> resetPeak;
+        explicit operator bool() const { return sample && resetPeak; }
+    };
+
+    struct Measurement {
+        size_t calls = 0;
+        Clock::duration time{0};
+        size_t allocations = 0;
+        size_t allocatedBytes = 0;
+        size_t peakBytes = 0;  ///< Largest increase of the live heap during a single call
+    };
+
+    struct ProcessorRecord {
+        std::string identifier;
+        std::string classIdentifier;
+        Measurement initializeResources;
+        Measurement process;
+        Clock::duration background{0};
+    };
+
+    struct Run {
+        std::string label;
+        Clock::duration time{0};
+        size_t evaluations = 0;
+        size_t peakBytes = 0;  ///< Peak live heap during the run, 0 without a MemorySource
+        std::vector<ProcessorRecord> processors;  ///< In order of first evaluation
+    };
+
+    NetworkProfiler(ProcessorNetwork* network, ProcessorNetworkEvaluator* evaluator,
+                    MemorySource memory = {});
+    NetworkProfiler(const NetworkProfiler&) = delete;
+    NetworkProfiler& operator=(const NetworkProfiler&) = delete;
+    virtual ~NetworkProfiler();
+
+    /**
+     * Start a new run, any currently active run is ended first.
+     * @param label stored with the run, e.g. the value of a swept property
+     */
+    void beginRun(std::string_view label = {});
+    void endRun();
+    bool isRunning() const;
+
+    const std::vector<Run>& getRuns() const;
+    void clear();
+
+    /**
+     * Write all runs as a JSON object with a "context" object holding the given key value pairs
+     * and a "runs" array. Times are given in milliseconds.
+     */
+    void writeJSON(std::ostream& os,
+                   const std::vector<std::pair<std::string, std::string>>& context = {}) const;
+    /**
+     * Write one row per processor and run, and one "network/<run>" row per run with the totals.
+     * Times are given in milliseconds.
+     */
+    void writeCSV(std::ostream& os) const;
+    /**
+     * Write a human readable table with the mean and max times of each processor over all runs,
+     * sorted by the total time spent.
+     */
+    void writeSummary(std::ostream& os) const;
+
+    // ProcessorNetworkObserver
+    virtual void onProcessorNetworkDidAddProcessor(Processor* p) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* p) override;
+    virtual void onProcessorBackgroundJobsChanged(Processor* p, int diff, int total) override;
+
+    // ProcessorNetworkEvaluationObserver
+    virtual void onProcessorNetworkEvaluationBegin() override;
+
+    // ProcessorObserver
+    virtual void onProcessorAboutToInitializeResources(Processor* p) override;
+    virtual void onProcessorFinishedInitializeResources(Processor* p) override;
+    virtual void onProcessorAboutToProcess(Processor* p) override;
+    virtual void onProcessorFinishedProcess(Processor* p) override;
+
+private:
+    struct Active {
+        Processor* processor = nullptr;
+        Clock::time_point start;
+        MemoryCounters counters;
+        size_t peakBytes = 0;  // Peak live heap before a nested call reset the peak
+    };
+
+    ProcessorRecord& record(Processor* p);
+    void start(Processor* p);
+    void finish(Processor* p, Measurement ProcessorRecord::*measurement);
+    MemoryCounters sampleAndReset();
+
+    ProcessorNetwork* network_;
+    ProcessorNetworkEvaluator* evaluator_;
+    MemorySource memory_;
+
+    std::vector<Run> runs_;
+    bool running_ = false;
+    Clock::time_point runStart_;
+    std::unordered_map<Processor*, size_t> recordIndex_;
+    std::unordered_map<Processor*, int> backgroundJobs_;
+    std::unordered_map<Processor*, Clock::time_point> backgroundStart_;
+    std::vector<Active> active_;  // Calls in progress, nested ones last
+};
+
+}  // namespace inviwo
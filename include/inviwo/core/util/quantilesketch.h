@@ -0,0 +1,139 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+class BufferRAM;
+class LayerRAM;
+class VolumeRAM;
+
+namespace util {
+
+/**
+ * \brief A mergeable streaming sketch for approximate quantiles.
+ *
+ * Follows the KLL sketch (Karnin, Lang, and Liberty, "Optimal Quantile Approximation in
+ * Streams", 2016). Values are kept in a hierarchy of compactors, items on level h represent
+ * 2^h input values. When a level overflows it is sorted and every other item is promoted to the
+ * level above. The memory use is O(k log(n / k)) and the rank error is roughly 1.7 / k for the
+ * default compaction factor, independent of the order the values arrive in.
+ *
+ * Sketches of disjoint parts of the data can be merged, which makes them suitable for parallel
+ * computation. The smallest and largest value are tracked exactly. NaNs are ignored.
+ *
+ * Compactions alternate deterministically between keeping even and odd items, so the same input
+ * always gives the same sketch.
+ */
+class IVW_CORE_API QuantileSketch {
+public:
+    static constexpr size_t defaultK = 200;
+
+    explicit QuantileSketch(size_t k = defaultK);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    /**
+     * \brief Approximate value below a fraction q of all added values
+     * @param q in the range [0 1], 0 gives the minimum and 1 the maximum
+     * @throw RangeException if q is outside [0 1]
+     */
+    double quantile(double q) const;
+
+    /**
+     * \brief Same as calling quantile for each q, but only sorts the sketch once
+     */
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+
+    /**
+     * \brief Approximate fraction of the values less than or equal to value
+     */
+    double rank(double value) const;
+
+    size_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    size_t getK() const { return k_; }
+
+    /**
+     * \brief Number of values retained in the sketch
+     */
+    size_t size() const;
+
+private:
+    size_t capacity(size_t level) const;
+    void compress();
+    std::vector<std::pair<double, uint64_t>> weighted() const;
+
+    size_t k_;
+    size_t count_ = 0;
+    double min_ = std::numeric_limits<double>::max();
+    double max_ = std::numeric_limits<double>::lowest();
+    std::vector<std::vector<double>> levels_;
+    std::vector<bool> offsets_;
+};
+
+/**
+ * \brief Compute a QuantileSketch for each channel of the representation.
+ * The data is split into chunks that are sketched in parallel and merged afterwards.
+ */
+IVW_CORE_API std::vector<QuantileSketch> quantileSketches(const VolumeRAM& volume,
+                                                          size_t k = QuantileSketch::defaultK);
+IVW_CORE_API std::vector<QuantileSketch> quantileSketches(const LayerRAM& layer,
+                                                          size_t k = QuantileSketch::defaultK);
+IVW_CORE_API std::vector<QuantileSketch> quantileSketches(const BufferRAM& buffer,
+                                                          size_t k = QuantileSketch::defaultK);
+
+/**
+ * \brief A data range that ignores outliers, suitable for DataMapper::dataRange.
+ * The range goes from the \p outlierFraction quantile to the 1 - \p outlierFraction quantile,
+ * taking the union over all channels. Empty sketches are skipped.
+ * @param sketches one sketch per channel, see quantileSketches
+ * @param outlierFraction fraction of the values to ignore at each end, in [0 0.5)
+ * @throw RangeException if outlierFraction is outside [0 0.5)
+ * @throw Exception if all sketches are empty
+ */
+IVW_CORE_API dvec2 robustRange(const std::vector<QuantileSketch>& sketches,
+                               double outlierFraction = 0.01);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <inviwo/core/util/settings/settings.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/directoryproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
 
@@ -60,6 +61,10 @@ public:
     BoolProperty logStackTraceProperty_;
     BoolProperty runtimeModuleReloading_;
     BoolProperty enableResourceManager_;
+    IntSizeTProperty representationPoolBudget_;
+    IntSizeTProperty representationMemoryBudget_;
+    IntSizeTProperty decodedVolumeCacheBudget_;
+    DirectoryProperty decodedVolumeCacheDirectory_;
     OptionProperty<MessageBreakLevel> breakOnMessage_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
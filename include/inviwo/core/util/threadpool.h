@@ -60,8 +60,10 @@
 
 #include <warn/push>
 #include <warn/ignore/all>
+#include <array>
+#include <chrono>
+#include <deque>
 #include <vector>
-#include <queue>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -70,12 +72,63 @@
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <unordered_map>
 #include <warn/pop>
 
 namespace inviwo {
 
+/**
+ * \brief A pool of worker threads with prioritized task queues.
+ *
+ * Tasks are queued in three priority lanes, workers always take the first runnable task of the
+ * highest priority lane. Tasks can be tagged with an owner and a maximum number of concurrently
+ * running tasks for that owner, tasks of an owner that is at its limit are skipped until one of
+ * its running tasks finishes.
+ *
+ * Running tasks can not be interrupted, but a task can provide a preempt callback, typically
+ * setting a pool::Stop token. When an Interactive task is enqueued while all workers are busy,
+ * the preempt callback of one running Background task is called, to free up a worker.
+ *
+ * Tasks enqueued from a worker thread without an explicit priority inherit the priority of the
+ * task running on that thread, hence e.g. util::forEachIndexParallel in a background task will
+ * also run in the background.
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    enum class Priority {
+        Interactive,  //< Work that the user is waiting for, like producing the next frame
+        Normal,       //< The default, e.g. processor background jobs
+        Background    //< Work that is not time critical, like histograms and file scanning
+    };
+    static constexpr size_t nPriorities = 3;
+
+    struct TaskInfo {
+        Priority priority = Priority::Normal;
+        /// Tasks with the same owner share the maxConcurrent limit
+        const void* owner = nullptr;
+        /// Max number of running tasks for the owner, 0 means no limit
+        size_t maxConcurrent = 0;
+        /// Called, at most once, if the task is running and should stop to free up the worker
+        std::function<void()> preempt = nullptr;
+    };
+
+    /**
+     * Counters for monitoring a priority lane.
+     */
+    struct Stats {
+        size_t queued = 0;     //< Number of tasks currently waiting
+        size_t running = 0;    //< Number of tasks currently running
+        size_t completed = 0;  //< Total number of finished tasks
+        size_t preempted = 0;  //< Total number of preempt callbacks called
+        std::chrono::duration<double> totalWait{0.0};  //< Time spent in the queue, all tasks
+        std::chrono::duration<double> maxWait{0.0};    //< Longest time spent in the queue
+
+        std::chrono::duration<double> meanWait() const {
+            return completed + running > 0 ? totalWait / static_cast<double>(completed + running)
+                                           : std::chrono::duration<double>{0.0};
+        }
+    };
+
     ThreadPool(
         size_t threads, std::function<void()> onThreadStart = []() {},
         std::function<void()> onThreadStop = []() {});
@@ -83,21 +136,73 @@ public:
 
     /**
      * Enqueue function f with arguments args. The function f may throw exceptions.
+     * The priority is inherited from the calling task, Normal if not called from a task.
      * @return a future to the result of f
      */
     template <class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+    /**
+     * Enqueue function f with arguments args using the given priority. The function f may throw
+     * exceptions.
+     * @return a future to the result of f
+     */
+    template <class F, class... Args>
+    auto enqueue(Priority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * Enqueue function f with arguments args using the given priority, owner, and preempt
+     * callback. The function f may throw exceptions.
+     * @return a future to the result of f
+     */
+    template <class F, class... Args>
+    auto enqueue(TaskInfo info, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
     /**
      * Enqueue a plain functor. The functor may not throw exceptions.
+     * The priority is inherited from the calling task, Normal if not called from a task.
      */
     void enqueueRaw(std::function<void()> f);
 
+    /**
+     * Enqueue a plain functor with the given priority, owner, and preempt callback.
+     * The functor may not throw exceptions.
+     */
+    void enqueueRaw(std::function<void()> f, TaskInfo info);
+
     size_t trySetSize(size_t size);
     size_t getSize() const;
 
+    /**
+     * The total number of waiting tasks, in all lanes
+     */
     size_t getQueueSize();
 
+    Stats getStats(Priority priority);
+
+    /**
+     * The priority of the task running on the calling thread, Normal if not called from a task
+     */
+    static Priority currentPriority();
+
+    /**
+     * RAII helper to set the priority that tasks enqueued from the calling thread inherit.
+     * The ProcessorNetworkEvaluator uses this to make work dispatched while evaluating the network
+     * Interactive.
+     */
+    class IVW_CORE_API PriorityScope {
+    public:
+        explicit PriorityScope(Priority priority);
+        PriorityScope(const PriorityScope&) = delete;
+        PriorityScope& operator=(const PriorityScope&) = delete;
+        ~PriorityScope();
+
+    private:
+        Priority previous_;
+    };
+
 private:
     enum class State {
         Free,     //< Worker is waiting for tasks.
@@ -107,6 +212,14 @@ private:
         Done      //< Worker is waiting to be joined.
     };
 
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        std::function<void()> func;
+        TaskInfo info;
+        Clock::time_point enqueued;
+    };
+
     struct Worker {
         Worker(ThreadPool& pool);
         Worker(const Worker&) = delete;
@@ -116,13 +229,26 @@ private:
         ~Worker();
 
         std::atomic<State> state;  //< State of the worker
+        // The currently running task, guarded by queue_mutex
+        Priority priority = Priority::Normal;
+        std::function<void()> preempt = nullptr;
         std::thread thread;
     };
+
+    // Take the first runnable task, needs the queue_mutex
+    bool takeTask(Task& task);
+    void finishTask(Worker& worker, const Task& task);
+    void push(Task task);
+    bool empty() const;
+
     // need to keep track of threads so we can join them
     std::vector<std::unique_ptr<Worker>> workers;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
+    // the task queues, one for each priority
+    std::array<std::deque<Task>, nPriorities> tasks;
+    std::unordered_map<const void*, size_t> ownerRunning_;
+    std::array<Stats, nPriorities> stats_;
+    size_t busy_ = 0;
 
     // synchronization
     std::mutex queue_mutex;
@@ -136,6 +262,18 @@ private:
 // add new work item to the pool
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+    return enqueue(currentPriority(), std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+auto ThreadPool::enqueue(Priority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    return enqueue(TaskInfo{priority}, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+auto ThreadPool::enqueue(TaskInfo info, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
     using return_type = std::invoke_result_t<F, Args...>;
 
     auto task = std::make_shared<std::packaged_task<return_type()>>(
@@ -146,10 +284,8 @@ auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_resul
     if (workers.empty()) {
         (*task)();  // No worker threads, just run the task.
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
+        push(Task{[task]() { (*task)(); }, std::move(info), Clock::now()});
     }
-    condition.notify_one();
     return res;
 }
 
@@ -39,6 +39,8 @@
 namespace inviwo {
 
 class Volume;
+class VolumeRAM;
+struct DiskRegion;
 
 namespace util {
 
@@ -70,6 +72,25 @@ size3_t IVW_CORE_API getVolumeDimensions(const std::shared_ptr<const Volume>& vo
  */
 double IVW_CORE_API voxelVolume(const Volume& volume);
 
+/**
+ * \brief Check if a region of the volume can be read from disk without loading all of it.
+ * That is the case when the volume has no valid VolumeRAM, but a valid VolumeDisk with a loader
+ * that supports regions.
+ * @see readVolumeRegion
+ */
+bool IVW_CORE_API canReadVolumeRegion(const Volume& volume);
+
+/**
+ * \brief Create a VolumeRAM of \p region of the volume
+ * If possible only the region is read from disk, see canReadVolumeRegion, otherwise the region is
+ * copied from the VolumeRAM representation. The result has the dimensions
+ * region.getOutputDimensions(), is not added to the volume, and wraps with clamp along axes
+ * where the region does not cover the whole volume.
+ * @throw Exception if the region is empty or outside of the volume
+ */
+std::shared_ptr<VolumeRAM> IVW_CORE_API readVolumeRegion(const Volume& volume,
+                                                         const DiskRegion& region);
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -127,6 +127,7 @@ public:
     StringProperty renderBaseName;
     OptionProperty<FileExtension> writer;
     DoubleProperty renderFPS;
+    IntSizeTProperty renderMaxPendingFrames;
     ButtonProperty renderAction;
     ButtonProperty renderActionStop;
 
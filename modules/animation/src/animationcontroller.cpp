@@ -56,8 +56,10 @@
 #include <inviwo/core/properties/stringproperty.h>      // for StringProperty
 #include <inviwo/core/properties/valuewrapper.h>        // for PropertySerializationMode
 #include <inviwo/core/util/assertion.h>                 // for ivwAssert
+#include <inviwo/core/util/exception.h>                 // for Exception
 #include <inviwo/core/util/fileextension.h>             // for FileExtension, operator<<
 #include <inviwo/core/util/glmvec.h>                    // for ivec2, dvec2
+#include <inviwo/core/util/logcentral.h>                // for LogError, log
 #include <inviwo/core/util/staticstring.h>              // for operator+
 #include <inviwo/core/util/stdextensions.h>             // for transform
 #include <inviwo/core/util/stringconversion.h>          // for toString
@@ -74,6 +76,8 @@
 #include <algorithm>      // for max, copy_if, find_if, min
 #include <chrono>         // for milliseconds, duration
 #include <cstdlib>        // for abs, size_t
+#include <deque>          // for deque
+#include <future>         // for future, future_status
 #include <iomanip>        // for operator<<, setfill, setw
 #include <iterator>       // for back_insert_iterator
 #include <map>            // for map
@@ -81,6 +85,7 @@
 #include <ratio>          // for ratio
 #include <sstream>        // for operator<<, basic_ostream
 #include <string_view>    // for string_view, operator==
+#include <thread>         // for yield
 #include <unordered_map>  // for unordered_map
 #include <utility>        // for move
 #include <variant>
@@ -134,6 +139,13 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     , renderFPS("renderFPS", "Frames per Second", 24.0, {0.001, ConstraintBehavior::Immutable},
                 {1000.0, ConstraintBehavior::Immutable}, 1.0, InvalidationLevel::InvalidOutput,
                 PropertySemantics::Text)
+    , renderMaxPendingFrames(
+          "renderMaxPendingFrames", "Max Pending Frames",
+          "Number of frames that can be queued for encoding and writing on the thread pool while "
+          "the network evaluates the next frame. When the queue is full the rendering waits for "
+          "the oldest frame to be written."_help,
+          8, {1, ConstraintBehavior::Immutable}, {256, ConstraintBehavior::Ignore}, 1,
+          InvalidationLevel::Valid, PropertySemantics::Text)
     , renderAction("renderAction", "Render")
     , renderActionStop("renderActionStop", "Stop")
     , controlOptions("controlOptions", "Special Tracks")
@@ -175,7 +187,8 @@ AnimationController::AnimationController(Animation& animation, InviwoApplication
     renderActionStop.setReadOnly(state_ != AnimationState::Rendering);
 
     renderOptions.addProperties(renderWindowMode, renderWindow, renderFPS, renderLocation,
-                                renderBaseName, writer, renderAction, renderActionStop);
+                                renderBaseName, writer, renderMaxPendingFrames, renderAction,
+                                renderActionStop);
     renderOptions.setCollapsed(true);
 
     controlOptions.addProperties(insertControlTrack, insertInvalidationTrack);
@@ -357,7 +370,32 @@ void AnimationController::render() {
     renderAction.setReadOnly(true);
     renderActionStop.setReadOnly(false);
 
+    // Frames that have been read back but are still being encoded / written on the pool. The
+    // queue is bounded by renderMaxPendingFrames to keep the number of in flight LayerRAM copies
+    // limited, and it is flushed before we return.
+    std::deque<std::future<void>> pending;
+    const auto waitForFront = [&]() {
+        auto& front = pending.front();
+        while (front.wait_for(std::chrono::milliseconds{0}) != std::future_status::ready) {
+            app_->processFront();
+            app_->processEvents();
+            std::this_thread::yield();
+        }
+        try {
+            front.get();
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        } catch (const std::exception& e) {
+            LogError(e.what());
+        }
+        pending.pop_front();
+    };
+    const auto flush = [&]() {
+        while (!pending.empty()) waitForFront();
+    };
+
     util::OnScopeExit reset{[&]() {
+        flush();
         setState(AnimationState::Paused);
         renderAction.setReadOnly(false);
         renderActionStop.setReadOnly(true);
@@ -386,6 +424,12 @@ void AnimationController::render() {
                                                     Overwrite::Yes);
                            },
                            [&](CanvasProcessor* cp) {
+                               // Back-pressure, don't let the readback get too far ahead of the
+                               // writers.
+                               while (pending.size() >= renderMaxPendingFrames.get()) {
+                                   waitForFront();
+                               }
+
                                // Hackish: Make sure LayerRAM is the last valid rep, so that it
                                // is the one that will be cloned. This also forces the
                                // download to happen on the main thread instead of in the
@@ -393,10 +437,12 @@ void AnimationController::render() {
                                cp->getImage()->getColorLayer()->getRepresentation<LayerRAM>();
                                auto layer =
                                    std::shared_ptr<Layer>(cp->getImage()->getColorLayer()->clone());
-                               app_->dispatchPool([ext = writer.get(), layer = std::move(layer),
-                                                   location = renderLocation.get(), file]() {
-                                   util::saveData(*layer, location, file, {ext}, Overwrite::Yes);
-                               });
+                               pending.push_back(app_->dispatchPool(
+                                   [ext = writer.get(), layer = std::move(layer),
+                                    location = renderLocation.get(), file]() {
+                                       util::saveData(*layer, location, file, {ext},
+                                                      Overwrite::Yes);
+                                   }));
                            }},
                        exporterKinds);
         }
@@ -406,6 +452,9 @@ void AnimationController::render() {
         if (state_ != AnimationState::Rendering) break;
     }
 
+    // Include the time it takes to write the last frames in the timing below.
+    flush();
+
     using duration_double = std::chrono::duration<double, std::ratio<1>>;
     auto seconds = std::chrono::duration_cast<duration_double>(
                        std::chrono::high_resolution_clock::now() - start)
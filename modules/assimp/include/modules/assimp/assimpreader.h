@@ -36,6 +36,7 @@
 
 #include <any>          // for any
 #include <memory>       // for shared_ptr
+#include <string>       // for string
 #include <string_view>  // for string_view
 
 namespace inviwo {
@@ -62,18 +63,32 @@ public:
     void setFixInvalidDataFlag(bool enable);
     bool getFixInvalidDataFlag() const;
 
+    /**
+     * If enabled, imported meshes are stored in the Inviwo binary mesh format (ivm) in the
+     * DecodedVolumeCache of the application. Subsequent reads of the same unmodified file with the
+     * same settings load the cached mesh instead of running the import and post processing again.
+     * Enabled by default, the cache is only used if the DecodedVolumeCache is enabled, i.e. if its
+     * budget in the system settings is not zero. The cache directory and budget are shared with it.
+     */
+    void setImportCacheFlag(bool enable);
+    bool getImportCacheFlag() const;
+
     virtual std::shared_ptr<Mesh> readData(std::string_view filePath) override;
 
     virtual bool setOption(std::string_view key, std::any value) override;
     virtual std::any getOption(std::string_view key) override;
 
 private:
+    std::shared_ptr<Mesh> importMesh(std::string_view filePath);
+    std::string cacheKey() const;
+
     AssimpLogLevel
         logLevel_;  //!< determines the verbosity of the logging during data import (default = Warn)
     bool verboseLog_;
     bool fixInvalidData_;  //!< if true, the imported data will be checked for invalid data, e.g.
                            //!< invalid normals or UV coords, which might be fixed or removed by
                            //!< Assimp
+    bool importCache_;
 };
 
 }  // namespace inviwo
@@ -37,7 +37,11 @@
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
 #include <inviwo/core/io/datareader.h>                                  // for DataReaderType
 #include <inviwo/core/io/datareaderexception.h>                         // for DataReaderException
+#include <inviwo/core/io/decodedvolumecache.h>                          // for DecodedVolumeCache
+#include <inviwo/core/io/ivmmeshreader.h>                               // for readIvmMesh
+#include <inviwo/core/io/ivmmeshwriter.h>                               // for writeIvmMesh
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
+#include <inviwo/core/util/filesystem.h>                                // for ifstream
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, vec4
 #include <inviwo/core/util/logcentral.h>                                // for LogVerbosity, Log...
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT
@@ -58,6 +62,7 @@
 #include <assimp/scene.h>            // for aiScene
 #include <assimp/types.h>            // for AI_SUCCESS, aiString
 #include <assimp/vector3.h>          // for aiVector3D
+#include <fmt/format.h>              // for format
 #include <glm/vec4.hpp>              // for operator*, operator+
 
 #include <warn/pop>
@@ -67,6 +72,7 @@
 #include <cstdint>        // for uint32_t
 #include <cstring>        // for strlen
 #include <ctime>          // for size_t, clock
+#include <ostream>        // for ostream
 #include <string>         // for basic_string<>::v...
 #include <type_traits>    // for remove_extent_t
 #include <unordered_map>  // for unordered_map
@@ -103,11 +109,38 @@ public:
     }
 };
 
+namespace {
+
+unsigned int importFlags(bool fixInvalidData) {
+    //#define AI_CONFIG_PP_SBP_REMOVE "aiPrimitiveType_POINTS | aiPrimitiveType_LINES"
+    //#define AI_CONFIG_PP_FD_REMOVE 1
+
+    unsigned int flags = aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+                         aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
+                         aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality |
+                         aiProcess_RemoveRedundantMaterials | aiProcess_OptimizeMeshes;
+    //      aiProcess_GenUVCoords | aiProcess_CalcTangentSpace | aiProcess_TransformUVCoords |
+    //      aiProcess_FindInstances
+    //      aiProcess_OptimizeGraph | aiProcess_SortByPType | aiProcess_FindDegenerates |
+    // aiProcess_OptimizeGraph is incompatible to aiProcess_PreTransformVertices
+
+    if (fixInvalidData) {
+        flags |= aiProcess_FindInvalidData;
+    }
+    return flags;
+}
+
+// Bump when the conversion from the assimp scene changes to invalidate cached meshes
+constexpr int importVersion = 1;
+
+}  // namespace
+
 AssimpReader::AssimpReader()
     : DataReaderType<Mesh>()
     , logLevel_(AssimpLogLevel::Warn)
     , verboseLog_(false)
-    , fixInvalidData_(false) {
+    , fixInvalidData_(false)
+    , importCache_(true) {
     aiString str{};
     Assimp::Importer importer{};
 
@@ -138,7 +171,38 @@ void AssimpReader::setFixInvalidDataFlag(bool enable) { fixInvalidData_ = enable
 
 bool AssimpReader::getFixInvalidDataFlag() const { return fixInvalidData_; }
 
+void AssimpReader::setImportCacheFlag(bool enable) { importCache_ = enable; }
+
+bool AssimpReader::getImportCacheFlag() const { return importCache_; }
+
+std::string AssimpReader::cacheKey() const {
+    // The cache checks the path, size and modification time of the file itself
+    return fmt::format("assimp mesh, flags {}, version {}", importFlags(fixInvalidData_),
+                       importVersion);
+}
+
 std::shared_ptr<Mesh> AssimpReader::readData(std::string_view filePath) {
+    checkExists(filePath);
+
+    auto* cache = importCache_ ? util::getDecodedVolumeCache() : nullptr;
+    if (!cache || !cache->isEnabled()) return importMesh(filePath);
+
+    const auto key = cacheKey();
+    if (const auto [cached, pin] = cache->loadFile(filePath, key); !cached.empty()) {
+        try {
+            auto in = filesystem::ifstream(cached, std::ios::in | std::ios::binary);
+            return util::readIvmMesh(in, key);
+        } catch (const Exception& e) {
+            LogWarn("Ignoring invalid cached import of '" << filePath << "': " << e.getMessage());
+        }
+    }
+
+    auto mesh = importMesh(filePath);
+    cache->storeFile(filePath, key, [&](std::ostream& os) { util::writeIvmMesh(*mesh, os, key); });
+    return mesh;
+}
+
+std::shared_ptr<Mesh> AssimpReader::importMesh(std::string_view filePath) {
     Assimp::Importer importer;
 
     std::clock_t start_readmetadata = std::clock();
@@ -170,23 +234,7 @@ std::shared_ptr<Mesh> AssimpReader::readData(std::string_view filePath) {
         }
     }
 
-    //#define AI_CONFIG_PP_SBP_REMOVE "aiPrimitiveType_POINTS | aiPrimitiveType_LINES"
-    //#define AI_CONFIG_PP_FD_REMOVE 1
-
-    unsigned int flags = aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
-                         aiProcess_GenSmoothNormals | aiProcess_PreTransformVertices |
-                         aiProcess_ValidateDataStructure | aiProcess_ImproveCacheLocality |
-                         aiProcess_RemoveRedundantMaterials | aiProcess_OptimizeMeshes;
-    //      aiProcess_GenUVCoords | aiProcess_CalcTangentSpace | aiProcess_TransformUVCoords |
-    //      aiProcess_FindInstances
-    //      aiProcess_OptimizeGraph | aiProcess_SortByPType | aiProcess_FindDegenerates |
-    // aiProcess_OptimizeGraph is incompatible to aiProcess_PreTransformVertices
-
-    if (fixInvalidData_) {
-        flags |= aiProcess_FindInvalidData;
-    }
-
-    const aiScene* scene = importer.ReadFile(std::string(filePath), flags);
+    const aiScene* scene = importer.ReadFile(std::string(filePath), importFlags(fixInvalidData_));
 
     std::clock_t start_convert = std::clock();
     if (logging) {
@@ -422,6 +470,9 @@ bool AssimpReader::setOption(std::string_view key, std::any value) {
     if (auto* fix = std::any_cast<bool>(&value); fix && key == "FixInvalidData") {
         setFixInvalidDataFlag(*fix);
         return true;
+    } else if (auto* cache = std::any_cast<bool>(&value); cache && key == "ImportCache") {
+        setImportCacheFlag(*cache);
+        return true;
     } else if (auto* level = std::any_cast<LogVerbosity>(&value); level && key == "LogLevel") {
         switch (*level) {
             case LogVerbosity::Error:
@@ -446,6 +497,8 @@ bool AssimpReader::setOption(std::string_view key, std::any value) {
 std::any AssimpReader::getOption(std::string_view key) {
     if (key == "FixInvalidData") {
         return getFixInvalidDataFlag();
+    } else if (key == "ImportCache") {
+        return getImportCacheFlag();
     } else if (key == "LogLevel") {
         switch (getLogLevel()) {
             case AssimpLogLevel::Error:
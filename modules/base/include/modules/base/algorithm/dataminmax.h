@@ -31,21 +31,12 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
-#include <inviwo/core/util/formats.h>                 // for DataFormat
-#include <inviwo/core/util/glm.h>                     // for isfinite
-#include <inviwo/core/util/glmcomp.h>                 // for glmcomp
-#include <inviwo/core/util/glmconvert.h>              // for glm_convert
-#include <inviwo/core/util/glmutils.h>                // for is_floating_point, flat_extent
 #include <inviwo/core/util/glmvec.h>                  // for dvec4
 #include <modules/base/algorithm/algorithmoptions.h>  // for IgnoreSpecialValues, IgnoreSpecialV...
+#include <modules/base/algorithm/datareduction.h>     // for dataReduction, Reduction
 
-#include <algorithm>    // for max, min
-#include <cstddef>      // for size_t
-#include <numeric>      // for accumulate
-#include <type_traits>  // for enable_if
-#include <utility>      // for pair
-
-#include <glm/common.hpp>  // for max, min
+#include <cstddef>  // for size_t
+#include <utility>  // for pair
 
 namespace inviwo {
 
@@ -76,58 +67,9 @@ IVW_MODULE_BASE_API std::pair<dvec4, dvec4> layerMinMax(
 IVW_MODULE_BASE_API std::pair<dvec4, dvec4> bufferMinMax(
     const BufferBase* buffer, IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
 
-namespace detail {
-
-// Specialization for double, float, half
-template <typename ValueType,
-          typename std::enable_if<util::is_floating_point<ValueType>::value, int>::type = 0>
-std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-
-    if (ignore == IgnoreSpecialValues::Yes) {
-        minmax = std::accumulate(
-            data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-                Res res(mm);
-                for (size_t i = 0; i < util::flat_extent<ValueType>::value; ++i) {
-                    if (util::isfinite(util::glmcomp(v, i))) {
-                        util::glmcomp(res.first, i) =
-                            std::min(util::glmcomp(mm.first, i), util::glmcomp(v, i));
-                        util::glmcomp(res.second, i) =
-                            std::max(util::glmcomp(mm.second, i), util::glmcomp(v, i));
-                    }
-                }
-                return res;
-            });
-    } else {
-        minmax = std::accumulate(data, data + size, minmax,
-                                 [](const Res& mm, const ValueType& v) -> Res {
-                                     return {glm::min(mm.first, v), glm::max(mm.second, v)};
-                                 });
-    }
-
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
-}
-// Specialization for integer types. They do not have special values
-template <typename ValueType,
-          typename std::enable_if<!util::is_floating_point<ValueType>::value, int>::type = 0>
-std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
-                                   IgnoreSpecialValues = IgnoreSpecialValues::No) {
-    using Res = std::pair<ValueType, ValueType>;
-    Res minmax{DataFormat<ValueType>::max(), DataFormat<ValueType>::lowest()};
-    minmax =
-        std::accumulate(data, data + size, minmax, [](const Res& mm, const ValueType& v) -> Res {
-            return {glm::min(mm.first, v), glm::max(mm.second, v)};
-        });
-
-    return {util::glm_convert<dvec4>(minmax.first), util::glm_convert<dvec4>(minmax.second)};
-}
-
-}  // namespace detail
-
 /**
  * Compute component-wise minimum and maximum values scalar and glm::vec types.
+ * The data is reduced in parallel using dataReduction.
  *
  * @param data pointer to values
  * @param size of data
@@ -137,7 +79,7 @@ std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
 template <typename ValueType>
 std::pair<dvec4, dvec4> dataMinMax(const ValueType* data, size_t size,
                                    IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
-    return detail::dataMinMax<ValueType>(data, size, ignore);
+    return dataReduction(data, size, Reduction::MinMax, ignore).minMax();
 }
 
 }  // namespace util
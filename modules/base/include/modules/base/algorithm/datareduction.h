@@ -0,0 +1,270 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/util/foreach.h>                 // for forEachIndexParallel
+#include <inviwo/core/util/formats.h>                 // for DataFormat
+#include <inviwo/core/util/glmutils.h>                // for value_type_t, flat_extent_v
+#include <inviwo/core/util/glmvec.h>                  // for dvec4, size4_t
+#include <modules/base/algorithm/algorithmoptions.h>  // for IgnoreSpecialValues
+
+#include <algorithm>    // for min, max
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <type_traits>  // for conditional_t, is_same_v, bool_constant
+#include <utility>      // for pair
+#include <vector>       // for vector
+
+#include <flags/flags.h>  // for flags
+
+namespace inviwo {
+
+class BufferBase;
+class BufferRAM;
+class Layer;
+class LayerRAM;
+class Volume;
+class VolumeRAM;
+
+/**
+ * The reductions computed by util::dataReduction
+ */
+enum class Reduction {
+    MinMax = 1 << 0,        //!< component-wise minimum and maximum
+    Sum = 1 << 1,           //!< component-wise sum
+    SumOfSquares = 1 << 2,  //!< component-wise sum of squares
+    SpecialValues = 1 << 3  //!< number of NaN and infinite values per component
+};
+
+ALLOW_FLAGS_FOR_ENUM(Reduction)
+using Reductions = flags::flags<Reduction>;
+
+/**
+ * \brief Result of util::dataReduction, all values are per component.
+ *
+ * Components not present in the data format are zero. Only the requested reductions are filled
+ * in, the others are zero.
+ */
+struct IVW_MODULE_BASE_API DataReduction {
+    dvec4 min{0.0};
+    dvec4 max{0.0};
+    dvec4 sum{0.0};
+    dvec4 sumOfSquares{0.0};
+    size4_t count{0};     //!< number of values included, excludes NaN and Inf if they are ignored
+    size4_t nanCount{0};  //!< only computed for Reduction::SpecialValues
+    size4_t infCount{0};  //!< only computed for Reduction::SpecialValues
+    size_t components = 0;
+    Reductions reductions{};
+
+    std::pair<dvec4, dvec4> minMax() const { return {min, max}; }
+    dvec4 mean() const;
+    /**
+     * Population variance, requires Reduction::Sum and Reduction::SumOfSquares
+     */
+    dvec4 variance() const;
+};
+
+namespace util {
+
+namespace detail {
+
+template <typename ValueType, bool MinMax, bool Sums, bool Check, bool Ignore>
+DataReduction reduceRange(const ValueType* data, size_t begin, size_t end) {
+    using V = util::value_type_t<ValueType>;
+    // Do the comparisons for half in float, it is much faster
+    using C = std::conditional_t<std::is_same_v<V, half_float::half>, float, V>;
+    constexpr size_t N = util::flat_extent_v<ValueType>;
+
+    std::array<C, N> lo;
+    std::array<C, N> hi;
+    lo.fill(static_cast<C>(DataFormat<V>::max()));
+    hi.fill(static_cast<C>(DataFormat<V>::lowest()));
+    std::array<double, N> sum{};
+    std::array<double, N> sumOfSquares{};
+    std::array<size_t, N> count{};
+    std::array<size_t, N> nan{};
+    std::array<size_t, N> inf{};
+
+    // The glm types are tightly packed, hence we can iterate over the components directly. Keeping
+    // the inner loop branch free lets the compiler vectorize it.
+    const V* flat = reinterpret_cast<const V*>(data);
+    for (size_t i = begin * N; i < end * N; i += N) {
+        for (size_t c = 0; c < N; ++c) {
+            const C v = static_cast<C>(flat[i + c]);
+            if constexpr (Check) {
+                const bool finite = (v - v) == C{0};  // false for NaN and Inf
+                const bool isNaN = !(v == v);
+                nan[c] += isNaN;
+                inf[c] += !finite && !isNaN;
+                if constexpr (Ignore) {
+                    count[c] += finite;
+                    if constexpr (MinMax) {
+                        lo[c] = finite && v < lo[c] ? v : lo[c];
+                        hi[c] = finite && hi[c] < v ? v : hi[c];
+                    }
+                    if constexpr (Sums) {
+                        const double d = finite ? static_cast<double>(v) : 0.0;
+                        sum[c] += d;
+                        sumOfSquares[c] += d * d;
+                    }
+                    continue;
+                }
+            }
+            if constexpr (MinMax) {
+                lo[c] = std::min(lo[c], v);
+                hi[c] = std::max(hi[c], v);
+            }
+            if constexpr (Sums) {
+                const double d = static_cast<double>(v);
+                sum[c] += d;
+                sumOfSquares[c] += d * d;
+            }
+        }
+    }
+
+    DataReduction res;
+    res.components = N;
+    for (size_t c = 0; c < N; ++c) {
+        res.min[c] = static_cast<double>(lo[c]);
+        res.max[c] = static_cast<double>(hi[c]);
+        res.sum[c] = sum[c];
+        res.sumOfSquares[c] = sumOfSquares[c];
+        res.count[c] = Ignore ? count[c] : end - begin;
+        res.nanCount[c] = nan[c];
+        res.infCount[c] = inf[c];
+    }
+    return res;
+}
+
+template <typename ValueType>
+DataReduction reduceRange(const ValueType* data, size_t begin, size_t end, Reductions reductions,
+                          IgnoreSpecialValues ignore) {
+    constexpr bool isFloat = util::is_floating_point_v<util::value_type_t<ValueType>>;
+    const bool minMax = !(reductions & Reduction::MinMax).empty();
+    const bool sums = !(reductions & (Reduction::Sum | Reduction::SumOfSquares)).empty();
+    const bool ignoreSpecial = isFloat && ignore == IgnoreSpecialValues::Yes;
+    const bool check =
+        isFloat && (ignoreSpecial || !(reductions & Reduction::SpecialValues).empty());
+
+    const auto dispatch = [&](auto useMinMax, auto useSums, auto useCheck, auto useIgnore) {
+        if constexpr (!isFloat && (decltype(useCheck)::value || decltype(useIgnore)::value)) {
+            return DataReduction{};  // never used, no special values in integer types
+        } else {
+            return reduceRange<ValueType, decltype(useMinMax)::value, decltype(useSums)::value,
+                               decltype(useCheck)::value, decltype(useIgnore)::value>(data, begin,
+                                                                                      end);
+        }
+    };
+    const auto withCheck = [&](auto useMinMax, auto useSums) {
+        if (ignoreSpecial) return dispatch(useMinMax, useSums, std::true_type{}, std::true_type{});
+        if (check) return dispatch(useMinMax, useSums, std::true_type{}, std::false_type{});
+        return dispatch(useMinMax, useSums, std::false_type{}, std::false_type{});
+    };
+    const auto withSums = [&](auto useMinMax) {
+        return sums ? withCheck(useMinMax, std::true_type{})
+                    : withCheck(useMinMax, std::false_type{});
+    };
+    return minMax ? withSums(std::true_type{}) : withSums(std::false_type{});
+}
+
+IVW_MODULE_BASE_API void combine(DataReduction& result, const DataReduction& partial);
+
+}  // namespace detail
+
+/**
+ * Compute the requested \p reductions of \p data in a single pass. The data is split into chunks
+ * that are reduced in parallel on the thread pool and then combined. The chunking does not depend
+ * on the number of threads, hence the result is deterministic.
+ *
+ * @param data pointer to values, scalars or glm vectors
+ * @param size number of values
+ * @param reductions the reductions to compute
+ * @param ignore if IgnoreSpecialValues::Yes, NaN and Inf are excluded from min/max and sums
+ */
+template <typename ValueType>
+DataReduction dataReduction(const ValueType* data, size_t size,
+                            Reductions reductions = Reductions{flags::any},
+                            IgnoreSpecialValues ignore = IgnoreSpecialValues::No) {
+    constexpr size_t chunkSize = size_t{1} << 18;
+    const size_t chunks = std::max(size_t{1}, (size + chunkSize - 1) / chunkSize);
+
+    std::vector<DataReduction> partials(chunks);
+    util::forEachIndexParallel(chunks, [&](size_t chunk) {
+        const auto begin = chunk * chunkSize;
+        const auto end = std::min(size, begin + chunkSize);
+        partials[chunk] = detail::reduceRange(data, begin, end, reductions, ignore);
+    });
+
+    auto result = partials.front();
+    for (size_t i = 1; i < chunks; ++i) {
+        detail::combine(result, partials[i]);
+    }
+    if ((reductions & Reduction::MinMax).empty()) {
+        result.min = dvec4{0.0};
+        result.max = dvec4{0.0};
+    }
+    result.reductions = reductions;
+    return result;
+}
+
+/**
+ * Compute the requested reductions of the data in the RAM representation.
+ * @see dataReduction
+ */
+IVW_MODULE_BASE_API DataReduction volumeReduction(
+    const VolumeRAM* volume, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+IVW_MODULE_BASE_API DataReduction layerReduction(
+    const LayerRAM* layer, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+IVW_MODULE_BASE_API DataReduction bufferReduction(
+    const BufferRAM* buffer, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+
+/**
+ * Compute the requested reductions of \p volume. The result is cached on the volume until it is
+ * edited, separately for each set of reductions, hence repeated calls are cheap.
+ * @see Data::getDerived
+ */
+IVW_MODULE_BASE_API DataReduction volumeReduction(
+    const Volume* volume, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+IVW_MODULE_BASE_API DataReduction layerReduction(
+    const Layer* layer, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+IVW_MODULE_BASE_API DataReduction bufferReduction(
+    const BufferBase* buffer, Reductions reductions = Reductions{flags::any},
+    IgnoreSpecialValues ignore = IgnoreSpecialValues::No);
+
+}  // namespace util
+
+}  // namespace inviwo
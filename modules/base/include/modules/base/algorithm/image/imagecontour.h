@@ -35,15 +35,53 @@
 
 #include <cstddef>  // for size_t
 #include <memory>   // for shared_ptr
+#include <vector>   // for vector
 
 namespace inviwo {
+class IsoValueCollection;
 class LayerRepresentation;
 class Mesh;
 
 class IVW_MODULE_BASE_API ImageContour {
 public:
+    /**
+     * Extracts the contour of a single isovalue, see the overload for multiple isovalues. The mesh
+     * has a single index buffer.
+     */
     static std::shared_ptr<Mesh> apply(const LayerRepresentation* in, size_t channel,
                                        double isoValue, vec4 color = vec4(1.0));
+
+    /**
+     * Extracts the contours of all isovalues in a single pass over the layer using marching
+     * squares, in parallel over bands of rows. Each cell only visits the isovalues within the
+     * range of its corner values.
+     *
+     * The line segments are stitched into polylines that share their vertices. The mesh has one
+     * index buffer per isovalue, in the order of isoValues, holding the segments of all its
+     * polylines as pairs of vertices (DrawType::Lines, ConnectivityType::None). The buffer of an
+     * isovalue without contours is empty. The mesh has a position buffer in [0,1]^2, a color
+     * buffer, a ScalarMetaAttrib buffer holding the isovalue of each vertex, and an IndexAttrib
+     * buffer holding the id of the polyline of each vertex. The ids are consecutive.
+     *
+     * For non floating point data formats the isovalues are relative to the range of the format.
+     * @param in the layer to contour
+     * @param channel the channel of the layer to use
+     * @param isoValues the isovalues to extract
+     * @param colors the color of each isovalue, white is used if there are fewer colors than
+     *        isovalues
+     * @return the contour mesh, or nullptr if the layer is empty
+     */
+    static std::shared_ptr<Mesh> apply(const LayerRepresentation* in, size_t channel,
+                                       const std::vector<double>& isoValues,
+                                       const std::vector<vec4>& colors = {});
+
+    /**
+     * Extracts the contours of all isovalues of the collection, using their colors. The values of
+     * a relative collection are handled like the isovalues of the overload above, those of an
+     * absolute collection are used as data values directly.
+     */
+    static std::shared_ptr<Mesh> apply(const LayerRepresentation* in, size_t channel,
+                                       const IsoValueCollection& isoValues);
 };
 
 }  // namespace inviwo
@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <cstddef>  // for size_t
+#include <limits>   // for numeric_limits
+#include <memory>   // for shared_ptr
+#include <vector>   // for vector
+
+namespace inviwo {
+
+class Mesh;
+
+namespace meshutil {
+
+enum class BoundaryHandling {
+    Weighted,  //!< Boundary edges add a plane perpendicular to the surface to the error metric
+    Locked     //!< Vertices on a boundary are never moved or removed
+};
+
+struct IVW_MODULE_BASE_API DecimationSettings {
+    /**
+     * The number of triangles to keep. The decimation stops before if no edge can be collapsed
+     * within maxError.
+     */
+    size_t targetTriangles = 0;
+    /**
+     * Largest allowed quadric error of a collapse, in squared model space units
+     */
+    double maxError = std::numeric_limits<double>::infinity();
+    BoundaryHandling boundary = BoundaryHandling::Weighted;
+    /**
+     * Weight of the boundary planes relative to the surface planes, only used with
+     * BoundaryHandling::Weighted
+     */
+    double boundaryWeight = 100.0;
+    /**
+     * Number of spatial partitions to decimate in parallel. 0 will use one partition per thread
+     * in the pool.
+     */
+    size_t partitions = 0;
+};
+
+/**
+ * Simplifies the triangles of a mesh by collapsing edges in the order given by their quadric
+ * error (Garland and Heckbert, Surface Simplification Using Quadric Error Metrics, 1997).
+ *
+ * All triangle index buffers are decimated together, regardless of their connectivity type, and
+ * are returned as plain triangle lists. The attribute buffers are interpolated along the collapsed
+ * edges: floating point attributes linearly, integer attributes by taking the nearest end point.
+ * Normals are renormalized. Vertices referenced by non-triangle index buffers are kept as they
+ * are. A mesh without index buffers is treated as a triangle list if its default draw type is
+ * triangles. A mesh without any triangles is returned as an unchanged copy.
+ *
+ * The mesh is first split into spatial partitions along its longest axis that are decimated in
+ * parallel while the vertices shared between partitions are kept fixed. If the target is not
+ * reached after that, a final pass over the whole remaining mesh removes the seams.
+ *
+ * @throws Exception if the mesh has triangles but no position buffer
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> decimate(const Mesh& mesh,
+                                                   const DecimationSettings& settings);
+
+/**
+ * Generates a chain of discrete levels of detail, where each level keeps `ratio` of the triangles
+ * of the level before it. The first element is the first decimated level, the input mesh is not
+ * included. Each level is decimated from the previous one, and the chain ends early if a level
+ * does not reduce the triangle count any further.
+ * @param mesh the full resolution mesh
+ * @param levels the maximum number of levels to generate
+ * @param ratio the fraction of triangles to keep between two levels, in (0, 1)
+ * @param settings the targetTriangles member is ignored
+ */
+IVW_MODULE_BASE_API std::vector<std::shared_ptr<Mesh>> generateLods(
+    const Mesh& mesh, size_t levels, double ratio, DecimationSettings settings = {});
+
+/**
+ * Counts the triangles in all index buffers with DrawType::Triangles, or in the vertex buffers
+ * of a mesh without index buffers whose default draw type is triangles.
+ */
+IVW_MODULE_BASE_API size_t countTriangles(const Mesh& mesh);
+
+}  // namespace meshutil
+
+}  // namespace inviwo
@@ -180,14 +180,14 @@ void forEachTriangle(const Mesh::MeshInfo& info, const IndexBuffer& ib, Callback
     }
 
     if (info.ct == ConnectivityType::None) {
-        for (size_t i = 0; i < ram.size(); i += 3) {
+        for (size_t i = 0; i + 2 < ram.size(); i += 3) {
             std::invoke(callback, ram[i], ram[i + 1], ram[i + 2]);
         }
     }
 
     else if (info.ct == ConnectivityType::Strip) {
-        for (size_t i = 0; i < ram.size() - 2; ++i) {
-            if (1 % 2 == 0) {
+        for (size_t i = 0; i + 2 < ram.size(); ++i) {
+            if (i % 2 == 0) {
                 std::invoke(callback, ram[i], ram[i + 1], ram[i + 2]);
             } else {
                 std::invoke(callback, ram[i + 1], ram[i], ram[i + 2]);
@@ -197,23 +197,21 @@ void forEachTriangle(const Mesh::MeshInfo& info, const IndexBuffer& ib, Callback
 
     else if (info.ct == ConnectivityType::Fan) {
         uint32_t a = static_cast<uint32_t>(ram.front());
-        for (size_t i = 1; i < ram.size(); ++i) {
+        for (size_t i = 1; i + 1 < ram.size(); ++i) {
             std::invoke(callback, a, ram[i], ram[i + 1]);
         }
     }
 
     else if (info.ct == ConnectivityType::Adjacency) {
-        if (ram.size() < 6) return;
-        for (size_t i = 0; i < ram.size(); i += 6) {
+        for (size_t i = 0; i + 5 < ram.size(); i += 6) {
             std::invoke(callback, ram[i], ram[i + 2], ram[i + 4]);
         }
 
     }
 
     else if (info.ct == ConnectivityType::StripAdjacency) {
-        if (ram.size() < 6) return;
-        for (size_t i = 0; i < ram.size(); i += 2) {
-            if (1 % 2 == 0) {
+        for (size_t i = 0; i + 4 < ram.size(); i += 2) {
+            if ((i / 2) % 2 == 0) {
                 std::invoke(callback, ram[i], ram[i + 2], ram[i + 4]);
             } else {
                 std::invoke(callback, ram[i + 2], ram[i], ram[i + 4]);
@@ -39,6 +39,10 @@ class Volume;
 
 namespace util {
 
+/**
+ * Compute the world space gradient of \p channel of the volume using central differences.
+ * @throw Exception if \p channel is not a channel of the volume
+ */
 IVW_MODULE_BASE_API std::shared_ptr<Volume> gradientVolume(std::shared_ptr<const Volume> volume,
                                                            int channel);
 
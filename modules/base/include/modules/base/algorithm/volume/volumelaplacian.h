@@ -29,7 +29,8 @@
 
 #pragma once
 
-#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+#include <modules/base/basemoduledefine.h>                 // for IVW_MODULE_BASE_API
+#include <modules/base/algorithm/volume/volumestencil.h>  // for forEachCentralDifference
 
 #include <inviwo/core/datastructures/coordinatetransformer.h>           // for CoordinateSpace
 #include <inviwo/core/datastructures/datamapper.h>                      // for DataMapper
@@ -38,12 +39,9 @@
 #include <inviwo/core/datastructures/unitsystem.h>                      // for Axis, Unit
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
 #include <inviwo/core/util/formats.h>                                   // for DataFormat
-#include <inviwo/core/util/glmcomp.h>                                   // for glmcomp
-#include <inviwo/core/util/glmmat.h>                                    // for dmat4
 #include <inviwo/core/util/glmutils.h>                                  // for same_extent
 #include <inviwo/core/util/glmvec.h>                                    // for dvec3, dvec2, siz...
 #include <inviwo/core/util/indexmapper.h>                               // for IndexMapper3D
-#include <inviwo/core/util/templatesampler.h>                           // for TemplateVolumeSam...
 #include <inviwo/core/util/volumeramutils.h>                            // for forEachVoxelParallel
 
 #include <algorithm>      // for max
@@ -54,12 +52,7 @@
 #include <type_traits>    // for remove_extent_t
 #include <unordered_set>  // for unordered_set
 
-#include <glm/gtx/matrix_operation.hpp>  // for diagonal3x3
-#include <glm/mat3x3.hpp>                // for mat
-#include <glm/mat4x4.hpp>                // for operator*, mat
-#include <glm/vec3.hpp>                  // for operator-, operator+
-#include <glm/vec4.hpp>                  // for operator*, operator+
-#include <units/units_decl.hpp>          // for precise_unit
+#include <units/units_decl.hpp>  // for precise_unit
 
 namespace inviwo {
 class Volume;
@@ -88,7 +81,7 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
     using T = typename DF::type;
     constexpr size_t comp = DF::comp;
     using R = typename util::same_extent<T, float>::type;
-    using Sampler = TemplateVolumeSampler<T, double, double>;
+    using V = typename util::same_extent<T, double>::type;
 
     static_assert(comp > 0, "zero extent");
 
@@ -98,39 +91,22 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
     newVolume->setModelMatrix(volume->getModelMatrix());
     newVolume->setWorldMatrix(volume->getWorldMatrix());
 
-    const dmat4 m{volume->getCoordinateTransformer().getDataToWorldMatrix()};
-    const auto a = m * dvec4(0, 0, 0, 1);
-    const auto b = m * dvec4(dvec3(1.0) / dvec3(volume->getDimensions() - size3_t(1)), 1);
-    const auto spacing = dvec3(b - a);
-
-    const auto o = glm::diagonal3x3(spacing);
-    const Sampler s(volume, CoordinateSpace::World);
-
+    const StencilTransform transform{volume->getCoordinateTransformer().getIndexToWorldMatrix()};
     const util::IndexMapper3D index{volume->getDimensions()};
 
-    const auto resDim = dvec3(1.0) / dvec3(volume->getDimensions() - size3_t(1));
-    const auto resSpace2 = dvec3(1.0) / (spacing * spacing);
-
-    auto minval(std::numeric_limits<double>::max());
-    auto maxval(std::numeric_limits<double>::lowest());
-
-    auto func = [&](const size3_t& pos) {
-        const dvec3 world{m * dvec4((dvec3(pos) + dvec3(0.5)) * resDim, 1.0)};
-
-        const auto center = 2.0 * s.sample(world);
-        const auto D2x = (s.sample(world + o[0]) + center - s.sample(world - o[0])) * resSpace2.x;
-        const auto D2y = (s.sample(world + o[1]) + center - s.sample(world - o[1])) * resSpace2.y;
-        const auto D2z = (s.sample(world + o[2]) + center - s.sample(world - o[2])) * resSpace2.z;
-        const auto laplacian = center + D2x + D2y + D2z;
-
-        for (size_t i = 0; i < comp; ++i) {
-            minval = glm::min(minval, util::glmcomp(laplacian, i));
-            maxval = glm::max(maxval, util::glmcomp(laplacian, i));
-        }
-        newData[index(pos)] = static_cast<R>(laplacian);
-    };
-
-    util::forEachVoxelParallel(*volume->getRepresentation<VolumeRAM>(), func);
+    const auto ram = static_cast<const VolumeRAMPrecision<T>*>(
+        volume->template getRepresentation<VolumeRAM>());
+    const auto fetch = [](const T& v) { return static_cast<V>(v); };
+
+    const auto minMax = util::forEachCentralDifference(
+        ram->getDataTyped(), ram->getDimensions(), fetch, StencilMinMax<double>{},
+        [&](StencilMinMax<double>& state, size_t i, const CentralDifferences<V>& diff) {
+            const auto laplacian = transform.laplacian(diff.d2);
+            state.update(laplacian);
+            newData[i] = static_cast<R>(laplacian);
+        });
+    const auto minval = minMax.min;
+    const auto maxval = minMax.max;
 
     // Make range symmetric
     auto rangemax = std::max(std::abs(minval), std::abs(maxval));
@@ -0,0 +1,258 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/util/foreach.h>   // for forEachIndexParallel
+#include <inviwo/core/util/glmmat.h>    // for mat3, mat4
+#include <inviwo/core/util/glmutils.h>  // for value_type
+#include <inviwo/core/util/glmvec.h>    // for size3_t
+
+#include <algorithm>  // for min, max
+#include <array>      // for array
+#include <cstddef>    // for size_t, ptrdiff_t
+#include <limits>     // for numeric_limits
+#include <utility>    // for declval
+#include <vector>     // for vector
+
+#include <glm/gtx/component_wise.hpp>  // for compMin, compMax
+#include <glm/matrix.hpp>              // for inverse
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Central differences of a field at a single voxel, in index space.
+ *
+ * First derivatives are per voxel step and second derivatives per voxel step squared. At the
+ * volume border first derivatives use one sided differences and second derivatives use the
+ * difference of the closest interior voxel, hence both are exact for quadratic fields everywhere.
+ * Along an axis with a single voxel the derivatives are zero, as are the second derivatives along
+ * an axis with two voxels.
+ */
+template <typename V>
+struct CentralDifferences {
+    V value;
+    std::array<V, 3> d;   //!< d/di, d/dj, d/dk
+    std::array<V, 3> d2;  //!< d²/di², d²/dj², d²/dk²
+};
+
+/**
+ * \brief Maps index space central differences to world space derivatives
+ */
+class StencilTransform {
+public:
+    explicit StencilTransform(const mat4& indexToWorld)
+        : worldToIndex_{glm::inverse(mat3(indexToWorld))} {
+        for (int r = 0; r < 3; ++r) {
+            for (int a = 0; a < 3; ++a) {
+                laplacianWeights_[r] += worldToIndex_[a][r] * worldToIndex_[a][r];
+            }
+        }
+    }
+
+    /**
+     * Derivatives along the world x, y, and z axis
+     */
+    template <typename V>
+    std::array<V, 3> derivatives(const std::array<V, 3>& d) const {
+        using S = typename util::value_type<V>::type;
+        std::array<V, 3> res;
+        for (int a = 0; a < 3; ++a) {
+            res[a] = d[0] * static_cast<S>(worldToIndex_[a][0]) +
+                     d[1] * static_cast<S>(worldToIndex_[a][1]) +
+                     d[2] * static_cast<S>(worldToIndex_[a][2]);
+        }
+        return res;
+    }
+
+    /**
+     * Laplacian in world space. Mixed derivatives are not considered, hence this is exact only for
+     * volumes whose basis is aligned with the world axes.
+     */
+    template <typename V>
+    V laplacian(const std::array<V, 3>& d2) const {
+        using S = typename util::value_type<V>::type;
+        return d2[0] * static_cast<S>(laplacianWeights_[0]) +
+               d2[1] * static_cast<S>(laplacianWeights_[1]) +
+               d2[2] * static_cast<S>(laplacianWeights_[2]);
+    }
+
+private:
+    mat3 worldToIndex_;
+    std::array<float, 3> laplacianWeights_{0.0f, 0.0f, 0.0f};
+};
+
+/**
+ * \brief Min/max accumulator to be used as stencil state
+ */
+template <typename T>
+struct StencilMinMax {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+
+    template <typename V>
+    void update(const V& v) {
+        min = std::min(min, static_cast<T>(glm::compMin(v)));
+        max = std::max(max, static_cast<T>(glm::compMax(v)));
+    }
+    void update(T v) {
+        min = std::min(min, v);
+        max = std::max(max, v);
+    }
+    void merge(const StencilMinMax& other) {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+/**
+ * \brief Visit each voxel of a volume with its central differences.
+ *
+ * Works directly on the typed index space buffer. The volume is split into tiles of a few rows
+ * and slices that are processed in parallel; within a tile rows are traversed along x with a
+ * branch free interior, so the compiler can vectorize the differences. Several outputs can be
+ * written by the same kernel, which avoids reading the input once per derived quantity.
+ *
+ * Each tile has its own copy of the state, they are merged at the end using `State::merge`, so
+ * reductions like min/max do not need any synchronization.
+ *
+ * @param data  pointer to the voxel data
+ * @param dims  dimensions of the volume
+ * @param fetch converts a voxel T to the value type V the differences are computed in, for
+ *              example selecting a channel or converting to float
+ * @param init  initial state for each tile
+ * @param kernel called as kernel(State& state, size_t index, const CentralDifferences<V>& diff)
+ *              for every voxel, index is the linear index of the voxel
+ * @return the merged state of all tiles
+ */
+template <typename T, typename Fetch, typename State, typename Kernel>
+State forEachCentralDifference(const T* data, size3_t dims, Fetch fetch, const State& init,
+                               Kernel kernel) {
+    using V = decltype(fetch(std::declval<const T&>()));
+    using S = typename util::value_type<V>::type;
+
+    constexpr size_t tileRows = 16;
+    constexpr size_t tileSlices = 4;
+
+    const size_t sx = 1;
+    const size_t sy = dims.x;
+    const size_t sz = dims.x * dims.y;
+
+    const size_t tilesY = (dims.y + tileRows - 1) / tileRows;
+    const size_t tilesZ = (dims.z + tileSlices - 1) / tileSlices;
+    std::vector<State> states(tilesY * tilesZ, init);
+
+    // Clamped neighbors, the first difference is scaled by the inverse of their distance
+    const auto prev = [](size_t i) { return i > 0 ? i - 1 : i; };
+    const auto next = [](size_t i, size_t size) { return i + 1 < size ? i + 1 : i; };
+    const auto scale = [](size_t m, size_t p) {
+        return p - m == 2 ? S{0.5} : (p - m == 1 ? S{1} : S{0});
+    };
+    // Center of the second difference, moved inwards at the border. Returns size for axes
+    // too short to have a second difference
+    const auto center = [](size_t i, size_t size) {
+        return size < 3 ? size : std::min(std::max(i, size_t{1}), size - 2);
+    };
+
+    util::forEachIndexParallel(states.size(), [&](size_t tile) {
+        auto& state = states[tile];
+        const size_t y0 = (tile % tilesY) * tileRows;
+        const size_t z0 = (tile / tilesY) * tileSlices;
+        const size_t y1 = std::min(dims.y, y0 + tileRows);
+        const size_t z1 = std::min(dims.z, z0 + tileSlices);
+
+        for (size_t z = z0; z < z1; ++z) {
+            const size_t zm = prev(z);
+            const size_t zp = next(z, dims.z);
+            const size_t zc = center(z, dims.z);
+            const S scaleZ = scale(zm, zp);
+            for (size_t y = y0; y < y1; ++y) {
+                const size_t ym = prev(y);
+                const size_t yp = next(y, dims.y);
+                const size_t yc = center(y, dims.y);
+                const S scaleY = scale(ym, yp);
+
+                const size_t rowStart = z * sz + y * sy;
+                const T* row = data + rowStart;
+                const T* rowYm = data + z * sz + ym * sy;
+                const T* rowYp = data + z * sz + yp * sy;
+                const T* rowZm = data + zm * sz + y * sy;
+                const T* rowZp = data + zp * sz + y * sy;
+                // Rows of the second differences, equal to the ones above in the interior
+                const T* rowYc = yc < dims.y ? data + z * sz + yc * sy : nullptr;
+                const T* rowZc = zc < dims.z ? data + zc * sz + y * sy : nullptr;
+
+                const auto secondDifference = [&](const T* c, size_t x, size_t stride) {
+                    if (!c) return V{0};
+                    const T* p = c + x;
+                    const auto s = static_cast<std::ptrdiff_t>(stride);
+                    return fetch(p[s]) - fetch(p[0]) * S{2} + fetch(p[-s]);
+                };
+
+                const auto visit = [&](size_t x, size_t xm, size_t xp, size_t xc) {
+                    CentralDifferences<V> diff;
+                    diff.value = fetch(row[x]);
+
+                    diff.d[0] = (fetch(row[xp]) - fetch(row[xm])) * scale(xm, xp);
+                    diff.d[1] = (fetch(rowYp[x]) - fetch(rowYm[x])) * scaleY;
+                    diff.d[2] = (fetch(rowZp[x]) - fetch(rowZm[x])) * scaleZ;
+                    diff.d2[0] = xc < dims.x ? secondDifference(row, xc, sx) : V{0};
+                    diff.d2[1] = secondDifference(rowYc, x, sy);
+                    diff.d2[2] = secondDifference(rowZc, x, sz);
+
+                    kernel(state, rowStart + x * sx, diff);
+                };
+
+                if (dims.x == 1) {
+                    visit(0, 0, 0, dims.x);
+                    continue;
+                }
+                visit(0, 0, 1, center(0, dims.x));
+                for (size_t x = 1; x + 1 < dims.x; ++x) {
+                    visit(x, x - 1, x + 1, x);
+                }
+                visit(dims.x - 1, dims.x - 2, dims.x - 1, center(dims.x - 1, dims.x));
+            }
+        }
+    });
+
+    State result = init;
+    for (const auto& state : states) {
+        result.merge(state);
+    }
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
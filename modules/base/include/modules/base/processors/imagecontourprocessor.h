@@ -31,11 +31,13 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
-#include <inviwo/core/ports/imageport.h>             // for ImageInport
-#include <inviwo/core/ports/meshport.h>              // for MeshOutport
-#include <inviwo/core/processors/processor.h>        // for Processor
-#include <inviwo/core/processors/processorinfo.h>    // for ProcessorInfo
-#include <inviwo/core/properties/ordinalproperty.h>  // for DoubleProperty, FloatVec4Property
+#include <inviwo/core/ports/imageport.h>              // for ImageInport
+#include <inviwo/core/ports/meshport.h>               // for MeshOutport
+#include <inviwo/core/processors/processor.h>         // for Processor
+#include <inviwo/core/processors/processorinfo.h>     // for ProcessorInfo
+#include <inviwo/core/properties/boolproperty.h>      // for BoolProperty
+#include <inviwo/core/properties/isovalueproperty.h>  // for IsoValueProperty
+#include <inviwo/core/properties/ordinalproperty.h>   // for DoubleProperty, FloatVec4Property
 
 namespace inviwo {
 
@@ -55,6 +57,8 @@ private:
     IntSizeTProperty channel_;
     DoubleProperty isoValue_;
     FloatVec4Property color_;
+    BoolProperty multiple_;
+    IsoValueProperty isoValues_;
 };
 
 }  // namespace inviwo
@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
+
+#include <inviwo/core/datastructures/geometry/mesh.h>    // for Mesh
+#include <inviwo/core/ports/dataoutport.h>               // for DataOutport
+#include <inviwo/core/ports/meshport.h>                  // for MeshInport, MeshOutport
+#include <inviwo/core/processors/poolprocessor.h>        // for PoolProcessor
+#include <inviwo/core/processors/processorinfo.h>        // for ProcessorInfo
+#include <inviwo/core/properties/compositeproperty.h>    // for CompositeProperty
+#include <inviwo/core/properties/optionproperty.h>       // for OptionProperty
+#include <inviwo/core/properties/ordinalproperty.h>      // for FloatProperty, IntSizeTProperty
+#include <modules/base/algorithm/mesh/meshdecimation.h>  // for BoundaryHandling
+
+#include <memory>  // for shared_ptr
+#include <vector>  // for vector
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.MeshDecimation, Mesh Decimation}
+ * ![](org.inviwo.MeshDecimation.png?classIdentifier=org.inviwo.MeshDecimation)
+ * Reduces the number of triangles of a mesh using quadric error metrics, see
+ * meshutil::decimate. The attribute buffers are interpolated along the collapsed edges. Large
+ * meshes are decimated in parallel spatial partitions.
+ *
+ * ### Inports
+ *   * __inport__ Mesh to decimate
+ *
+ * ### Outports
+ *   * __outport__ The decimated mesh
+ *   * __lods__ Levels of detail generated from the decimated mesh, each with fewer triangles
+ *     than the one before
+ *
+ * ### Properties
+ *   * __Target Ratio__ Fraction of the triangles to keep
+ *   * __Max Error__ Largest allowed quadric error of a collapse, 0 means no limit
+ *   * __Boundary__ Keep boundary vertices fixed, or only penalize moving them
+ *   * __Boundary Weight__ Penalty for moving boundary vertices
+ *   * __Partitions__ Number of parts to decimate in parallel, 0 uses one per thread
+ *   * __Levels__ Number of levels of detail to generate
+ *   * __Level Ratio__ Fraction of the triangles to keep between two levels
+ */
+class IVW_MODULE_BASE_API MeshDecimation : public PoolProcessor {
+public:
+    MeshDecimation();
+    virtual ~MeshDecimation() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    MeshInport inport_;
+    MeshOutport outport_;
+    DataOutport<std::vector<std::shared_ptr<Mesh>>> lods_;
+
+    FloatProperty ratio_;
+    FloatProperty maxError_;
+    OptionProperty<meshutil::BoundaryHandling> boundary_;
+    FloatProperty boundaryWeight_;
+    IntSizeTProperty partitions_;
+
+    CompositeProperty lod_;
+    IntSizeTProperty lodLevels_;
+    FloatProperty lodRatio_;
+};
+
+}  // namespace inviwo
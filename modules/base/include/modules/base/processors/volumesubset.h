@@ -31,12 +31,13 @@
 
 #include <modules/base/basemoduledefine.h>  // for IVW_MODULE_BASE_API
 
-#include <inviwo/core/ports/volumeport.h>           // for VolumeInport, VolumeOutport
-#include <inviwo/core/processors/processor.h>       // for Processor
-#include <inviwo/core/processors/processorinfo.h>   // for ProcessorInfo
-#include <inviwo/core/properties/boolproperty.h>    // for BoolProperty
-#include <inviwo/core/properties/minmaxproperty.h>  // for IntSizeTMinMaxProperty
-#include <inviwo/core/util/glmvec.h>                // for size3_t
+#include <inviwo/core/ports/volumeport.h>            // for VolumeInport, VolumeOutport
+#include <inviwo/core/processors/processor.h>        // for Processor
+#include <inviwo/core/processors/processorinfo.h>    // for ProcessorInfo
+#include <inviwo/core/processors/processortraits.h>  // for ProcessorTraits
+#include <inviwo/core/properties/boolproperty.h>     // for BoolProperty
+#include <inviwo/core/properties/minmaxproperty.h>   // for IntSizeTMinMaxProperty
+#include <inviwo/core/util/glmvec.h>                 // for size3_t
 
 namespace inviwo {
 
@@ -84,4 +85,14 @@ private:
     size3_t dims_;
 };
 
+/**
+ * The subset only depends on the input volume and the properties, hence the outputs can be
+ * memoized when changing the ranges back and forth.
+ */
+template <>
+struct ProcessorTraits<VolumeSubset> {
+    static ProcessorInfo getProcessorInfo() { return VolumeSubset::processorInfo_; }
+    static constexpr bool memoizeOutputs = true;
+};
+
 }  // namespace inviwo
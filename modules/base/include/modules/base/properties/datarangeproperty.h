@@ -39,7 +39,7 @@
 #include <inviwo/core/properties/propertysemantics.h>      // for PropertySemantics, PropertySem...
 #include <inviwo/core/util/glmvec.h>                       // for dvec2
 
-#include <memory>       // for shared_ptr
+#include <memory>       // for shared_ptr, weak_ptr
 #include <string>       // for string
 #include <string_view>  // for string_view
 
@@ -96,7 +96,14 @@ public:
     bool getCustomRangeEnabled() const;
 
 private:
+    /**
+     * Set the custom ranges to the 1st to 99th percentile of the input volume, approximated with
+     * a util::QuantileSketch, to exclude outliers.
+     */
+    void setCustomRangeFromQuantiles();
+
     const bool customRanges_;
+    std::weak_ptr<const Volume> volume_;
 
     DoubleMinMaxProperty dataRange_;
     DoubleMinMaxProperty valueRange_;
@@ -104,6 +111,7 @@ private:
     DoubleMinMaxProperty customDataRange_;
     DoubleMinMaxProperty customValueRange_;
     ButtonProperty copyFromInput_;
+    ButtonProperty robustFromInput_;
 };
 
 }  // namespace inviwo
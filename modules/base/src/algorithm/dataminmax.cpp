@@ -29,54 +29,34 @@
 
 #include <modules/base/algorithm/dataminmax.h>
 
-#include <inviwo/core/datastructures/buffer/buffer.h>                   // for BufferBase
-#include <inviwo/core/datastructures/buffer/bufferram.h>                // for BufferRAM
-#include <inviwo/core/datastructures/image/layer.h>                     // for Layer
-#include <inviwo/core/datastructures/image/layerram.h>                  // for LayerRAM
-#include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
-#include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
-#include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
-#include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
-#include <inviwo/core/util/glmvec.h>                                    // for dvec4
-#include <modules/base/algorithm/algorithmoptions.h>                    // for IgnoreSpecialValues
-
-#include <memory>         // for unique_ptr
-#include <unordered_set>  // for unordered_set
-
-#include <half/half.hpp>  // for operator<
+#include <inviwo/core/util/glmvec.h>                  // for dvec4
+#include <modules/base/algorithm/algorithmoptions.h>  // for IgnoreSpecialValues
+#include <modules/base/algorithm/datareduction.h>     // for volumeReduction, layerReduction
 
 namespace inviwo {
 
 std::pair<dvec4, dvec4> util::volumeMinMax(const VolumeRAM* volume, IgnoreSpecialValues ignore) {
-    return volume->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto vr) -> std::pair<dvec4, dvec4> {
-        const auto dim = vr->getDimensions();
-        return dataMinMax(vr->getDataTyped(), dim.x * dim.y * dim.z, ignore);
-    });
+    return volumeReduction(volume, Reduction::MinMax, ignore).minMax();
 }
 
 std::pair<dvec4, dvec4> util::layerMinMax(const LayerRAM* layer, IgnoreSpecialValues ignore) {
-    return layer->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto lr) -> std::pair<dvec4, dvec4> {
-        const auto dim = lr->getDimensions();
-        return dataMinMax(lr->getDataTyped(), dim.x * dim.y, ignore);
-    });
+    return layerReduction(layer, Reduction::MinMax, ignore).minMax();
 }
 
 std::pair<dvec4, dvec4> util::bufferMinMax(const BufferRAM* buffer, IgnoreSpecialValues ignore) {
-    return buffer->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto br) -> std::pair<dvec4, dvec4> {
-        return dataMinMax(br->getDataContainer().data(), br->getSize(), ignore);
-    });
+    return bufferReduction(buffer, Reduction::MinMax, ignore).minMax();
 }
 
 std::pair<dvec4, dvec4> util::volumeMinMax(const Volume* volume, IgnoreSpecialValues ignore) {
-    return util::volumeMinMax(volume->getRepresentation<VolumeRAM>(), ignore);
+    return volumeReduction(volume, Reduction::MinMax, ignore).minMax();
 }
 
 std::pair<dvec4, dvec4> util::layerMinMax(const Layer* layer, IgnoreSpecialValues ignore) {
-    return util::layerMinMax(layer->getRepresentation<LayerRAM>(), ignore);
+    return layerReduction(layer, Reduction::MinMax, ignore).minMax();
 }
 
 std::pair<dvec4, dvec4> util::bufferMinMax(const BufferBase* buffer, IgnoreSpecialValues ignore) {
-    return util::bufferMinMax(buffer->getRepresentation<BufferRAM>(), ignore);
+    return bufferReduction(buffer, Reduction::MinMax, ignore).minMax();
 }
 
 }  // namespace inviwo
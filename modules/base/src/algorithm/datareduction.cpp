@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/datareduction.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>     // for BufferBase
+#include <inviwo/core/datastructures/buffer/bufferram.h>  // for BufferRAM
+#include <inviwo/core/datastructures/image/layer.h>       // for Layer
+#include <inviwo/core/datastructures/image/layerram.h>    // for LayerRAM
+#include <inviwo/core/datastructures/volume/volume.h>     // for Volume
+#include <inviwo/core/datastructures/volume/volumeram.h>  // for VolumeRAM
+
+#include <string>  // for string
+
+#include <half/half.hpp>  // for half
+
+namespace inviwo {
+
+dvec4 DataReduction::mean() const {
+    dvec4 res{0.0};
+    for (size_t c = 0; c < components; ++c) {
+        if (count[c] > 0) res[c] = sum[c] / static_cast<double>(count[c]);
+    }
+    return res;
+}
+
+dvec4 DataReduction::variance() const {
+    const auto m = mean();
+    dvec4 res{0.0};
+    for (size_t c = 0; c < components; ++c) {
+        if (count[c] > 0) {
+            res[c] = std::max(0.0, sumOfSquares[c] / static_cast<double>(count[c]) - m[c] * m[c]);
+        }
+    }
+    return res;
+}
+
+void util::detail::combine(DataReduction& result, const DataReduction& partial) {
+    result.min = glm::min(result.min, partial.min);
+    result.max = glm::max(result.max, partial.max);
+    result.sum += partial.sum;
+    result.sumOfSquares += partial.sumOfSquares;
+    result.count += partial.count;
+    result.nanCount += partial.nanCount;
+    result.infCount += partial.infCount;
+}
+
+DataReduction util::volumeReduction(const VolumeRAM* volume, Reductions reductions,
+                                    IgnoreSpecialValues ignore) {
+    return volume->dispatch<DataReduction>([&](auto vr) {
+        const auto dim = vr->getDimensions();
+        return dataReduction(vr->getDataTyped(), dim.x * dim.y * dim.z, reductions, ignore);
+    });
+}
+
+DataReduction util::layerReduction(const LayerRAM* layer, Reductions reductions,
+                                   IgnoreSpecialValues ignore) {
+    return layer->dispatch<DataReduction>([&](auto lr) {
+        const auto dim = lr->getDimensions();
+        return dataReduction(lr->getDataTyped(), dim.x * dim.y, reductions, ignore);
+    });
+}
+
+DataReduction util::bufferReduction(const BufferRAM* buffer, Reductions reductions,
+                                    IgnoreSpecialValues ignore) {
+    return buffer->dispatch<DataReduction>([&](auto br) {
+        return dataReduction(br->getDataContainer().data(), br->getSize(), reductions, ignore);
+    });
+}
+
+namespace {
+
+/**
+ * A separate entry for each set of reductions, such that callers only interested in, e.g., the
+ * min/max do not pay for the sums.
+ */
+std::string reductionKey(Reductions reductions, IgnoreSpecialValues ignore) {
+    constexpr auto all =
+        Reduction::MinMax | Reduction::Sum | Reduction::SumOfSquares | Reduction::SpecialValues;
+    auto key = "dataReduction." + std::to_string((reductions & all).underlying_value());
+    if (ignore == IgnoreSpecialValues::Yes) key += ".ignoreSpecial";
+    return key;
+}
+
+}  // namespace
+
+DataReduction util::volumeReduction(const Volume* volume, Reductions reductions,
+                                    IgnoreSpecialValues ignore) {
+    return *volume->getDerived<DataReduction>(reductionKey(reductions, ignore), [&]() {
+        return util::volumeReduction(volume->getRepresentation<VolumeRAM>(), reductions, ignore);
+    });
+}
+
+DataReduction util::layerReduction(const Layer* layer, Reductions reductions,
+                                   IgnoreSpecialValues ignore) {
+    return *layer->getDerived<DataReduction>(reductionKey(reductions, ignore), [&]() {
+        return util::layerReduction(layer->getRepresentation<LayerRAM>(), reductions, ignore);
+    });
+}
+
+DataReduction util::bufferReduction(const BufferBase* buffer, Reductions reductions,
+                                    IgnoreSpecialValues ignore) {
+    return *buffer->getDerived<DataReduction>(reductionKey(reductions, ignore), [&]() {
+        return util::bufferReduction(buffer->getRepresentation<BufferRAM>(), reductions, ignore);
+    });
+}
+
+}  // namespace inviwo
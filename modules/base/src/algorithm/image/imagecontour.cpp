@@ -29,12 +29,16 @@
 
 #include <modules/base/algorithm/image/imagecontour.h>
 
+#include <inviwo/core/datastructures/buffer/buffer.h>                   // for makeBuffer, makeI...
 #include <inviwo/core/datastructures/geometry/geometrytype.h>           // for ConnectivityType
-#include <inviwo/core/datastructures/geometry/typedmesh.h>              // for BasicMesh, TypedMesh
+#include <inviwo/core/datastructures/geometry/mesh.h>                   // for Mesh
 #include <inviwo/core/datastructures/image/layerram.h>                  // IWYU pragma: keep
 #include <inviwo/core/datastructures/image/layerrepresentation.h>       // for LayerRepresentation
+#include <inviwo/core/datastructures/isovaluecollection.h>              // for IsoValueCollection
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/tfprimitive.h>                     // for TFPrimitive
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexParallel
 #include <inviwo/core/util/formatdispatching.h>                         // for dispatch, All
 #include <inviwo/core/util/formats.h>                                   // for DataFormatBase
 #include <inviwo/core/util/glmcomp.h>                                   // for glmcomp
@@ -42,33 +46,100 @@
 #include <inviwo/core/util/glmutils.h>                                  // for extent
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, vec4
 #include <inviwo/core/util/indexmapper.h>                               // for IndexMapper, Inde...
-#include <inviwo/core/util/interpolation.h>                             // for Interpolation
+#include <inviwo/core/util/threadutil.h>                                // for getPoolSize
 
-#include <algorithm>      // for min
+#include <algorithm>      // for min, upper_bound, sort
+#include <array>          // for array
+#include <cstdint>        // for uint32_t, uint64_t
+#include <limits>         // for numeric_limits
 #include <type_traits>    // for remove_extent_t
 #include <unordered_map>  // for unordered_map
-#include <unordered_set>  // for unordered_set
+#include <utility>        // for pair
 #include <vector>         // for vector
 
-#include <glm/common.hpp>        // for mix
-#include <glm/detail/setup.hpp>  // for size_t
-#include <glm/vec3.hpp>          // for operator*, operator+
+#include <glm/vec3.hpp>  // for operator*, operator+
 
 namespace inviwo {
-class Mesh;
 
 namespace {
+
+constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * A sequence of edges, `reversed` is set for edges that are traversed from their second node
+ */
+struct Path {
+    std::vector<std::pair<std::uint32_t, bool>> edges;
+    bool closed = false;
+};
+
+/**
+ * Walk a graph where each node is shared by at most two edges and split it into paths. Paths
+ * start at nodes with only one edge; the remaining edges form closed loops.
+ */
+std::vector<Path> stitch(size_t nodes, const std::vector<std::array<std::uint32_t, 2>>& edges) {
+    std::vector<std::array<std::uint32_t, 2>> adjacency(nodes, {none, none});
+    for (std::uint32_t e = 0; e < edges.size(); ++e) {
+        for (auto node : edges[e]) {
+            auto& adj = adjacency[node];
+            (adj[0] == none ? adj[0] : adj[1]) = e;
+        }
+    }
+
+    std::vector<Path> paths;
+    std::vector<std::uint8_t> visited(edges.size(), 0);
+    const auto walk = [&](std::uint32_t start, std::uint32_t edge) {
+        Path path;
+        auto node = start;
+        while (edge != none) {
+            visited[edge] = 1;
+            const bool reversed = edges[edge][0] != node;
+            path.edges.emplace_back(edge, reversed);
+            node = edges[edge][reversed ? 0 : 1];
+            const auto& adj = adjacency[node];
+            edge = adj[0] != none && !visited[adj[0]]   ? adj[0]
+                   : adj[1] != none && !visited[adj[1]] ? adj[1]
+                                                        : none;
+        }
+        path.closed = node == start;
+        paths.push_back(std::move(path));
+    };
+
+    for (std::uint32_t node = 0; node < nodes; ++node) {
+        const auto& adj = adjacency[node];
+        if (adj[0] != none && adj[1] == none && !visited[adj[0]]) walk(node, adj[0]);
+    }
+    for (std::uint32_t e = 0; e < edges.size(); ++e) {
+        if (!visited[e]) walk(edges[e][0], e);
+    }
+    return paths;
+}
+
+/**
+ * The contours of a band of cell rows, the chains are stitched within the band only.
+ */
+struct Band {
+    std::vector<std::uint64_t> keys;  // Identifies the grid edge and isovalue of a vertex
+    std::vector<vec3> positions;
+    std::vector<std::uint32_t> isoIndices;
+    std::vector<std::vector<std::uint32_t>> chains;
+    std::vector<std::uint8_t> closed;
+};
+
 struct ImageContourDispatcher {
     using type = std::shared_ptr<Mesh>;
     template <typename Result, typename T>
-    std::shared_ptr<Mesh> operator()(const LayerRepresentation* in, size_t channel, double isoValue,
-                                     vec4 color);
+    std::shared_ptr<Mesh> operator()(const LayerRepresentation* in, size_t channel,
+                                     const std::vector<std::pair<double, std::uint32_t>>& isos,
+                                     const std::vector<double>& isoValues,
+                                     const std::vector<vec4>& colors);
 };
 
 template <typename Result, class DataType>
-std::shared_ptr<Mesh> ImageContourDispatcher::operator()(const LayerRepresentation* in,
-                                                         size_t channel, double isoValue,
-                                                         vec4 color) {
+std::shared_ptr<Mesh> ImageContourDispatcher::operator()(
+    const LayerRepresentation* in, size_t channel,
+    const std::vector<std::pair<double, std::uint32_t>>& isos,
+    const std::vector<double>& isoValues, const std::vector<vec4>& colors) {
     static const std::vector<std::vector<int>> caseTable = {
         std::vector<int>(),                          // case 0
         std::vector<int>({0, 1, 0, 3}),              // case 1
@@ -80,82 +151,248 @@ std::shared_ptr<Mesh> ImageContourDispatcher::operator()(const LayerRepresentati
         std::vector<int>({0, 3, 3, 2}),              // case 7
         std::vector<int>({0, 3, 0, 1, 1, 2, 2, 3})};
 
-    auto mesh = std::make_shared<BasicMesh>();
-    auto indices = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
-
     using T = typename DataType::type;
     channel = std::min(channel, util::extent<typename DataType::type>::value - 1);
 
     const LayerRAMPrecision<T>* ram = dynamic_cast<const LayerRAMPrecision<T>*>(in);
     if (!ram) return nullptr;
 
-    auto data = static_cast<const T*>(ram->getData());
-
-    auto dim = ram->getDimensions();
-
+    const auto data = static_cast<const T*>(ram->getData());
+    const auto dim = ram->getDimensions();
     if (dim.x == 0 || dim.y == 0) return nullptr;
 
-    double vals[4];
-    vec3 outPos[4];
-    vec3 outPosScale =
+    const vec3 outPosScale =
         vec3(1.0f / static_cast<float>(dim.x - 1), 1.0f / static_cast<float>(dim.y - 1), 1);
-    util::IndexMapper2D index(dim);
-    for (size_t y = 0; y < dim.y - 1; y++) {
-        for (size_t x = 0; x < dim.x - 1; x++) {
-            auto idx = index(x, y);
-            vals[0] = util::glm_convert<double>(util::glmcomp(data[idx], channel));
-            vals[1] = util::glm_convert<double>(util::glmcomp(data[idx + 1], channel));
-            vals[2] = util::glm_convert<double>(util::glmcomp(data[idx + 1 + dim.x], channel));
-            vals[3] = util::glm_convert<double>(util::glmcomp(data[idx + dim.x], channel));
-
-            int theCase = 0;
-            theCase += vals[0] < isoValue ? 0 : 1;
-            theCase += vals[1] < isoValue ? 0 : 2;
-            theCase += vals[2] < isoValue ? 0 : 4;
-            theCase += vals[3] < isoValue ? 0 : 8;
-
-            if (theCase == 0 || theCase == 15) {
-                continue;
-            } else if (theCase == 5 || theCase == 10) {
-                auto m = (vals[0] + vals[1] + vals[2] + vals[3]) * 0.25;
-                bool inside = m >= isoValue;
-                if (theCase == 5) {
-                    theCase = inside ? 5 : 8;
-                } else {
-                    theCase = !inside ? 5 : 8;
+    const util::IndexMapper2D index(dim);
+    const auto value = [&](size_t idx) {
+        return util::glm_convert<double>(util::glmcomp(data[idx], channel));
+    };
+    const auto nIsos = static_cast<std::uint64_t>(isos.size());
+
+    const size_t rows = dim.y - 1;
+    const size_t nBands = std::min(rows, std::max(size_t{1}, 4 * util::getPoolSize()));
+    std::vector<Band> bands(nBands);
+
+    util::forEachIndexParallel(nBands, [&](size_t b) {
+        auto& band = bands[b];
+        std::unordered_map<std::uint64_t, std::uint32_t> vertices;
+        std::vector<std::array<std::uint32_t, 2>> segments;
+
+        // Grid edges are numbered by their start point, horizontal first
+        const auto vertex = [&](size_t x, size_t y, bool vertical, double v0, double v1,
+                                std::uint32_t iso) {
+            const auto key = (static_cast<std::uint64_t>(index(x, y)) * 2 + vertical) * nIsos + iso;
+            const auto [it, inserted] =
+                vertices.try_emplace(key, static_cast<std::uint32_t>(band.keys.size()));
+            if (inserted) {
+                const auto t = static_cast<float>((isos[iso].first - v0) / (v1 - v0));
+                const auto p = vec3(x, y, 0) + (vertical ? vec3(0, t, 0) : vec3(t, 0, 0));
+                band.keys.push_back(key);
+                band.positions.push_back(p * outPosScale);
+                band.isoIndices.push_back(iso);
+            }
+            return it->second;
+        };
+
+        double vals[4];
+        for (size_t y = (rows * b) / nBands; y < (rows * (b + 1)) / nBands; ++y) {
+            for (size_t x = 0; x < dim.x - 1; ++x) {
+                const auto idx = index(x, y);
+                vals[0] = value(idx);
+                vals[1] = value(idx + 1);
+                vals[2] = value(idx + 1 + dim.x);
+                vals[3] = value(idx + dim.x);
+
+                // A contour crosses the cell for isovalues in (min, max]
+                const auto [lo, hi] = std::minmax({vals[0], vals[1], vals[2], vals[3]});
+                const auto first =
+                    std::upper_bound(isos.begin(), isos.end(), lo,
+                                     [](double v, const auto& iso) { return v < iso.first; });
+                const auto last =
+                    std::upper_bound(first, isos.end(), hi,
+                                     [](double v, const auto& iso) { return v < iso.first; });
+
+                for (auto it = first; it != last; ++it) {
+                    const auto isoValue = it->first;
+                    const auto iso = static_cast<std::uint32_t>(it - isos.begin());
+
+                    int theCase = 0;
+                    theCase += vals[0] < isoValue ? 0 : 1;
+                    theCase += vals[1] < isoValue ? 0 : 2;
+                    theCase += vals[2] < isoValue ? 0 : 4;
+                    theCase += vals[3] < isoValue ? 0 : 8;
+
+                    if (theCase == 5 || theCase == 10) {
+                        auto m = (vals[0] + vals[1] + vals[2] + vals[3]) * 0.25;
+                        bool inside = m >= isoValue;
+                        if (theCase == 5) {
+                            theCase = inside ? 5 : 8;
+                        } else {
+                            theCase = !inside ? 5 : 8;
+                        }
+                    } else if (theCase > 7) {
+                        theCase = 15 - theCase;
+                    }
+
+                    const auto edgeVertex = [&](int c0, int c1) {
+                        switch (std::min(c0, c1) * 4 + std::max(c0, c1)) {
+                            case 1:  // 0-1
+                                return vertex(x, y, false, vals[0], vals[1], iso);
+                            case 6:  // 1-2
+                                return vertex(x + 1, y, true, vals[1], vals[2], iso);
+                            case 11:  // 2-3
+                                return vertex(x, y + 1, false, vals[3], vals[2], iso);
+                            default:  // 0-3
+                                return vertex(x, y, true, vals[0], vals[3], iso);
+                        }
+                    };
+
+                    const auto& edges = caseTable[theCase];
+                    for (size_t i = 0; i < edges.size(); i += 4) {
+                        segments.push_back({edgeVertex(edges[i], edges[i + 1]),
+                                            edgeVertex(edges[i + 2], edges[i + 3])});
+                    }
                 }
-            } else if (theCase > 7) {
-                theCase = 15 - theCase;
             }
+        }
 
-            outPos[0] = vec3(x, y, 0) * outPosScale;
-            outPos[1] = vec3(x + 1, y, 0) * outPosScale;
-            outPos[2] = vec3(x + 1, y + 1, 0) * outPosScale;
-            outPos[3] = vec3(x, y + 1, 0) * outPosScale;
-
-            auto& edges = caseTable[theCase];
-            for (size_t i = 0; i < edges.size(); i += 2) {
-                auto t = (isoValue - vals[edges[i]]) / (vals[edges[i + 1]] - vals[edges[i]]);
-                auto p = Interpolation<vec3, float>::linear(outPos[edges[i]], outPos[edges[i + 1]],
-                                                            static_cast<float>(t));
-                indices->add(mesh->addVertex(p, p, p, color));
+        for (const auto& path : stitch(band.keys.size(), segments)) {
+            std::vector<std::uint32_t> chain;
+            chain.reserve(path.edges.size() + 1);
+            const auto [e0, r0] = path.edges.front();
+            chain.push_back(segments[e0][r0 ? 1 : 0]);
+            for (const auto& [e, reversed] : path.edges) {
+                chain.push_back(segments[e][reversed ? 0 : 1]);
             }
+            if (path.closed) chain.pop_back();
+            band.chains.push_back(std::move(chain));
+            band.closed.push_back(path.closed);
+        }
+    });
+
+    // Join the open chains that meet at the boundaries between the bands
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> chains;  // band, chain
+    std::vector<std::array<std::uint32_t, 2>> ends;
+    std::unordered_map<std::uint64_t, std::uint32_t> nodes;
+    const auto node = [&](std::uint64_t key) {
+        return nodes.try_emplace(key, static_cast<std::uint32_t>(nodes.size())).first->second;
+    };
+    for (std::uint32_t b = 0; b < nBands; ++b) {
+        const auto& band = bands[b];
+        for (std::uint32_t c = 0; c < band.chains.size(); ++c) {
+            if (band.closed[c]) continue;
+            chains.emplace_back(b, c);
+            ends.push_back({node(band.keys[band.chains[c].front()]),
+                            node(band.keys[band.chains[c].back()])});
         }
     }
 
+    std::vector<vec3> positions;
+    std::vector<vec4> vertexColors;
+    std::vector<float> vertexIsoValues;
+    std::vector<std::uint32_t> polylineIds;
+    std::uint32_t nPolylines = 0;
+    std::vector<std::vector<std::uint32_t>> segments(isoValues.size());
+
+    using Vertices = std::vector<std::pair<const Band*, std::uint32_t>>;
+    const auto addPolyline = [&](const Vertices& vertices, bool closed) {
+        if (vertices.size() < 2) return;
+        // All vertices of a polyline belong to the same isovalue
+        const auto iso = isos[vertices.front().first->isoIndices[vertices.front().second]].second;
+        const auto id = nPolylines++;
+        const auto start = static_cast<std::uint32_t>(positions.size());
+        for (const auto& [band, v] : vertices) {
+            positions.push_back(band->positions[v]);
+            vertexColors.push_back(iso < colors.size() ? colors[iso] : vec4(1.0f));
+            vertexIsoValues.push_back(static_cast<float>(isoValues[iso]));
+            polylineIds.push_back(id);
+        }
+        const auto end = static_cast<std::uint32_t>(positions.size());
+        auto& indices = segments[iso];
+        for (auto i = start; i + 1 < end; ++i) indices.insert(indices.end(), {i, i + 1});
+        if (closed && end - start > 2) indices.insert(indices.end(), {end - 1, start});
+    };
+
+    Vertices vertices;
+    for (const auto& band : bands) {
+        for (size_t c = 0; c < band.chains.size(); ++c) {
+            if (!band.closed[c]) continue;
+            vertices.clear();
+            for (auto v : band.chains[c]) vertices.emplace_back(&band, v);
+            addPolyline(vertices, true);
+        }
+    }
+    for (const auto& path : stitch(nodes.size(), ends)) {
+        vertices.clear();
+        for (const auto& [c, reversed] : path.edges) {
+            const auto& band = bands[chains[c].first];
+            const auto& chain = band.chains[chains[c].second];
+            // The first vertex of each joined chain is the last one of the previous chain
+            for (size_t i = vertices.empty() ? 0 : 1; i < chain.size(); ++i) {
+                vertices.emplace_back(&band, chain[reversed ? chain.size() - 1 - i : i]);
+            }
+        }
+        // The last vertex of a closed path is the first one again
+        if (path.closed) vertices.pop_back();
+        addPolyline(vertices, path.closed);
+    }
+
+    auto mesh = std::make_shared<Mesh>(DrawType::Lines, ConnectivityType::None);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(vertexColors)));
+    mesh->addBuffer(BufferType::ScalarMetaAttrib, util::makeBuffer(std::move(vertexIsoValues)));
+    mesh->addBuffer(BufferType::IndexAttrib, util::makeBuffer(std::move(polylineIds)));
+    for (auto& indices : segments) {
+        mesh->addIndices(Mesh::MeshInfo{DrawType::Lines, ConnectivityType::None},
+                         util::makeIndexBuffer(std::move(indices)));
+    }
     return mesh;
 }
+
+std::shared_ptr<Mesh> contour(const LayerRepresentation* in, size_t channel,
+                              const std::vector<double>& dataValues,
+                              const std::vector<double>& isoValues,
+                              const std::vector<vec4>& colors) {
+    std::vector<std::pair<double, std::uint32_t>> isos;
+    for (std::uint32_t i = 0; i < dataValues.size(); ++i) isos.emplace_back(dataValues[i], i);
+    std::sort(isos.begin(), isos.end());
+
+    ImageContourDispatcher disp;
+    return dispatching::dispatch<std::shared_ptr<Mesh>, dispatching::filter::All>(
+        in->getDataFormat()->getId(), disp, in, channel, isos, isoValues, colors);
+}
+
 }  // namespace
 
 std::shared_ptr<Mesh> ImageContour::apply(const LayerRepresentation* in, size_t channel,
                                           double isoValue, vec4 color) {
-    ImageContourDispatcher disp;
-    auto df = in->getDataFormat();
+    return apply(in, channel, std::vector<double>{isoValue}, std::vector<vec4>{color});
+}
+
+std::shared_ptr<Mesh> ImageContour::apply(const LayerRepresentation* in, size_t channel,
+                                          const std::vector<double>& isoValues,
+                                          const std::vector<vec4>& colors) {
+    auto dataValues = isoValues;
+    const auto df = in->getDataFormat();
     if (df->getNumericType() != NumericType::Float) {
-        isoValue = df->getMin() + isoValue * (df->getMax() - df->getMin());
+        for (auto& v : dataValues) v = df->getMin() + v * (df->getMax() - df->getMin());
+    }
+    return contour(in, channel, dataValues, isoValues, colors);
+}
+
+std::shared_ptr<Mesh> ImageContour::apply(const LayerRepresentation* in, size_t channel,
+                                          const IsoValueCollection& isoValues) {
+    std::vector<double> values;
+    std::vector<vec4> colors;
+    for (const auto& iso : isoValues) {
+        values.push_back(iso.getPosition());
+        colors.push_back(iso.getColor());
+    }
+    if (isoValues.getType() == TFPrimitiveSetType::Absolute) {
+        return contour(in, channel, values, values, colors);
+    } else {
+        return apply(in, channel, values, colors);
     }
-    return dispatching::dispatch<std::shared_ptr<Mesh>, dispatching::filter::All>(
-        df->getId(), disp, in, channel, isoValue, color);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,684 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/meshdecimation.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>              // for IndexBuffer, makeIn...
+#include <inviwo/core/datastructures/buffer/bufferram.h>           // for BufferRAM
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>  // for BufferRAMPrecision
+#include <inviwo/core/datastructures/geometry/geometrytype.h>      // for BufferType, DrawType
+#include <inviwo/core/datastructures/geometry/mesh.h>              // for Mesh
+#include <inviwo/core/util/exception.h>                            // for Exception
+#include <inviwo/core/util/foreach.h>                              // for forEachIndexParallel
+#include <inviwo/core/util/formatdispatching.h>                    // for PrecisionValueType
+#include <inviwo/core/util/glmconvert.h>                           // for glm_convert
+#include <inviwo/core/util/glmutils.h>                             // for same_extent_t, extent
+#include <inviwo/core/util/glmvec.h>                               // for dvec3, u32vec3
+#include <inviwo/core/util/sourcecontext.h>                        // for IVW_CONTEXT_CUSTOM
+#include <inviwo/core/util/stdextensions.h>                        // for find_if
+#include <inviwo/core/util/threadutil.h>                           // for getPoolSize
+#include <modules/base/algorithm/meshutils.h>                      // for forEachTriangle
+
+#include <algorithm>    // for sort, nth_element, lower_bound
+#include <array>        // for array
+#include <cmath>        // for abs
+#include <cstdint>      // for uint32_t, uint8_t
+#include <functional>   // for greater
+#include <numeric>      // for iota, accumulate
+#include <optional>     // for optional
+#include <queue>        // for priority_queue
+#include <type_traits>  // for is_floating_point_v
+#include <utility>      // for pair
+
+#include <glm/common.hpp>     // for min, max
+#include <glm/geometric.hpp>  // for cross, dot, length
+#include <glm/mat3x3.hpp>     // for dmat3
+#include <glm/matrix.hpp>     // for determinant, inverse
+
+namespace inviwo {
+
+namespace meshutil {
+
+namespace {
+
+struct Triangle {
+    glm::u32vec3 v;
+    std::uint32_t group;  // index of the index buffer the triangle came from
+};
+
+/**
+ * Vertex `from` was merged into vertex `into`, its attributes are given by interpolating from
+ * `into` towards `from` by `t`.
+ */
+struct Collapse {
+    std::uint32_t from;
+    std::uint32_t into;
+    double t;
+};
+
+struct Part {
+    std::vector<Triangle> triangles;
+    std::vector<Collapse> collapses;
+};
+
+/**
+ * Symmetric 4x4 matrix of the sum of squared distances to a set of planes
+ */
+struct Quadric {
+    static Quadric plane(const dvec3& n, double d, double w) {
+        return {w * n.x * n.x, w * n.x * n.y, w * n.x * n.z, w * n.x * d, w * n.y * n.y,
+                w * n.y * n.z, w * n.y * d,   w * n.z * n.z, w * n.z * d, w * d * d};
+    }
+
+    Quadric& operator+=(const Quadric& q) {
+        a2 += q.a2;
+        ab += q.ab;
+        ac += q.ac;
+        ad += q.ad;
+        b2 += q.b2;
+        bc += q.bc;
+        bd += q.bd;
+        c2 += q.c2;
+        cd += q.cd;
+        d2 += q.d2;
+        return *this;
+    }
+    friend Quadric operator+(Quadric a, const Quadric& b) { return a += b; }
+
+    double error(const dvec3& p) const {
+        const double e = a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z +
+                         2.0 * ad * p.x + b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y +
+                         c2 * p.z * p.z + 2.0 * cd * p.z + d2;
+        return std::max(e, 0.0);
+    }
+
+    /**
+     * The position minimizing the error, if it is well defined
+     */
+    std::optional<dvec3> optimum() const {
+        const glm::dmat3 a{a2, ab, ac, ab, b2, bc, ac, bc, c2};
+        const double det = glm::determinant(a);
+        const double scale = a2 + b2 + c2;
+        if (std::abs(det) <= 1e-10 * scale * scale * scale) return std::nullopt;
+        return glm::inverse(a) * dvec3{-ad, -bd, -cd};
+    }
+
+    double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0, b2 = 0.0, bc = 0.0, bd = 0.0, c2 = 0.0,
+           cd = 0.0, d2 = 0.0;
+};
+
+/**
+ * Decimates the triangles of a part down to `target` triangles. Vertices marked in `locked` are
+ * never moved or removed. The positions of the other vertices of the part are updated in
+ * `positions`, which is safe to do concurrently for parts that only share locked vertices.
+ */
+void decimatePart(Part& part, std::vector<dvec3>& positions,
+                  const std::vector<std::uint8_t>& locked, size_t target,
+                  const DecimationSettings& settings) {
+    auto& tris = part.triangles;
+    if (tris.size() <= target) return;
+
+    // Map the global vertex ids to a compact local range
+    std::vector<std::uint32_t> ids;
+    ids.reserve(tris.size() * 3);
+    for (const auto& tri : tris) {
+        ids.insert(ids.end(), {tri.v[0], tri.v[1], tri.v[2]});
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    const auto toLocal = [&](std::uint32_t id) {
+        return static_cast<std::uint32_t>(std::lower_bound(ids.begin(), ids.end(), id) -
+                                          ids.begin());
+    };
+
+    const auto nVertices = ids.size();
+    std::vector<dvec3> pos(nVertices);
+    std::vector<std::uint8_t> lock(nVertices);
+    for (size_t i = 0; i < nVertices; ++i) {
+        pos[i] = positions[ids[i]];
+        lock[i] = locked[ids[i]];
+    }
+
+    std::vector<glm::u32vec3> tv(tris.size());
+    std::vector<std::uint8_t> alive(tris.size(), 1);
+    std::vector<std::vector<std::uint32_t>> adj(nVertices);
+    for (std::uint32_t t = 0; t < tris.size(); ++t) {
+        for (int j = 0; j < 3; ++j) {
+            tv[t][j] = toLocal(tris[t].v[j]);
+            adj[tv[t][j]].push_back(t);
+        }
+    }
+
+    const auto normal = [&](std::uint32_t t) {
+        return glm::cross(pos[tv[t][1]] - pos[tv[t][0]], pos[tv[t][2]] - pos[tv[t][0]]);
+    };
+
+    std::vector<Quadric> quadrics(nVertices);
+    for (std::uint32_t t = 0; t < tris.size(); ++t) {
+        const auto n = normal(t);
+        const auto length = glm::length(n);
+        if (length == 0.0) continue;
+        const auto q =
+            Quadric::plane(n / length, -glm::dot(n / length, pos[tv[t][0]]), 0.5 * length);
+        for (int j = 0; j < 3; ++j) quadrics[tv[t][j]] += q;
+    }
+
+    // Sorted edge list, an edge that occurs only once is on the boundary
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> edges;
+    edges.reserve(tris.size() * 3);
+    for (std::uint32_t t = 0; t < tris.size(); ++t) {
+        for (int j = 0; j < 3; ++j) {
+            const std::uint64_t a = std::min(tv[t][j], tv[t][(j + 1) % 3]);
+            const std::uint64_t b = std::max(tv[t][j], tv[t][(j + 1) % 3]);
+            edges.emplace_back((a << 32) | b, t);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> uniqueEdges;
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i + 1;
+        while (j < edges.size() && edges[j].first == edges[i].first) ++j;
+        const auto a = static_cast<std::uint32_t>(edges[i].first >> 32);
+        const auto b = static_cast<std::uint32_t>(edges[i].first & 0xffffffff);
+        uniqueEdges.emplace_back(a, b);
+
+        // Edges between two locked vertices also include the seams between parts
+        if (j == i + 1 && !(lock[a] && lock[b])) {
+            if (settings.boundary == BoundaryHandling::Locked) {
+                lock[a] = 1;
+                lock[b] = 1;
+            } else {
+                const auto e = pos[b] - pos[a];
+                const auto m = glm::cross(e, normal(edges[i].second));
+                const auto length = glm::length(m);
+                if (length > 0.0) {
+                    const auto q = Quadric::plane(m / length, -glm::dot(m / length, pos[a]),
+                                                  settings.boundaryWeight * glm::dot(e, e));
+                    quadrics[a] += q;
+                    quadrics[b] += q;
+                }
+            }
+        }
+        i = j;
+    }
+    edges = {};
+
+    struct Plan {
+        std::uint32_t into;
+        std::uint32_t from;
+        dvec3 pos;
+        double cost;
+    };
+    const auto plan = [&](std::uint32_t u, std::uint32_t v) -> std::optional<Plan> {
+        if (lock[u] && lock[v]) return std::nullopt;
+        const auto q = quadrics[u] + quadrics[v];
+        if (lock[u]) return Plan{u, v, pos[u], q.error(pos[u])};
+        if (lock[v]) return Plan{v, u, pos[v], q.error(pos[v])};
+        if (auto p = q.optimum()) return Plan{u, v, *p, q.error(*p)};
+
+        Plan best{u, v, pos[u], q.error(pos[u])};
+        for (const auto& p : {pos[v], 0.5 * (pos[u] + pos[v])}) {
+            if (const auto cost = q.error(p); cost < best.cost) best = Plan{u, v, p, cost};
+        }
+        return best;
+    };
+
+    struct Candidate {
+        double cost;
+        double length2;  // Shorter edges first for equal cost, i.e. in flat regions
+        std::uint32_t u;
+        std::uint32_t v;
+        std::uint32_t stampU;
+        std::uint32_t stampV;
+        bool operator>(const Candidate& rhs) const {
+            return cost > rhs.cost || (cost == rhs.cost && length2 > rhs.length2);
+        }
+    };
+    std::vector<std::uint32_t> stamps(nVertices, 0);
+    std::vector<std::uint8_t> removed(nVertices, 0);
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> heap;
+    const auto push = [&](std::uint32_t u, std::uint32_t v) {
+        if (auto p = plan(u, v)) {
+            const auto e = pos[v] - pos[u];
+            heap.push({p->cost, glm::dot(e, e), u, v, stamps[u], stamps[v]});
+        }
+    };
+    for (auto [u, v] : uniqueEdges) push(u, v);
+    uniqueEdges = {};
+
+    const auto contains = [&](std::uint32_t t, std::uint32_t v) {
+        return tv[t][0] == v || tv[t][1] == v || tv[t][2] == v;
+    };
+    const auto neighbors = [&](std::uint32_t v, std::vector<std::uint32_t>& res) {
+        res.clear();
+        for (auto t : adj[v]) {
+            if (!alive[t]) continue;
+            for (int j = 0; j < 3; ++j) {
+                if (tv[t][j] != v) res.push_back(tv[t][j]);
+            }
+        }
+        std::sort(res.begin(), res.end());
+        res.erase(std::unique(res.begin(), res.end()), res.end());
+    };
+
+    // Ratio of the area to the sum of the squared edge lengths, 0.29 for an equilateral triangle
+    const auto quality = [](const dvec3& n, const std::array<dvec3, 3>& c) {
+        const auto e0 = c[1] - c[0];
+        const auto e1 = c[2] - c[1];
+        const auto e2 = c[0] - c[2];
+        const auto sum = glm::dot(e0, e0) + glm::dot(e1, e1) + glm::dot(e2, e2);
+        return sum > 0.0 ? glm::length(n) / sum : 0.0;
+    };
+    constexpr double minQuality = 0.02;
+
+    std::vector<std::uint32_t> ringA;
+    std::vector<std::uint32_t> ringB;
+    const auto allowed = [&](const Plan& p) {
+        // The link condition, the collapse must not make the surface non-manifold
+        size_t shared = 0;
+        for (auto t : adj[p.into]) {
+            if (alive[t] && contains(t, p.from)) ++shared;
+        }
+        if (shared == 0) return false;
+        neighbors(p.into, ringA);
+        neighbors(p.from, ringB);
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < ringA.size() && j < ringB.size();) {
+            if (ringA[i] < ringB[j]) {
+                ++i;
+            } else if (ringB[j] < ringA[i]) {
+                ++j;
+            } else {
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        if (common != shared) return false;
+
+        // No remaining triangle may flip, turn by more than about 75 degrees, or become a sliver
+        for (auto v : {p.into, p.from}) {
+            for (auto t : adj[v]) {
+                if (!alive[t] || (contains(t, p.into) && contains(t, p.from))) continue;
+                const auto before = normal(t);
+                if (glm::dot(before, before) == 0.0) continue;
+                std::array<dvec3, 3> c;
+                for (int j = 0; j < 3; ++j) c[j] = tv[t][j] == v ? p.pos : pos[tv[t][j]];
+                const auto after = glm::cross(c[1] - c[0], c[2] - c[0]);
+                if (glm::dot(before, after) <= 0.25 * glm::length(before) * glm::length(after)) {
+                    return false;
+                }
+                const auto worst = std::min(
+                    minQuality, quality(before, {pos[tv[t][0]], pos[tv[t][1]], pos[tv[t][2]]}));
+                if (quality(after, c) < worst) return false;
+            }
+        }
+        return true;
+    };
+
+    size_t count = tris.size();
+    while (count > target && !heap.empty()) {
+        const auto c = heap.top();
+        heap.pop();
+        if (removed[c.u] || removed[c.v] || stamps[c.u] != c.stampU || stamps[c.v] != c.stampV) {
+            continue;
+        }
+        if (c.cost > settings.maxError) break;
+        const auto p = plan(c.u, c.v);
+        if (!p || !allowed(*p)) continue;
+
+        const auto a = p->into;
+        const auto b = p->from;
+        const auto e = pos[b] - pos[a];
+        const auto l2 = glm::dot(e, e);
+        const auto t = l2 > 0.0 ? std::clamp(glm::dot(p->pos - pos[a], e) / l2, 0.0, 1.0) : 0.0;
+        part.collapses.push_back({ids[b], ids[a], t});
+
+        for (auto tri : adj[b]) {
+            if (!alive[tri]) continue;
+            if (contains(tri, a)) {
+                alive[tri] = 0;
+                --count;
+            } else {
+                for (int j = 0; j < 3; ++j) {
+                    if (tv[tri][j] == b) tv[tri][j] = a;
+                }
+                adj[a].push_back(tri);
+            }
+        }
+        adj[b] = {};
+        removed[b] = 1;
+        pos[a] = p->pos;
+        quadrics[a] += quadrics[b];
+        ++stamps[a];
+        adj[a].erase(std::remove_if(adj[a].begin(), adj[a].end(),
+                                    [&](std::uint32_t tri) { return !alive[tri]; }),
+                     adj[a].end());
+
+        neighbors(a, ringA);
+        for (auto w : ringA) push(a, w);
+    }
+
+    for (size_t i = 0; i < nVertices; ++i) {
+        if (!locked[ids[i]] && !removed[i]) positions[ids[i]] = pos[i];
+    }
+    std::vector<Triangle> res;
+    res.reserve(count);
+    for (size_t t = 0; t < tris.size(); ++t) {
+        if (alive[t]) res.push_back({{ids[tv[t][0]], ids[tv[t][1]], ids[tv[t][2]]}, tris[t].group});
+    }
+    tris = std::move(res);
+}
+
+/**
+ * Split the triangles into `count` parts of equal size along the longest axis and mark all
+ * vertices that are used by more than one part in `locked`.
+ */
+std::vector<Part> partition(std::vector<Triangle> triangles, const std::vector<dvec3>& positions,
+                            size_t count, std::vector<std::uint8_t>& locked) {
+    std::vector<Part> parts(std::max(count, size_t{1}));
+    if (parts.size() == 1) {
+        parts.front().triangles = std::move(triangles);
+        return parts;
+    }
+
+    dvec3 min{std::numeric_limits<double>::max()};
+    dvec3 max{std::numeric_limits<double>::lowest()};
+    for (const auto& p : positions) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    const auto extent = max - min;
+    const int axis =
+        extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+    std::vector<std::pair<double, std::uint32_t>> keys(triangles.size());
+    for (std::uint32_t t = 0; t < triangles.size(); ++t) {
+        const auto& v = triangles[t].v;
+        keys[t] = {positions[v[0]][axis] + positions[v[1]][axis] + positions[v[2]][axis], t};
+    }
+    const auto n = keys.size();
+    for (size_t i = 1; i < parts.size(); ++i) {
+        std::nth_element(keys.begin() + (n * (i - 1)) / parts.size(),
+                         keys.begin() + (n * i) / parts.size(), keys.end());
+    }
+
+    std::vector<std::int32_t> owner(positions.size(), -1);
+    for (size_t i = 0; i < parts.size(); ++i) {
+        auto& tris = parts[i].triangles;
+        tris.reserve((n * (i + 1)) / parts.size() - (n * i) / parts.size());
+        for (size_t k = (n * i) / parts.size(); k < (n * (i + 1)) / parts.size(); ++k) {
+            const auto& tri = triangles[keys[k].second];
+            tris.push_back(tri);
+            for (int j = 0; j < 3; ++j) {
+                auto& o = owner[tri.v[j]];
+                if (o == -1) {
+                    o = static_cast<std::int32_t>(i);
+                } else if (o != static_cast<std::int32_t>(i)) {
+                    locked[tri.v[j]] = 1;
+                }
+            }
+        }
+    }
+    return parts;
+}
+
+template <typename T>
+T interpolate(const T& a, const T& b, double t) {
+    if constexpr (std::is_floating_point_v<util::value_type_t<T>>) {
+        using D = util::same_extent_t<T, double>;
+        const auto da = util::glm_convert<D>(a);
+        const auto db = util::glm_convert<D>(b);
+        return util::glm_convert<T>(da + t * (db - da));
+    } else {
+        return t < 0.5 ? a : b;
+    }
+}
+
+std::shared_ptr<BufferBase> gatherAttribute(const BufferBase& buffer, BufferType type,
+                                            const std::vector<Collapse>& collapses,
+                                            const std::vector<std::uint32_t>& keep) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<std::shared_ptr<BufferBase>>(
+        [&](auto ram) -> std::shared_ptr<BufferBase> {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            auto data = ram->getDataContainer();
+            for (const auto& c : collapses) {
+                data[c.into] = interpolate(data[c.into], data[c.from], c.t);
+            }
+            std::vector<T> res(keep.size());
+            for (size_t i = 0; i < keep.size(); ++i) res[i] = data[keep[i]];
+
+            if constexpr (util::extent_v<T> == 3 &&
+                          std::is_floating_point_v<util::value_type_t<T>>) {
+                if (type == BufferType::NormalAttrib) {
+                    for (auto& n : res) {
+                        if (glm::dot(n, n) > 0) n = glm::normalize(n);
+                    }
+                }
+            }
+            auto repr = std::make_shared<BufferRAMPrecision<T>>(std::move(res),
+                                                                buffer.getBufferUsage());
+            return std::make_shared<Buffer<T>>(repr);
+        });
+}
+
+std::shared_ptr<BufferBase> gatherPositions(const BufferBase& buffer,
+                                            const std::vector<dvec3>& positions,
+                                            const std::vector<std::uint32_t>& keep) {
+    return buffer.getRepresentation<BufferRAM>()
+        ->dispatch<std::shared_ptr<BufferBase>, dispatching::filter::Vecs>(
+            [&](auto ram) -> std::shared_ptr<BufferBase> {
+                using T = util::PrecisionValueType<decltype(ram)>;
+                using V = util::value_type_t<T>;
+                const auto& data = ram->getDataContainer();
+                std::vector<T> res(keep.size());
+                for (size_t i = 0; i < keep.size(); ++i) {
+                    // Only replace xyz, to keep for example the w component of vec4 positions
+                    auto value = data[keep[i]];
+                    constexpr auto n =
+                        static_cast<glm::length_t>(std::min(util::extent_v<T>, size_t{3}));
+                    for (glm::length_t j = 0; j < n; ++j) {
+                        value[j] = static_cast<V>(positions[keep[i]][j]);
+                    }
+                    res[i] = value;
+                }
+                auto repr = std::make_shared<BufferRAMPrecision<T>>(std::move(res),
+                                                                    buffer.getBufferUsage());
+                return std::make_shared<Buffer<T>>(repr);
+            });
+}
+
+}  // namespace
+
+size_t countTriangles(const Mesh& mesh) {
+    size_t count = 0;
+    if (mesh.getIndexBuffers().empty()) {
+        const auto info = mesh.getDefaultMeshInfo();
+        if (info.dt == DrawType::Triangles && info.ct == ConnectivityType::None &&
+            !mesh.getBuffers().empty()) {
+            count = mesh.getBuffers().front().second->getSize() / 3;
+        }
+    }
+    for (const auto& [info, indices] : mesh.getIndexBuffers()) {
+        if (info.dt != DrawType::Triangles) continue;
+        forEachTriangle(info, *indices, [&](std::uint32_t, std::uint32_t, std::uint32_t) {
+            ++count;
+        });
+    }
+    return count;
+}
+
+std::shared_ptr<Mesh> decimate(const Mesh& mesh, const DecimationSettings& settings) {
+    // Points and lines only, nothing to decimate
+    if (countTriangles(mesh) == 0) return std::shared_ptr<Mesh>(mesh.clone());
+
+    const auto posIt = util::find_if(mesh.getBuffers(), [](const auto& buf) {
+        return buf.first.type == BufferType::PositionAttrib;
+    });
+    if (posIt == mesh.getBuffers().end()) {
+        throw Exception("Error: could not find a position buffer",
+                        IVW_CONTEXT_CUSTOM("meshutil::decimate"));
+    }
+    auto positions =
+        posIt->second->getRepresentation<BufferRAM>()
+            ->dispatch<std::vector<dvec3>, dispatching::filter::Vecs>([](auto ram) {
+                const auto& data = ram->getDataContainer();
+                std::vector<dvec3> res(data.size());
+                std::transform(data.begin(), data.end(), res.begin(),
+                               [](const auto& p) { return util::glm_convert<dvec3>(p); });
+                return res;
+            });
+
+    // Triangles of all triangle index buffers, vertices used by other primitives are locked
+    std::vector<Triangle> triangles;
+    std::vector<std::uint8_t> locked(positions.size(), 0);
+    const auto addTriangle = [&](std::uint32_t group) {
+        return [&triangles, group](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+            if (a != b && b != c && c != a) triangles.push_back({{a, b, c}, group});
+        };
+    };
+
+    Mesh::IndexVector indexBuffers = mesh.getIndexBuffers();
+    if (indexBuffers.empty() && mesh.getDefaultMeshInfo().dt == DrawType::Triangles &&
+        mesh.getDefaultMeshInfo().ct == ConnectivityType::None) {
+        std::vector<std::uint32_t> implicit(positions.size() - positions.size() % 3);
+        std::iota(implicit.begin(), implicit.end(), 0);
+        indexBuffers.emplace_back(mesh.getDefaultMeshInfo(),
+                                  util::makeIndexBuffer(std::move(implicit)));
+    }
+    for (size_t i = 0; i < indexBuffers.size(); ++i) {
+        const auto& [info, indices] = indexBuffers[i];
+        if (info.dt == DrawType::Triangles) {
+            forEachTriangle(info, *indices, addTriangle(static_cast<std::uint32_t>(i)));
+        } else {
+            for (auto v : indices->getRAMRepresentation()->getDataContainer()) locked[v] = 1;
+        }
+    }
+
+    const auto target = std::min(settings.targetTriangles, triangles.size());
+    std::vector<Collapse> collapses;
+
+    // Partitioned pass, only worth it for large meshes. The parts leave some of the reduction
+    // to the final pass, which has to move the vertices along the seams.
+    constexpr size_t minPartSize = 16384;
+    const auto nParts =
+        std::min(settings.partitions == 0 ? std::max(util::getPoolSize(), size_t{1})
+                                          : settings.partitions,
+                 triangles.size() / minPartSize);
+    if (nParts > 1 && triangles.size() > target) {
+        auto shared = locked;
+        auto parts = partition(std::move(triangles), positions, nParts, shared);
+        const auto total = static_cast<double>(target + target / 4);
+        const auto n = static_cast<double>(std::accumulate(
+            parts.begin(), parts.end(), size_t{0},
+            [](size_t sum, const Part& p) { return sum + p.triangles.size(); }));
+        util::forEachIndexParallel(parts.size(), [&](size_t i) {
+            const auto partTarget =
+                static_cast<size_t>(total * static_cast<double>(parts[i].triangles.size()) / n);
+            decimatePart(parts[i], positions, shared, partTarget, settings);
+        });
+        triangles.clear();
+        for (auto& part : parts) {
+            triangles.insert(triangles.end(), part.triangles.begin(), part.triangles.end());
+            collapses.insert(collapses.end(), part.collapses.begin(), part.collapses.end());
+        }
+    }
+
+    // Final pass over the whole mesh, this also removes the seams between the parts
+    if (triangles.size() > target) {
+        Part whole{std::move(triangles), {}};
+        decimatePart(whole, positions, locked, target, settings);
+        triangles = std::move(whole.triangles);
+        collapses.insert(collapses.end(), whole.collapses.begin(), whole.collapses.end());
+    }
+
+    // Compact the vertices
+    std::vector<std::uint32_t> remap(positions.size(), std::numeric_limits<std::uint32_t>::max());
+    std::vector<std::uint32_t> keep;
+    const auto use = [&](std::uint32_t v) {
+        if (remap[v] == std::numeric_limits<std::uint32_t>::max()) {
+            remap[v] = static_cast<std::uint32_t>(keep.size());
+            keep.push_back(v);
+        }
+        return remap[v];
+    };
+    std::vector<std::vector<std::uint32_t>> triangleIndices(indexBuffers.size());
+    for (const auto& tri : triangles) {
+        auto& ib = triangleIndices[tri.group];
+        ib.insert(ib.end(), {use(tri.v[0]), use(tri.v[1]), use(tri.v[2])});
+    }
+
+    auto res = std::make_shared<Mesh>(mesh.getDefaultMeshInfo());
+    res->copyMetaDataFrom(mesh);
+    res->setModelMatrix(mesh.getModelMatrix());
+    res->setWorldMatrix(mesh.getWorldMatrix());
+
+    for (size_t i = 0; i < indexBuffers.size(); ++i) {
+        const auto& [info, indices] = indexBuffers[i];
+        if (info.dt == DrawType::Triangles) {
+            res->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                            util::makeIndexBuffer(std::move(triangleIndices[i])));
+        } else {
+            auto data = indices->getRAMRepresentation()->getDataContainer();
+            for (auto& v : data) v = use(v);
+            res->addIndices(info, util::makeIndexBuffer(std::move(data)));
+        }
+    }
+
+    for (const auto& [info, buffer] : mesh.getBuffers()) {
+        if (buffer == posIt->second) {
+            res->addBuffer(info, gatherPositions(*buffer, positions, keep));
+        } else {
+            res->addBuffer(info, gatherAttribute(*buffer, info.type, collapses, keep));
+        }
+    }
+    return res;
+}
+
+std::vector<std::shared_ptr<Mesh>> generateLods(const Mesh& mesh, size_t levels, double ratio,
+                                                DecimationSettings settings) {
+    std::vector<std::shared_ptr<Mesh>> lods;
+    const Mesh* current = &mesh;
+    size_t count = countTriangles(mesh);
+    for (size_t level = 0; level < levels; ++level) {
+        settings.targetTriangles = static_cast<size_t>(static_cast<double>(count) * ratio);
+        auto lod = decimate(*current, settings);
+        const auto lodCount = countTriangles(*lod);
+        if (lodCount >= count) break;
+        count = lodCount;
+        lods.push_back(lod);
+        current = lods.back().get();
+        if (count == 0) break;
+    }
+    return lods;
+}
+
+}  // namespace meshutil
+
+}  // namespace inviwo
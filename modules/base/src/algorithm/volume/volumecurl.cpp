@@ -29,32 +29,26 @@
 
 #include <modules/base/algorithm/volume/volumecurl.h>
 
+#include <modules/base/algorithm/volume/volumestencil.h>  // for forEachCentralDifference
+
 #include <inviwo/core/datastructures/coordinatetransformer.h>           // for StructuredCoordin...
 #include <inviwo/core/datastructures/data.h>                            // for noData
 #include <inviwo/core/datastructures/datamapper.h>                      // for DataMapper
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/representationpool.h>              // for makePooledReprese...
+#include <inviwo/core/datastructures/unitsystem.h>                      // for Axis, Unit
 #include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAMPrecision
 #include <inviwo/core/util/formatdispatching.h>                         // for PrecisionValueType
 #include <inviwo/core/util/glmutils.h>                                  // for Vector
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, size3_t, dvec2
-#include <inviwo/core/util/indexmapper.h>                               // for IndexMapper, Inde...
-#include <inviwo/core/util/templatesampler.h>                           // for TemplateVolumeSam...
-#include <inviwo/core/util/volumeramutils.h>                            // for forEachVoxel
 
-#include <stdlib.h>       // for abs
-#include <algorithm>      // for max, min
+#include <algorithm>      // for max
 #include <cmath>          // for abs
-#include <limits>         // for numeric_limits
-#include <type_traits>    // for conditional_t
+#include <cstddef>        // for size_t
 #include <unordered_set>  // for unordered_set
 
-#include <glm/common.hpp>  // for mix
-#include <glm/mat4x4.hpp>  // for operator*, mat
-#include <glm/vec3.hpp>    // for operator/, operator*
-#include <glm/vec4.hpp>    // for operator*, operator+
-
 namespace inviwo {
 namespace util {
 
@@ -64,61 +58,32 @@ std::unique_ptr<Volume> curlVolume(std::shared_ptr<const Volume> volume) {
 
 std::unique_ptr<Volume> curlVolume(const Volume& volume) {
     auto newVolume = std::make_unique<Volume>(volume, noData);
-    auto newVolumeRep = std::make_shared<VolumeRAMPrecision<vec3>>(volume.getDimensions());
+    auto newVolumeRep =
+        util::makePooledRepresentation<VolumeRAMPrecision<vec3>>(volume.getDimensions());
     newVolume->addRepresentation(newVolumeRep);
 
-    const auto m = newVolume->getCoordinateTransformer().getDataToWorldMatrix();
-
-    const auto a = m * vec4(0, 0, 0, 1);
-    const auto b = m * vec4(1.0f / vec3(volume.getDimensions() - size3_t(1)), 1);
-    const auto spacing = b - a;
-
-    const vec3 ox(spacing.x, 0, 0);
-    const vec3 oy(0, spacing.y, 0);
-    const vec3 oz(0, 0, spacing.z);
-
-    volume.getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Vec3s>([&](auto
-                                                                                              vol) {
-        using ValueType = util::PrecisionValueType<decltype(vol)>;
-        using ComponentType = typename ValueType::value_type;
-        using FloatType =
-            typename std::conditional_t<std::is_same<float, ComponentType>::value, float, double>;
-        using Sampler = TemplateVolumeSampler<ValueType, FloatType>;
-
-        util::IndexMapper3D index(volume.getDimensions());
-        auto data = newVolumeRep->getDataTyped();
-        float minV = std::numeric_limits<float>::max();
-        float maxV = std::numeric_limits<float>::lowest();
-
-        const auto worldSpace = Sampler::Space::World;
-        const Sampler sampler(volume, worldSpace);
-
-        util::forEachVoxel(*vol, [&](const size3_t& pos) {
-            const vec3 world{m * vec4(vec3(pos) / vec3(volume.getDimensions() - size3_t(1)), 1)};
-
-            const auto Fxp = static_cast<vec3>(sampler.sample(world + ox));
-            const auto Fxm = static_cast<vec3>(sampler.sample(world - ox));
-            const auto Fyp = static_cast<vec3>(sampler.sample(world + oy));
-            const auto Fym = static_cast<vec3>(sampler.sample(world - oy));
-            const auto Fzp = static_cast<vec3>(sampler.sample(world + oz));
-            const auto Fzm = static_cast<vec3>(sampler.sample(world - oz));
-
-            const vec3 Fx = (Fxp - Fxm) / (2.0f * spacing.x);
-            const vec3 Fy = (Fyp - Fym) / (2.0f * spacing.y);
-            const vec3 Fz = (Fzp - Fzm) / (2.0f * spacing.z);
-
-            const vec3 c{Fy.z - Fz.y, Fz.x - Fx.z, Fx.y - Fy.x};
-
-            minV = std::min({minV, c.x, c.y, c.z});
-            maxV = std::max({maxV, c.x, c.y, c.z});
-
-            data[index(pos)] = c;
+    const StencilTransform transform{volume.getCoordinateTransformer().getIndexToWorldMatrix()};
+    auto data = newVolumeRep->getDataTyped();
+
+    const auto* ram = volume.getRepresentation<VolumeRAM>();
+    const auto minMax =
+        ram->dispatch<StencilMinMax<float>, dispatching::filter::Vec3s>([&](auto vol) {
+            using ValueType = util::PrecisionValueType<decltype(vol)>;
+            const auto fetch = [](const ValueType& v) { return static_cast<vec3>(v); };
+
+            return util::forEachCentralDifference(
+                vol->getDataTyped(), vol->getDimensions(), fetch, StencilMinMax<float>{},
+                [&](StencilMinMax<float>& state, size_t i, const CentralDifferences<vec3>& diff) {
+                    const auto [Fx, Fy, Fz] = transform.derivatives(diff.d);
+                    const vec3 c{Fy.z - Fz.y, Fz.x - Fx.z, Fx.y - Fy.x};
+                    data[i] = c;
+                    state.update(c);
+                });
         });
 
-        auto range = std::max(std::abs(minV), std::abs(maxV));
-        newVolume->dataMap_.dataRange = dvec2(-range, range);
-        newVolume->dataMap_.valueRange = dvec2(minV, maxV);
-    });
+    const auto range = std::max(std::abs(minMax.min), std::abs(minMax.max));
+    newVolume->dataMap_.dataRange = dvec2(-range, range);
+    newVolume->dataMap_.valueRange = dvec2(minMax.min, minMax.max);
 
     return newVolume;
 }
@@ -29,83 +29,71 @@
 
 #include <modules/base/algorithm/volume/volumegradient.h>
 
+#include <modules/base/algorithm/volume/volumestencil.h>  // for forEachCentralDifference
+
 #include <inviwo/core/datastructures/coordinatetransformer.h>           // for StructuredCoordin...
 #include <inviwo/core/datastructures/data.h>                            // for noData
 #include <inviwo/core/datastructures/datamapper.h>                      // for DataMapper
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/representationpool.h>              // for makePooledReprese...
 #include <inviwo/core/datastructures/unitsystem.h>                      // for Axis, Unit
 #include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAMPrecision
+#include <inviwo/core/util/exception.h>                                 // for Exception
+#include <inviwo/core/util/formatdispatching.h>                         // for PrecisionValueType
+#include <inviwo/core/util/formats.h>                                   // for DataFormatBase
+#include <inviwo/core/util/glmcomp.h>                                   // for glmcomp
 #include <inviwo/core/util/glmutils.h>                                  // for Vector
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, size3_t, dvec2
-#include <inviwo/core/util/indexmapper.h>                               // for IndexMapper3D
-#include <inviwo/core/util/spatialsampler.h>                            // for SpatialSampler<>:...
-#include <inviwo/core/util/volumeramutils.h>                            // for forEachVoxelParallel
-#include <inviwo/core/util/volumesampler.h>                             // for VolumeDoubleSampler
 
-#include <array>          // for array
+#include <cstddef>        // for size_t
 #include <functional>     // for __base
-#include <limits>         // for numeric_limits
 #include <string>         // for string
 #include <type_traits>    // for remove_extent_t
 #include <unordered_set>  // for unordered_set
-#include <vector>         // for vector
 
-#include <glm/common.hpp>              // for mix, max, abs
+#include <glm/common.hpp>              // for abs
 #include <glm/gtx/component_wise.hpp>  // for compMax
-#include <glm/mat4x4.hpp>              // for operator*, mat
-#include <glm/vec3.hpp>                // for operator-, operator/
-#include <glm/vec4.hpp>                // for operator*, operator+
 
 namespace inviwo {
 namespace util {
 
 std::shared_ptr<Volume> gradientVolume(std::shared_ptr<const Volume> volume, int channel) {
+    const auto components = volume->getDataFormat()->getComponents();
+    if (channel < 0 || static_cast<size_t>(channel) >= components) {
+        throw Exception(IVW_CONTEXT_CUSTOM("util::gradientVolume"),
+                        "Invalid channel {}, the volume has {} channels", channel, components);
+    }
 
     auto newVolume = std::make_unique<Volume>(*volume, noData);
-    auto newVolumeRep = std::make_shared<VolumeRAMPrecision<vec3>>(volume->getDimensions());
+    auto newVolumeRep =
+        util::makePooledRepresentation<VolumeRAMPrecision<vec3>>(volume->getDimensions());
     newVolume->addRepresentation(newVolumeRep);
     newVolume->dataMap_.valueAxis.name = "gradient";
     newVolume->dataMap_.valueAxis.unit = volume->dataMap_.valueAxis.unit / volume->axes[0].unit;
 
-    auto m = newVolume->getCoordinateTransformer().getDataToWorldMatrix();
-
-    const auto a = m * vec4(0, 0, 0, 1);
-    const auto b = m * vec4(1.0f / vec3(volume->getDimensions() - size3_t(1)), 1);
-    const auto spacing = b - a;
-
-    const vec3 ox(spacing.x, 0, 0);
-    const vec3 oy(0, spacing.y, 0);
-    const vec3 oz(0, 0, spacing.z);
-
-    VolumeDoubleSampler<4> sampler(volume);
-    const auto worldSpace = VolumeDoubleSampler<3>::Space::World;
-
-    util::IndexMapper3D index(volume->getDimensions());
+    const StencilTransform transform{volume->getCoordinateTransformer().getIndexToWorldMatrix()};
     auto data = newVolumeRep->getDataTyped();
 
-    float max = std::numeric_limits<float>::lowest();
-    auto func = [&](const size3_t& pos) {
-        const vec3 world{m * vec4(vec3(pos) / vec3(volume->getDimensions() - size3_t(1)), 1)};
-
-        vec3 g;
-        g.x = static_cast<float>((sampler.sample(world + ox, worldSpace) -
-                                  sampler.sample(world - ox, worldSpace))[channel] /
-                                 (2.0 * spacing.x));
-        g.y = static_cast<float>((sampler.sample(world + oy, worldSpace) -
-                                  sampler.sample(world - oy, worldSpace))[channel] /
-                                 (2.0 * spacing.y));
-        g.z = static_cast<float>((sampler.sample(world + oz, worldSpace) -
-                                  sampler.sample(world - oz, worldSpace))[channel] /
-                                 (2.0 * spacing.z));
-        data[index(pos)] = g;
-
-        max = glm::max(max, glm::compMax(glm::abs(g)));
-    };
-
-    util::forEachVoxelParallel(*volume->getRepresentation<VolumeRAM>(), func);
-
+    const auto minMax = volume->getRepresentation<VolumeRAM>()->dispatch<StencilMinMax<float>>(
+        [&](auto vol) {
+            using ValueType = util::PrecisionValueType<decltype(vol)>;
+            const auto fetch = [c = static_cast<size_t>(channel)](const ValueType& v) {
+                return static_cast<float>(util::glmcomp(v, c));
+            };
+
+            return util::forEachCentralDifference(
+                vol->getDataTyped(), vol->getDimensions(), fetch, StencilMinMax<float>{},
+                [&](StencilMinMax<float>& state, size_t i, const CentralDifferences<float>& diff) {
+                    const auto d = transform.derivatives(diff.d);
+                    const vec3 g{d[0], d[1], d[2]};
+                    data[i] = g;
+                    state.update(glm::compMax(glm::abs(g)));
+                });
+        });
+
+    const auto max = minMax.max;
     newVolume->dataMap_.dataRange = dvec2(-max, max);
     newVolume->dataMap_.valueRange = dvec2(-max, max);
 
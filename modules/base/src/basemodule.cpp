@@ -89,6 +89,7 @@
 #include <modules/base/processors/meshcolorfromnormals.h>                    // for MeshColorFro...
 #include <modules/base/processors/meshconverterprocessor.h>                  // for MeshConverte...
 #include <modules/base/processors/meshcreator.h>                             // for MeshCreator
+#include <modules/base/processors/meshdecimation.h>                          // for MeshDecimation
 #include <modules/base/processors/meshexport.h>                              // for MeshExport
 #include <modules/base/processors/meshinformation.h>                         // for MeshInformation
 #include <modules/base/processors/meshmapping.h>                             // for MeshMapping
@@ -198,6 +199,7 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<MeshClipping>();
     registerProcessor<MeshColorFromNormals>();
     registerProcessor<MeshCreator>();
+    registerProcessor<MeshDecimation>();
     registerProcessor<MeshInformation>();
     registerProcessor<MeshMapping>();
     registerProcessor<MeshPlaneClipping>();
@@ -40,7 +40,9 @@
 #include <inviwo/core/processors/processorinfo.h>                       // for ProcessorInfo
 #include <inviwo/core/processors/processorstate.h>                      // for CodeState, CodeSt...
 #include <inviwo/core/processors/processortags.h>                       // for Tags, Tags::CPU
+#include <inviwo/core/properties/boolproperty.h>                        // for BoolProperty
 #include <inviwo/core/properties/constraintbehavior.h>                  // for ConstraintBehavior
+#include <inviwo/core/properties/isovalueproperty.h>                    // for IsoValueProperty
 #include <inviwo/core/properties/ordinalproperty.h>                     // for IntSizeTProperty
 #include <inviwo/core/util/formats.h>                                   // for DataFormatBase
 #include <inviwo/core/util/glmvec.h>                                    // for vec4
@@ -61,8 +63,11 @@ const ProcessorInfo ImageContourProcessor::processorInfo_{
     "Image Processing",                  // Category
     CodeState::Experimental,             // Code state
     Tags::CPU,                           // Tags
-    R"(Extracts a contour line for a specific value in the image using marching squares.
-    The output contour is provided as a line mesh.)"_unindentHelp};
+    R"(Extracts contour lines for one or several values in the image using marching squares.
+    The output contours are provided as a line mesh with one index buffer of line segments per
+    isovalue. Each contour is stitched into a polyline of shared vertices. The isovalue of each
+    vertex is stored in a scalar meta buffer and the id of its polyline in an index attribute
+    buffer.)"_unindentHelp};
 
 const ProcessorInfo ImageContourProcessor::getProcessorInfo() const { return processorInfo_; }
 
@@ -74,10 +79,21 @@ ImageContourProcessor::ImageContourProcessor()
                {0, ConstraintBehavior::Immutable}, {4, ConstraintBehavior::Editable})
     , isoValue_("iso", "ISO Value", "The contour iso value"_help, 0.5,
                 {0, ConstraintBehavior::Ignore}, {1, ConstraintBehavior::Ignore})
-    , color_("color", "Color", util::ordinalColor(vec4(1.0)).set("The contour color"_help)) {
+    , color_("color", "Color", util::ordinalColor(vec4(1.0)).set("The contour color"_help))
+    , multiple_("multiple", "Multiple Iso Values",
+                "Extract a contour for each iso value of the iso value collection instead of a "
+                "single iso value"_help,
+                false)
+    , isoValues_("isoValues", "Iso Values",
+                 "Iso values and colors of the contours when multiple iso values are "
+                 "used"_help) {
 
     addPorts(image_, mesh_);
-    addProperties(channel_, isoValue_, color_);
+    addProperties(channel_, isoValue_, color_, multiple_, isoValues_);
+
+    isoValue_.visibilityDependsOn(multiple_, [](const auto& p) { return !p.get(); });
+    color_.visibilityDependsOn(multiple_, [](const auto& p) { return !p.get(); });
+    isoValues_.visibilityDependsOn(multiple_, [](const auto& p) { return p.get(); });
 }
 
 void ImageContourProcessor::process() {
@@ -85,9 +101,12 @@ void ImageContourProcessor::process() {
         auto max = image_.getData()->getDataFormat()->getComponents() - 1;
         channel_.setMaxValue(max);
     }
-    mesh_.setData(
-        ImageContour::apply(image_.getData()->getColorLayer()->getRepresentation<LayerRAM>(),
-                            channel_, isoValue_, color_));
+    const auto* layer = image_.getData()->getColorLayer()->getRepresentation<LayerRAM>();
+    if (multiple_) {
+        mesh_.setData(ImageContour::apply(layer, channel_, isoValues_.get()));
+    } else {
+        mesh_.setData(ImageContour::apply(layer, channel_, isoValue_, color_));
+    }
 }
 
 }  // namespace inviwo
@@ -49,6 +49,7 @@
 #include <inviwo/core/properties/property.h>                            // for OverwriteState
 #include <inviwo/core/util/exception.h>                                 // for Exception
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexPar...
 #include <inviwo/core/util/formatdispatching.h>                         // for PrecisionValueType
 #include <inviwo/core/util/formats.h>                                   // for DataFormat, DataF...
 #include <inviwo/core/util/glmconvert.h>                                // for glm_convert_norma...
@@ -57,7 +58,6 @@
 #include <inviwo/core/util/raiiutils.h>                                 // for OnScopeExit, OnSc...
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT
 #include <inviwo/core/util/statecoordinator.h>                          // for StateCoordinator
-#include <inviwo/core/util/zip.h>                                       // for zipper, enumerate
 #include <modules/base/properties/basisproperty.h>                      // for BasisProperty
 #include <modules/base/properties/volumeinformationproperty.h>          // for VolumeInformation...
 
@@ -238,19 +238,19 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                 }
             };
 
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second.get();
+            // The slices are independent, decode them in parallel directly into the volume
+            util::forEachIndexParallel(slices.size(), [&](size_t slice) {
+                const auto& file = slices[slice].first;
+                const auto reader = slices[slice].second.get();
                 if (!reader) {
                     fill(slice);
-                    continue;
+                    return;
                 }
 
                 const auto layer = read(file, reader);
                 if (!layer) {
                     fill(slice);
-                    continue;
+                    return;
                 }
                 const auto layerRAM = layer->template getRepresentation<LayerRAM>();
 
@@ -260,7 +260,7 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                     LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
                                                  format->getPrecision(), file));
                     fill(slice);
-                    continue;
+                    return;
                 }
 
                 if (layerRAM->getDimensions() != layerDims) {
@@ -268,7 +268,7 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                         fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
                                     layer->getDimensions(), layerDims, file));
                     fill(slice);
-                    continue;
+                    return;
                 }
                 layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
                     const auto data = layerpr->getDataTyped();
@@ -276,7 +276,7 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                         data, data + sliceOffset, volData + slice * sliceOffset,
                         [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
                 });
-            }
+            });
 
             auto volume = std::make_shared<Volume>(volumeRAM);
             volume->dataMap_.dataRange =
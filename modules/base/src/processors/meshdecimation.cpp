@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/meshdecimation.h>
+
+#include <inviwo/core/datastructures/geometry/mesh.h>    // for Mesh
+#include <inviwo/core/ports/dataoutport.h>               // for DataOutport
+#include <inviwo/core/ports/meshport.h>                  // for MeshInport, MeshOutport
+#include <inviwo/core/processors/poolprocessor.h>        // for PoolProcessor
+#include <inviwo/core/processors/processorinfo.h>        // for ProcessorInfo
+#include <inviwo/core/processors/processorstate.h>       // for CodeState, CodeState::Experi...
+#include <inviwo/core/processors/processortags.h>        // for Tags, Tags::CPU
+#include <inviwo/core/properties/compositeproperty.h>    // for CompositeProperty
+#include <inviwo/core/properties/optionproperty.h>       // for OptionPropertyOption, OptionP...
+#include <inviwo/core/properties/ordinalproperty.h>      // for FloatProperty, IntSizeTProperty
+#include <modules/base/algorithm/mesh/meshdecimation.h>  // for decimate, generateLods, Decim...
+
+#include <limits>   // for numeric_limits
+#include <utility>  // for move, pair
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo MeshDecimation::processorInfo_{
+    "org.inviwo.MeshDecimation",  // Class identifier
+    "Mesh Decimation",            // Display name
+    "Mesh Operation",             // Category
+    CodeState::Experimental,      // Code state
+    Tags::CPU,                    // Tags
+};
+const ProcessorInfo MeshDecimation::getProcessorInfo() const { return processorInfo_; }
+
+MeshDecimation::MeshDecimation()
+    : PoolProcessor()
+    , inport_("inport")
+    , outport_("outport")
+    , lods_("lods")
+    , ratio_("ratio", "Target Ratio", 0.5f, 0.0f, 1.0f, 0.01f)
+    , maxError_("maxError", "Max Error", 0.0f, 0.0f, 1.0f, 0.0001f)
+    , boundary_("boundary", "Boundary",
+                {{"weighted", "Weighted", meshutil::BoundaryHandling::Weighted},
+                 {"locked", "Locked", meshutil::BoundaryHandling::Locked}},
+                0)
+    , boundaryWeight_("boundaryWeight", "Boundary Weight", 100.0f, 0.0f, 1000.0f, 1.0f)
+    , partitions_("partitions", "Partitions", 0, 0, 256)
+    , lod_("lod", "Levels of Detail")
+    , lodLevels_("levels", "Levels", 3, 0, 16)
+    , lodRatio_("levelRatio", "Level Ratio", 0.5f, 0.01f, 0.99f, 0.01f) {
+
+    addPort(inport_);
+    addPort(outport_);
+    addPort(lods_);
+
+    lod_.addProperties(lodLevels_, lodRatio_);
+    addProperties(ratio_, maxError_, boundary_, boundaryWeight_, partitions_, lod_);
+
+    boundaryWeight_.visibilityDependsOn(
+        boundary_, [](const auto& p) { return p == meshutil::BoundaryHandling::Weighted; });
+}
+
+void MeshDecimation::process() {
+    meshutil::DecimationSettings settings;
+    settings.maxError =
+        maxError_.get() > 0.0f ? maxError_.get() : std::numeric_limits<double>::infinity();
+    settings.boundary = boundary_.get();
+    settings.boundaryWeight = boundaryWeight_.get();
+    settings.partitions = partitions_.get();
+
+    using Lods = std::vector<std::shared_ptr<Mesh>>;
+    using Result = std::pair<std::shared_ptr<const Mesh>, std::shared_ptr<Lods>>;
+
+    outport_.clear();
+    lods_.clear();
+    dispatchOne(
+        [mesh = inport_.getData(), settings, ratio = ratio_.get(), levels = lodLevels_.get(),
+         lodRatio = lodRatio_.get()]() mutable -> Result {
+            std::shared_ptr<const Mesh> result = mesh;
+            if (ratio < 1.0f) {
+                const auto count = meshutil::countTriangles(*mesh);
+                settings.targetTriangles =
+                    static_cast<size_t>(static_cast<double>(count) * ratio);
+                result = meshutil::decimate(*mesh, settings);
+            }
+            auto lods = std::make_shared<Lods>(
+                meshutil::generateLods(*result, levels, lodRatio, settings));
+            return {std::move(result), std::move(lods)};
+        },
+        [this](Result result) {
+            outport_.setData(result.first);
+            lods_.setData(result.second);
+            newResults();
+        });
+}
+
+}  // namespace inviwo
@@ -46,24 +46,22 @@
 #include <inviwo/core/properties/propertysemantics.h>                   // for PropertySemantics
 #include <inviwo/core/properties/stringproperty.h>                      // for StringProperty
 #include <inviwo/core/properties/valuewrapper.h>                        // for PropertySerializa...
+#include <inviwo/core/util/dataformatconversion.h>                      // for convertVolumeRAM
 #include <inviwo/core/util/foreacharg.h>                                // for for_each_type
-#include <inviwo/core/util/formatdispatching.h>                         // for dispatch, Precisi...
 #include <inviwo/core/util/formats.h>                                   // for DataFormatBase
-#include <inviwo/core/util/glmutils.h>                                  // for same_extent
 #include <inviwo/core/util/glmvec.h>                                    // for dvec2
 #include <inviwo/core/util/staticstring.h>                              // for operator+
 #include <modules/base/properties/datarangeproperty.h>                  // for DataRangeProperty
 
-#include <algorithm>      // for transform
 #include <limits>         // for numeric_limits
 #include <memory>         // for shared_ptr, share...
+#include <optional>       // for optional
 #include <tuple>          // for tuple
 #include <type_traits>    // for remove_extent_t
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for pair
 
-#include <glm/gtx/component_wise.hpp>  // for compMul
-#include <glm/vec2.hpp>                // for vec<>::(anonymous)
+#include <glm/vec2.hpp>  // for vec<>::(anonymous)
 
 namespace inviwo {
 
@@ -76,55 +74,6 @@ struct Helper {
     }
 };
 
-#include <warn/push>
-#include <warn/ignore/conversion>
-
-struct CopyVol {
-    template <typename Result, typename Format>
-    Result operator()(std::shared_ptr<const Volume> src, bool mapData, dvec2 dstRange) {
-        return src->getRepresentation<VolumeRAM>()->dispatch<std::shared_ptr<Volume>>(
-            [&](auto vrprecision, bool mapData, dvec2 dstRange) {
-                using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
-                const auto dims = vrprecision->getDimensions();
-                const ValueType* srcData = vrprecision->getDataTyped();
-                using T = typename util::same_extent<ValueType, typename Format::type>::type;
-                using Tdouble = typename util::same_extent<ValueType, double>::type;
-
-                auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(
-                    dims, src->getSwizzleMask(), src->getInterpolation(), src->getWrapping());
-                T* dstData = dstVol->getDataTyped();
-
-                if (mapData) {
-                    const dvec2 srcRange{
-                        (src->getDataFormat()->getNumericType() != NumericType::Float)
-                            ? src->dataMap_.dataRange
-                            : dvec2{0.0, 1.0}};
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [srcRange, dstRange](auto& v) {
-                                       const auto result = (static_cast<Tdouble>(v) - srcRange.x) /
-                                                               (srcRange.y - srcRange.x) *
-                                                               (dstRange.y - dstRange.x) +
-                                                           dstRange.x;
-                                       return static_cast<T>(result);
-                                   });
-                } else {
-                    std::transform(srcData, srcData + glm::compMul(dims), dstData,
-                                   [](auto& v) { return static_cast<T>(v); });
-                }
-
-                auto vol = std::make_shared<Volume>(dstVol);
-                vol->setBasis(src->getBasis());
-                vol->setOffset(src->getOffset());
-                vol->copyMetaDataFrom(*src.get());
-
-                return vol;
-            },
-            mapData, dstRange);
-    }
-};
-
-#include <warn/pop>
-
 }  // namespace detail
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -220,13 +169,31 @@ void VolumeConverter::process() {
     }();
 
     auto volume = [&]() {
-        if (inport_.getData()->getDataFormat()->getId() == format_.get()) {
-            return std::shared_ptr<Volume>(inport_.getData()->clone());
-        } else {
-            return dispatching::dispatch<std::shared_ptr<Volume>, dispatching::filter::Scalars>(
-                format_.get(), detail::CopyVol{}, inport_.getData(), enableDataMapping_,
-                dstRange.first);
+        const auto src = inport_.getData();
+        const auto* srcFormat = src->getDataFormat();
+        if (srcFormat->getId() == format_.get()) {
+            return std::shared_ptr<Volume>(src->clone());
+        }
+
+        std::optional<util::LinearMap> map;
+        if (enableDataMapping_) {
+            const dvec2 srcRange{(srcFormat->getNumericType() != NumericType::Float)
+                                     ? src->dataMap_.dataRange
+                                     : dvec2{0.0, 1.0}};
+            map = util::LinearMap::fromRanges(srcRange, dstRange.first);
         }
+        // The output format option is a scalar type, keep the number of components of the input
+        const auto* scalarFormat = DataFormatBase::get(format_.get());
+        const auto* dstFormat =
+            DataFormatBase::get(scalarFormat->getNumericType(), srcFormat->getComponents(),
+                                scalarFormat->getPrecision());
+
+        auto vol = std::make_shared<Volume>(
+            util::convertVolumeRAM(*src->getRepresentation<VolumeRAM>(), dstFormat, map));
+        vol->setBasis(src->getBasis());
+        vol->setOffset(src->getOffset());
+        vol->copyMetaDataFrom(*src);
+        return vol;
     }();
     volume->dataMap_.dataRange = dstRange.first;
     volume->dataMap_.valueRange = dstRange.second;
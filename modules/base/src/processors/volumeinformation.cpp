@@ -227,7 +227,7 @@ void VolumeInformation::process() {
         significantVoxelsRatio_.set(static_cast<double>(sigVoxels) /
                                     static_cast<double>(numVoxels));
 
-        auto minMax = util::volumeMinMax(volumeRAM);
+        auto minMax = util::volumeMinMax(volume.get());
         dvec2 minMaxA(minMax.first.x, minMax.second.x);
         dvec2 minMaxB(minMax.first.y, minMax.second.y);
         dvec2 minMaxC(minMax.first.z, minMax.second.z);
@@ -32,6 +32,7 @@
 #include <inviwo/core/datastructures/datamapper.h>                      // for DataMapper
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/representationpool.h>              // for makePooledReprese...
 #include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
 #include <inviwo/core/ports/volumeport.h>                               // for VolumeInport, Vol...
@@ -98,9 +99,12 @@ void VolumeShifter::process() {
                 const int size = glm::compMul(dim);
                 util::IndexMapper<3, int> im(dim);
 
-                auto vol = std::make_shared<VolumeRAMPrecision<ValueType>>(
-                    vr->getDimensions(), vr->getSwizzleMask(), vr->getInterpolation(),
-                    vr->getWrapping());
+                // Every voxel is written below, so a reused representation is fine.
+                auto vol = util::makePooledRepresentation<VolumeRAMPrecision<ValueType>>(
+                    vr->getDimensions());
+                vol->setSwizzleMask(vr->getSwizzleMask());
+                vol->setInterpolation(vr->getInterpolation());
+                vol->setWrapping(vr->getWrapping());
                 auto dst = vol->getDataTyped();
                 for (int i = 0; i < size; ++i) {
                     const auto dstIndex = VolumeRAM::periodicPosToIndex(im(i) + offset, dim);
@@ -29,12 +29,14 @@
 
 #include <modules/base/processors/volumesliceextractor.h>
 
+#include <inviwo/core/datastructures/diskrepresentation.h>              // for DiskRegion
 #include <inviwo/core/datastructures/geometry/geometrytype.h>           // for CartesianCoordina...
 #include <inviwo/core/datastructures/image/image.h>                     // for Image
 #include <inviwo/core/datastructures/image/imageram.h>                  // IWYU pragma: keep
 #include <inviwo/core/datastructures/image/imagetypes.h>                // for ImageChannel, Ima...
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
+#include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
 #include <inviwo/core/datastructures/volume/volumeram.h>                // for VolumeRAM
 #include <inviwo/core/interaction/events/eventmatcher.h>                // for GestureEventMatcher
 #include <inviwo/core/interaction/events/gestureevent.h>                // for GestureEvent
@@ -58,6 +60,7 @@
 #include <inviwo/core/util/glmvec.h>                                    // for size2_t, dvec2
 #include <inviwo/core/util/indexmapper.h>                               // for IndexMapper, Inde...
 #include <inviwo/core/util/staticstring.h>                              // for operator+
+#include <inviwo/core/util/volumeutils.h>                               // for readVolumeRegion
 #include <inviwo/core/util/document.h>                                  // for Document
 #include <modules/base/datastructures/imagereusecache.h>                // for ImageReuseCache
 
@@ -364,6 +367,19 @@ void VolumeSliceExtractor::process() {
                              flipVertical_,       &transferFunction_.get(),
                              tfAlphaOffset_.get()};
 
+    // If the volume has not been loaded yet, only read the requested slice from disk
+    if (util::canReadVolumeRegion(*vol)) {
+        const auto axis = static_cast<size_t>(sliceAlongAxis_.get());
+        DiskRegion region{size3_t{0}, dims};
+        region.offset[axis] = state.slice;
+        region.dimensions[axis] = 1;
+
+        auto slice = std::make_shared<Volume>(*vol, noData);
+        slice->addRepresentation(util::readVolumeRegion(*vol, region));
+        vol = slice;
+        state.slice = 0;
+    }
+
     std::shared_ptr<Image> image;
 
     switch (format_.get()) {
@@ -30,6 +30,7 @@
 #include <modules/base/processors/volumesubset.h>
 
 #include <inviwo/core/datastructures/datamapper.h>                      // for DataMapper
+#include <inviwo/core/datastructures/diskrepresentation.h>              // for DiskRegion
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
 #include <inviwo/core/datastructures/volume/volume.h>                   // for Volume
@@ -45,6 +46,7 @@
 #include <inviwo/core/properties/valuewrapper.h>                        // for PropertySerializa...
 #include <inviwo/core/util/glmmat.h>                                    // for mat3
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, size3_t
+#include <inviwo/core/util/volumeutils.h>                               // for readVolumeRegion
 #include <modules/base/algorithm/volume/volumeramsubset.h>              // for VolumeRAMSubSet
 
 #include <functional>     // for __base
@@ -115,7 +117,6 @@ VolumeSubset::~VolumeSubset() = default;
 
 void VolumeSubset::process() {
     if (enabled_.get()) {
-        const auto vol = inport_.getData()->getRepresentation<VolumeRAM>();
         const size3_t offset{rangeX_.get().x, rangeY_.get().x, rangeZ_.get().x};
         const size3_t dim = size3_t{rangeX_.get().y, rangeY_.get().y, rangeZ_.get().y} - offset;
 
@@ -123,7 +124,14 @@ void VolumeSubset::process() {
             outport_.setData(inport_.getData());
         else {
             auto volume = std::make_shared<Volume>(*inport_.getData(), NoData{});
-            volume->addRepresentation(VolumeRAMSubSet::apply(vol, dim, offset));
+            // Only read the subset from disk if the volume has not been loaded already
+            if (util::canReadVolumeRegion(*inport_.getData())) {
+                volume->addRepresentation(
+                    util::readVolumeRegion(*inport_.getData(), DiskRegion{offset, dim}));
+            } else {
+                const auto vol = inport_.getData()->getRepresentation<VolumeRAM>();
+                volume->addRepresentation(VolumeRAMSubSet::apply(vol, dim, offset));
+            }
 
             if (adjustBasisAndOffset_.get()) {
                 vec3 volOffset = inport_.getData()->getOffset();
@@ -30,6 +30,9 @@
 #include <modules/base/properties/datarangeproperty.h>
 
 #include <inviwo/core/datastructures/datamapper.h>         // for DataMapper
+#include <inviwo/core/datastructures/histogram.h>          // for HistogramContainer
+#include <inviwo/core/datastructures/volume/volume.h>      // for Volume
+#include <inviwo/core/datastructures/volume/volumeram.h>   // for VolumeRAM
 #include <inviwo/core/ports/volumeport.h>                  // for VolumeInport
 #include <inviwo/core/properties/boolcompositeproperty.h>  // for BoolCompositeProperty
 #include <inviwo/core/properties/compositeproperty.h>      // for CompositeProperty
@@ -39,13 +42,15 @@
 #include <inviwo/core/properties/valuewrapper.h>           // for PropertySerializationMode, Pro...
 #include <inviwo/core/util/formats.h>                      // for DataFloat64
 #include <inviwo/core/util/glmvec.h>                       // for dvec2
+#include <inviwo/core/util/quantilesketch.h>               // for robustRange, quantileSketches
 
+#include <algorithm>    // for all_of
 #include <functional>   // for __base, function
 #include <limits>       // for numeric_limits
 #include <type_traits>  // for remove_extent_t
+#include <vector>       // for vector
 
 namespace inviwo {
-class Volume;
 
 const std::string DataRangeProperty::classIdentifier = "org.inviwo.DataRangeProperty";
 std::string DataRangeProperty::getClassIdentifier() const { return classIdentifier; }
@@ -99,14 +104,17 @@ DataRangeProperty::DataRangeProperty(std::string_view identifier, std::string_vi
     , copyFromInput_{"copyFromInput", "Copy Range from Input", [&]() {
                          customDataRange_.set(dataRange_);
                          customValueRange_.set(valueRange_);
-                     }} {
+                     }}
+    , robustFromInput_{"robustFromInput", "Robust Range from Input",
+                       [&]() { setCustomRangeFromQuantiles(); }} {
 
     dataRange_.setReadOnly(true);
     valueRange_.setReadOnly(true);
     dataRange_.setSerializationMode(PropertySerializationMode::All);
     valueRange_.setSerializationMode(PropertySerializationMode::All);
 
-    useCustomRange_.addProperties(customDataRange_, customValueRange_, copyFromInput_);
+    useCustomRange_.addProperties(customDataRange_, customValueRange_, copyFromInput_,
+                                  robustFromInput_);
     useCustomRange_.setVisible(customRanges_);
     useCustomRange_.setCollapsed(true);
     addProperties(dataRange_, valueRange_, useCustomRange_);
@@ -121,6 +129,7 @@ DataRangeProperty::DataRangeProperty(std::string_view identifier, std::string_vi
     port.onChange([&]() {
         if (port.hasData()) {
             const auto data = port.getData();
+            volume_ = data;
             dataRange_.set(data->dataMap_.dataRange);
             valueRange_.set(data->dataMap_.valueRange);
         }
@@ -130,13 +139,16 @@ DataRangeProperty::DataRangeProperty(std::string_view identifier, std::string_vi
 DataRangeProperty::DataRangeProperty(const DataRangeProperty& rhs)
     : CompositeProperty{rhs}
     , customRanges_{rhs.customRanges_}
+    , volume_{rhs.volume_}
     , dataRange_{rhs.dataRange_}
     , valueRange_{rhs.valueRange_}
     , useCustomRange_{rhs.useCustomRange_}
     , customDataRange_{rhs.customDataRange_}
     , customValueRange_{rhs.customValueRange_}
-    , copyFromInput_{rhs.copyFromInput_} {
-    useCustomRange_.addProperties(customDataRange_, customValueRange_, copyFromInput_);
+    , copyFromInput_{rhs.copyFromInput_}
+    , robustFromInput_{rhs.robustFromInput_} {
+    useCustomRange_.addProperties(customDataRange_, customValueRange_, copyFromInput_,
+                                  robustFromInput_);
     useCustomRange_.setVisible(customRanges_);
     addProperties(dataRange_, valueRange_, useCustomRange_);
 }
@@ -145,6 +157,7 @@ DataRangeProperty* DataRangeProperty::clone() const { return new DataRangeProper
 
 void DataRangeProperty::updateFromVolume(std::shared_ptr<Volume> volume) {
     if (!volume) return;
+    volume_ = volume;
     dataRange_.set(volume->dataMap_.dataRange);
     valueRange_.set(volume->dataMap_.valueRange);
 }
@@ -177,4 +190,27 @@ bool DataRangeProperty::getCustomRangeEnabled() const {
     return (customRanges_ && useCustomRange_.isChecked());
 }
 
+void DataRangeProperty::setCustomRangeFromQuantiles() {
+    const auto volume = volume_.lock();
+    if (!volume) return;
+
+    // Use the quantiles of the histograms if they are up to date, they are computed along with
+    // the histograms and kept with the volume
+    std::vector<util::QuantileSketch> sketches;
+    if (volume->hasHistograms() && !volume->hasOutdatedHistograms()) {
+        const auto& histograms = volume->getHistograms();
+        for (size_t i = 0; i < histograms.size(); ++i) {
+            sketches.push_back(histograms[i].quantiles_);
+        }
+    }
+    if (sketches.empty() || std::all_of(sketches.begin(), sketches.end(),
+                                        [](const auto& sketch) { return sketch.empty(); })) {
+        sketches = util::quantileSketches(*volume->getRepresentation<VolumeRAM>());
+    }
+
+    const auto range = util::robustRange(sketches);
+    customDataRange_.set(range);
+    customValueRange_.set(volume->dataMap_.mapFromDataToValue(range));
+}
+
 }  // namespace inviwo
@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/datareduction.h>
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataReductionTests, scalarStatistics) {
+    std::vector<float> data{1.0f, 2.0f, 3.0f, 4.0f};
+    const auto res = util::dataReduction(data.data(), data.size());
+
+    EXPECT_EQ(res.min.x, 1.0);
+    EXPECT_EQ(res.max.x, 4.0);
+    EXPECT_EQ(res.sum.x, 10.0);
+    EXPECT_EQ(res.sumOfSquares.x, 30.0);
+    EXPECT_EQ(res.count.x, 4u);
+    EXPECT_DOUBLE_EQ(res.mean().x, 2.5);
+    EXPECT_DOUBLE_EQ(res.variance().x, 1.25);
+    EXPECT_EQ(res.min.y, 0.0);
+    EXPECT_EQ(res.max.y, 0.0);
+}
+
+TEST(DataReductionTests, vectorComponents) {
+    std::vector<ivec2> data{{-1, 10}, {5, 2}, {3, -7}};
+    const auto [min, max] = util::dataMinMax(data.data(), data.size());
+
+    EXPECT_EQ(min, dvec4(-1.0, -7.0, 0.0, 0.0));
+    EXPECT_EQ(max, dvec4(5.0, 10.0, 0.0, 0.0));
+}
+
+TEST(DataReductionTests, specialValues) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    const auto inf = std::numeric_limits<double>::infinity();
+    std::vector<double> data{2.0, nan, -inf, 1.0, inf, nan};
+
+    const auto all = util::dataReduction(data.data(), data.size());
+    EXPECT_EQ(all.nanCount.x, 2u);
+    EXPECT_EQ(all.infCount.x, 2u);
+    EXPECT_EQ(all.count.x, data.size());
+
+    const auto finite = util::dataReduction(data.data(), data.size(), Reductions{flags::any},
+                                            IgnoreSpecialValues::Yes);
+    EXPECT_EQ(finite.min.x, 1.0);
+    EXPECT_EQ(finite.max.x, 2.0);
+    EXPECT_EQ(finite.sum.x, 3.0);
+    EXPECT_EQ(finite.count.x, 2u);
+}
+
+TEST(DataReductionTests, manyChunks) {
+    std::vector<unsigned char> data(1'000'003);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<unsigned char>(i % 200 + 10);
+
+    const auto res = util::dataReduction(data.data(), data.size(), Reduction::MinMax);
+    EXPECT_EQ(res.min.x, 10.0);
+    EXPECT_EQ(res.max.x, 209.0);
+    EXPECT_EQ(res.sum.x, 0.0);
+}
+
+TEST(DataReductionTests, cachedPerReductions) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{4, 4, 4});
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < 64; ++i) data[i] = static_cast<float>(i);
+    Volume volume{ram};
+
+    // A min/max request only computes the min/max, also when cached
+    const auto minMax = util::volumeReduction(&volume, Reduction::MinMax);
+    EXPECT_EQ(minMax.min.x, 0.0);
+    EXPECT_EQ(minMax.max.x, 63.0);
+    EXPECT_EQ(minMax.sum.x, 0.0);
+
+    const auto all = util::volumeReduction(&volume);
+    EXPECT_EQ(all.min.x, 0.0);
+    EXPECT_EQ(all.max.x, 63.0);
+    EXPECT_EQ(all.sum.x, 63.0 * 64.0 / 2.0);
+
+    EXPECT_EQ(util::volumeMinMax(&volume), minMax.minMax());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/image/imagecontour.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glm/geometric.hpp>
+
+namespace inviwo {
+
+namespace {
+
+template <typename F>
+std::shared_ptr<LayerRAMPrecision<float>> makeLayer(size2_t dim, F func) {
+    auto layer = std::make_shared<LayerRAMPrecision<float>>(dim);
+    auto data = layer->getDataTyped();
+    for (size_t y = 0; y < dim.y; ++y) {
+        for (size_t x = 0; x < dim.x; ++x) {
+            data[y * dim.x + x] = func(static_cast<float>(x) / static_cast<float>(dim.x - 1),
+                                       static_cast<float>(y) / static_cast<float>(dim.y - 1));
+        }
+    }
+    return layer;
+}
+
+template <typename T>
+const std::vector<T>& buffer(const Mesh& mesh, BufferType type) {
+    return static_cast<const Buffer<T>*>(mesh.findBuffer(type).first)
+        ->getRAMRepresentation()
+        ->getDataContainer();
+}
+
+}  // namespace
+
+TEST(ImageContour, Ramp) {
+    auto layer = makeLayer({17, 9}, [](float x, float) { return x; });
+    auto mesh = ImageContour::apply(layer.get(), 0, 0.45, vec4(1.0f));
+    ASSERT_TRUE(mesh);
+
+    ASSERT_EQ(mesh->getNumberOfIndicies(), 1);
+    const auto& [info, indices] = mesh->getIndexBuffers().front();
+    EXPECT_EQ(info.dt, DrawType::Lines);
+    EXPECT_EQ(info.ct, ConnectivityType::None);
+    EXPECT_EQ(indices->getSize(), 16);
+
+    const auto& positions = buffer<vec3>(*mesh, BufferType::PositionAttrib);
+    ASSERT_EQ(positions.size(), 9);
+    for (const auto& p : positions) EXPECT_NEAR(p.x, 0.45f, 1e-5f);
+
+    const auto& ids = buffer<std::uint32_t>(*mesh, BufferType::IndexAttrib);
+    EXPECT_EQ(ids, std::vector<std::uint32_t>(9, 0));
+}
+
+TEST(ImageContour, NoContour) {
+    auto layer = makeLayer({17, 9}, [](float x, float) { return x; });
+    auto mesh = ImageContour::apply(layer.get(), 0, 2.0, vec4(1.0f));
+    ASSERT_TRUE(mesh);
+    ASSERT_EQ(mesh->getNumberOfIndicies(), 1);
+    EXPECT_EQ(mesh->getIndices(0)->getSize(), 0);
+}
+
+TEST(ImageContour, MultipleCircles) {
+    auto layer = makeLayer({33, 33}, [](float x, float y) {
+        return std::sqrt((x - 0.5f) * (x - 0.5f) + (y - 0.5f) * (y - 0.5f));
+    });
+    const std::vector<double> isoValues{0.4, 0.25};
+    auto mesh = ImageContour::apply(layer.get(), 0, isoValues);
+    ASSERT_TRUE(mesh);
+
+    // One closed polyline per isovalue, each vertex is shared by two segments
+    ASSERT_EQ(mesh->getNumberOfIndicies(), 2);
+    const auto& positions = buffer<vec3>(*mesh, BufferType::PositionAttrib);
+    const auto& values = buffer<float>(*mesh, BufferType::ScalarMetaAttrib);
+    const auto& ids = buffer<std::uint32_t>(*mesh, BufferType::IndexAttrib);
+    ASSERT_EQ(values.size(), positions.size());
+    ASSERT_EQ(ids.size(), positions.size());
+
+    size_t count = 0;
+    for (size_t k = 0; k < mesh->getNumberOfIndicies(); ++k) {
+        EXPECT_EQ(mesh->getIndexMeshInfo(k).ct, ConnectivityType::None);
+        const auto& idx = mesh->getIndices(k)->getRAMRepresentation()->getDataContainer();
+        ASSERT_FALSE(idx.empty());
+        count += idx.size();
+        for (auto i : idx) {
+            const auto r = glm::length(vec2(positions[i]) - vec2(0.5f));
+            EXPECT_NEAR(r, values[i], 1e-3f);
+            EXPECT_EQ(values[i], static_cast<float>(isoValues[k]));
+            EXPECT_EQ(ids[i], ids[idx.front()]);
+        }
+    }
+    EXPECT_EQ(count, 2 * positions.size());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/mesh/meshdecimation.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+// A unit square in the xy-plane with n x n quads, and a color gradient along x
+std::shared_ptr<Mesh> grid(std::uint32_t n, bool bump = false) {
+    std::vector<vec3> positions;
+    std::vector<vec4> colors;
+    for (std::uint32_t j = 0; j <= n; ++j) {
+        for (std::uint32_t i = 0; i <= n; ++i) {
+            const float x = static_cast<float>(i) / n;
+            const float y = static_cast<float>(j) / n;
+            const float z = bump ? 0.1f * std::sin(6.0f * x) * std::cos(5.0f * y) : 0.0f;
+            positions.emplace_back(x, y, z);
+            colors.emplace_back(x, 0.0f, 0.0f, 1.0f);
+        }
+    }
+    std::vector<std::uint32_t> indices;
+    const auto id = [&](std::uint32_t i, std::uint32_t j) { return j * (n + 1) + i; };
+    for (std::uint32_t j = 0; j < n; ++j) {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            indices.insert(indices.end(), {id(i, j), id(i + 1, j), id(i + 1, j + 1)});
+            indices.insert(indices.end(), {id(i, j), id(i + 1, j + 1), id(i, j + 1)});
+        }
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(colors)));
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None},
+                     util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+void checkOrientation(const Mesh& mesh) {
+    const auto& positions = static_cast<const Buffer<vec3>*>(mesh.getBuffer(0))
+                                ->getRAMRepresentation()
+                                ->getDataContainer();
+    for (const auto& [info, ib] : mesh.getIndexBuffers()) {
+        if (info.dt != DrawType::Triangles) continue;
+        const auto& indices = ib->getRAMRepresentation()->getDataContainer();
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const auto n = glm::cross(positions[indices[i + 1]] - positions[indices[i]],
+                                      positions[indices[i + 2]] - positions[indices[i]]);
+            EXPECT_GT(n.z, 0.0f);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(MeshDecimation, FlatGrid) {
+    const auto mesh = grid(20);
+    ASSERT_EQ(meshutil::countTriangles(*mesh), 800);
+
+    meshutil::DecimationSettings settings;
+    settings.targetTriangles = 100;
+    const auto res = meshutil::decimate(*mesh, settings);
+
+    EXPECT_LE(meshutil::countTriangles(*res), 100);
+    EXPECT_GT(meshutil::countTriangles(*res), 0);
+    checkOrientation(*res);
+
+    const auto& positions = static_cast<const Buffer<vec3>*>(res->getBuffer(0))
+                                ->getRAMRepresentation()
+                                ->getDataContainer();
+    const auto& colors = static_cast<const Buffer<vec4>*>(res->getBuffer(1))
+                             ->getRAMRepresentation()
+                             ->getDataContainer();
+    ASSERT_EQ(positions.size(), colors.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_NEAR(positions[i].z, 0.0f, 1e-5f);
+        // The gradient is linear, interpolating along the edges has to keep it intact
+        EXPECT_NEAR(colors[i].r, positions[i].x, 1e-4f);
+    }
+}
+
+TEST(MeshDecimation, LockedBoundary) {
+    const auto mesh = grid(10, true);
+
+    meshutil::DecimationSettings settings;
+    settings.targetTriangles = 0;
+    settings.boundary = meshutil::BoundaryHandling::Locked;
+    const auto res = meshutil::decimate(*mesh, settings);
+    checkOrientation(*res);
+
+    // All 40 vertices on the border of the grid have to remain
+    const auto& positions = static_cast<const Buffer<vec3>*>(res->getBuffer(0))
+                                ->getRAMRepresentation()
+                                ->getDataContainer();
+    const auto onBorder = [](const vec3& p) {
+        return p.x == 0.0f || p.x == 1.0f || p.y == 0.0f || p.y == 1.0f;
+    };
+    EXPECT_EQ(std::count_if(positions.begin(), positions.end(), onBorder), 40);
+}
+
+TEST(MeshDecimation, KeepsOtherPrimitives) {
+    auto mesh = grid(10);
+    mesh->addIndices(Mesh::MeshInfo{DrawType::Lines, ConnectivityType::None},
+                     util::makeIndexBuffer({60, 61}));
+
+    meshutil::DecimationSettings settings;
+    settings.targetTriangles = 20;
+    const auto res = meshutil::decimate(*mesh, settings);
+
+    ASSERT_EQ(res->getNumberOfIndicies(), 2);
+    const auto& positions = static_cast<const Buffer<vec3>*>(res->getBuffer(0))
+                                ->getRAMRepresentation()
+                                ->getDataContainer();
+    const auto& line = res->getIndices(1)->getRAMRepresentation()->getDataContainer();
+    ASSERT_EQ(line.size(), 2);
+    EXPECT_EQ(positions[line[0]], vec3(0.5f, 0.5f, 0.0f));
+    EXPECT_EQ(positions[line[1]], vec3(0.6f, 0.5f, 0.0f));
+}
+
+TEST(MeshDecimation, NoTriangles) {
+    Mesh mesh{DrawType::Lines, ConnectivityType::None};
+    mesh.addBuffer(BufferType::PositionAttrib,
+                   util::makeBuffer<vec3>({vec3{0.0f}, vec3{1.0f}, vec3{2.0f}}));
+    mesh.addIndices(Mesh::MeshInfo{DrawType::Lines, ConnectivityType::Strip},
+                    util::makeIndexBuffer({0, 1, 2}));
+
+    meshutil::DecimationSettings settings;
+    settings.targetTriangles = 0;
+    const auto res = meshutil::decimate(mesh, settings);
+
+    ASSERT_EQ(res->getNumberOfBuffers(), 1);
+    ASSERT_EQ(res->getNumberOfIndicies(), 1);
+    EXPECT_EQ(res->getIndexMeshInfo(0).ct, ConnectivityType::Strip);
+    EXPECT_TRUE(*res->getBuffer(0) == *mesh.getBuffer(0));
+    EXPECT_TRUE(*res->getIndices(0) == *mesh.getIndices(0));
+
+    // Also without a position buffer
+    const Mesh empty{DrawType::Points, ConnectivityType::None};
+    EXPECT_EQ(meshutil::decimate(empty, settings)->getNumberOfBuffers(), 0);
+}
+
+TEST(MeshDecimation, Partitioned) {
+    const auto mesh = grid(200, true);
+
+    meshutil::DecimationSettings settings;
+    settings.targetTriangles = 2000;
+    settings.partitions = 4;
+    const auto res = meshutil::decimate(*mesh, settings);
+
+    EXPECT_LE(meshutil::countTriangles(*res), 2000);
+    EXPECT_GT(meshutil::countTriangles(*res), 1900);
+    checkOrientation(*res);
+}
+
+TEST(MeshDecimation, Lods) {
+    const auto mesh = grid(20, true);
+
+    const auto lods = meshutil::generateLods(*mesh, 3, 0.5);
+    ASSERT_EQ(lods.size(), 3);
+    size_t count = meshutil::countTriangles(*mesh);
+    for (const auto& lod : lods) {
+        const auto lodCount = meshutil::countTriangles(*lod);
+        EXPECT_LE(lodCount, count / 2);
+        count = lodCount;
+        checkOrientation(*lod);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,209 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumecurl.h>
+#include <modules/base/algorithm/volume/volumedivergence.h>
+#include <modules/base/algorithm/volume/volumegradient.h>
+#include <modules/base/algorithm/volume/volumelaplacian.h>
+
+#include <inviwo/core/datastructures/coordinatetransformer.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glmfmt.h>
+#include <inviwo/core/util/glmmat.h>
+#include <inviwo/core/util/glmvec.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size3_t dims{6, 5, 4};
+
+// Voxel spacing of 1, 2, and 3 along the axes
+const mat3 alignedBasis{vec3{6.0f, 0.0f, 0.0f}, vec3{0.0f, 10.0f, 0.0f}, vec3{0.0f, 0.0f, 12.0f}};
+// Second axis tilted towards the first one
+const mat3 skewedBasis{vec3{6.0f, 0.0f, 0.0f}, vec3{2.0f, 10.0f, 0.0f}, vec3{0.0f, 0.0f, 12.0f}};
+
+/**
+ * Creates a volume with the value of `func` at the world position of each voxel
+ */
+template <typename T, typename Func>
+std::shared_ptr<Volume> makeVolume(Func func, const mat3& basis = alignedBasis) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setBasis(basis);
+    volume->setOffset(vec3{-1.0f, 2.0f, 0.5f});
+
+    const auto indexToWorld = volume->getCoordinateTransformer().getIndexToWorldMatrix();
+    const util::IndexMapper3D im(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const vec3 world{indexToWorld * vec4{x, y, z, 1.0f}};
+                data[im(x, y, z)] = static_cast<T>(func(dvec3{world}));
+            }
+        }
+    }
+    return volume;
+}
+
+template <typename T, typename Func>
+void forEachVoxel(const Volume& volume, Func func) {
+    const auto ram =
+        static_cast<const VolumeRAMPrecision<T>*>(volume.getRepresentation<VolumeRAM>());
+    const util::IndexMapper3D im(dims);
+    const auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                func(size3_t{x, y, z}, data[im(x, y, z)]);
+            }
+        }
+    }
+}
+
+bool isInterior(const size3_t& pos) {
+    return glm::all(glm::greaterThan(pos, size3_t{0})) &&
+           glm::all(glm::lessThan(pos + size3_t{1}, dims));
+}
+
+}  // namespace
+
+TEST(VolumeDerivatives, GradientOfLinearField) {
+    const dvec3 a{1.5, -2.0, 0.25};
+    auto volume =
+        makeVolume<float>([&](const dvec3& p) { return glm::dot(a, p) + 3.0; }, skewedBasis);
+
+    const auto gradient = util::gradientVolume(volume, 0);
+    forEachVoxel<vec3>(*gradient, [&](const size3_t& pos, const vec3& g) {
+        EXPECT_NEAR(g.x, a.x, 1e-4) << "at " << pos;
+        EXPECT_NEAR(g.y, a.y, 1e-4) << "at " << pos;
+        EXPECT_NEAR(g.z, a.z, 1e-4) << "at " << pos;
+    });
+}
+
+TEST(VolumeDerivatives, GradientOfQuadraticField) {
+    auto volume = makeVolume<float>(
+        [](const dvec3& p) { return p.x * p.x + 2.0 * p.y * p.y - 0.5 * p.z * p.z; });
+    const auto indexToWorld = volume->getCoordinateTransformer().getIndexToWorldMatrix();
+
+    // Central differences are exact for quadratic fields, the one sided ones at the border are not
+    const auto gradient = util::gradientVolume(volume, 0);
+    forEachVoxel<vec3>(*gradient, [&](const size3_t& pos, const vec3& g) {
+        if (!isInterior(pos)) return;
+        const vec3 p{indexToWorld * vec4{pos, 1.0f}};
+        EXPECT_NEAR(g.x, 2.0f * p.x, 1e-3) << "at " << pos;
+        EXPECT_NEAR(g.y, 4.0f * p.y, 1e-3) << "at " << pos;
+        EXPECT_NEAR(g.z, -p.z, 1e-3) << "at " << pos;
+    });
+}
+
+TEST(VolumeDerivatives, GradientInvalidChannel) {
+    auto volume = makeVolume<float>([](const dvec3&) { return 0.0; });
+    EXPECT_THROW(util::gradientVolume(volume, 1), Exception);
+    EXPECT_THROW(util::gradientVolume(volume, -1), Exception);
+}
+
+TEST(VolumeDerivatives, LaplacianOfLinearField) {
+    auto volume = makeVolume<double>([](const dvec3& p) { return 2.0 * p.x - p.y + 4.0 * p.z; });
+
+    const auto laplacian =
+        util::volumeLaplacian(volume, util::VolumeLaplacianPostProcessing::None, 1.0);
+    forEachVoxel<float>(*laplacian, [&](const size3_t& pos, float l) {
+        EXPECT_NEAR(l, 0.0f, 1e-4) << "at " << pos;
+    });
+}
+
+TEST(VolumeDerivatives, LaplacianOfQuadraticField) {
+    auto volume = makeVolume<double>(
+        [](const dvec3& p) { return p.x * p.x + 2.0 * p.y * p.y - 0.5 * p.z * p.z + p.x; });
+
+    // Exact everywhere, including the border voxels, since the basis is axis aligned
+    const auto laplacian =
+        util::volumeLaplacian(volume, util::VolumeLaplacianPostProcessing::None, 1.0);
+    forEachVoxel<float>(*laplacian, [&](const size3_t& pos, float l) {
+        EXPECT_NEAR(l, 2.0f + 4.0f - 1.0f, 1e-4) << "at " << pos;
+    });
+}
+
+TEST(VolumeDerivatives, CurlAndDivergenceOfLinearField) {
+    // F = (2x - z, 3x + y, y + 4z), curl F = (1, -1, 3), div F = 7
+    const auto field = [](const dvec3& p) {
+        return dvec3{2.0 * p.x - p.z, 3.0 * p.x + p.y, p.y + 4.0 * p.z};
+    };
+    auto volume = makeVolume<vec3>(field, skewedBasis);
+
+    const auto curl = util::curlVolume(*volume);
+    forEachVoxel<vec3>(*curl, [&](const size3_t& pos, const vec3& c) {
+        EXPECT_NEAR(c.x, 1.0f, 1e-4) << "at " << pos;
+        EXPECT_NEAR(c.y, -1.0f, 1e-4) << "at " << pos;
+        EXPECT_NEAR(c.z, 3.0f, 1e-4) << "at " << pos;
+    });
+
+    const auto divergence = util::divergenceVolume(*volume);
+    forEachVoxel<float>(*divergence, [&](const size3_t& pos, float d) {
+        EXPECT_NEAR(d, 7.0f, 1e-4) << "at " << pos;
+    });
+}
+
+TEST(VolumeDerivatives, CurlAndDivergenceOfQuadraticField) {
+    // F = (xy, yz, zx), curl F = (-y, -z, -x), div F = x + y + z
+    const auto field = [](const dvec3& p) { return dvec3{p.x * p.y, p.y * p.z, p.z * p.x}; };
+    auto volume = makeVolume<vec3>(field);
+    const auto indexToWorld = volume->getCoordinateTransformer().getIndexToWorldMatrix();
+
+    const auto curl = util::curlVolume(*volume);
+    forEachVoxel<vec3>(*curl, [&](const size3_t& pos, const vec3& c) {
+        if (!isInterior(pos)) return;
+        const vec3 p{indexToWorld * vec4{pos, 1.0f}};
+        EXPECT_NEAR(c.x, -p.y, 1e-3) << "at " << pos;
+        EXPECT_NEAR(c.y, -p.z, 1e-3) << "at " << pos;
+        EXPECT_NEAR(c.z, -p.x, 1e-3) << "at " << pos;
+    });
+
+    const auto divergence = util::divergenceVolume(*volume);
+    forEachVoxel<float>(*divergence, [&](const size3_t& pos, float d) {
+        if (!isInterior(pos)) return;
+        const vec3 p{indexToWorld * vec4{pos, 1.0f}};
+        EXPECT_NEAR(d, p.x + p.y + p.z, 1e-3) << "at " << pos;
+    });
+}
+
+}  // namespace inviwo
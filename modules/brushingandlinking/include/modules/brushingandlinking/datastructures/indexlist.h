@@ -45,6 +45,13 @@ namespace inviwo {
 class Deserializer;
 class Serializer;
 
+/**
+ * \brief The union of index sets provided by several sources.
+ *
+ * The union is kept up to date incrementally. When a source changes, only the indices that were
+ * added or removed by that source are applied to the union, instead of recomputing the union of
+ * all sources. The sets of the sources share their bitmaps with the BitSets passed to set().
+ */
 class IVW_MODULE_BRUSHINGANDLINKING_API IndexList : public Serializable {
 public:
     IndexList() = default;
@@ -71,6 +78,8 @@ public:
 
 private:
     void update() const;
+    // Remove \p removed from the union, except for indices that are still part of any source
+    void removeFromUnion(BitSet removed);
 
     mutable std::unordered_map<std::string, BitSet> indicesBySource_;
     mutable BitSet indices_;
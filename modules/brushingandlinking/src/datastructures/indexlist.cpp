@@ -40,9 +40,9 @@
 
 namespace inviwo {
 
-bool IndexList::empty() const { return indices_.empty(); }
+bool IndexList::empty() const { return getIndices().empty(); }
 
-size_t IndexList::size() const { return indices_.size(); }
+size_t IndexList::size() const { return getIndices().size(); }
 
 void IndexList::clear() {
     indices_.clear();
@@ -63,16 +63,20 @@ bool IndexList::set(std::string_view src, const BitSet& indices) {
         if (indices.empty()) return false;
 
         indicesBySource_.emplace(std::make_pair(source, indices));
+        if (!indicesDirty_) indices_ |= indices;
     } else {
         if (it->second == indices) return false;
 
+        BitSet removed = it->second - indices;
+        if (!indicesDirty_) indices_ |= indices;
+
         if (indices.empty()) {
             indicesBySource_.erase(it);
         } else {
             it->second = indices;
         }
+        removeFromUnion(std::move(removed));
     }
-    indicesDirty_ = true;
     return true;
 }
 
@@ -82,12 +86,31 @@ bool IndexList::contains(uint32_t idx) const {
 }
 
 bool IndexList::removeSources(const std::vector<std::string>& sources) {
-    size_t modified = 0u;
+    std::vector<BitSet> removed;
     for (auto& source : sources) {
-        modified += indicesBySource_.erase(source);
+        if (auto it = indicesBySource_.find(source); it != indicesBySource_.end()) {
+            removed.push_back(std::move(it->second));
+            indicesBySource_.erase(it);
+        }
+    }
+    if (removed.empty()) return false;
+
+    if (!indicesDirty_) {
+        auto bitsets = util::transform(removed, [](auto& b) -> const BitSet* { return &b; });
+        removeFromUnion(BitSet::fastUnion(bitsets));
+    }
+    return true;
+}
+
+void IndexList::removeFromUnion(BitSet removed) {
+    if (indicesDirty_ || removed.empty()) return;
+
+    // Indices are only removed from the union if no other source contains them
+    for (auto& [source, indices] : indicesBySource_) {
+        removed -= indices;
+        if (removed.empty()) return;
     }
-    indicesDirty_ |= (modified != 0);
-    return (modified != 0);
+    indices_ -= removed;
 }
 
 void IndexList::update() const {
@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/image/layer.h>  // for DataWriterType
 #include <inviwo/core/io/datawriter.h>               // for DataWriterType
 
+#include <any>          // for any
 #include <memory>       // for unique_ptr
 #include <string_view>  // for string_view
 #include <vector>       // for vector
@@ -43,6 +44,10 @@ namespace inviwo {
 /**
  * \ingroup dataio
  * \brief Writer for Images files
+ *
+ * Supported options, see setOption:
+ *  * "CompressionLevel" (int) used for TIFF files, 0 (default) writes uncompressed strips and 1 to
+ *    9 deflates the strips in parallel with the given zlib compression level.
  */
 class IVW_MODULE_CIMG_API CImgLayerWriter : public DataWriterType<Layer> {
 public:
@@ -55,6 +60,12 @@ public:
     virtual void writeData(const Layer* data, std::string_view filePath) const override;
     virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
         const Layer* data, std::string_view fileExtension) const override;
+
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) const override;
+
+private:
+    int compressionLevel_ = 0;
 };
 
 }  // namespace inviwo
@@ -43,6 +43,7 @@
 namespace inviwo {
 class Layer;
 class LayerRAM;
+struct DiskRegion;
 
 namespace cimgutil {
 
@@ -65,6 +66,7 @@ struct IVW_MODULE_CIMG_API TIFFHeader {
     dvec2 resolution;
     TIFFResolutionUnit resolutionUnit;
     SwizzleMask swizzleMask;
+    bool compressed = false;
 };
 
 IVW_MODULE_CIMG_API TIFFHeader getTIFFHeader(std::string_view filename);
@@ -86,8 +88,11 @@ IVW_MODULE_CIMG_API void* loadVolumeData(void* dst, std::string_view filePath, s
  * @param filePath the path including filename and extension, which is used to determine the image
  * format
  * @param inputImage specifies the image that is to be saved.
+ * @param compressionLevel used for TIFF files, 0 (default) writes uncompressed strips and 1 to 9
+ * deflates the strips in parallel with the given zlib compression level.
  */
-IVW_MODULE_CIMG_API void saveLayer(std::string_view filePath, const Layer* inputImage);
+IVW_MODULE_CIMG_API void saveLayer(std::string_view filePath, const Layer* inputImage,
+                                   int compressionLevel = 0);
 
 /**
  * Saves an layer of an unsigned char buffer.
@@ -106,12 +111,21 @@ void* loadTIFFLayerData(void* dst, std::string_view filePath, TIFFHeader header,
                         bool rescaleToDim = false);
 
 /**
- * Load TIFF stack as volume.
+ * Load TIFF stack as volume. The slices are decoded in parallel using the thread pool and written
+ * directly into dst, if dst is nullptr a new buffer is allocated.
  * \see TIFFStackVolumeRAMLoader
  * \see getTIFFHeader
  */
 void* loadTIFFVolumeData(void* dst, std::string_view filePath, TIFFHeader header);
 
+/**
+ * Load a region of a TIFF stack as volume. Only the slices that intersect the region are
+ * decoded, in parallel using the thread pool. If dst is nullptr a new buffer is allocated.
+ * \see TIFFStackVolumeRAMLoader
+ */
+void* loadTIFFVolumeRegion(void* dst, std::string_view filePath, TIFFHeader header,
+                           const DiskRegion& region);
+
 /**
  * \brief Rescales Layer of given image data
  *
@@ -54,7 +54,11 @@ public:
 class IVW_MODULE_CIMG_API TIFFStackVolumeRAMLoader
     : public DiskRepresentationLoader<VolumeRepresentation> {
 public:
-    TIFFStackVolumeRAMLoader(std::string_view sourceFile);
+    /**
+     * @param sourceFile the TIFF stack to load
+     * @param compressed if true, the decoded data is kept in the DecodedVolumeCache
+     */
+    TIFFStackVolumeRAMLoader(std::string_view sourceFile, bool compressed = false);
     virtual TIFFStackVolumeRAMLoader* clone() const override;
     virtual ~TIFFStackVolumeRAMLoader() = default;
 
@@ -63,8 +67,16 @@ public:
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
 
+    /**
+     * Regions are read slice by slice, only decoding the slices within the region.
+     */
+    virtual bool supportsRegions() const override;
+    virtual std::shared_ptr<VolumeRepresentation> createRegionRepresentation(
+        const VolumeRepresentation& src, const DiskRegion& region) const override;
+
 private:
     std::string sourceFile_;
+    bool compressed_;
 };
 
 }  // namespace inviwo
@@ -34,6 +34,8 @@
 #include <inviwo/core/util/fileextension.h>          // for FileExtension
 #include <modules/cimg/cimgutils.h>                  // for saveLayer, saveLayerToBuffer
 
+#include <algorithm>  // for clamp
+
 namespace inviwo {
 
 CImgLayerWriter::CImgLayerWriter() : DataWriterType<Layer>() {
@@ -56,7 +58,7 @@ CImgLayerWriter::CImgLayerWriter() : DataWriterType<Layer>() {
 CImgLayerWriter* CImgLayerWriter::clone() const { return new CImgLayerWriter(*this); }
 
 void CImgLayerWriter::writeData(const Layer* data, std::string_view filePath) const {
-    cimgutil::saveLayer(filePath, data);
+    cimgutil::saveLayer(filePath, data, compressionLevel_);
 }
 
 std::unique_ptr<std::vector<unsigned char>> CImgLayerWriter::writeDataToBuffer(
@@ -64,4 +66,19 @@ std::unique_ptr<std::vector<unsigned char>> CImgLayerWriter::writeDataToBuffer(
     return cimgutil::saveLayerToBuffer(fileExtension, data);
 }
 
+bool CImgLayerWriter::setOption(std::string_view key, std::any value) {
+    if (auto* level = std::any_cast<int>(&value); level && key == "CompressionLevel") {
+        compressionLevel_ = std::clamp(*level, 0, 9);
+        return true;
+    }
+    return false;
+}
+
+std::any CImgLayerWriter::getOption(std::string_view key) const {
+    if (key == "CompressionLevel") {
+        return compressionLevel_;
+    }
+    return std::any{};
+}
+
 }  // namespace inviwo
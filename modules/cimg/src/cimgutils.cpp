@@ -29,6 +29,7 @@
 
 #include <modules/cimg/cimgutils.h>
 
+#include <inviwo/core/datastructures/diskrepresentation.h>              // for DiskRegion
 #include <inviwo/core/datastructures/image/imagetypes.h>                // for SwizzleMask, lumi...
 #include <inviwo/core/datastructures/image/layer.h>                     // for Layer
 #include <inviwo/core/datastructures/image/layerram.h>                  // for LayerRAM
@@ -36,8 +37,10 @@
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
 #include <inviwo/core/io/datareaderexception.h>                         // for DataReaderException
 #include <inviwo/core/io/datawriterexception.h>                         // for DataWriterException
+#include <inviwo/core/util/dataformatconversion.h>                      // for convertValues
 #include <inviwo/core/util/exception.h>                                 // for Exception
 #include <inviwo/core/util/filesystem.h>                                // for getFileExtension
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexPar...
 #include <inviwo/core/util/formatdispatching.h>                         // for dispatch, All
 #include <inviwo/core/util/formats.h>                                   // for DataFormatId, Dat...
 #include <inviwo/core/util/glmutils.h>                                  // for extent, rank
@@ -48,11 +51,15 @@
 #include <inviwo/core/util/stringconversion.h>                          // for toLower
 #include <modules/cimg/cimgsavebuffer.h>                                // for saveCImgToBuffer
 
-#include <algorithm>      // for min
+#include <algorithm>      // for min, clamp
 #include <cstdint>        // for uint16_t, uint32_t
 #include <cstring>        // for size_t, memcpy
 #include <functional>     // for __base
+#include <limits>         // for numeric_limits
+#include <memory>         // for unique_ptr, make_unique
+#include <optional>       // for optional
 #include <ostream>        // for operator<<, basic...
+#include <type_traits>    // for conditional_t
 #include <unordered_map>  // for unordered_map
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for move
@@ -92,6 +99,7 @@
 #ifdef cimg_use_tiff
 #include <tiff.h>    // for SAMPLEFORMAT_COMP...
 #include <tiffio.h>  // for TIFFGetFieldDefau...
+#include <zlib.h>    // for compress2
 #endif
 
 #ifdef cimg_use_openexr
@@ -465,6 +473,220 @@ struct CImgLoadVolumeDispatcher {
     }
 };
 
+#ifdef cimg_use_tiff
+// Decodes a TIFF stack in blocks of slices in parallel, each block is read by a separate
+// libtiff handle and written directly into the destination buffer.
+struct CImgLoadTIFFVolumeDispatcher {
+    using type = void*;
+    template <typename Result, typename DF>
+    void* operator()(void* dst, std::string_view filePath, size3_t dimensions) {
+        using P = typename DF::primitive;
+        constexpr size_t slicesPerBlock = 8;
+
+        const size_t sliceSize = dimensions.x * dimensions.y * DF::components();
+        std::unique_ptr<P[]> alloc;
+        P* data = static_cast<P*>(dst);
+        if (!data) {
+            alloc = std::make_unique<P[]>(sliceSize * dimensions.z);
+            data = alloc.get();
+        }
+
+        const auto fp = SafeCStr(filePath);
+        const size_t blocks = (dimensions.z + slicesPerBlock - 1) / slicesPerBlock;
+        util::forEachIndexParallel(blocks, [&](size_t block) {
+            const size_t first = block * slicesPerBlock;
+            const size_t last = std::min(first + slicesPerBlock, dimensions.z);
+
+            cimg_library::CImg<P> img;
+            img.load_tiff(fp.c_str(), static_cast<unsigned int>(first),
+                          static_cast<unsigned int>(last - 1));
+
+            if (size3_t(img.width(), img.height(), img.depth()) !=
+                    size3_t(dimensions.x, dimensions.y, last - first) ||
+                static_cast<size_t>(img.spectrum()) != DF::components()) {
+                throw DataReaderException(IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"),
+                                          "Unexpected dimensions of slices {} to {} in '{}'",
+                                          first, last, filePath);
+            }
+
+            // Image is up-side-down
+            img.mirror('y');
+            if (img.spectrum() > 1) {
+                img.permute_axes("cxyz");
+            }
+            std::memcpy(data + first * sliceSize, img.data(), img.size() * sizeof(P));
+        });
+
+        alloc.release();
+        return data;
+    }
+};
+
+// Decodes only the slices of a TIFF stack that intersect a region, in parallel, and copies the
+// part of each slice that lies within the region into the destination buffer.
+struct CImgLoadTIFFVolumeRegionDispatcher {
+    using type = void*;
+    template <typename Result, typename DF>
+    void* operator()(void* dst, std::string_view filePath, size3_t dimensions,
+                     const DiskRegion& region) {
+        using P = typename DF::primitive;
+        const size_t components = DF::components();
+        const auto out = region.getOutputDimensions();
+        const size_t sliceSize = out.x * out.y * components;
+
+        std::unique_ptr<P[]> alloc;
+        P* data = static_cast<P*>(dst);
+        if (!data) {
+            alloc = std::make_unique<P[]>(sliceSize * out.z);
+            data = alloc.get();
+        }
+
+        const auto fp = SafeCStr(filePath);
+        util::forEachIndexParallel(out.z, [&](size_t z) {
+            const auto slice = static_cast<unsigned int>(region.offset.z + z * region.stride.z);
+
+            cimg_library::CImg<P> img;
+            img.load_tiff(fp.c_str(), slice, slice);
+
+            if (size3_t(img.width(), img.height(), img.depth()) !=
+                    size3_t(dimensions.x, dimensions.y, 1) ||
+                static_cast<size_t>(img.spectrum()) != components) {
+                throw DataReaderException(IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeRegion"),
+                                          "Unexpected dimensions of slice {} in '{}'", slice,
+                                          filePath);
+            }
+
+            // Image is up-side-down
+            img.mirror('y');
+            if (img.spectrum() > 1) {
+                img.permute_axes("cxyz");
+            }
+            P* dest = data + z * sliceSize;
+            for (size_t y = 0; y < out.y; ++y) {
+                const size_t row = region.offset.y + y * region.stride.y;
+                const P* src = img.data() + (row * dimensions.x + region.offset.x) * components;
+                for (size_t x = 0; x < out.x; ++x) {
+                    std::copy_n(src + x * region.stride.x * components, components, dest);
+                    dest += components;
+                }
+            }
+        });
+
+        alloc.release();
+        return data;
+    }
+};
+
+// Writes a layer as a strip based TIFF. The strips are converted, and optionally deflated, in
+// parallel on the thread pool, and then written in order as raw strips.
+struct CImgSaveTIFFLayerDispatcher {
+    using type = void;
+    template <typename Result, typename T>
+    void operator()(std::string_view filePath, const LayerRAM* inputLayer, int compressionLevel) {
+        using P = typename T::primitive;
+        // TIFF supports 8 and 16 bit integer formats as well as 32 bit floating point
+        using O = std::conditional_t<
+            !std::is_integral_v<P>, float,
+            std::conditional_t<sizeof(P) == 1, P,
+                               std::conditional_t<std::is_signed_v<P>, std::int16_t,
+                                                  std::uint16_t>>>;
+        constexpr size_t stripBytes = size_t{1} << 18;
+
+        const auto dims = inputLayer->getDimensions();
+        const size_t rowValues = dims.x * T::comp;
+        const size_t rowsPerStrip = std::max<size_t>(
+            1, std::min<size_t>(dims.y, stripBytes / std::max<size_t>(1, rowValues * sizeof(O))));
+        const size_t strips = (dims.y + rowsPerStrip - 1) / rowsPerStrip;
+
+        // For float input images, we assume that the range is [0,1] (which is the same as
+        // rendered in a Canvas). For float output images, we normalize to [0,1]
+        const DataFormatBase* inFormat = inputLayer->getDataFormat();
+        const auto inRange = inFormat->getNumericType() == NumericType::Float
+                                 ? dvec2{0.0, 1.0}
+                                 : dvec2{inFormat->getMin(), inFormat->getMax()};
+        const auto outRange =
+            std::is_floating_point_v<O>
+                ? dvec2{0.0, 1.0}
+                : dvec2{static_cast<double>(std::numeric_limits<O>::lowest()),
+                        static_cast<double>(std::numeric_limits<O>::max())};
+        const auto map = inRange != outRange
+                             ? std::optional<util::LinearMap>{util::LinearMap::fromRanges(
+                                   inRange, outRange)}
+                             : std::nullopt;
+
+        const auto* src = static_cast<const P*>(inputLayer->getData());
+        std::vector<std::vector<unsigned char>> stripData(strips);
+        util::forEachIndexParallel(strips, [&](size_t strip) {
+            const size_t first = strip * rowsPerStrip;
+            const size_t last = std::min(first + rowsPerStrip, dims.y);
+
+            std::vector<O> values((last - first) * rowValues);
+            for (size_t row = first; row < last; ++row) {
+                // Image is up-side-down
+                util::convertValues(src + (dims.y - row - 1) * rowValues,
+                                    values.data() + (row - first) * rowValues, rowValues, map);
+            }
+
+            auto& data = stripData[strip];
+            const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+            const auto size = values.size() * sizeof(O);
+            if (compressionLevel > 0) {
+                auto length = compressBound(static_cast<uLong>(size));
+                data.resize(length);
+                if (compress2(data.data(), &length, bytes, static_cast<uLong>(size),
+                              compressionLevel) != Z_OK) {
+                    throw DataWriterException(IVW_CONTEXT_CUSTOM("cimgutil::saveLayer"),
+                                              "Failed to compress TIFF strip {} of '{}'", strip,
+                                              filePath);
+                }
+                data.resize(length);
+            } else {
+                data.assign(bytes, bytes + size);
+            }
+        });
+
+        const auto fp = SafeCStr(filePath);
+        TIFF* tif = TIFFOpen(fp.c_str(), "w");
+        if (!tif) {
+            throw DataWriterException(IVW_CONTEXT_CUSTOM("cimgutil::saveLayer"),
+                                      "Failed to open file for writing, {}", filePath);
+        }
+        util::OnScopeExit closeFile([tif]() { TIFFClose(tif); });
+
+        TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, static_cast<std::uint32_t>(dims.x));
+        TIFFSetField(tif, TIFFTAG_IMAGELENGTH, static_cast<std::uint32_t>(dims.y));
+        TIFFSetField(tif, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+        TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, static_cast<std::uint16_t>(T::comp));
+        TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, static_cast<std::uint16_t>(sizeof(O) * 8));
+        TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT,
+                     std::is_floating_point_v<O> ? SAMPLEFORMAT_IEEEFP
+                     : std::is_signed_v<O>       ? SAMPLEFORMAT_INT
+                                                 : SAMPLEFORMAT_UINT);
+        TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+        TIFFSetField(tif, TIFFTAG_PHOTOMETRIC,
+                     T::comp >= 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+        if constexpr (T::comp == 2 || T::comp == 4) {
+            std::uint16_t extra = EXTRASAMPLE_UNASSALPHA;
+            TIFFSetField(tif, TIFFTAG_EXTRASAMPLES, 1, &extra);
+        }
+        TIFFSetField(tif, TIFFTAG_COMPRESSION,
+                     compressionLevel > 0 ? COMPRESSION_ADOBE_DEFLATE : COMPRESSION_NONE);
+        TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, static_cast<std::uint32_t>(rowsPerStrip));
+        TIFFSetField(tif, TIFFTAG_SOFTWARE, "Inviwo");
+
+        for (size_t strip = 0; strip < strips; ++strip) {
+            auto& data = stripData[strip];
+            if (TIFFWriteRawStrip(tif, static_cast<std::uint32_t>(strip), data.data(),
+                                  static_cast<tmsize_t>(data.size())) < 0) {
+                throw DataWriterException(IVW_CONTEXT_CUSTOM("cimgutil::saveLayer"),
+                                          "Failed to write TIFF strip {} of '{}'", strip,
+                                          filePath);
+            }
+        }
+    }
+};
+#endif
+
 ////////////////////// CImgUtils ///////////////////////////////////////////////////
 
 void* loadLayerData(void* dst, std::string_view filePath, uvec2& dimensions, DataFormatId& formatId,
@@ -505,17 +727,52 @@ void* loadTIFFLayerData(void* dst, std::string_view filePath, TIFFHeader header,
 }
 
 void* loadTIFFVolumeData(void* dst, std::string_view filePath, TIFFHeader header) {
+#ifdef cimg_use_tiff
+    CImgLoadTIFFVolumeDispatcher tiffDisp;
+    return dispatching::dispatch<void*, dispatching::filter::All>(
+        header.format->getId(), tiffDisp, dst, filePath, header.dimensions);
+#else
     CImgLoadVolumeDispatcher disp;
     DataFormatId formatId = header.format->getId();
     size3_t dims{header.dimensions};
     return dispatching::dispatch<void*, dispatching::filter::All>(formatId, disp, dst, filePath,
                                                                   dims, formatId);
+#endif
 }
 
-void saveLayer(std::string_view filePath, const Layer* inputLayer) {
-    CImgSaveLayerDispatcher disp;
+void* loadTIFFVolumeRegion(void* dst, std::string_view filePath, TIFFHeader header,
+                           const DiskRegion& region) {
+#ifdef cimg_use_tiff
+    CImgLoadTIFFVolumeRegionDispatcher tiffDisp;
+    return dispatching::dispatch<void*, dispatching::filter::All>(
+        header.format->getId(), tiffDisp, dst, filePath, header.dimensions, region);
+#else
+    (void)dst;
+    (void)filePath;
+    (void)header;
+    (void)region;
+    throw DataReaderException("Reading regions of TIFF stacks requires libtiff",
+                              IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeRegion"));
+#endif
+}
+
+void saveLayer(std::string_view filePath, const Layer* inputLayer, int compressionLevel) {
     const LayerRAM* inputLayerRam = inputLayer->getRepresentation<LayerRAM>();
 
+#ifdef cimg_use_tiff
+    const std::string fileExtension = toLower(filesystem::getFileExtension(filePath));
+    if ((fileExtension == "tif") || (fileExtension == "tiff")) {
+        CImgSaveTIFFLayerDispatcher tiffDisp;
+        return dispatching::dispatch<void, dispatching::filter::All>(
+            inputLayerRam->getDataFormat()->getId(), tiffDisp, filePath, inputLayerRam,
+            std::clamp(compressionLevel, 0, 9));
+    }
+#else
+    (void)compressionLevel;
+#endif
+
+    CImgSaveLayerDispatcher disp;
+
     return dispatching::dispatch<void, dispatching::filter::All>(
         inputLayerRam->getDataFormat()->getId(), disp, filePath, inputLayerRam);
 }
@@ -674,6 +931,11 @@ TIFFHeader getTIFFHeader(std::string_view filename) {
     }
     const TIFFResolutionUnit resolutionUnit = static_cast<TIFFResolutionUnit>(resUnit);
 
+    std::uint16_t compression = COMPRESSION_NONE;
+    if (!TIFFGetFieldDefaulted(tif, TIFFTAG_COMPRESSION, &compression)) {
+        compression = COMPRESSION_NONE;
+    }
+
     std::uint32_t x = 0, y = 0, z = 0;
     TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH, &x);
     TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGELENGTH, &y);
@@ -720,7 +982,8 @@ TIFFHeader getTIFFHeader(std::string_view filename) {
 
     auto df = DataFormatBase::get(numericType, samplesPerPixel, bitsPerSample);
 
-    return {df, size3_t{x, y, z}, res, resolutionUnit, swizzleMask};
+    return {df, size3_t{x, y, z}, res, resolutionUnit, swizzleMask,
+            compression != COMPRESSION_NONE};
 #else
     throw Exception("TIFF not available", IVW_CONTEXT_CUSTOM("cimgutil::getTIFFDataFormat()"));
     return {};
@@ -36,6 +36,7 @@
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>  // for VolumeRepresentation
 #include <inviwo/core/io/datareader.h>                               // for DataReaderType
 #include <inviwo/core/io/datareaderexception.h>                      // for DataReaderException
+#include <inviwo/core/io/decodedvolumecache.h>                       // for DecodedVolumeCache
 #include <inviwo/core/util/fileextension.h>                          // for FileExtension
 #include <inviwo/core/util/filesystem.h>                             // for fileExists, addBasePath
 #include <inviwo/core/util/formats.h>                                // for DataFormatBase
@@ -78,14 +79,14 @@ std::shared_ptr<Volume> TIFFStackVolumeReader::readData(std::string_view filePat
     volume->setBasis(glm::scale(extent));
     volume->setOffset(-extent * 0.5f);
 
-    volumeDisk->setLoader(new TIFFStackVolumeRAMLoader(filePath));
+    volumeDisk->setLoader(new TIFFStackVolumeRAMLoader(filePath, header.compressed));
     volume->addRepresentation(volumeDisk);
 
     return volume;
 }
 
-TIFFStackVolumeRAMLoader::TIFFStackVolumeRAMLoader(std::string_view sourceFile)
-    : sourceFile_{sourceFile} {}
+TIFFStackVolumeRAMLoader::TIFFStackVolumeRAMLoader(std::string_view sourceFile, bool compressed)
+    : sourceFile_{sourceFile}, compressed_{compressed} {}
 
 TIFFStackVolumeRAMLoader* TIFFStackVolumeRAMLoader::clone() const {
     return new TIFFStackVolumeRAMLoader(*this);
@@ -104,6 +105,12 @@ std::shared_ptr<VolumeRepresentation> TIFFStackVolumeRAMLoader::createRepresenta
             throw DataReaderException(IVW_CONTEXT, "Error could not find input file: {}", fileName);
         }
     }
+
+    auto cache = compressed_ ? util::getDecodedVolumeCache() : nullptr;
+    if (cache && cache->isEnabled()) {
+        if (auto volumeRAM = cache->loadRepresentation(fileName, {}, src)) return volumeRAM;
+    }
+
     cimgutil::TIFFHeader header;
     header.format = src.getDataFormat();
     header.dimensions = src.getDimensions();
@@ -113,6 +120,8 @@ std::shared_ptr<VolumeRepresentation> TIFFStackVolumeRAMLoader::createRepresenta
         createVolumeRAM(src.getDimensions(), src.getDataFormat(), data, src.getSwizzleMask(),
                         src.getInterpolation(), src.getWrapping());
 
+    if (cache && cache->isEnabled()) cache->store(fileName, {}, *volumeRAM);
+
     return volumeRAM;
 }
 
@@ -137,4 +146,37 @@ void TIFFStackVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepres
     cimgutil::loadTIFFVolumeData(volumeDst->getData(), fileName, header);
 }
 
+bool TIFFStackVolumeRAMLoader::supportsRegions() const {
+#ifdef cimg_use_tiff
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<VolumeRepresentation> TIFFStackVolumeRAMLoader::createRegionRepresentation(
+    const VolumeRepresentation& src, const DiskRegion& region) const {
+    std::string fileName = sourceFile_;
+    if (!filesystem::fileExists(fileName)) {
+        const auto newPath = filesystem::addBasePath(fileName);
+
+        if (filesystem::fileExists(newPath)) {
+            fileName = newPath;
+        } else {
+            throw DataReaderException(IVW_CONTEXT, "Error could not find input file: {}", fileName);
+        }
+    }
+
+    auto volumeRAM = createVolumeRAM(region.getOutputDimensions(), src.getDataFormat(), nullptr,
+                                     src.getSwizzleMask(), src.getInterpolation(),
+                                     src.getWrapping());
+
+    cimgutil::TIFFHeader header;
+    header.format = src.getDataFormat();
+    header.dimensions = src.getDimensions();
+    cimgutil::loadTIFFVolumeRegion(volumeRAM->getData(), fileName, header, region);
+
+    return volumeRAM;
+}
+
 }  // namespace inviwo
@@ -42,6 +42,7 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/io/tempfilehandle.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/datastructures/image/layerram.h>
 #include <modules/cimg/cimgutils.h>
 #include <modules/cimg/cimglayerreader.h>
 
@@ -49,6 +50,9 @@
 #include <array>
 #include <cstdio>
 #include <algorithm>
+#include <cstring>
+
+#include <glm/gtx/component_wise.hpp>
 
 namespace inviwo {
 
@@ -89,4 +93,24 @@ TEST(CImgUtils, cimgToBuffer) {
     EXPECT_EQ(*imgBuffer.get(), fileContents) << "buffer and file contents do not match";
 }
 
+TEST(CImgUtils, tiffRoundTrip) {
+    const auto filename = filesystem::getPath(PathType::Tests, "/images/swirl.bmp");
+    CImgLayerReader reader;
+    auto layer = reader.readData(filename);
+    const auto* ram = layer->getRepresentation<LayerRAM>();
+    const auto bytes = glm::compMul(ram->getDimensions()) * ram->getDataFormat()->getSize();
+
+    for (int level : {0, 1, 6}) {
+        util::TempFileHandle tmpFile("cimg", ".tif");
+        cimgutil::saveLayer(tmpFile.getFileName(), layer.get(), level);
+
+        auto result = reader.readData(tmpFile.getFileName());
+        const auto* resultRam = result->getRepresentation<LayerRAM>();
+        ASSERT_EQ(ram->getDimensions(), resultRam->getDimensions());
+        ASSERT_EQ(ram->getDataFormat(), resultRam->getDataFormat());
+        EXPECT_EQ(0, std::memcmp(ram->getData(), resultRam->getData(), bytes))
+            << "level " << level;
+    }
+}
+
 }  // namespace inviwo
@@ -37,10 +37,10 @@
 #include <inviwo/core/processors/processorinfo.h>                       // for ProcessorInfo
 #include <inviwo/core/processors/processorstate.h>                      // for CodeState, CodeSt...
 #include <inviwo/core/processors/processortags.h>                       // for Tags
+#include <inviwo/core/util/dataformatconversion.h>                      // for convertValuesPar...
 #include <inviwo/core/util/formatdispatching.h>                         // for Floats, Precision...
 #include <inviwo/core/util/formats.h>                                   // for DataFormatBase
 #include <inviwo/core/util/glmutils.h>                                  // for same_extent
-#include <inviwo/core/util/stdextensions.h>                             // for transform
 #include <inviwo/dataframe/datastructures/dataframe.h>                  // for DataFrame, DataFr...
 
 #include <memory>         // for shared_ptr, share...
@@ -49,6 +49,7 @@
 #include <type_traits>    // for remove_extent_t
 #include <unordered_set>  // for unordered_set
 #include <utility>        // for move
+#include <vector>         // for vector
 
 namespace inviwo {
 class Column;
@@ -83,8 +84,8 @@ void DataFrameFloat32Converter::process() {
                     using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
                     using T = typename util::same_extent<ValueType, float>::type;
 
-                    auto dst = util::transform(typedBuf->getDataContainer(),
-                                               [](const auto& v) { return static_cast<T>(v); });
+                    std::vector<T> dst(typedBuf->getSize());
+                    util::convertValuesParallel(typedBuf->getDataTyped(), dst.data(), dst.size());
 
                     dataframe->addColumn(srcCol->getHeader(), std::move(dst), srcCol->getUnit(),
                                          srcCol->getRange());
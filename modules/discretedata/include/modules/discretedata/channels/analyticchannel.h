@@ -86,6 +86,20 @@ public:
     }
 
 protected:
+    /**
+     * \brief Contiguous block access, constant
+     * Evaluates the function for each index without going through fillRaw.
+     * @param dest Position to write to, expect write of NumComponents * count many T
+     * @param start First linear index of the block
+     * @param count Number of elements in the block
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind count) const override {
+        Vec* destVec = reinterpret_cast<Vec*>(dest);
+        for (ind i = 0; i < count; ++i) {
+            dataFunction_(destVec[i], start + i);
+        }
+    }
+
     virtual CachedGetter<AnalyticChannel>* newIterator() override {
         return new CachedGetter<AnalyticChannel>(this);
     }
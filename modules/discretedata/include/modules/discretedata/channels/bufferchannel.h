@@ -36,6 +36,8 @@
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/buffergetter.h>
 
+#include <tcb/span.hpp>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -100,6 +102,39 @@ public:
 
     const std::vector<T>& data() const { return buffer_; }
 
+    /**
+     * \brief Direct access to a contiguous range of elements
+     * Invalidated when the buffer is resized.
+     * @param start First linear index of the range
+     * @param count Number of elements, -1 for all remaining
+     */
+    template <typename VecNT = DefaultVec>
+    util::span<VecNT> span(ind start = 0, ind count = -1) {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        if (count < 0) count = size() - start;
+        IVW_ASSERT(start >= 0 && start + count <= size(), "Range out of bounds.");
+        return util::span<VecNT>(reinterpret_cast<VecNT*>(buffer_.data() + start * N),
+                                 static_cast<size_t>(count));
+    }
+
+    /**
+     * \brief Direct access to a contiguous range of elements, constant
+     * Invalidated when the buffer is resized.
+     * @param start First linear index of the range
+     * @param count Number of elements, -1 for all remaining
+     */
+    template <typename VecNT = DefaultVec>
+    util::span<const VecNT> span(ind start = 0, ind count = -1) const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        if (count < 0) count = size() - start;
+        IVW_ASSERT(start >= 0 && start + count <= size(), "Range out of bounds.");
+        return util::span<const VecNT>(
+            reinterpret_cast<const VecNT*>(buffer_.data() + start * N),
+            static_cast<size_t>(count));
+    }
+
     /**
      * \brief Indexed point access
      * @param index Linear point index
@@ -156,6 +191,16 @@ protected:
         memcpy(dest, &buffer_[index * N], sizeof(T) * N);
     }
 
+    /**
+     * \brief Contiguous block access, constant
+     * @param dest Position to write to, expect write of NumComponents * count many T
+     * @param start First linear index of the block
+     * @param count Number of elements in the block
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind count) const override {
+        if (count > 0) memcpy(dest, &buffer_[start * N], sizeof(T) * N * count);
+    }
+
     /**
      * \brief Vector containing the buffer data
      * Resizeable only by DataSet. Handle with care:
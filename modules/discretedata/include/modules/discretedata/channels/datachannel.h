@@ -34,6 +34,7 @@
 #include <modules/discretedata/channels/channel.h>
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/channeliterator.h>
+#include <inviwo/core/util/assertion.h>
 
 namespace inviwo {
 namespace discretedata {
@@ -47,6 +48,20 @@ public:
 
 protected:
     virtual void fillRaw(T* dest, ind index) const = 0;
+
+    /**
+     * \brief Contiguous block access, copy data
+     * Default implementation falls back to fillRaw per element.
+     * @param dest Position to write to, expect T[NumComponents * count]
+     * @param start First linear index of the block
+     * @param count Number of elements in the block
+     */
+    virtual void fillRawBlock(T* dest, ind start, ind count) const {
+        for (ind i = 0; i < count; ++i) {
+            fillRaw(dest + i * N, start + i);
+        }
+    }
+
     virtual ChannelGetter<T, N>* newIterator() = 0;
 };
 
@@ -106,6 +121,35 @@ public:
         fill(dest, index);
     }
 
+    /**
+     * \brief Block access, copy a contiguous range of elements
+     * One virtual call per block instead of one per element.
+     * Thread safe.
+     * @param dest Position to write to, expect VecNT[count]
+     * @param start First linear index of the block
+     * @param count Number of elements in the block
+     */
+    template <typename VecNT>
+    void fillBlock(VecNT* dest, ind start, ind count) const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        IVW_ASSERT(start >= 0 && count >= 0 && start + count <= this->size(),
+                   "Block out of range.");
+        this->fillRawBlock(reinterpret_cast<T*>(dest), start, count);
+    }
+
+    /**
+     * \brief Block access, copy a contiguous range of elements
+     * @param dest Vector to write to, resized to count
+     * @param start First linear index of the block
+     * @param count Number of elements in the block
+     */
+    template <typename VecNT>
+    void fillBlock(std::vector<VecNT>& dest, ind start, ind count) const {
+        dest.resize(count);
+        fillBlock(dest.data(), start, count);
+    }
+
     template <typename VecNT = DefaultVec>
     iterator<VecNT> begin() {
         return iterator<VecNT>(this->newIterator(), 0);
@@ -92,6 +92,23 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const = 0;
 
+    /**
+     * \brief Get the connections of a contiguous range of elements at once
+     * The result is stored compressed: the connections of element start + i are
+     * result[offsets[i]] to result[offsets[i + 1]]. The default implementation calls
+     * getConnections for each element, grids override it to avoid per-element overhead.
+     * @param result All connected indices in dimension 'to', cleared first
+     * @param offsets Start of each element's connections in result, size count + 1
+     * @param start Index of first element in dimension 'from'
+     * @param count Number of elements
+     * @param from Dimension the indices live in
+     * @param to Dimension the result lives in
+     * @param isPosition
+     */
+    virtual void getConnections(std::vector<ind>& result, std::vector<ind>& offsets, ind start,
+                                ind count, GridPrimitive from, GridPrimitive to,
+                                bool isPosition = false) const;
+
     /**
      * \brief Range of all elements to iterate over
      * @param dim Dimension to return the elements of
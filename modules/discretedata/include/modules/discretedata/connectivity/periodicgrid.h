@@ -60,6 +60,10 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const override;
 
+    virtual void getConnections(std::vector<ind>& result, std::vector<ind>& offsets, ind start,
+                                ind count, GridPrimitive from, GridPrimitive to,
+                                bool isPosition = false) const override;
+
 protected:
     void sameLevelConnection(std::vector<ind>& result, ind idxLin,
                              const std::vector<ind>& size) const;
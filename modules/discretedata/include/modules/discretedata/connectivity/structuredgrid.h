@@ -60,6 +60,15 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool positions = false) const override;
 
+    /**
+     * \brief Get the connections of a contiguous range of elements at once
+     * Cell to vertex connections are computed directly from the grid strides,
+     * walking the cell index incrementally. Other combinations use the generic path.
+     */
+    virtual void getConnections(std::vector<ind>& result, std::vector<ind>& offsets, ind start,
+                                ind count, GridPrimitive from, GridPrimitive to,
+                                bool positions = false) const override;
+
     static void sameLevelConnection(std::vector<ind>& result, ind idxLin,
                                     const std::vector<ind>& size);
 
@@ -43,6 +43,22 @@ ind Connectivity::getNumElements(GridPrimitive elementType) const {
     return numGridPrimitives_[(int)elementType];
 }
 
+void Connectivity::getConnections(std::vector<ind>& result, std::vector<ind>& offsets,
+                                  ind start, ind count, GridPrimitive from, GridPrimitive to,
+                                  bool isPosition) const {
+    result.clear();
+    offsets.resize(count + 1);
+    offsets[0] = 0;
+
+    std::vector<ind> connections;
+    for (ind i = 0; i < count; ++i) {
+        connections.clear();
+        getConnections(connections, start + i, from, to, isPosition);
+        result.insert(result.end(), connections.begin(), connections.end());
+        offsets[i + 1] = static_cast<ind>(result.size());
+    }
+}
+
 ElementRange Connectivity::all(GridPrimitive dim) const { return ElementRange(dim, this); }
 
 CellType Connectivity::getCellType(GridPrimitive dim, ind) const {
@@ -186,6 +186,18 @@ void PeriodicGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPrim
     assert(false && "Not implemented yet.");
 }
 
+void PeriodicGrid::getConnections(std::vector<ind>& result, std::vector<ind>& offsets,
+                                  ind start, ind count, GridPrimitive from, GridPrimitive to,
+                                  bool isPosition) const {
+    if (isPosition) {
+        // Position-wise, there is no difference from a StructuredGrid.
+        StructuredGrid::getConnections(result, offsets, start, count, from, to, isPosition);
+    } else {
+        // Wrapping is handled per element.
+        Connectivity::getConnections(result, offsets, start, count, from, to, isPosition);
+    }
+}
+
 ind PeriodicGrid::getNumCellsInDimension(ind dim) const {
     assert(numCellsPerDimension_[dim] >= 0 && "Number of elements not known yet.");
     return numCellsPerDimension_[dim];
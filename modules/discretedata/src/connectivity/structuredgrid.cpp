@@ -188,6 +188,57 @@ void StructuredGrid::getConnections(std::vector<ind>& result, ind idxLin, GridPr
     assert(false && "Not implemented yet.");
 }
 
+void StructuredGrid::getConnections(std::vector<ind>& result, std::vector<ind>& offsets,
+                                    ind start, ind count, GridPrimitive from, GridPrimitive to,
+                                    bool positions) const {
+    if (from != gridDimension_ || to != GridPrimitive::Vertex) {
+        return Connectivity::getConnections(result, offsets, start, count, from, to, positions);
+    }
+
+    const ind numDimensions = numCellsPerDimension_.size();
+    const ind numCorners = ind(1) << numDimensions;
+
+    // Vertex Strides - how much to add to the linear index to go forward by 1 in each dimension
+    std::vector<ind> vStrides(numDimensions);
+    ind dimProduct(1);
+    for (ind dim(0); dim < numDimensions; dim++) {
+        vStrides[dim] = dimProduct;
+        dimProduct *= (numCellsPerDimension_[dim] + 1);
+    }
+
+    // Corner offsets relative to the lower-left-front corner, the same for every cell.
+    std::vector<ind> cornerOffsets(numCorners, 0);
+    for (ind i(1); i < numCorners; i++) {
+        for (ind d(0); d < numDimensions; d++) {
+            if (i & (ind(1) << d)) cornerOffsets[i] += vStrides[d];
+        }
+    }
+
+    result.resize(count * numCorners);
+    offsets.resize(count + 1);
+
+    // Only the first cell index is computed by division, then it is advanced like an odometer.
+    std::vector<ind> cellIndex = indexFromLinear(start, numCellsPerDimension_);
+    for (ind c(0); c < count; c++) {
+        ind lowerLeftFrontVertexLinearIndex = 0;
+        for (ind dim(0); dim < numDimensions; dim++) {
+            lowerLeftFrontVertexLinearIndex += cellIndex[dim] * vStrides[dim];
+        }
+
+        ind* cellCorners = result.data() + c * numCorners;
+        for (ind i(0); i < numCorners; i++) {
+            cellCorners[i] = lowerLeftFrontVertexLinearIndex + cornerOffsets[i];
+        }
+        offsets[c] = c * numCorners;
+
+        for (ind dim(0); dim < numDimensions; dim++) {
+            if (++cellIndex[dim] < numCellsPerDimension_[dim]) break;
+            cellIndex[dim] = 0;
+        }
+    }
+    offsets[count] = count * numCorners;
+}
+
 ind StructuredGrid::getNumCellsInDimension(ind dim) const {
     assert(numCellsPerDimension_[dim] >= 0 && "Number of elements not known yet.");
     return numCellsPerDimension_[dim];
@@ -40,6 +40,8 @@
 #include <modules/discretedata/connectivity/connectioniterator.h>
 #include <modules/discretedata/connectivity/structuredgrid.h>
 
+#include <numeric>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -73,5 +75,44 @@ TEST(AccessingData, Connectivity) {
     EXPECT_TRUE(allFine && "Connectivity is not bi-directional.");
 }
 
+TEST(AccessingData, BlockAccess) {
+    std::vector<ind> size = {4, 5, 6};
+    auto grid = std::make_shared<StructuredGrid>(GridPrimitive::Volume, size);
+    const ind numCells = grid->getNumElements(GridPrimitive::Volume);
+
+    // Batched connections have to agree with the per-element ones.
+    std::vector<ind> connections, offsets, single;
+    grid->getConnections(connections, offsets, 3, numCells - 3, GridPrimitive::Volume,
+                         GridPrimitive::Vertex);
+    ASSERT_EQ(offsets.size(), static_cast<size_t>(numCells - 2));
+    for (ind cell = 3; cell < numCells; ++cell) {
+        single.clear();
+        grid->getConnections(single, cell, GridPrimitive::Volume, GridPrimitive::Vertex);
+        const std::vector<ind> batched(connections.begin() + offsets[cell - 3],
+                                       connections.begin() + offsets[cell - 2]);
+        EXPECT_EQ(single, batched);
+    }
+
+    std::vector<float> raw(30);
+    std::iota(raw.begin(), raw.end(), 0.0f);
+    BufferChannel<float, 3> buffer(raw, "Buffer");
+    AnalyticChannel<float, 3, vec3> analytic(
+        [](vec3& val, ind idx) { val = vec3(3 * idx, 3 * idx + 1, 3 * idx + 2); }, 10,
+        "Analytic");
+
+    std::vector<vec3> block;
+    buffer.fillBlock(block, 2, 5);
+    auto span = buffer.span<vec3>(2, 5);
+    ASSERT_EQ(span.size(), block.size());
+    for (size_t i = 0; i < block.size(); ++i) {
+        EXPECT_EQ(block[i], span[i]);
+        vec3 val;
+        analytic.fill(val, 2 + static_cast<ind>(i));
+        EXPECT_EQ(block[i], val);
+    }
+    analytic.fillBlock(block, 0, 10);
+    EXPECT_EQ(block.back(), vec3(27, 28, 29));
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
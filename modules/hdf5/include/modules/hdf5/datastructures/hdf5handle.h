@@ -30,6 +30,7 @@
 #pragma once
 
 #include <modules/hdf5/hdf5moduledefine.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/stdextensions.h>
@@ -83,9 +84,21 @@ public:
 
     Handle* getHandleForPath(const std::string& path) const;
 
+    /**
+     * Create a volume from a selection of the dataset at path.
+     * The data is read in slabs aligned to the chunks of the dataset such that every chunk is only
+     * read and decompressed once, even for strided selections.
+     * @param path of the dataset relative to this handle
+     * @param selection one selection per dimension of the dataset, in column major order
+     * @param type the format of the resulting volume, if nullptr the format of the dataset is used
+     * @param lazy if true, the data is not read until a representation is requested. The volume
+     *             will then only hold a VolumeDisk and the data range is set from the type.
+     *             Otherwise the data is read directly and the data range is computed from it.
+     */
     std::shared_ptr<Volume> getVolumeAtPathAsType(const Path& path,
                                                   std::vector<Selection> selection,
-                                                  const DataFormatBase* type) const;
+                                                  const DataFormatBase* type,
+                                                  bool lazy = false) const;
 
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
@@ -106,6 +119,34 @@ private:
     H5::Group data_;
 };
 
+/**
+ * Reads a selection of a dataset into a VolumeRAM when the VolumeDisk representation created by
+ * Handle::getVolumeAtPathAsType is converted. Each load opens its own file handle.
+ * Regions are read as a hyperslab of the selection, i.e. only the selected elements are read.
+ */
+class IVW_MODULE_HDF5_API VolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    VolumeRAMLoader(std::string filename, Path group, Path path,
+                    std::vector<Handle::Selection> selection);
+    virtual VolumeRAMLoader* clone() const override;
+    virtual ~VolumeRAMLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                      const VolumeRepresentation& src) const override;
+
+    virtual bool supportsRegions() const override;
+    virtual std::shared_ptr<VolumeRepresentation> createRegionRepresentation(
+        const VolumeRepresentation& src, const DiskRegion& region) const override;
+
+private:
+    std::string filename_;
+    Path group_;
+    Path path_;
+    std::vector<Handle::Selection> selection_;
+};
+
 template <typename T>
 std::vector<T> Handle::getVectorAtPath(const Path& path) const {
     H5::DataSet ds = data_.openDataSet(path);
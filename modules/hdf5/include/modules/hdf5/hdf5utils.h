@@ -39,6 +39,7 @@
 #include <H5Cpp.h>
 #include <warn/pop>
 
+#include <mutex>
 #include <vector>
 
 namespace inviwo {
@@ -59,6 +60,14 @@ IVW_MODULE_HDF5_API Paths findpaths(const H5::Group& grp, const Path& path,
 IVW_MODULE_HDF5_API bool isOfType(const H5::Group& grp, const std::string& type);
 IVW_MODULE_HDF5_API VolumeInfos getVolumeInfo(const H5::DataSet& ds, const Path& path);
 
+/**
+ * Serializes calls into the HDF5 library. Unless the library is built thread safe all of its
+ * state is global, and calls from different threads, like volumes loaded on the thread pool, must
+ * not overlap. Hold the returned lock, declared before any H5 objects, for as long as HDF5 is
+ * used. The lock is recursive and does not lock anything if the library is thread safe.
+ */
+IVW_MODULE_HDF5_API std::unique_lock<std::recursive_mutex> lock();
+
 }  // namespace hdf5
 
 }  // namespace inviwo
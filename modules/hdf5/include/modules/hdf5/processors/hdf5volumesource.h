@@ -64,6 +64,8 @@ namespace hdf5 {
  *   * __Value range__ ...
  *   * __Dimensions__ ...
  *   * __Automatic loading__ ...
+ *   * __Load on demand__ Only read the data when a representation of the volume is requested.
+ *                        The data range will be set from the data type instead of the data.
  *   * __Basis__ ...
  *   * __Use Range__ ...
  *   * __Spacing__ ...
@@ -146,6 +148,7 @@ private:
     OptionPropertyString volumeSelection_;
 
     BoolProperty automaticEvaluation_;
+    BoolProperty loadOnDemand_;
     ButtonProperty evaluate_;
 
     CompositeProperty basisGroup_;
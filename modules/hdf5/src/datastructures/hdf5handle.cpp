@@ -34,10 +34,16 @@
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/io/decodedvolumecache.h>
 
 #include <modules/base/algorithm/dataminmax.h>
 
 #include <algorithm>
+#include <array>
+#include <numeric>
+
+#include <fmt/format.h>
 
 namespace inviwo {
 
@@ -45,9 +51,238 @@ namespace hdf5 {
 
 namespace {
 H5::Group load(const std::string& filename, const std::string& path) {
+    const auto guard = lock();
     H5::H5File hdfFile(filename, H5F_ACC_RDONLY);
     return hdfFile.openGroup(path);
 }
+
+/*
+ * Compressed datasets are worth keeping in the DecodedVolumeCache, the settings identify the
+ * selection within the file
+ */
+DecodedVolumeCache* getCache(const H5::DataSet& dataset) {
+    auto cache = ::inviwo::util::getDecodedVolumeCache();
+    if (!cache || !cache->isEnabled()) return nullptr;
+    return dataset.getCreatePlist().getNfilters() > 0 ? cache : nullptr;
+}
+
+std::string cacheSettings(const std::string& group, const std::string& path,
+                          const std::vector<Handle::Selection>& selection,
+                          const DataFormatBase* format) {
+    auto settings = fmt::format("{}:{} {}", group, path, format->getString());
+    for (const auto& s : selection) {
+        settings += fmt::format(" {}:{}:{}", s.start, s.end, s.stride);
+    }
+    return settings;
+}
+
+size_t nextPrime(size_t n) {
+    const auto isPrime = [](size_t v) {
+        if (v < 2) return false;
+        for (size_t d = 2; d * d <= v; ++d) {
+            if (v % d == 0) return false;
+        }
+        return true;
+    };
+    while (!isPrime(n)) ++n;
+    return n;
+}
+
+/*
+ * A hyperslab selection of a dataset in HDF (row major) order
+ */
+struct HyperSlab {
+    std::vector<hsize_t> start;
+    std::vector<hsize_t> count;
+    std::vector<hsize_t> stride;
+    // Row major dimensions of the memory, the first dimension with count > 1 maps to the first
+    // memory dimension.
+    std::vector<hsize_t> memoryDimensions{1, 1, 1};
+    // Column major dimensions of the resulting volume
+    size3_t volumeDimensions{1};
+};
+
+HyperSlab toHyperSlab(std::vector<Handle::Selection> selection, size_t rank) {
+    if (selection.size() != rank) {
+        throw Exception("Selection not of the same rank as the data",
+                        IVW_CONTEXT_CUSTOM("hdf5::Handle"));
+    }
+
+    /*
+     * Column major, i.e. the FIRST listed dimension is the fasted changing
+     * Inviwo, OpenGL, matlab, Fortran
+     *
+     * Row major, i.e. the LAST listed dimension is the fasted changing
+     * HDF, C/C++, Mathematica, Python
+     *
+     * Solution reverse all the dimension lists.
+     * Row major version of the selection to match the hdf row major dataDimensions.
+     */
+    std::reverse(selection.begin(), selection.end());
+
+    HyperSlab slab;
+    slab.start.resize(rank);
+    slab.count.resize(rank);
+    slab.stride.resize(rank);
+
+    int resRank = 0;
+    for (size_t i = 0; i < rank; ++i) {
+        slab.start[i] = selection[i].start;
+        slab.count[i] =
+            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
+        slab.stride[i] = selection[i].stride;
+
+        if (slab.count[i] > 1) {
+            if (resRank > 2) {
+                throw Exception("Invalid selection, resulting rank > 3",
+                                IVW_CONTEXT_CUSTOM("hdf5::Handle"));
+            }
+            slab.memoryDimensions[resRank] = slab.count[i];
+            slab.volumeDimensions[resRank] = slab.count[i];
+            resRank++;
+        }
+    }
+    // Reverse back the Column major
+    std::reverse(&slab.volumeDimensions[0],
+                 &slab.volumeDimensions[0] + slab.volumeDimensions.length());
+    return slab;
+}
+
+std::vector<hsize_t> getChunkDimensions(const H5::DataSet& dataset, size_t rank) {
+    const auto plist = dataset.getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED) return {};
+    std::vector<hsize_t> chunk(rank);
+    plist.getChunk(static_cast<int>(rank), chunk.data());
+    return chunk;
+}
+
+/*
+ * Open the dataset with a chunk cache large enough to hold all chunks that intersect one row of
+ * chunks of the selection. Together with the slab wise reading in readHyperSlab that makes sure
+ * each chunk is only read and decompressed once.
+ */
+H5::DataSet openDataSet(const H5::Group& group, const std::string& path,
+                        const std::vector<Handle::Selection>& selection) {
+    auto dataset = group.openDataSet(path);
+    const size_t rank = dataset.getSpace().getSimpleExtentNdims();
+    const auto chunk = getChunkDimensions(dataset, rank);
+    if (chunk.empty() || selection.size() != rank) return dataset;
+
+    const auto slab = toHyperSlab(selection, rank);
+    const auto first = std::find_if(slab.count.begin(), slab.count.end(),
+                                    [](hsize_t count) { return count > 1; });
+    if (first == slab.count.end()) return dataset;
+    const auto split = static_cast<size_t>(std::distance(slab.count.begin(), first));
+
+    size_t chunks = 1;
+    for (size_t i = 0; i < rank; ++i) {
+        if (i == split || slab.count[i] == 0) continue;
+        const auto last = slab.start[i] + (slab.count[i] - 1) * slab.stride[i];
+        chunks *= static_cast<size_t>(last / chunk[i] - slab.start[i] / chunk[i] + 1);
+    }
+    const size_t chunkBytes =
+        std::accumulate(chunk.begin(), chunk.end(), size_t{1}, std::multiplies<>{}) *
+        dataset.getDataType().getSize();
+
+    const size_t defaultBytes = 1024 * 1024;
+    if (chunks * chunkBytes <= defaultBytes) return dataset;
+
+    dataset.close();
+    H5::DSetAccPropList dapl;
+    // The number of slots should be a prime number, about 100 times the number of chunks.
+    dapl.setChunkCache(nextPrime(100 * chunks), chunks * chunkBytes,
+                       H5D_CHUNK_CACHE_W0_DEFAULT);
+    return group.openDataSet(path, dapl);
+}
+
+/*
+ * Read the selection into dest. For chunked datasets the selection is split along the slowest
+ * varying selected dimension into slabs that each cover one row of chunks.
+ */
+void readHyperSlab(const H5::DataSet& dataset, const HyperSlab& slab, void* dest,
+                   const H5::DataType& memoryType) {
+    H5::DataSpace dataSpace = dataset.getSpace();
+    H5::DataSpace memorySpace(3, slab.memoryDimensions.data());
+
+    const auto rank = slab.start.size();
+    const auto chunk = getChunkDimensions(dataset, rank);
+    const auto first = std::find_if(slab.count.begin(), slab.count.end(),
+                                    [](hsize_t count) { return count > 1; });
+
+    if (chunk.empty() || first == slab.count.end()) {
+        dataSpace.selectHyperslab(H5S_SELECT_SET, slab.count.data(), slab.start.data(),
+                                  slab.stride.data(), nullptr);
+        memorySpace.selectAll();
+        dataset.read(dest, memoryType, memorySpace, dataSpace);
+        return;
+    }
+
+    const auto split = static_cast<size_t>(std::distance(slab.count.begin(), first));
+    auto start = slab.start;
+    auto count = slab.count;
+    std::vector<hsize_t> memoryStart{0, 0, 0};
+    auto memoryCount = slab.memoryDimensions;
+
+    for (hsize_t i = 0; i < slab.count[split];) {
+        const hsize_t pos = slab.start[split] + i * slab.stride[split];
+        const hsize_t chunkEnd = (pos / chunk[split] + 1) * chunk[split];
+        // number of selected elements in this row of chunks
+        const hsize_t n = std::min(slab.count[split] - i,
+                                   (chunkEnd - pos + slab.stride[split] - 1) / slab.stride[split]);
+
+        start[split] = pos;
+        count[split] = n;
+        memoryStart[0] = i;
+        memoryCount[0] = n;
+
+        dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), slab.stride.data(),
+                                  nullptr);
+        memorySpace.selectHyperslab(H5S_SELECT_SET, memoryCount.data(), memoryStart.data());
+        dataset.read(dest, memoryType, memorySpace, dataSpace);
+
+        i += n;
+    }
+}
+
+/*
+ * The index of the selected dimension for each of the volume axes x, y, and z, or -1 for axes
+ * that are not part of the selection. Follows the order of the dimensions in toHyperSlab.
+ */
+std::array<int, 3> selectionAxes(const std::vector<Handle::Selection>& selection) {
+    std::array<int, 3> axes{-1, -1, -1};
+    int resRank = 0;
+    for (size_t i = selection.size(); i-- > 0 && resRank < 3;) {
+        const auto& s = selection[i];
+        if ((s.end - s.start) / s.stride > 1) axes[2 - resRank++] = static_cast<int>(i);
+    }
+    return axes;
+}
+
+/*
+ * Read the selection of the dataset at path into dest, which has to have as many voxels as the
+ * selection.
+ */
+void readSelection(const std::string& filename, const Path& group, const Path& path,
+                   const std::vector<Handle::Selection>& selection, VolumeRAM& dest) {
+    const auto guard = lock();
+    const auto data = load(filename, group);
+    auto dataset = openDataSet(data, path, selection);
+    ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
+    const size_t rank = dataset.getSpace().getSimpleExtentNdims();
+    const auto slab = toHyperSlab(selection, rank);
+
+    dest.dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+        using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+        try {
+            readHyperSlab(dataset, slab, vrprecision->getDataTyped(),
+                          TypeMap<ValueType>::getType());
+        } catch (H5::DataSetIException& e) {
+            throw Exception("HDF: unable to read data: " + e.getDetailMsg(),
+                            IVW_CONTEXT_CUSTOM("hdf5::VolumeRAMLoader"));
+        }
+    });
+}
+
 }  // namespace
 
 Handle::Handle(std::string filename)
@@ -66,6 +301,7 @@ Handle& Handle::operator=(Handle&& that) {
     if (this != &that) {
         filename_ = that.filename_;
         path_ = that.path_;
+        const auto guard = lock();
         data_.close();
         H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
         data_ = hdfFile.openGroup(path_);
@@ -77,6 +313,7 @@ Handle& Handle::operator=(const Handle& that) {
     if (this != &that) {
         filename_ = that.filename_;
         path_ = that.path_;
+        const auto guard = lock();
         data_.close();
         H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
         data_ = hdfFile.openGroup(path_);
@@ -84,7 +321,10 @@ Handle& Handle::operator=(const Handle& that) {
     return *this;
 }
 
-Handle::~Handle() { data_.close(); }
+Handle::~Handle() {
+    const auto guard = lock();
+    data_.close();
+}
 
 Handle* Handle::getHandleForPath(const std::string& path) const {
     return new Handle(this->filename_, path_ + path);
@@ -125,71 +365,45 @@ double Handle::getMax(const DataFormatBase* type) const {
 
 std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
-                                                      const DataFormatBase* type) const {
-
-    auto dataset = data_.openDataSet(path);
+                                                      const DataFormatBase* type, bool lazy) const {
+    const auto guard = lock();
+    auto dataset = openDataSet(data_, path, selection);
     ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
 
     const H5::DataSpace dataSpace = dataset.getSpace();
     const size_t rank = dataSpace.getSimpleExtentNdims();
-    if (selection.size() != rank) {
-        throw Exception("Selection not of the same rank as the data", IVW_CONTEXT);
-    }
 
     std::vector<hsize_t> dataDimensions(rank);
     dataSpace.getSimpleExtentDims(dataDimensions.data());
     const hsize_t dataSize = dataSpace.getSelectNpoints();
 
-    std::vector<hsize_t> start(rank);
-    std::vector<hsize_t> count(rank);
-    std::vector<hsize_t> stride(rank);
-
-    /*
-     * Column major, i.e. the FIRST listed dimension is the fasted changing
-     * Inviwo, OpenGL, matlab, Fortran
-     *
-     * Row major, i.e. the LAST listed dimension is the fasted changing
-     * HDF, C/C++, Mathematica, Python
-     *
-     * Solution reverse all the dimension lists.
-     * Row major version of the selection to match the hdf row major dataDimensions.
-     */
-    std::reverse(selection.begin(), selection.end());
+    const auto slab = toHyperSlab(selection, rank);
+    const auto volumeDimensions = slab.volumeDimensions;
+    const hsize_t selectionSize = glm::compMul(volumeDimensions);
 
-    size3_t volumeDimensions(1);
-    int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
+    LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
+                          << dataSize << " selection " << selectionSize << " memory dim "
+                          << volumeDimensions);
 
-    for (size_t i = 0; i < rank; ++i) {
-        start[i] = selection[i].start;
-        count[i] =
-            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
-        stride[i] = selection[i].stride;
+    const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
 
-        if (count[i] > 1) {
-            if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
-            volumeDimensions[resRank] = count[i];
-            resRank++;
-        }
+    auto cache = lazy ? nullptr : getCache(dataset);
+    const auto settings = cache ? cacheSettings(path_, path, selection, format) : std::string{};
+    if (cache) {
+        if (auto volume = cache->load(filename_, settings)) return volume;
     }
 
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
-
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
-
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
+    if (lazy) {
+        auto volume = std::make_shared<Volume>(volumeDimensions, format);
+        volume->dataMap_.dataRange = dvec2{getMin(format), getMax(format)};
+        volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
-    LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
-
-    const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
+        auto volumeDisk = std::make_shared<VolumeDisk>(filename_, volumeDimensions, format);
+        volumeDisk->setLoader(new VolumeRAMLoader(filename_, path_, path, std::move(selection)));
+        volume->addRepresentation(volumeDisk);
+        return volume;
+    }
 
-    // Reverse back the Column major
-    std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
     auto volumeram = createVolumeRAM(volumeDimensions, format);
 
     auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
@@ -199,7 +413,7 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
             ValueType* data = vrprecision->getDataTyped();
 
             try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
+                readHyperSlab(dataset, slab, data, TypeMap<ValueType>::getType());
             } catch (H5::DataSetIException& e) {
                 throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
             }
@@ -219,6 +433,7 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
     volume->dataMap_.valueRange = volume->dataMap_.dataRange;
 
     volume->addRepresentation(volumeram);
+    if (cache) cache->store(filename_, settings, *volume);
 
     return volume;
 }
@@ -231,6 +446,74 @@ const std::string Handle::dataName = "HDF";
 
 const H5::Group& Handle::getGroup() const { return data_; }
 
+VolumeRAMLoader::VolumeRAMLoader(std::string filename, Path group, Path path,
+                                 std::vector<Handle::Selection> selection)
+    : filename_{std::move(filename)}
+    , group_{std::move(group)}
+    , path_{std::move(path)}
+    , selection_{std::move(selection)} {}
+
+VolumeRAMLoader* VolumeRAMLoader::clone() const { return new VolumeRAMLoader(*this); }
+
+std::shared_ptr<VolumeRepresentation> VolumeRAMLoader::createRepresentation(
+    const VolumeRepresentation& src) const {
+    const auto guard = lock();
+    auto cache = [&]() -> DecodedVolumeCache* {
+        auto enabled = ::inviwo::util::getDecodedVolumeCache();
+        if (!enabled || !enabled->isEnabled()) return nullptr;
+        const auto group = load(filename_, group_);
+        auto dataset = group.openDataSet(path_);
+        ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
+        return getCache(dataset);
+    }();
+    const auto settings =
+        cache ? cacheSettings(group_, path_, selection_, src.getDataFormat()) : std::string{};
+    if (cache) {
+        if (auto volumeRAM = cache->loadRepresentation(filename_, settings, src)) {
+            return volumeRAM;
+        }
+    }
+
+    auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(), nullptr,
+                                     src.getSwizzleMask(), src.getInterpolation(),
+                                     src.getWrapping());
+    updateRepresentation(volumeRAM, src);
+    if (cache) cache->store(filename_, settings, *volumeRAM);
+    return volumeRAM;
+}
+
+void VolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
+                                           const VolumeRepresentation& src) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    if (volumeDst->getDimensions() != src.getDimensions()) {
+        throw Exception("HDF: dimensions of the destination does not match the selection",
+                        IVW_CONTEXT);
+    }
+    readSelection(filename_, group_, path_, selection_, *volumeDst);
+}
+
+bool VolumeRAMLoader::supportsRegions() const { return true; }
+
+std::shared_ptr<VolumeRepresentation> VolumeRAMLoader::createRegionRepresentation(
+    const VolumeRepresentation& src, const DiskRegion& region) const {
+    // The region is relative to the selection, compose them into a new selection
+    const auto out = region.getOutputDimensions();
+    const auto axes = selectionAxes(selection_);
+    auto selection = selection_;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (axes[axis] < 0) continue;
+        auto& s = selection[axes[axis]];
+        s.start += region.offset[axis] * s.stride;
+        s.stride *= region.stride[axis];
+        s.end = s.start + out[axis] * s.stride;
+    }
+
+    auto volumeRAM = createVolumeRAM(out, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    readSelection(filename_, group_, path_, selection, *volumeRAM);
+    return volumeRAM;
+}
+
 }  // namespace hdf5
 
 }  // namespace inviwo
@@ -52,6 +52,17 @@ Paths findpaths(const H5::Group& grp, const Path& path, const std::string& type)
     return paths;
 }
 
+std::unique_lock<std::recursive_mutex> lock() {
+    static const bool threadSafe = []() {
+        hbool_t isThreadSafe = false;
+        return H5is_library_threadsafe(&isThreadSafe) >= 0 && isThreadSafe;
+    }();
+    if (threadSafe) return {};
+
+    static std::recursive_mutex mutex;
+    return std::unique_lock<std::recursive_mutex>{mutex};
+}
+
 VolumeInfos getVolumeInfo(const H5::DataSet& ds, const Path& path) {
     auto size = std::make_unique<hsize_t[]>(ds.getSpace().getSimpleExtentNdims());
     ds.getSpace().getSimpleExtentDims(size.get());
@@ -56,12 +56,14 @@ PathSelection::PathSelection()
 
 void PathSelection::process() {
     if (inport_.hasData()) {
+        const auto guard = lock();
         auto data = inport_.getData();
         outport_.setData(data->getHandleForPath(selection_.getSelectedValue()));
     }
 }
 
 void PathSelection::onDataChange() {
+    const auto guard = lock();
     const auto data = inport_.getData();
 
     std::vector<OptionPropertyStringOption> options;
@@ -55,6 +55,7 @@ void Source::process() {
     }
 
     try {
+        const auto guard = lock();
         auto data = std::make_shared<Handle>(file_.get());
         port_.setData(data);
     } catch (H5::Exception& e) {
@@ -61,6 +61,7 @@ HDF5ToVolume::HDF5ToVolume()
 
     , automaticEvaluation_("automaticEvaluation", "Automatic loading", true,
                            InvalidationLevel::Valid)
+    , loadOnDemand_("loadOnDemand", "Load on demand", false)
     , evaluate_("evaluate", "Load")
 
     , basisGroup_("basisGroup", "Basis")
@@ -104,6 +105,7 @@ HDF5ToVolume::HDF5ToVolume()
     automaticEvaluation_.onChange([this]() { evaluate_.setReadOnly(automaticEvaluation_); });
 
     evaluate_.onChange([this]() { dirty_ = true; });
+    loadOnDemand_.onChange([this]() { dirty_ = true; });
 
     basisGroup_.addProperties(basisSelection_, spacing_, basis_);
 
@@ -123,8 +125,8 @@ HDF5ToVolume::HDF5ToVolume()
         }
     });
 
-    addProperties(volumeSelection_, automaticEvaluation_, evaluate_, basisGroup_, information_,
-                  outputGroup_);
+    addProperties(volumeSelection_, automaticEvaluation_, loadOnDemand_, evaluate_, basisGroup_,
+                  information_, outputGroup_);
 }
 
 HDF5ToVolume::~HDF5ToVolume() = default;
@@ -195,6 +197,7 @@ mat4 HDF5ToVolume::getBasisFromMeta(MetaData meta) {
     mat4 basis(1.0f);
 
     if (inport_.hasData()) {
+        const auto guard = lock();
         const auto data = inport_.getData();
         H5::DataSet dataset = data->getGroup().openDataSet(meta.path_);
         H5::DataSpace space = dataset.getSpace();
@@ -228,6 +231,7 @@ mat4 HDF5ToVolume::getBasisFromMeta(MetaData meta) {
 
 void HDF5ToVolume::onDataChange() {
     if (inport_.hasData()) {
+        const auto guard = lock();
         const auto data = inport_.getData();
 
         std::vector<MetaData> metadata = util::getMetaData(data->getGroup());
@@ -316,6 +320,7 @@ void HDF5ToVolume::onSelectionChange() {
 
 void HDF5ToVolume::makeVolume() {
     if (inport_.hasData()) {
+        const auto guard = lock();
         const auto data = inport_.getData();
         MetaData volumeMeta = volumeMatches_[volumeSelection_.getSelectedIndex()];
 
@@ -337,7 +342,8 @@ void HDF5ToVolume::makeVolume() {
 
             volume_ = std::shared_ptr<Volume>(
                 data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
-                                            selection_.getSelection(), format));
+                                            selection_.getSelection(), format,
+                                            loadOnDemand_.get()));
 
             dataRange_.set(volume_->dataMap_.dataRange);
             outport_.setData(volume_);
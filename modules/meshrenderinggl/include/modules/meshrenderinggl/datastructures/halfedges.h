@@ -35,12 +35,14 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>  // for Mesh
 #include <inviwo/core/util/iterrange.h>                // for as_range
 #include <inviwo/core/util/transformiterator.h>        // for TransformIterator, make...
+#include <inviwo/core/util/zip.h>                      // for make_sequence
 
-#include <cstdint>        // for uint32_t
-#include <iterator>       // for bidirectional_iterator_tag
-#include <optional>       // for optional, nullopt
-#include <unordered_map>  // for unordered_map<>::const_...
-#include <vector>         // for vector
+#include <cstdint>    // for uint32_t
+#include <iterator>   // for bidirectional_iterator_tag
+#include <limits>     // for numeric_limits
+#include <optional>   // for optional, nullopt
+#include <stdexcept>  // for out_of_range
+#include <vector>     // for vector
 
 namespace inviwo {
 
@@ -63,6 +65,10 @@ namespace inviwo {
  *     ╱ ▼────e0─────▶ ╲ ╱
  *   v0────────────────v1
  *
+ * The half edges are stored in flat arrays. The three half edges of face f are stored
+ * consecutively starting at index 3f, and the half edges starting at each vertex are kept in a
+ * compressed sparse row (CSR) layout, built with a counting sort on the vertex index. Twins are
+ * matched in parallel by searching the row of the end vertex instead of using a hash map.
  */
 
 class IVW_MODULE_MESHRENDERINGGL_API HalfEdges {
@@ -130,12 +136,27 @@ public:
     EdgeIter faceToEdge(std::uint32_t faceIndex) const;
     EdgeIter vertexToEdge(std::uint32_t vertexIndex) const;
 
+    /**
+     * \brief All half edges starting at the given vertex, in order of increasing edge index.
+     */
+    auto vertexEdges(std::uint32_t vertexIndex) const;
+
     auto faces() const;
     auto vertices() const;
 
+    std::uint32_t numberOfFaces() const;
+
 private:
     friend EdgeIter;
 
+    static constexpr std::uint32_t noEdge = std::numeric_limits<std::uint32_t>::max();
+
+    void addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c);
+    /**
+     * \brief Build the vertex rows and match twins, called once all faces have been added.
+     */
+    void build();
+
     /**
      * \brief A single half edge
      */
@@ -159,40 +180,72 @@ private:
 
         /**
          * \brief Twin half edge, opposite direction.
-         * nullopt if border.
+         * noEdge if border.
          */
-        std::optional<std::uint32_t> twin = std::nullopt;
+        std::uint32_t twin = noEdge;
     };
 
     std::vector<HalfEdge> edges_;
-    std::unordered_map<std::uint32_t, std::uint32_t> vertexToEdge_;
-    std::unordered_map<std::uint32_t, std::uint32_t> faceToEdge_;
+    /**
+     * \brief Offsets into vertexEdges_, the half edges of vertex v are found in
+     * [vertexOffsets_[v], vertexOffsets_[v + 1])
+     */
+    std::vector<std::uint32_t> vertexOffsets_;
+    /**
+     * \brief Half edge indices grouped by their vertex
+     */
+    std::vector<std::uint32_t> vertexEdges_;
+    /**
+     * \brief The first half edge of each vertex that is referenced by any face
+     */
+    std::vector<std::uint32_t> vertexToEdge_;
 };
 
 inline auto HalfEdges::faceToEdge(std::uint32_t faceIndex) const -> EdgeIter {
-    return {this, faceToEdge_.at(faceIndex)};
+    if (faceIndex >= numberOfFaces()) {
+        throw std::out_of_range("Face index out of range");
+    }
+    return {this, 3 * faceIndex};
 }
 
 inline auto HalfEdges::vertexToEdge(std::uint32_t vertexIndex) const -> EdgeIter {
-    return {this, vertexToEdge_.at(vertexIndex)};
+    if (vertexIndex + 1 >= vertexOffsets_.size() ||
+        vertexOffsets_[vertexIndex] == vertexOffsets_[vertexIndex + 1]) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    return {this, vertexEdges_[vertexOffsets_[vertexIndex]]};
 }
 
-inline auto HalfEdges::faces() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
+inline auto HalfEdges::vertexEdges(std::uint32_t vertexIndex) const {
+    const auto transform = [this](const std::uint32_t& edge) -> EdgeIter {
+        return {this, edge};
     };
+    const auto begin = vertexIndex + 1 < vertexOffsets_.size()
+                           ? vertexEdges_.begin() + vertexOffsets_[vertexIndex]
+                           : vertexEdges_.end();
+    const auto end = vertexIndex + 1 < vertexOffsets_.size()
+                         ? vertexEdges_.begin() + vertexOffsets_[vertexIndex + 1]
+                         : vertexEdges_.end();
+    return util::as_range(util::makeTransformIterator(transform, begin),
+                          util::makeTransformIterator(transform, end));
+}
+
+inline std::uint32_t HalfEdges::numberOfFaces() const {
+    return static_cast<std::uint32_t>(edges_.size() / 3);
+}
 
-    return util::as_range(util::makeTransformIterator(transform, faceToEdge_.begin()),
-                          util::makeTransformIterator(transform, faceToEdge_.end()));
+inline auto HalfEdges::faces() const {
+    const auto transform = [this](const std::uint32_t& face) -> EdgeIter {
+        return {this, 3 * face};
+    };
+    const auto seq = util::make_sequence<std::uint32_t>(0, numberOfFaces(), 1);
+    return util::as_range(util::makeTransformIterator(transform, seq.begin()),
+                          util::makeTransformIterator(transform, seq.end()));
 }
 
 inline auto HalfEdges::vertices() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
+    const auto transform = [this](const std::uint32_t& edge) -> EdgeIter {
+        return {this, edge};
     };
 
     return util::as_range(util::makeTransformIterator(transform, vertexToEdge_.begin()),
@@ -213,8 +266,9 @@ inline auto HalfEdges::EdgeIter::prev() const -> EdgeIter {
 }
 
 inline auto HalfEdges::EdgeIter::twin() const -> std::optional<EdgeIter> {
-    if (auto twin = edges_->edges_[edgeIndex_].twin) {
-        return EdgeIter{edges_, *twin};
+    const auto twin = edges_->edges_[edgeIndex_].twin;
+    if (twin != noEdge) {
+        return EdgeIter{edges_, twin};
     } else {
         return std::nullopt;
     }
@@ -37,15 +37,18 @@
 #include <inviwo/core/datastructures/representationconverter.h>         // for RepresentationCon...
 #include <inviwo/core/datastructures/representationconverterfactory.h>  // for RepresentationCon...
 #include <inviwo/core/util/exception.h>                                 // for Exception
+#include <inviwo/core/util/foreach.h>                                   // for forEachParallel
 #include <inviwo/core/util/formatdispatching.h>                         // for Floats
 #include <inviwo/core/util/glmconvert.h>                                // for glm_convert
 #include <inviwo/core/util/glmvec.h>                                    // for vec3, dvec3
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT_CUSTOM
 #include <modules/base/algorithm/meshutils.h>                           // for forEachTriangle
 
-#include <algorithm>      // for transform
+#include <array>          // for array
 #include <cmath>          // for acos
+#include <cstdint>        // for uint32_t
 #include <limits>         // for numeric_limits
+#include <numeric>        // for partial_sum
 #include <string>         // for string
 #include <string_view>    // for string_view
 #include <unordered_map>  // for unordered_map
@@ -79,81 +82,109 @@ void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
     }
 
     auto vertices = positions->getRepresentation<BufferRAM>();
-    std::vector<vec3> normals(vertices->getSize(), vec3(0.0f));
+    const auto numVertices = vertices->getSize();
 
-    // loop over index buffers
+    using Triangle = std::array<std::uint32_t, 3>;
+    std::vector<Triangle> triangles;
     for (auto [meshInfo, buffer] : mesh.getIndexBuffers()) {
         if (meshInfo.dt != DrawType::Triangles) continue;
+        meshutil::forEachTriangle(meshInfo, *buffer,
+                                  [&](std::uint32_t i0, std::uint32_t i1, std::uint32_t i2) {
+                                      triangles.push_back({i0, i1, i2});
+                                  });
+    }
+
+    // weighted face normal for each corner of each triangle, computed in parallel over faces
+    std::vector<vec3> corners(3 * triangles.size(), vec3(0.0f));
+    vertices->dispatch<void, dispatching::filter::Floats>([&](auto ram) {
+        const auto& vert = ram->getDataContainer();
+
+        util::forEachParallel(triangles, [&](const Triangle& tri, size_t face) {
+            const auto v0 = util::glm_convert<dvec3>(vert[tri[0]]);
+            const auto v1 = util::glm_convert<dvec3>(vert[tri[1]]);
+            const auto v2 = util::glm_convert<dvec3>(vert[tri[2]]);
+
+            const dvec3 n = cross(v1 - v0, v2 - v0);
+            double l = glm::length(n);
+            if (l < std::numeric_limits<float>::epsilon()) {
+                // degenerated triangle
+                return;
+            }
+            // weighting factor
+            double weightA;
+            double weightB;
+            double weightC;
+            switch (mode) {
+                case Mode::WeightArea:
+                    // area = norm of cross product
+                    weightA = 1;
+                    weightB = 1;
+                    weightC = 1;
+                    break;
+                case Mode::WeightAngle: {
+                    // based on the angle between the edges
+                    const dvec3 e0 = glm::normalize(v1 - v2);
+                    const dvec3 e1 = glm::normalize(v2 - v0);
+                    const dvec3 e2 = glm::normalize(v1 - v0);
+                    weightA = acos(dot(e1, e2)) / l;
+                    weightB = acos(dot(e0, e2)) / l;
+                    weightC = acos(dot(e0, e1)) / l;
+                    break;
+                }
+                case Mode::WeightNMax: {
+                    const auto edge = [](auto a, auto b) {
+                        auto e = a - b;
+                        auto l = glm::length(e);
+                        return std::make_pair(e / l, l);
+                    };
+                    const auto [e0, l0] = edge(v1, v2);
+                    const auto [e1, l1] = edge(v2, v0);
+                    const auto [e2, l2] = edge(v1, v0);
+                    weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
+                    weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
+                    weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
+                    break;
+                }
+                case Mode::NoWeighting:
+                default:
+                    weightA = 1.0 / l;
+                    weightB = 1.0 / l;
+                    weightC = 1.0 / l;
+            }
+            corners[3 * face + 0] = vec3(n * weightA);
+            corners[3 * face + 1] = vec3(n * weightB);
+            corners[3 * face + 2] = vec3(n * weightC);
+        });
+    });
 
-        vertices->dispatch<void, dispatching::filter::Floats>(
-            [&, mi = meshInfo, buf = buffer](auto ram) {
-                const auto& vert = ram->getDataContainer();
-
-                meshutil::forEachTriangle(mi, *buf, [&](auto i0, auto i1, auto i2) {
-                    const auto v0 = util::glm_convert<dvec3>(vert[i0]);
-                    const auto v1 = util::glm_convert<dvec3>(vert[i1]);
-                    const auto v2 = util::glm_convert<dvec3>(vert[i2]);
-
-                    const dvec3 n = cross(v1 - v0, v2 - v0);
-                    double l = glm::length(n);
-                    if (l < std::numeric_limits<float>::epsilon()) {
-                        // degenerated triangle
-                        return;
-                    }
-                    // weighting factor
-                    double weightA;
-                    double weightB;
-                    double weightC;
-                    switch (mode) {
-                        case Mode::WeightArea:
-                            // area = norm of cross product
-                            weightA = 1;
-                            weightB = 1;
-                            weightC = 1;
-                            break;
-                        case Mode::WeightAngle: {
-                            // based on the angle between the edges
-                            const dvec3 e0 = glm::normalize(v1 - v2);
-                            const dvec3 e1 = glm::normalize(v2 - v0);
-                            const dvec3 e2 = glm::normalize(v1 - v0);
-                            weightA = acos(dot(e1, e2)) / l;
-                            weightB = acos(dot(e0, e2)) / l;
-                            weightC = acos(dot(e0, e1)) / l;
-                            break;
-                        }
-                        case Mode::WeightNMax: {
-                            const auto edge = [](auto a, auto b) {
-                                auto e = a - b;
-                                auto l = glm::length(e);
-                                return std::make_pair(e / l, l);
-                            };
-                            const auto [e0, l0] = edge(v1, v2);
-                            const auto [e1, l1] = edge(v2, v0);
-                            const auto [e2, l2] = edge(v1, v0);
-                            weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
-                            weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
-                            weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
-                            break;
-                        }
-                        case Mode::NoWeighting:
-                        default:
-                            weightA = 1.0 / l;
-                            weightB = 1.0 / l;
-                            weightC = 1.0 / l;
-                    }
-                    // add it to the vertices
-                    normals[i0] += vec3(n * weightA);
-                    normals[i1] += vec3(n * weightB);
-                    normals[i2] += vec3(n * weightC);
-                });
-            });
+    // vertex to corner adjacency in compressed sparse row layout, the corners of each vertex are
+    // kept in face order so that the sums below are independent of the number of threads.
+    std::vector<std::uint32_t> offsets(numVertices + 1, 0);
+    for (const auto& tri : triangles) {
+        ++offsets[tri[0] + 1];
+        ++offsets[tri[1] + 1];
+        ++offsets[tri[2] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::uint32_t> vertexCorners(corners.size());
+    {
+        std::vector<std::uint32_t> pos(offsets.begin(), offsets.end() - 1);
+        for (std::uint32_t corner = 0; corner < static_cast<std::uint32_t>(corners.size());
+             ++corner) {
+            vertexCorners[pos[triangles[corner / 3][corner % 3]]++] = corner;
+        }
     }
 
-    // normalize normals
-    std::transform(normals.begin(), normals.end(), normals.begin(), [](auto n) {
+    // sum and normalize the normals in parallel over the vertices
+    std::vector<vec3> normals(numVertices, vec3(0.0f));
+    util::forEachParallel(normals, [&](const vec3&, size_t v) {
+        vec3 n{0.0f};
+        for (auto i = offsets[v]; i < offsets[v + 1]; ++i) {
+            n += corners[vertexCorners[i]];
+        }
         const auto l = glm::length(n);
-        if (l < std::numeric_limits<float>::epsilon()) return n;
-        return n / l;
+        normals[v] = l < std::numeric_limits<float>::epsilon() ? n : n / l;
     });
 
     auto bufferRAM = std::make_shared<BufferRAMPrecision<vec3>>(std::move(normals));
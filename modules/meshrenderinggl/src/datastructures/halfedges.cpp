@@ -34,93 +34,88 @@
 #include <inviwo/core/datastructures/geometry/geometrytype.h>      // for DrawType, DrawType::Tr...
 #include <inviwo/core/datastructures/geometry/mesh.h>              // for Mesh, Mesh::IndexVector
 #include <inviwo/core/util/assertion.h>                            // for IVW_ASSERT
+#include <inviwo/core/util/foreach.h>                              // for forEachParallel
 #include <inviwo/core/util/iterrange.h>                            // for iter_range
 #include <inviwo/core/util/transformiterator.h>                    // for TransformIterator
 #include <modules/base/algorithm/meshutils.h>                      // for forEachTriangle
 
-#include <map>          // for map, operator!=, __map...
+#include <algorithm>    // for find_if, max
 #include <memory>       // for make_shared, shared_ptr
+#include <numeric>      // for partial_sum
 #include <type_traits>  // for remove_reference<>::type
 #include <utility>      // for pair, move
 
 namespace inviwo {
 
 HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
-    // map to fill in the opposite direction
-    // (start_vertex, end_vertex) -> edge_index
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-
-    std::uint32_t face = 0;
     meshutil::forEachTriangle(info, indexBuffer,
                               [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                  // a-b, b-c, c-a
-                                  const auto count = static_cast<std::uint32_t>(edges_.size());
-                                  edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                  edgeMap.try_emplace({a, b}, count + 0);
-                                  vertexToEdge_.try_emplace(a, count + 0);
-
-                                  edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                  edgeMap.try_emplace({b, c}, count + 1);
-                                  vertexToEdge_.try_emplace(b, count + 1);
-
-                                  edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                  edgeMap.try_emplace({c, a}, count + 2);
-                                  vertexToEdge_.try_emplace(c, count + 2);
-
-                                  faceToEdge_.try_emplace(face, count);
-
-                                  ++face;
+                                  addTriangle(a, b, c);
                               });
-
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
-        }
-    }
+    build();
 }
 
 HalfEdges::HalfEdges(const Mesh& mesh) {
-
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-    std::uint32_t face = 0;
-
     for (auto [info, indexBuffer] : mesh.getIndexBuffers()) {
         if (info.dt != DrawType::Triangles) continue;
         meshutil::forEachTriangle(info, *indexBuffer,
                                   [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                      // a-b, b-c, c-a
-                                      const auto count = static_cast<std::uint32_t>(edges_.size());
-                                      edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                      edgeMap.try_emplace({a, b}, count + 0);
-                                      vertexToEdge_.try_emplace(a, count + 0);
+                                      addTriangle(a, b, c);
+                                  });
+    }
+    build();
+}
 
-                                      edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                      edgeMap.try_emplace({b, c}, count + 1);
-                                      vertexToEdge_.try_emplace(b, count + 1);
+void HalfEdges::addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+    // a-b, b-c, c-a
+    const auto count = static_cast<std::uint32_t>(edges_.size());
+    const auto face = count / 3;
+    edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
+    edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
+    edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
+}
 
-                                      edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                      edgeMap.try_emplace({c, a}, count + 2);
-                                      vertexToEdge_.try_emplace(c, count + 2);
+void HalfEdges::build() {
+    std::uint32_t numVertices = 0;
+    for (const auto& edge : edges_) {
+        numVertices = std::max(numVertices, edge.vertex + 1);
+    }
 
-                                      faceToEdge_.try_emplace(face, count);
+    // Counting sort of the half edges by their vertex. The scatter keeps the edges of each vertex
+    // in order of increasing edge index.
+    vertexOffsets_.assign(static_cast<size_t>(numVertices) + 1, 0);
+    for (const auto& edge : edges_) {
+        ++vertexOffsets_[edge.vertex + 1];
+    }
+    std::partial_sum(vertexOffsets_.begin(), vertexOffsets_.end(), vertexOffsets_.begin());
 
-                                      ++face;
-                                  });
+    vertexEdges_.resize(edges_.size());
+    {
+        std::vector<std::uint32_t> pos(vertexOffsets_.begin(), vertexOffsets_.end() - 1);
+        for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(edges_.size()); ++i) {
+            vertexEdges_[pos[edges_[i].vertex]++] = i;
+        }
+    }
+
+    vertexToEdge_.clear();
+    for (std::uint32_t v = 0; v < numVertices; ++v) {
+        if (vertexOffsets_[v] != vertexOffsets_[v + 1]) {
+            vertexToEdge_.push_back(vertexEdges_[vertexOffsets_[v]]);
+        }
     }
 
-    for (auto& edge : edges_) {
+    // The twin of a-b is the first edge b-a, found by scanning the (short) row of b.
+    util::forEachParallel(edges_, [&](const HalfEdge& edge, size_t i) {
         const auto a = edge.vertex;
         const auto b = edges_[edge.next].vertex;
-
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
+        const auto begin = vertexEdges_.begin() + vertexOffsets_[b];
+        const auto end = vertexEdges_.begin() + vertexOffsets_[b + 1];
+        const auto it = std::find_if(
+            begin, end, [&](std::uint32_t e) { return edges_[edges_[e].next].vertex == a; });
+        if (it != end) {
+            edges_[i].twin = *it;
         }
-    }
+    });
 }
 
 IndexBuffer HalfEdges::createIndexBuffer() const {
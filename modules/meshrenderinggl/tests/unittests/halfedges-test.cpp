@@ -213,6 +213,45 @@ TEST(HalfEdges, plane) {
     }
 }
 
+TEST(HalfEdges, vertexEdges) {
+    constexpr int width = 4;
+    constexpr int height = 3;
+    const IndexBuffer plane = createPlane(width, height);
+
+    util::IndexMapper<2, std::uint32_t> im{glm::uvec2{width + 1, height + 1}};
+
+    HalfEdges edges(Mesh::MeshInfo{DrawType::Triangles, ConnectivityType::None}, plane);
+
+    for (std::uint32_t v = 0; v < (width + 1) * (height + 1); ++v) {
+        const auto range = edges.vertexEdges(v);
+        ASSERT_NE(range.begin(), range.end());
+        EXPECT_EQ(*range.begin(), edges.vertexToEdge(v));
+        for (auto edge : range) {
+            EXPECT_EQ(edge.vertex(), v);
+            if (auto twin = edge.twin()) {
+                EXPECT_EQ(twin->vertex(), edge.next().vertex());
+                EXPECT_EQ(twin->next().vertex(), v);
+                EXPECT_EQ(*twin->twin(), edge);
+            }
+        }
+    }
+
+    // corner vertices
+    EXPECT_EQ(std::distance(edges.vertexEdges(im(0, 0)).begin(),
+                            edges.vertexEdges(im(0, 0)).end()),
+              1);
+    EXPECT_EQ(std::distance(edges.vertexEdges(im(width, 0)).begin(),
+                            edges.vertexEdges(im(width, 0)).end()),
+              2);
+    // interior vertex
+    EXPECT_EQ(std::distance(edges.vertexEdges(im(1, 1)).begin(),
+                            edges.vertexEdges(im(1, 1)).end()),
+              6);
+
+    EXPECT_THROW(edges.vertexToEdge((width + 1) * (height + 1)), std::out_of_range);
+    EXPECT_THROW(edges.faceToEdge(2 * width * height), std::out_of_range);
+}
+
 TEST(HalfEdges, indexbuffer) {
     constexpr int width = 4;
     constexpr int height = 3;
@@ -41,6 +41,7 @@
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>     // for VolumeRepresentation
 #include <inviwo/core/io/datareader.h>                                  // for DataReaderType
 #include <inviwo/core/io/datareaderexception.h>                         // for DataReaderException
+#include <inviwo/core/io/decodedvolumecache.h>                          // for DecodedVolumeCache
 #include <inviwo/core/metadata/metadata.h>                              // for StringMetaData
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
 #include <inviwo/core/util/formats.h>                                   // for NumericType, Data...
@@ -60,6 +61,7 @@
 #include <glm/vec3.hpp>                // for operator*, operat...
 #include <glm/vec4.hpp>                // for operator*, operator+
 #include <glm/vector_relational.hpp>   // for any, equal
+#include <fmt/format.h>                // for format
 #include <nifti1.h>                    // for DT_BINARY, DT_COM...
 #include <nifti1_io.h>                 // for nifti_image, nift...
 
@@ -90,6 +92,14 @@ public:
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                       const VolumeRepresentation& src) const override;
 
+    /**
+     * Regions are read slice by slice as sub regions of the image, for uncompressed scalar
+     * images. Compressed images are better read as a whole through the DecodedVolumeCache.
+     */
+    virtual bool supportsRegions() const override;
+    virtual std::shared_ptr<VolumeRepresentation> createRegionRepresentation(
+        const VolumeRepresentation& src, const DiskRegion& region) const override;
+
 private:
     std::array<int, 7> start_index;
     std::array<int, 7> region_size;
@@ -363,8 +373,7 @@ std::shared_ptr<NiftiReader::VolumeSequence> NiftiReader::readData(std::string_v
         // In other words:
         // The minimum value will correspond to 0 and the maximum will correspond to 1 in the
         // Transfer Function
-        auto volRAM = volumes->front()->getRepresentation<VolumeRAM>();
-        auto minmax = util::volumeMinMax(volRAM);
+        auto minmax = util::volumeMinMax(volumes->front().get());
         // minmax always have four components, unused components are set to zero.
         // Hence, only consider components used by the data format
         dvec2 dataRange(minmax.first[0], minmax.second[0]);
@@ -439,6 +448,16 @@ void flip(char* data, size_t elemSize, size3_t dim, std::array<bool, 3> flipAxis
 std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
+    // Reading from .nii.gz files means decompressing everything up to the time step
+    auto cache = nifti_is_gzfile(nim->iname) ? util::getDecodedVolumeCache() : nullptr;
+    const auto settings = fmt::format("t={} flip={}{}{}", start_index[3], flipAxis[0],
+                                      flipAxis[1], flipAxis[2]);
+    if (cache && cache->isEnabled()) {
+        if (auto volumeRAM = cache->loadRepresentation(nim->iname, settings, src)) {
+            return volumeRAM;
+        }
+    }
+
     const auto format = niftiDataTypeToInviwoDataFormat(nim.get());
     const auto voxelSize = format->getSize();
 
@@ -465,6 +484,8 @@ std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRepresentation
                         src.getInterpolation(), src.getWrapping());
     data.release();
 
+    if (cache && cache->isEnabled()) cache->store(nim->iname, settings, *volumeRAM);
+
     return volumeRAM;
 }
 
@@ -491,4 +512,47 @@ void NiftiVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresenta
     flip(static_cast<char*>(data), voxelSize, dim, flipAxis);
 }
 
+bool NiftiVolumeRAMLoader::supportsRegions() const {
+    return region_size[4] == 1 && !nifti_is_gzfile(nim->iname);
+}
+
+std::shared_ptr<VolumeRepresentation> NiftiVolumeRAMLoader::createRegionRepresentation(
+    const VolumeRepresentation& src, const DiskRegion& region) const {
+    const auto voxelSize = src.getDataFormat()->getSize();
+    const auto out = region.getOutputDimensions();
+    auto volumeRAM = createVolumeRAM(out, src.getDataFormat(), nullptr, src.getSwizzleMask(),
+                                     src.getInterpolation(), src.getWrapping());
+    auto dst = static_cast<char*>(volumeRAM->getData());
+
+    // Read one slice of the region at the time such that slices skipped by the stride are not read
+    const size3_t box{(out.x - 1) * region.stride.x + 1, (out.y - 1) * region.stride.y + 1, 1};
+    auto slice = std::make_unique<char[]>(box.x * box.y * voxelSize);
+    for (size_t z = 0; z < out.z; ++z) {
+        const size3_t pos{region.offset.x, region.offset.y, region.offset.z + z * region.stride.z};
+        auto start = start_index;
+        auto size = region_size;
+        for (int i = 0; i < 3; ++i) {
+            // flipped axes are stored in reverse order in the file
+            const auto first = flipAxis[i] ? region_size[i] - (pos[i] + box[i]) : pos[i];
+            start[i] += static_cast<int>(first);
+            size[i] = static_cast<int>(box[i]);
+        }
+        void* pdata = static_cast<void*>(slice.get());
+        if (nifti_read_subregion_image(nim.get(), start.data(), size.data(), &pdata) < 0) {
+            throw DataReaderException(IVW_CONTEXT, "Error: Could not read data from file: {}",
+                                      nim->fname);
+        }
+        flip(slice.get(), voxelSize, box, flipAxis);
+
+        for (size_t y = 0; y < out.y; ++y) {
+            const auto row = slice.get() + y * region.stride.y * box.x * voxelSize;
+            for (size_t x = 0; x < out.x; ++x) {
+                std::memcpy(dst, row + x * region.stride.x * voxelSize, voxelSize);
+                dst += voxelSize;
+            }
+        }
+    }
+    return volumeRAM;
+}
+
 }  // namespace inviwo
@@ -34,13 +34,15 @@
 #include <inviwo/core/util/exception.h>      // for Exception
 #include <inviwo/core/util/glm.h>            // for isnan
 #include <inviwo/core/util/glmutils.h>       // for is_floating_point
+#include <inviwo/core/util/quantilesketch.h>  // for QuantileSketch
 #include <inviwo/core/util/sourcecontext.h>  // for IVW_CONTEXT_CUSTOM
 
-#include <algorithm>    // for max, sort, partition
+#include <algorithm>    // for max, sort, partition, nth_element
 #include <cmath>        // for ceil
 #include <cstddef>      // for size_t
 #include <iosfwd>       // for ostream
-#include <iterator>     // for distance
+#include <iterator>     // for distance, iterator_traits
+#include <numeric>      // for iota
 #include <stdexcept>    // for invalid_argument
 #include <string>       // for string
 #include <string_view>  // for string_view
@@ -64,6 +66,67 @@ IVW_MODULE_PLOTTING_API RegresionResult linearRegresion(const BufferBase& X, con
 
 IVW_MODULE_PLOTTING_API std::ostream& operator<<(std::ostream& os, RegresionResult res);
 
+/**
+ * Statistics for drawing a box plot. The whiskers extend to the most extreme values within
+ * whiskerFactor * (q3 - q1) of the box, values outside are outliers.
+ */
+struct BoxPlotStats {
+    double min;
+    double lowerWhisker;
+    double q1;
+    double median;
+    double q3;
+    double upperWhisker;
+    double max;
+};
+
+/**
+ * \brief Approximate box plot statistics from a quantile sketch.
+ * The quartiles have the rank error of the sketch, min and max are exact. All values are NaN if
+ * the sketch is empty.
+ */
+IVW_MODULE_PLOTTING_API BoxPlotStats boxPlotStats(const util::QuantileSketch& sketch,
+                                                  double whiskerFactor = 1.5);
+
+/**
+ * \brief Approximate box plot statistics for each channel of \p buffer, without sorting the data.
+ * @see util::quantileSketches
+ */
+IVW_MODULE_PLOTTING_API std::vector<BoxPlotStats> boxPlotStats(const BufferBase& buffer,
+                                                               double whiskerFactor = 1.5);
+
+namespace detail {
+
+/**
+ * Select the values at the nearest rank of each percentile in [begin, end). Instead of sorting
+ * the whole range, the ranks are visited in increasing order and each one is found with
+ * std::nth_element on the part of the range that is left.
+ */
+template <typename Iter>
+auto selectPercentiles(Iter begin, Iter end, const std::vector<double>& percentiles) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    const auto nElements = static_cast<size_t>(std::distance(begin, end));
+
+    std::vector<size_t> order(percentiles.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return percentiles[a] < percentiles[b]; });
+
+    std::vector<T> result(percentiles.size());
+    auto first = begin;
+    for (auto i : order) {
+        const auto rank = static_cast<size_t>(
+            std::max(std::ceil(static_cast<double>(nElements) * percentiles[i]) - 1., 0.));
+        const auto nth = begin + rank;
+        std::nth_element(first, nth, end);
+        first = nth;
+        result[i] = *nth;
+    }
+    return result;
+}
+
+}  // namespace detail
+
 /**
  * \brief Compute value below a percentage of observations in the data.
  * Uses the nearest rank method, i.e. ceil(percentile * N), where N = number of elements in data.
@@ -75,6 +138,9 @@ IVW_MODULE_PLOTTING_API std::ostream& operator<<(std::ostream& os, RegresionResu
  * \endcode
  * See also https://en.wikipedia.org/wiki/Percentile
  *
+ * The values are found by selection, which is linear in the number of elements for each
+ * percentile. For large data, prefer an approximation with util::QuantileSketch.
+ *
  * @param data to compute percentiles on
  * @param percentiles in the range [0 1]
  * @return values below the percentage given by the percentiles.
@@ -82,40 +148,26 @@ IVW_MODULE_PLOTTING_API std::ostream& operator<<(std::ostream& os, RegresionResu
  */
 template <typename T, typename std::enable_if<!util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    std::sort(data.begin(), data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    auto nElements = data.size();
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw Exception("Percentile must be between 0 and 1",
                             IVW_CONTEXT_CUSTOM("statsutil::percentiles"));
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    return detail::selectPercentiles(data.begin(), data.end(), percentiles);
 }
 
 // Float/double types have special values
 template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    auto noNaN =
-        std::partition(data.begin(), data.end(), [](const auto& a) { return glm::isnan(a); });
-    std::sort(noNaN, data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    size_t nElements = std::distance(noNaN, data.end());
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw std::invalid_argument("Percentile must be between 0 and 1");
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    auto noNaN =
+        std::partition(data.begin(), data.end(), [](const auto& a) { return glm::isnan(a); });
+    return detail::selectPercentiles(noNaN, data.end(), percentiles);
 }
 
 }  // namespace statsutil
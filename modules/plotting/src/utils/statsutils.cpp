@@ -41,6 +41,7 @@
 #include <inviwo/core/util/zip.h>                                       // for zipper, get, zip
 
 #include <stdlib.h>       // for abs
+#include <algorithm>      // for clamp, max, min
 #include <memory>         // for unique_ptr
 #include <ostream>        // for operator<<, basic...
 #include <unordered_set>  // for unordered_set
@@ -143,6 +144,36 @@ std::ostream& operator<<(std::ostream& os, RegresionResult res) {
     return os;
 }
 
+BoxPlotStats boxPlotStats(const util::QuantileSketch& sketch, double whiskerFactor) {
+    const auto q = sketch.quantiles({0.0, 0.25, 0.5, 0.75, 1.0});
+    BoxPlotStats stats{q[0], q[0], q[1], q[2], q[3], q[4], q[4]};
+    if (sketch.empty()) return stats;
+
+    const auto iqr = stats.q3 - stats.q1;
+    const auto lowerFence = std::max(stats.q1 - whiskerFactor * iqr, stats.min);
+    const auto upperFence = std::min(stats.q3 + whiskerFactor * iqr, stats.max);
+    // The values at the ranks of the fences are the most extreme values within the fences. For
+    // the lower fence that value can be an outlier, then take the next value instead.
+    const auto lowerRank = sketch.rank(lowerFence);
+    auto lower = sketch.quantile(lowerRank);
+    if (lower < lowerFence) {
+        const auto next = lowerRank + 1.0 / static_cast<double>(sketch.count());
+        lower = sketch.quantile(std::min(1.0, next));
+    }
+    stats.lowerWhisker = std::clamp(lower, lowerFence, stats.q1);
+    stats.upperWhisker =
+        std::clamp(sketch.quantile(sketch.rank(upperFence)), stats.q3, upperFence);
+    return stats;
+}
+
+std::vector<BoxPlotStats> boxPlotStats(const BufferBase& buffer, double whiskerFactor) {
+    std::vector<BoxPlotStats> result;
+    for (const auto& sketch : util::quantileSketches(*buffer.getRepresentation<BufferRAM>())) {
+        result.push_back(boxPlotStats(sketch, whiskerFactor));
+    }
+    return result;
+}
+
 }  // namespace statsutil
 
 }  // namespace inviwo
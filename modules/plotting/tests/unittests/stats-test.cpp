@@ -30,6 +30,8 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <modules/plotting/utils/statsutils.h>
 
+#include <limits>
+
 #include <warn/push>
 #include <warn/ignore/all>
 #include <gtest/gtest.h>
@@ -67,6 +69,29 @@ TEST(StatsUtilsTest, init) {
     EXPECT_DOUBLE_EQ(20., percentiles[2]) << " 40 percentile";
     EXPECT_DOUBLE_EQ(35., percentiles[3]) << " 50 percentile";
     EXPECT_DOUBLE_EQ(50., percentiles[4]) << " 100 percentile";
+
+    data.push_back(std::numeric_limits<double>::quiet_NaN());
+    percentiles = statsutil::percentiles(data, {1.0, 0.05});
+    EXPECT_DOUBLE_EQ(50., percentiles[0]) << " 100 percentile with NaN";
+    EXPECT_DOUBLE_EQ(15., percentiles[1]) << " 5 percentile with NaN";
+}
+
+TEST(StatsUtilsTest, boxPlot) {
+    Buffer<double> buffer;
+    auto& vec = buffer.getEditableRAMRepresentation()->getDataContainer();
+    vec.push_back(-1000.0);
+    for (int i = 1; i <= 100; ++i) vec.push_back(static_cast<double>(i));
+    vec.push_back(1000.0);
+
+    const auto stats = statsutil::boxPlotStats(buffer);
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_DOUBLE_EQ(-1000., stats[0].min);
+    EXPECT_DOUBLE_EQ(1., stats[0].lowerWhisker);
+    EXPECT_DOUBLE_EQ(25., stats[0].q1);
+    EXPECT_DOUBLE_EQ(50., stats[0].median);
+    EXPECT_DOUBLE_EQ(76., stats[0].q3);
+    EXPECT_DOUBLE_EQ(100., stats[0].upperWhisker);
+    EXPECT_DOUBLE_EQ(1000., stats[0].max);
 }
 
 }  // namespace inviwo
@@ -35,14 +35,36 @@
 #include <inviwo/core/io/datawriter.h>               // for DataWriterType
 
 #include <stdio.h>      // for FILE
+#include <any>          // for any
+#include <cstddef>      // for size_t
 #include <memory>       // for unique_ptr
 #include <string_view>  // for string_view
 #include <vector>       // for vector
 
 namespace inviwo {
 
+/**
+ * \brief A LayerWriter for png files
+ *
+ * Supported options, see setOption:
+ *  * "CompressionLevel" (int) the zlib compression level, 0 (none) to 9 (best), or -1 for the
+ *    zlib default. Lower levels trade file size for speed.
+ *  * "Filter" (PNGLayerWriter::Filter) the row filter strategy
+ *  * "Bands" (size_t) the number of row bands to encode in parallel. 0 (default) picks the number
+ *    of bands from the image size and the thread pool size, 1 encodes serially using libpng.
+ *
+ * In the parallel path the image is split into bands of rows, each band is filtered and
+ * deflated on the thread pool as a separate part of one zlib stream. The parts are then stitched
+ * together into a single valid png file. The deflate window of each band is primed with the end
+ * of the previous band, so the compression ratio is close to the serial one.
+ */
 class IVW_MODULE_PNG_API PNGLayerWriter : public DataWriterType<Layer> {
 public:
+    /**
+     * The png row filter strategy, Adaptive picks the best filter per row like libpng does.
+     */
+    enum class Filter { None, Sub, Up, Average, Paeth, Adaptive };
+
     PNGLayerWriter();
     PNGLayerWriter(const PNGLayerWriter& rhs) = default;
     PNGLayerWriter& operator=(const PNGLayerWriter& that) = default;
@@ -53,6 +75,29 @@ public:
     virtual void writeData(const Layer* data, std::string_view filePath) const override;
     virtual std::unique_ptr<std::vector<unsigned char>> writeDataToBuffer(
         const Layer* data, std::string_view fileExtension) const override;
+
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) const override;
+
+    /**
+     * Set the zlib compression level, 0 (none) to 9 (best), or -1 for the zlib default.
+     */
+    void setCompressionLevel(int level);
+    int getCompressionLevel() const;
+
+    void setFilter(Filter filter);
+    Filter getFilter() const;
+
+    /**
+     * Set the number of row bands to encode in parallel. 0 means automatic, 1 means serial.
+     */
+    void setBands(size_t bands);
+    size_t getBands() const;
+
+private:
+    int compressionLevel_ = -1;
+    Filter filter_ = Filter::Adaptive;
+    size_t bands_ = 0;
 };
 
 }  // namespace inviwo
@@ -37,15 +37,22 @@
 #include <inviwo/core/io/datawriterexception.h>                         // for DataWriterException
 #include <inviwo/core/util/fileextension.h>                             // for FileExtension
 #include <inviwo/core/util/filesystem.h>                                // for fopen
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexParallel
 #include <inviwo/core/util/formats.h>                                   // for DataFormat, Numer...
 #include <inviwo/core/util/glmconvert.h>                                // for glm_convert_norma...
 #include <inviwo/core/util/glmutils.h>                                  // for same_extent, valu...
 #include <inviwo/core/util/logcentral.h>                                // for LogCentral, LogWa...
 #include <inviwo/core/util/raiiutils.h>                                 // for OnScopeExit, OnSc...
 #include <inviwo/core/util/sourcecontext.h>                             // for IVW_CONTEXT_CUSTOM
+#include <inviwo/core/util/threadutil.h>                                // for getPoolSize
 
 #include <algorithm>      // for min, transform
-#include <functional>     // for __base
+#include <array>          // for array
+#include <cstdint>        // for uint32_t
+#include <cstdio>         // for fwrite
+#include <cstdlib>        // for abs
+#include <functional>     // for function
+#include <limits>         // for numeric_limits
 #include <string>         // for string
 #include <type_traits>    // for enable_if, is_int...
 #include <unordered_set>  // for unordered_set
@@ -57,17 +64,19 @@
 #include <half/half.hpp>               // for operator<
 #include <png.h>                       // for png_structp, png_...
 #include <pngconf.h>                   // for png_const_charp
+#include <zlib.h>                      // for deflate, crc32, adler32
 
 namespace inviwo {
 
 namespace detail {
 
-void writeToBuffer(png_structp png_ptr, png_bytep data, png_size_t length) {
-    auto buffer = static_cast<std::vector<unsigned char>*>(png_get_io_ptr(png_ptr));
-    for (png_size_t i = 0; i < length; i++) {
-        buffer->push_back(static_cast<unsigned char>(data[i]));
-    }
-}
+using PNGSink = std::function<void(const unsigned char*, size_t)>;
+
+struct PNGSettings {
+    int compressionLevel;
+    PNGLayerWriter::Filter filter;
+    size_t bands;
+};
 
 template <typename Result, typename T>
 std::vector<Result> convert(const T* data, const size_t size, const T min, const T max) {
@@ -101,10 +110,22 @@ auto convertToUnsigned(const T*, const size_t, const T, const T) -> std::vector<
     return {};
 }
 
-template <typename T>
-void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFunc = nullptr,
-           png_flush_ptr flushFunc = nullptr) {
-
+/**
+ * Describes the pixels to encode. The rows are stored bottom up as in Inviwo, with 8 or 16 bit
+ * samples in native byte order.
+ */
+struct PNGImage {
+    const unsigned char* pixels;
+    size2_t size;
+    int bitDepth;
+    int colorType;
+    size_t channels;
+
+    size_t bytesPerPixel() const { return channels * static_cast<size_t>(bitDepth) / 8; }
+    size_t rowBytes() const { return size.x * bytesPerPixel(); }
+};
+
+void writeLibPNG(const PNGImage& img, const PNGSettings& settings, PNGSink& sink) {
     // TODO better exception messages
     auto png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
     if (!png_ptr) {
@@ -129,8 +150,304 @@ void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFun
     util::OnScopeExit cleanup2 = std::move(cleanup);
     cleanup2.setAction([&]() { png_destroy_write_struct(&png_ptr, &info_ptr); });
 
-    png_set_write_fn(png_ptr, ioPtr, writeFunc, flushFunc);
+    png_set_write_fn(
+        png_ptr, &sink,
+        [](png_structp png_ptr, png_bytep data, png_size_t length) {
+            (*static_cast<PNGSink*>(png_get_io_ptr(png_ptr)))(data, length);
+        },
+        [](png_structp) {});
+
+    if (settings.compressionLevel >= 0) {
+        png_set_compression_level(png_ptr, settings.compressionLevel);
+    }
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, [&]() {
+        switch (settings.filter) {
+            case PNGLayerWriter::Filter::None:
+                return PNG_FILTER_NONE;
+            case PNGLayerWriter::Filter::Sub:
+                return PNG_FILTER_SUB;
+            case PNGLayerWriter::Filter::Up:
+                return PNG_FILTER_UP;
+            case PNGLayerWriter::Filter::Average:
+                return PNG_FILTER_AVG;
+            case PNGLayerWriter::Filter::Paeth:
+                return PNG_FILTER_PAETH;
+            case PNGLayerWriter::Filter::Adaptive:
+            default:
+                return PNG_ALL_FILTERS;
+        }
+    }());
+
+    png_set_IHDR(png_ptr, info_ptr, static_cast<png_uint_32>(img.size.x),
+                 static_cast<png_uint_32>(img.size.y), img.bitDepth, img.colorType,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+    png_write_info(png_ptr, info_ptr);
+    png_set_swap(png_ptr);
+
+    std::vector<png_bytep> rows(img.size.y);
+    for (size_t r = 0; r < img.size.y; ++r) {
+        // Inviwo images are upside down compared to how libpng expects them
+        rows[img.size.y - r - 1] = const_cast<png_bytep>(img.pixels + r * img.rowBytes());
+    }
+    png_write_image(png_ptr, rows.data());
+    png_write_end(png_ptr, nullptr);
+}
+
+/**
+ * Copy row `row`, counted from the top, into `dst` with the 16 bit samples in the big endian byte
+ * order of png.
+ */
+void copyRow(const PNGImage& img, size_t row, unsigned char* dst) {
+    const auto rowBytes = img.rowBytes();
+    const auto* src = img.pixels + (img.size.y - row - 1) * rowBytes;
+    if (img.bitDepth == 16) {
+        for (size_t i = 0; i < rowBytes; i += 2) {
+            dst[i] = src[i + 1];
+            dst[i + 1] = src[i];
+        }
+    } else {
+        std::copy(src, src + rowBytes, dst);
+    }
+}
+
+unsigned char paethPredictor(int a, int b, int c) {
+    const auto p = a + b - c;
+    const auto pa = std::abs(p - a);
+    const auto pb = std::abs(p - b);
+    const auto pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return static_cast<unsigned char>(a);
+    if (pb <= pc) return static_cast<unsigned char>(b);
+    return static_cast<unsigned char>(c);
+}
+
+/**
+ * Apply png filter `type` to the row `cur` given the previous row `prev` (all zeros for the first
+ * row) and write the filter type byte followed by the filtered row to `dst`.
+ */
+void filterRow(int type, const unsigned char* cur, const unsigned char* prev, size_t rowBytes,
+               size_t bpp, unsigned char* dst) {
+    dst[0] = static_cast<unsigned char>(type);
+    auto* out = dst + 1;
+    switch (type) {
+        case 0:
+            std::copy(cur, cur + rowBytes, out);
+            break;
+        case 1:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                out[i] = static_cast<unsigned char>(cur[i] - (i >= bpp ? cur[i - bpp] : 0));
+            }
+            break;
+        case 2:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                out[i] = static_cast<unsigned char>(cur[i] - prev[i]);
+            }
+            break;
+        case 3:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                const int a = i >= bpp ? cur[i - bpp] : 0;
+                out[i] = static_cast<unsigned char>(cur[i] - ((a + prev[i]) >> 1));
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < rowBytes; ++i) {
+                const int a = i >= bpp ? cur[i - bpp] : 0;
+                const int c = i >= bpp ? prev[i - bpp] : 0;
+                out[i] = static_cast<unsigned char>(cur[i] - paethPredictor(a, prev[i], c));
+            }
+            break;
+    }
+}
+
+/**
+ * Filter rows [begin, end) into `dst`. For the adaptive strategy, use the heuristic of libpng and
+ * pick the filter that minimizes the sum of the absolute values of the filtered bytes.
+ */
+void filterRows(const PNGImage& img, PNGLayerWriter::Filter filter, size_t begin, size_t end,
+                unsigned char* dst) {
+    const auto rowBytes = img.rowBytes();
+    const auto bpp = std::max<size_t>(1, img.bytesPerPixel());
+
+    std::vector<unsigned char> prev(rowBytes, 0);
+    std::vector<unsigned char> cur(rowBytes);
+    if (begin > 0) copyRow(img, begin - 1, prev.data());
+
+    std::array<std::vector<unsigned char>, 5> candidates;
+    if (filter == PNGLayerWriter::Filter::Adaptive) {
+        for (auto& c : candidates) c.resize(rowBytes + 1);
+    }
+
+    for (size_t row = begin; row < end; ++row, dst += rowBytes + 1) {
+        copyRow(img, row, cur.data());
+        if (filter != PNGLayerWriter::Filter::Adaptive) {
+            filterRow(static_cast<int>(filter), cur.data(), prev.data(), rowBytes, bpp, dst);
+        } else {
+            size_t bestSum = std::numeric_limits<size_t>::max();
+            size_t best = 0;
+            for (size_t type = 0; type < candidates.size(); ++type) {
+                auto& c = candidates[type];
+                filterRow(static_cast<int>(type), cur.data(), prev.data(), rowBytes, bpp,
+                          c.data());
+                size_t sum = 0;
+                for (size_t i = 1; i < c.size(); ++i) {
+                    sum += static_cast<size_t>(std::abs(static_cast<signed char>(c[i])));
+                }
+                if (sum < bestSum) {
+                    bestSum = sum;
+                    best = type;
+                }
+            }
+            std::copy(candidates[best].begin(), candidates[best].end(), dst);
+        }
+        std::swap(prev, cur);
+    }
+}
+
+void appendUInt32(std::vector<unsigned char>& dst, std::uint32_t value) {
+    dst.push_back(static_cast<unsigned char>(value >> 24));
+    dst.push_back(static_cast<unsigned char>(value >> 16));
+    dst.push_back(static_cast<unsigned char>(value >> 8));
+    dst.push_back(static_cast<unsigned char>(value));
+}
+
+void writeChunk(PNGSink& sink, const char* type, const unsigned char* data, size_t size) {
+    std::vector<unsigned char> header;
+    appendUInt32(header, static_cast<std::uint32_t>(size));
+    header.insert(header.end(), type, type + 4);
 
+    auto crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, header.data() + 4, 4);
+    if (size > 0) crc = crc32(crc, data, static_cast<uInt>(size));
+
+    std::vector<unsigned char> footer;
+    appendUInt32(footer, static_cast<std::uint32_t>(crc));
+
+    sink(header.data(), header.size());
+    if (size > 0) sink(data, size);
+    sink(footer.data(), footer.size());
+}
+
+/**
+ * Encode the image in bands of rows in parallel. Each band is filtered and compressed into a raw
+ * deflate stream on its own. All but the last band end with a sync flush to end on a byte
+ * boundary without marking the last block, such that the parts can be concatenated into one
+ * deflate stream. The zlib header and the combined adler32 checksum are then added around it.
+ */
+void writeParallel(const PNGImage& img, const PNGSettings& settings, size_t bands,
+                   PNGSink& sink) {
+    const auto rowBytes = img.rowBytes();
+    const auto rows = img.size.y;
+    const auto rowsPerBand = (rows + bands - 1) / bands;
+    bands = (rows + rowsPerBand - 1) / rowsPerBand;
+
+    const auto bandBegin = [&](size_t band) { return std::min(rows, band * rowsPerBand); };
+
+    std::vector<unsigned char> filtered(rows * (rowBytes + 1));
+    util::forEachIndexParallel(bands, [&](size_t band) {
+        filterRows(img, settings.filter, bandBegin(band), bandBegin(band + 1),
+                   filtered.data() + bandBegin(band) * (rowBytes + 1));
+    });
+
+    constexpr size_t windowSize = 32768;
+    std::vector<std::vector<unsigned char>> parts(bands);
+    std::vector<uLong> checksums(bands);
+    util::forEachIndexParallel(bands, [&](size_t band) {
+        auto* begin = filtered.data() + bandBegin(band) * (rowBytes + 1);
+        auto* end = filtered.data() + bandBegin(band + 1) * (rowBytes + 1);
+        const auto last = band + 1 == bands;
+
+        // Like libpng, use the filtered strategy for filtered data
+        const auto strategy =
+            settings.filter == PNGLayerWriter::Filter::None ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+        z_stream strm{};
+        if (deflateInit2(&strm, settings.compressionLevel, Z_DEFLATED, -15, 8, strategy) !=
+            Z_OK) {
+            throw DataWriterException(IVW_CONTEXT_CUSTOM("PNGLayerWriter"),
+                                      "Internal PNG Error: Failed to initialize deflate");
+        }
+        util::OnScopeExit cleanup([&]() { deflateEnd(&strm); });
+
+        // The bytes preceding this band in the stream, the decoder will have them in its window.
+        if (band > 0) {
+            const auto dictSize = std::min<size_t>(windowSize, begin - filtered.data());
+            deflateSetDictionary(&strm, begin - dictSize, static_cast<uInt>(dictSize));
+        }
+
+        auto& out = parts[band];
+        out.resize(deflateBound(&strm, static_cast<uLong>(end - begin)) + 16);
+        strm.next_in = begin;
+        strm.avail_in = static_cast<uInt>(end - begin);
+        strm.next_out = out.data();
+        strm.avail_out = static_cast<uInt>(out.size());
+
+        const auto flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+        for (;;) {
+            const auto ret = deflate(&strm, flush);
+            if (ret == Z_STREAM_ERROR) {
+                throw DataWriterException(IVW_CONTEXT_CUSTOM("PNGLayerWriter"),
+                                          "Error writing PNG: {}",
+                                          strm.msg ? strm.msg : "deflate failed");
+            }
+            if (last ? ret == Z_STREAM_END : strm.avail_out != 0) break;
+
+            const auto used = out.size() - strm.avail_out;
+            out.resize(out.size() * 2);
+            strm.next_out = out.data() + used;
+            strm.avail_out = static_cast<uInt>(out.size() - used);
+        }
+        out.resize(out.size() - strm.avail_out);
+
+        checksums[band] = adler32(adler32(0L, Z_NULL, 0), begin, static_cast<uInt>(end - begin));
+    });
+
+    auto checksum = adler32(0L, Z_NULL, 0);
+    for (size_t band = 0; band < bands; ++band) {
+        const auto length = (bandBegin(band + 1) - bandBegin(band)) * (rowBytes + 1);
+        checksum = adler32_combine(checksum, checksums[band], static_cast<z_off_t>(length));
+    }
+
+    // zlib header: deflate with a 32K window and the level hint, padded to a multiple of 31
+    const auto level = settings.compressionLevel < 0 ? 6 : settings.compressionLevel;
+    const unsigned cmf = 0x78;
+    unsigned flg = (level < 2 ? 0u : level < 6 ? 1u : level == 6 ? 2u : 3u) << 6;
+    flg += 31 - (cmf * 256 + flg) % 31;
+    parts.front().insert(parts.front().begin(),
+                         {static_cast<unsigned char>(cmf), static_cast<unsigned char>(flg)});
+    appendUInt32(parts.back(), static_cast<std::uint32_t>(checksum));
+
+    const std::array<unsigned char, 8> signature{137, 80, 78, 71, 13, 10, 26, 10};
+    sink(signature.data(), signature.size());
+
+    std::vector<unsigned char> ihdr;
+    appendUInt32(ihdr, static_cast<std::uint32_t>(img.size.x));
+    appendUInt32(ihdr, static_cast<std::uint32_t>(img.size.y));
+    ihdr.insert(ihdr.end(), {static_cast<unsigned char>(img.bitDepth),
+                             static_cast<unsigned char>(img.colorType), 0, 0, 0});
+    writeChunk(sink, "IHDR", ihdr.data(), ihdr.size());
+
+    constexpr size_t maxChunkSize = size_t{1} << 30;
+    for (const auto& part : parts) {
+        for (size_t offset = 0; offset < part.size(); offset += maxChunkSize) {
+            writeChunk(sink, "IDAT", part.data() + offset,
+                       std::min(maxChunkSize, part.size() - offset));
+        }
+    }
+    writeChunk(sink, "IEND", nullptr, 0);
+}
+
+size_t numberOfBands(const PNGImage& img, const PNGSettings& settings) {
+    if (settings.bands != 0) return std::min(settings.bands, img.size.y);
+
+    // Aim for bands of at least 256K to keep the compression overhead per band small
+    constexpr size_t minBandBytes = size_t{1} << 18;
+    const auto poolSize = util::getPoolSize();
+    if (poolSize == 0) return 1;
+    const auto bytes = img.size.y * (img.rowBytes() + 1);
+    return std::min({img.size.y, bytes / minBandBytes, 4 * poolSize});
+}
+
+template <typename T>
+void write(const LayerRAMPrecision<T>* ram, const PNGSettings& settings, PNGSink sink) {
     const auto df = ram->getDataFormat();
     const auto color_type = [&]() {
         switch (df->getComponents()) {
@@ -144,8 +461,8 @@ void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFun
                 return PNG_COLOR_TYPE_RGBA;
             default:
                 // Should not ever reach this
-                throw new DataWriterException(IVW_CONTEXT_CUSTOM("PNGLayerWriter"),
-                                              "Unsupported number of channels");
+                throw DataWriterException(IVW_CONTEXT_CUSTOM("PNGLayerWriter"),
+                                          "Unsupported number of channels");
         }
     }();
 
@@ -153,47 +470,35 @@ void write(const LayerRAMPrecision<T>* ram, png_voidp ioPtr, png_rw_ptr writeFun
     const auto bit_depth = df->getPrecision();
 
     auto writePNG = [&](auto pixels) {
-        std::vector<png_bytep> rows(size.y);
-        for (png_uint_32 r = 0; r < size.y; ++r) {
-            // Inviwo images are upside down compared to how libpng expects them
-            rows[size.y - r - 1] = reinterpret_cast<png_bytep>(pixels + r * size.x);
+        using P = typename util::value_type<
+            std::remove_cv_t<std::remove_pointer_t<decltype(pixels)>>>::type;
+        const PNGImage img{reinterpret_cast<const unsigned char*>(pixels), size,
+                           static_cast<int>(sizeof(P) * 8), color_type, df->getComponents()};
+
+        const auto bands = numberOfBands(img, settings);
+        if (bands > 1) {
+            writeParallel(img, settings, bands, sink);
+        } else {
+            writeLibPNG(img, settings, sink);
         }
-        png_write_image(png_ptr, rows.data());
-        png_write_end(png_ptr, nullptr);
     };
 
     const auto data = ram->getDataTyped();
     if (df->getNumericType() == NumericType::Float) {
-        png_set_IHDR(png_ptr, info_ptr, static_cast<int>(size.x), static_cast<int>(size.y), 16,
-                     color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
-                     PNG_FILTER_TYPE_BASE);
-
-        png_write_info(png_ptr, info_ptr);
-        png_set_swap(png_ptr);
-
         using T2 = typename util::same_extent<T, glm::uint16>::type;
         auto newData = convert<T2>(data, glm::compMul(size), T{0}, T{1});
         writePNG(newData.data());
+    } else if (bit_depth > 16) {
+        using T2 = typename util::same_extent<T, glm::uint16>::type;
+        auto newData = convert<T2>(data, glm::compMul(size), DataFormat<T>::lowest(),
+                                   DataFormat<T>::max());
+        writePNG(newData.data());
+    } else if (df->getNumericType() == NumericType::SignedInteger) {
+        auto newData = convertToUnsigned(data, glm::compMul(size), DataFormat<T>::lowest(),
+                                         DataFormat<T>::max());
+        writePNG(newData.data());
     } else {
-        png_set_IHDR(png_ptr, info_ptr, static_cast<int>(size.x), static_cast<int>(size.y),
-                     static_cast<int>(std::min<size_t>(bit_depth, 16)), color_type,
-                     PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-
-        png_write_info(png_ptr, info_ptr);
-        png_set_swap(png_ptr);
-
-        if (bit_depth > 16) {
-            using T2 = typename util::same_extent<T, glm::uint16>::type;
-            auto newData = convert<T2>(data, glm::compMul(size), DataFormat<T>::lowest(),
-                                       DataFormat<T>::max());
-            writePNG(newData.data());
-        } else if (df->getNumericType() == NumericType::SignedInteger) {
-            auto newData = convertToUnsigned(data, glm::compMul(size), DataFormat<T>::lowest(),
-                                             DataFormat<T>::max());
-            writePNG(newData.data());
-        } else {
-            writePNG(const_cast<T*>(ram->getDataTyped()));
-        }
+        writePNG(data);
     }
 }
 
@@ -206,8 +511,15 @@ PNGLayerWriter::PNGLayerWriter() : DataWriterType<Layer>() {
 PNGLayerWriter* PNGLayerWriter::clone() const { return new PNGLayerWriter(*this); }
 
 void PNGLayerWriter::writeData(const Layer* data, FILE* fp) const {
-    data->getRepresentation<LayerRAM>()->dispatch<void>(
-        [&](auto ram) { detail::write(ram, static_cast<png_voidp>(fp)); });
+    const detail::PNGSettings settings{compressionLevel_, filter_, bands_};
+    data->getRepresentation<LayerRAM>()->dispatch<void>([&](auto ram) {
+        detail::write(ram, settings, [fp](const unsigned char* bytes, size_t length) {
+            if (std::fwrite(bytes, 1, length, fp) != length) {
+                throw DataWriterException(IVW_CONTEXT_CUSTOM("PNGLayerWriter"),
+                                          "Error writing PNG: Failed to write to file");
+            }
+        });
+    });
 }
 
 void PNGLayerWriter::writeData(const Layer* data, std::string_view filePath) const {
@@ -224,11 +536,53 @@ std::unique_ptr<std::vector<unsigned char>> PNGLayerWriter::writeDataToBuffer(
     const Layer* data, std::string_view) const {
 
     auto buffer = std::make_unique<std::vector<unsigned char>>();
+    const detail::PNGSettings settings{compressionLevel_, filter_, bands_};
     data->getRepresentation<LayerRAM>()->dispatch<void>([&](auto ram) {
-        detail::write(ram, static_cast<png_voidp>(buffer.get()), &detail::writeToBuffer);
+        detail::write(ram, settings, [b = buffer.get()](const unsigned char* bytes, size_t length) {
+            b->insert(b->end(), bytes, bytes + length);
+        });
     });
 
     return buffer;
 }
 
+bool PNGLayerWriter::setOption(std::string_view key, std::any value) {
+    if (auto* level = std::any_cast<int>(&value); level && key == "CompressionLevel") {
+        setCompressionLevel(*level);
+        return true;
+    } else if (auto* filter = std::any_cast<Filter>(&value); filter && key == "Filter") {
+        setFilter(*filter);
+        return true;
+    } else if (auto* bands = std::any_cast<size_t>(&value); bands && key == "Bands") {
+        setBands(*bands);
+        return true;
+    } else if (auto* intBands = std::any_cast<int>(&value); intBands && key == "Bands") {
+        setBands(static_cast<size_t>(std::max(0, *intBands)));
+        return true;
+    }
+    return false;
+}
+
+std::any PNGLayerWriter::getOption(std::string_view key) const {
+    if (key == "CompressionLevel") {
+        return compressionLevel_;
+    } else if (key == "Filter") {
+        return filter_;
+    } else if (key == "Bands") {
+        return bands_;
+    }
+    return std::any{};
+}
+
+void PNGLayerWriter::setCompressionLevel(int level) {
+    compressionLevel_ = std::clamp(level, -1, 9);
+}
+int PNGLayerWriter::getCompressionLevel() const { return compressionLevel_; }
+
+void PNGLayerWriter::setFilter(Filter filter) { filter_ = filter; }
+PNGLayerWriter::Filter PNGLayerWriter::getFilter() const { return filter_; }
+
+void PNGLayerWriter::setBands(size_t bands) { bands_ = bands; }
+size_t PNGLayerWriter::getBands() const { return bands_; }
+
 }  // namespace inviwo
@@ -38,6 +38,7 @@
 #include <windows.h>
 #endif
 
+#include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/io/tempfilehandle.h>
@@ -46,10 +47,14 @@
 #include <inviwo/png/pngreader.h>
 #include <inviwo/png/pngwriter.h>
 
+#include <any>
 #include <fstream>
 #include <array>
 #include <cstdio>
 #include <algorithm>
+#include <cstring>
+
+#include <glm/gtx/component_wise.hpp>
 
 namespace inviwo {
 
@@ -93,4 +98,36 @@ TEST(CImgUtils, cimgToBuffer) {
     EXPECT_EQ(*imgBuffer.get(), fileContents) << "buffer and file contents do not match";
 }
 
+TEST(PNGWriter, parallelRoundTrip) {
+    const auto filename = filesystem::getPath(PathType::Tests, "/images/swirl.png");
+    PNGLayerReader reader;
+    auto layer = reader.readData(filename);
+    const auto* ram = layer->getRepresentation<LayerRAM>();
+    const auto bytes = glm::compMul(ram->getDimensions()) * ram->getDataFormat()->getSize();
+
+    for (auto filter : {PNGLayerWriter::Filter::None, PNGLayerWriter::Filter::Paeth,
+                        PNGLayerWriter::Filter::Adaptive}) {
+        for (int level : {-1, 0, 1, 9}) {
+            for (size_t bands : {size_t{1}, size_t{3}, size_t{16}}) {
+                PNGLayerWriter writer;
+                EXPECT_TRUE(writer.setOption("CompressionLevel", level));
+                EXPECT_TRUE(writer.setOption("Filter", filter));
+                EXPECT_TRUE(writer.setOption("Bands", bands));
+                EXPECT_EQ(level, std::any_cast<int>(writer.getOption("CompressionLevel")));
+
+                util::TempFileHandle tmpFile("png", ".png", "wb");
+                writer.writeData(layer.get(), tmpFile.getHandle());
+                std::fflush(tmpFile.getHandle());
+
+                auto result = reader.readData(tmpFile.getFileName());
+                const auto* resultRam = result->getRepresentation<LayerRAM>();
+                ASSERT_EQ(ram->getDimensions(), resultRam->getDimensions());
+                ASSERT_EQ(ram->getDataFormat(), resultRam->getDataFormat());
+                EXPECT_EQ(0, std::memcmp(ram->getData(), resultRam->getData(), bytes))
+                    << "level " << level << " bands " << bands;
+            }
+        }
+    }
+}
+
 }  // namespace inviwo
@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>  // for createVolumeRAM
 #include <inviwo/core/io/datareader.h>                    // for DataReaderType
 #include <inviwo/core/io/datareaderexception.h>           // for DataReaderException
+#include <inviwo/core/io/decodedvolumecache.h>            // for DecodedVolumeCache
 #include <inviwo/core/metadata/metadata.h>                // for StringMetaData, MetaDataPrimiti...
 #include <inviwo/core/metadata/metadataowner.h>           // for MetaDataOwner
 #include <inviwo/core/util/fileextension.h>               // for FileExtension
@@ -70,8 +71,18 @@ PVMVolumeReader* PVMVolumeReader::clone() const { return new PVMVolumeReader(*th
 std::shared_ptr<Volume> PVMVolumeReader::readData(std::string_view filePath) {
     checkExists(filePath);
 
+    // PVM files are compressed and decoding is slow, reuse earlier decoded data when possible
+    auto cache = util::getDecodedVolumeCache();
+    if (cache && cache->isEnabled()) {
+        if (auto volume = cache->load(filePath)) {
+            LogInfo("Loaded volume: " << filePath << " from the decoded volume cache");
+            return volume;
+        }
+    }
+
     auto volume = readPVMData(filePath);
     if (!volume) return nullptr;
+    if (cache && cache->isEnabled()) cache->store(filePath, {}, *volume);
 
     // Print information
     size3_t dim = volume->getDimensions();
@@ -156,6 +156,9 @@ void exposeNetwork(py::module& m) {
         .def("unlock", &ProcessorNetwork::unlock)
         .def("isLocked", &ProcessorNetwork::islocked)
         .def_property_readonly("locked", &ProcessorNetwork::islocked)
+        .def("beginTransaction", &ProcessorNetwork::beginTransaction)
+        .def("endTransaction", &ProcessorNetwork::endTransaction)
+        .def_property_readonly("inTransaction", &ProcessorNetwork::isInTransaction)
         .def_property_readonly("deserializing", &ProcessorNetwork::isDeserializing)
 
         .def("clear",
@@ -265,6 +265,8 @@ void exposeProcessors(pybind11::module& m) {
         .def("isSource", &Processor::isSource)
         .def("isSink", &Processor::isSink)
         .def("isReady", &Processor::isReady)
+        .def_property("outputMemoization", &Processor::getOutputMemoization,
+                      &Processor::setOutputMemoization)
 
         .def("initializeResources", &Processor::initializeResources)
         .def("process", &Processor::process)
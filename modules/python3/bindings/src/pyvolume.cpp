@@ -108,7 +108,14 @@ void exposeVolume(pybind11::module& m) {
                 pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
 
                 memcpy(rep->getData(), data.data(0), data.nbytes());
+                rep->markModified();
             })
+        .def(
+            "markModified",
+            [](Volume* volume, const size3_t& offset, const size3_t& extent) {
+                volume->getEditableRepresentation<VolumeRAM>()->markModified(offset, extent);
+            },
+            py::arg("offset"), py::arg("extent"))
         .def("__repr__", [](const Volume& volume) {
             return fmt::format(
                 "<Volume: {} {} dataRange: {} valueRange: {} value: {}{: [}\n"
@@ -293,10 +293,14 @@ void TFEditorView::updateHistogram(const HistogramContainer& histCont) {
 void TFEditorView::updateHistogram() {
     if (histogramMode_ != HistogramMode::Off && volumeInport_ && volumeInport_->isReady()) {
         if (auto volume = volumeInport_->getData()) {
+            const bool outdated = volume->hasOutdatedHistograms();
             if (volume->hasHistograms()) {
+                // Outdated histograms are shown until the update is done
                 updateHistogram(volume->getHistograms());
-            } else if (!histCalculation_) {
+            } else {
                 histograms_.clear();
+            }
+            if ((outdated || !volume->hasHistograms()) && !histCalculation_) {
                 histCalculation_ = volume->calculateHistograms(2048);
                 histCalculation_->whenDone([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
@@ -0,0 +1,300 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+
+#include <inviwo/core/util/exception.h>      // for Exception
+#include <inviwo/core/util/glmvec.h>         // for dvec2, dvec3
+#include <inviwo/core/util/sourcecontext.h>  // for IVW_CONTEXT_CUSTOM
+
+#include <algorithm>  // for clamp, min, max
+#include <cmath>      // for floor, sqrt
+#include <cstddef>    // for size_t
+#include <vector>     // for vector
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+#include <warn/pop>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Radial basis function interpolant using compactly supported kernels
+ *
+ * Interpolates the values given at a set of centers using the Wendland C2 kernel
+ *     phi(r) = (1 - r/h)^4 (4r/h + 1) for r < h, and 0 otherwise,
+ * where h is the support radius. The kernel is positive definite in up to three dimensions, and
+ * since it is zero beyond the support radius the interpolation matrix is sparse. The centers are
+ * binned into a uniform grid with cells at least as large as the support radius, such that
+ * only nearby centers have to be visited when building the matrix and evaluating the
+ * interpolant. The system is solved with conjugate gradients preconditioned by an incomplete
+ * Cholesky factorization, which is computed once and reused for all components of the values.
+ * A direct factorization is not used since its fill-in grows too fast for large sets of centers
+ * in 3D.
+ *
+ * The interpolant is immutable after construction and can be evaluated concurrently.
+ *
+ * Example Usage:
+ * \code{.cpp}
+ * util::CompactRBF<3> rbf{positions, vectors, 0.25};
+ * dvec3 v = rbf(dvec3{0.1, 0.2, 0.3});
+ * \endcode
+ */
+template <size_t N>
+class CompactRBF {
+public:
+    using Point = glm::vec<N, double>;
+
+    /**
+     * @param centers  positions of the samples
+     * @param values   the values to interpolate, one for each center
+     * @param support  the support radius of the kernel
+     * @param tolerance relative residual at which the iterative solver stops
+     * @throw Exception if there are no centers, if the sizes do not match, or if the
+     *        preconditioner can not be computed
+     */
+    CompactRBF(const std::vector<Point>& centers, const std::vector<Point>& values,
+               double support, double tolerance = 1e-10);
+
+    /**
+     * \brief Evaluate the interpolant at position p
+     */
+    Point operator()(const Point& p) const;
+
+    /**
+     * \brief The Wendland C2 kernel for r normalized by the support radius
+     */
+    static double kernel(double r) {
+        if (r >= 1.0) return 0.0;
+        const auto t = 1.0 - r;
+        const auto t2 = t * t;
+        return t2 * t2 * (4.0 * r + 1.0);
+    }
+
+    double getSupport() const { return support_; }
+    size_t size() const { return centers_.size(); }
+    /**
+     * \brief The number of non zeros in the interpolation matrix
+     */
+    size_t getNonZeros() const { return nonZeros_; }
+    /**
+     * \brief The relative residual reached by the solver, larger than the tolerance if the solver
+     * did not converge. This happens if centers are close to each other relative to the support.
+     */
+    double getError() const { return error_; }
+
+private:
+    using Cell = glm::vec<N, size_t>;
+
+    /**
+     * Calls callback(index, distance) for every center within the support radius of p
+     */
+    template <typename Callback>
+    void forEachNeighbor(const Point& p, Callback callback) const;
+
+    size_t cellIndex(const Cell& cell) const {
+        size_t index = 0;
+        for (size_t i = N; i-- > 0;) index = index * cells_[i] + cell[i];
+        return index;
+    }
+
+    double support_;
+    double cellSize_ = 1.0;
+    Point origin_{0.0};
+    Cell cells_{1};
+    size_t nonZeros_ = 0;
+    double error_ = 0.0;
+    std::vector<size_t> cellStart_;  //!< Index of the first center of each cell, plus the end
+    std::vector<Point> centers_;     //!< Centers sorted by cell
+    std::vector<Point> weights_;     //!< Weights in the order of centers_
+};
+
+template <size_t N>
+CompactRBF<N>::CompactRBF(const std::vector<Point>& centers, const std::vector<Point>& values,
+                          double support, double tolerance)
+    : support_{support} {
+    if (centers.empty()) {
+        throw Exception("At least one center is needed", IVW_CONTEXT_CUSTOM("CompactRBF"));
+    }
+    if (centers.size() != values.size()) {
+        throw Exception("The number of centers and values has to match",
+                        IVW_CONTEXT_CUSTOM("CompactRBF"));
+    }
+    if (!(support > 0.0)) {
+        throw Exception("The support radius has to be positive", IVW_CONTEXT_CUSTOM("CompactRBF"));
+    }
+    const auto count = centers.size();
+
+    Point min{centers.front()};
+    Point max{centers.front()};
+    for (const auto& c : centers) {
+        min = glm::min(min, c);
+        max = glm::max(max, c);
+    }
+
+    // Cells are at least as large as the support radius, grow them if the grid would have many
+    // more cells than centers to keep the memory bounded for small radii.
+    const double maxCells = static_cast<double>(std::max<size_t>(8 * count, 64));
+    cellSize_ = support;
+    for (;;) {
+        double total = 1.0;
+        for (size_t i = 0; i < N; ++i) {
+            total *= std::floor((max[i] - min[i]) / cellSize_) + 1.0;
+        }
+        if (total <= maxCells) break;
+        cellSize_ *= 2.0;
+    }
+    origin_ = min;
+    for (size_t i = 0; i < N; ++i) {
+        cells_[i] = static_cast<size_t>(std::floor((max[i] - min[i]) / cellSize_)) + 1;
+    }
+
+    // Counting sort of the centers into the cells
+    size_t totalCells = 1;
+    for (size_t i = 0; i < N; ++i) totalCells *= cells_[i];
+    std::vector<size_t> cellOf(count);
+    cellStart_.assign(totalCells + 1, 0);
+    for (size_t j = 0; j < count; ++j) {
+        Cell cell;
+        for (size_t i = 0; i < N; ++i) {
+            cell[i] = std::min(static_cast<size_t>((centers[j][i] - origin_[i]) / cellSize_),
+                               cells_[i] - 1);
+        }
+        cellOf[j] = cellIndex(cell);
+        ++cellStart_[cellOf[j] + 1];
+    }
+    for (size_t i = 1; i < cellStart_.size(); ++i) cellStart_[i] += cellStart_[i - 1];
+
+    std::vector<size_t> fill(cellStart_.begin(), cellStart_.end() - 1);
+    std::vector<size_t> order(count);
+    centers_.resize(count);
+    for (size_t j = 0; j < count; ++j) {
+        const auto dest = fill[cellOf[j]]++;
+        order[dest] = j;
+        centers_[dest] = centers[j];
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(count * 32);
+    for (size_t row = 0; row < count; ++row) {
+        forEachNeighbor(centers_[row], [&](size_t col, double r) {
+            triplets.emplace_back(static_cast<int>(row), static_cast<int>(col),
+                                  kernel(r / support_));
+        });
+    }
+    nonZeros_ = triplets.size();
+
+    const auto n = static_cast<Eigen::Index>(count);
+    Eigen::SparseMatrix<double> A(n, n);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+    triplets = {};
+
+    Eigen::MatrixXd b(n, static_cast<Eigen::Index>(N));
+    for (size_t row = 0; row < count; ++row) {
+        for (size_t i = 0; i < N; ++i) {
+            b(static_cast<Eigen::Index>(row), static_cast<Eigen::Index>(i)) = values[order[row]][i];
+        }
+    }
+
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper,
+                             Eigen::IncompleteCholesky<double>>
+        solver;
+    solver.setTolerance(tolerance);
+    solver.compute(A);
+    if (solver.info() != Eigen::Success) {
+        throw Exception("Unable to factorize the interpolation matrix",
+                        IVW_CONTEXT_CUSTOM("CompactRBF"));
+    }
+    const Eigen::MatrixXd x = solver.solve(b);
+    error_ = solver.error();
+
+    weights_.resize(count);
+    for (size_t row = 0; row < count; ++row) {
+        for (size_t i = 0; i < N; ++i) {
+            weights_[row][i] = x(static_cast<Eigen::Index>(row), static_cast<Eigen::Index>(i));
+        }
+    }
+}
+
+template <size_t N>
+template <typename Callback>
+void CompactRBF<N>::forEachNeighbor(const Point& p, Callback callback) const {
+    Cell lo;
+    Cell hi;
+    for (size_t i = 0; i < N; ++i) {
+        const auto max = static_cast<double>(cells_[i] - 1);
+        const auto l = std::floor((p[i] - support_ - origin_[i]) / cellSize_);
+        const auto h = std::floor((p[i] + support_ - origin_[i]) / cellSize_);
+        if (h < 0.0 || l > max) return;
+        lo[i] = static_cast<size_t>(std::max(l, 0.0));
+        hi[i] = static_cast<size_t>(std::min(h, max));
+    }
+
+    const auto support2 = support_ * support_;
+    Cell cell = lo;
+    for (;;) {
+        const auto index = cellIndex(cell);
+        for (auto j = cellStart_[index]; j < cellStart_[index + 1]; ++j) {
+            double r2 = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                const auto d = p[i] - centers_[j][i];
+                r2 += d * d;
+            }
+            if (r2 < support2) callback(j, std::sqrt(r2));
+        }
+
+        // Advance to the next cell, first dimension fastest
+        size_t i = 0;
+        for (; i < N; ++i) {
+            if (cell[i] < hi[i]) {
+                ++cell[i];
+                break;
+            }
+            cell[i] = lo[i];
+        }
+        if (i == N) break;
+    }
+}
+
+template <size_t N>
+auto CompactRBF<N>::operator()(const Point& p) const -> Point {
+    Point result{0.0};
+    forEachNeighbor(p, [&](size_t j, double r) { result += weights_[j] * kernel(r / support_); });
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
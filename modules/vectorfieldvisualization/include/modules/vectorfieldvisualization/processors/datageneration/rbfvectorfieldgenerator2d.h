@@ -36,6 +36,7 @@
 #include <inviwo/core/processors/processorinfo.h>      // for Proce...
 #include <inviwo/core/properties/boolproperty.h>       // for BoolP...
 #include <inviwo/core/properties/compositeproperty.h>  // for Compo...
+#include <inviwo/core/properties/optionproperty.h>     // for Optio...
 #include <inviwo/core/properties/ordinalproperty.h>    // for IntPr...
 #include <inviwo/core/util/glmvec.h>                   // for dvec2
 #include <modules/base/properties/gaussianproperty.h>  // for Gauss...
@@ -50,6 +51,11 @@ class Serializer;
 
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API RBFVectorFieldGenerator2D : public Processor {
 public:
+    enum class Kernel {
+        Gaussian,  //!< Globally supported, solved densely, limited to a few hundred seeds
+        Wendland   //!< Compactly supported, solved sparsely, scales to large numbers of seeds
+    };
+
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
     RBFVectorFieldGenerator2D();
@@ -65,6 +71,8 @@ protected:
 
     IntVec2Property size_;
     IntProperty seeds_;
+    OptionProperty<Kernel> kernel_;
+    FloatProperty support_;
 
     CompositeProperty randomness_;
     BoolProperty useSameSeed_;
@@ -37,6 +37,7 @@
 #include <inviwo/core/processors/processorinfo.h>      // for Proce...
 #include <inviwo/core/properties/boolproperty.h>       // for BoolP...
 #include <inviwo/core/properties/compositeproperty.h>  // for Compo...
+#include <inviwo/core/properties/optionproperty.h>     // for Optio...
 #include <inviwo/core/properties/ordinalproperty.h>    // for Float...
 #include <inviwo/core/util/glmvec.h>                   // for size3_t
 #include <modules/base/properties/gaussianproperty.h>  // for Gauss...
@@ -48,6 +49,11 @@ namespace inviwo {
 
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API RBFVectorFieldGenerator3D : public Processor {
 public:
+    enum class Kernel {
+        Gaussian,  //!< Globally supported, solved densely, limited to a few hundred seeds
+        Wendland   //!< Compactly supported, solved sparsely, scales to large numbers of seeds
+    };
+
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
     RBFVectorFieldGenerator3D();
@@ -61,6 +67,8 @@ protected:
 
     OrdinalProperty<size3_t> size_;
     IntProperty seeds_;
+    OptionProperty<Kernel> kernel_;
+    FloatProperty support_;
 
     CompositeProperty randomness_;
     BoolProperty useSameSeed_;
@@ -45,12 +45,16 @@
 #include <inviwo/core/processors/processortags.h>                       // for Tags
 #include <inviwo/core/properties/boolproperty.h>                        // for BoolProperty
 #include <inviwo/core/properties/compositeproperty.h>                   // for CompositeProperty
+#include <inviwo/core/properties/optionproperty.h>                      // for OptionProperty
 #include <inviwo/core/properties/ordinalproperty.h>                     // for IntProperty, IntV...
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexPar...
 #include <inviwo/core/util/formats.h>                                   // for DataVec2Float32
 #include <inviwo/core/util/glmmat.h>                                    // for mat2
 #include <inviwo/core/util/glmvec.h>                                    // for dvec2, vec2, ivec2
+#include <inviwo/core/util/logcentral.h>                                // for LogWarn
 #include <inviwo/core/util/typetraits.h>                                // for alwaysTrue, identity
 #include <modules/base/properties/gaussianproperty.h>                   // for Gaussian1DProperty
+#include <modules/vectorfieldvisualization/algorithms/compactrbf.h>     // for CompactRBF
 
 #include <algorithm>      // for generate
 #include <cmath>          // for cos, sin, M_PI
@@ -76,6 +80,12 @@
 
 namespace inviwo {
 
+namespace {
+// The Gaussian kernel solves a dense system, the compactly supported Wendland kernel a sparse one
+constexpr int maxDenseSeeds = 100;
+constexpr int maxSparseSeeds = 100000;
+}  // namespace
+
 const ProcessorInfo RBFVectorFieldGenerator2D::processorInfo_{
     "org.inviwo.RBFVectorFieldGenerator2D",  // Class identifier
     "RBF Based 2D Vector Field Generator",   // Display name
@@ -89,7 +99,12 @@ RBFVectorFieldGenerator2D::RBFVectorFieldGenerator2D()
     : Processor()
     , vectorField_("vectorField", DataVec2Float32::get(), false)
     , size_("size", "Volume size", ivec2(700, 700), ivec2(1, 1), ivec2(1024, 1024))
-    , seeds_("seeds", "Number of seeds", 9, 1, 100)
+    , seeds_("seeds", "Number of seeds", 9, 1, maxDenseSeeds)
+    , kernel_("kernel", "Kernel",
+              {{"gaussian", "Gaussian", Kernel::Gaussian},
+               {"wendland", "Wendland", Kernel::Wendland}},
+              0)
+    , support_("support", "Support Radius", 0.5f, 0.001f, 4.0f, 0.001f)
     , randomness_("randomness", "Randomness")
     , useSameSeed_("useSameSeed", "Use same seed", true)
     , seed_("seed", "Seed", 1, 0, std::numeric_limits<int>::max())
@@ -104,9 +119,21 @@ RBFVectorFieldGenerator2D::RBFVectorFieldGenerator2D()
 
     addProperty(size_);
     addProperty(seeds_);
+    addProperty(kernel_);
+    addProperty(support_);
     addProperty(shape_);
     addProperty(gaussian_);
 
+    const auto isKernel = [](Kernel kernel) {
+        return [kernel](const OptionProperty<Kernel>& p) { return p.get() == kernel; };
+    };
+    support_.visibilityDependsOn(kernel_, isKernel(Kernel::Wendland));
+    shape_.visibilityDependsOn(kernel_, isKernel(Kernel::Gaussian));
+    gaussian_.visibilityDependsOn(kernel_, isKernel(Kernel::Gaussian));
+    kernel_.onChange([&]() {
+        seeds_.setMaxValue(kernel_.get() == Kernel::Gaussian ? maxDenseSeeds : maxSparseSeeds);
+    });
+
     addProperty(randomness_);
     randomness_.addProperty(useSameSeed_);
     randomness_.addProperty(seed_);
@@ -124,51 +151,62 @@ void RBFVectorFieldGenerator2D::process() {
         createSamples();
     }
 
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(seeds_.get(), seeds_.get());
-    Eigen::VectorXd bx = Eigen::VectorXd::Zero(seeds_.get()), by(seeds_.get());
-    Eigen::VectorXd xx = Eigen::VectorXd::Zero(seeds_.get()), xy(seeds_.get());
-
-    int row = 0;
-    for (auto& a : samples_) {
-        int col = 0;
-        for (auto& b : samples_) {
-            auto r = glm::distance(a.first, b.first);
-            A(row, col++) = shape_.get() + gaussian_.evaluate(r);
-        }
-        bx(row) = a.second.x;
-        by(row++) = a.second.y;
-    }
-
-    auto solverX = A.llt();
-    auto solverY = A.llt();
-
-    xx = solverX.solve(bx);
-    xy = solverY.solve(by);
-
-    auto img = std::make_shared<Image>(size_.get(), DataVec2Float32::get());
+    const auto dims = size2_t(size_.get());
+    auto img = std::make_shared<Image>(dims, DataVec2Float32::get());
     img->getColorLayer()->setSwizzleMask(
         {ImageChannel::Red, ImageChannel::Green, ImageChannel::Zero, ImageChannel::One});
     auto data =
         static_cast<vec2*>(img->getColorLayer()->getEditableRepresentation<LayerRAM>()->getData());
 
-    int i = 0;
-    for (int y = 0; y < size_.get().y; y++) {
-        for (int x = 0; x < size_.get().x; x++) {
-            dvec2 p(x, y);
-            p /= size_.get();
-            p *= 2;
-            p -= 1;
-
-            vec2 v(0, 0);
-            int s = 0;
-            for (; s < seeds_.get(); s++) {
-                double r = glm::distance(p, samples_[s].first);
-                auto w = gaussian_.evaluate(r);
-                v.x += static_cast<float>(xx(s) * w);
-                v.y += static_cast<float>(xy(s) * w);
+    // Evaluates the field for each pixel in parallel, one row of pixels per job
+    const auto evaluate = [&](auto&& field) {
+        util::forEachIndexParallel(dims.y, [&](size_t y) {
+            auto* dest = data + y * dims.x;
+            for (size_t x = 0; x < dims.x; x++) {
+                const auto p = dvec2(x, y) / dvec2(dims) * 2.0 - 1.0;
+                dest[x] = vec2(field(p));
             }
-            data[i++] = v;
+        });
+    };
+
+    if (kernel_.get() == Kernel::Wendland) {
+        std::vector<dvec2> positions(samples_.size());
+        std::vector<dvec2> vectors(samples_.size());
+        std::transform(samples_.begin(), samples_.end(), positions.begin(),
+                       [](auto& s) { return s.first; });
+        std::transform(samples_.begin(), samples_.end(), vectors.begin(),
+                       [](auto& s) { return s.second; });
+
+        const util::CompactRBF<2> rbf(positions, vectors, support_.get());
+        if (rbf.getError() > 1e-6) {
+            LogWarn("RBF solver did not converge (residual: "
+                    << rbf.getError() << "), consider decreasing the support radius");
         }
+        evaluate(rbf);
+    } else {
+        const auto n = samples_.size();
+        Eigen::MatrixXd A(n, n);
+        Eigen::MatrixXd b(n, 2);
+        for (size_t row = 0; row < n; ++row) {
+            const auto& a = samples_[row];
+            for (size_t col = 0; col < n; ++col) {
+                auto r = glm::distance(a.first, samples_[col].first);
+                A(row, col) = shape_.get() + gaussian_.evaluate(r);
+            }
+            b(row, 0) = a.second.x;
+            b(row, 1) = a.second.y;
+        }
+        // One factorization for both components
+        const Eigen::MatrixXd w = A.llt().solve(b);
+
+        evaluate([&](const dvec2& p) {
+            dvec2 v(0.0);
+            for (size_t s = 0; s < n; s++) {
+                const auto g = gaussian_.evaluate(glm::distance(p, samples_[s].first));
+                v += dvec2(w(s, 0), w(s, 1)) * g;
+            }
+            return v;
+        });
     }
     vectorField_.setData(img);
 }
@@ -43,13 +43,17 @@
 #include <inviwo/core/processors/processortags.h>                       // for Tags
 #include <inviwo/core/properties/boolproperty.h>                        // for BoolProperty
 #include <inviwo/core/properties/compositeproperty.h>                   // for CompositeProperty
+#include <inviwo/core/properties/optionproperty.h>                      // for OptionProperty
 #include <inviwo/core/properties/ordinalproperty.h>                     // for IntProperty, Ordi...
 #include <inviwo/core/properties/propertysemantics.h>                   // for PropertySemantics
+#include <inviwo/core/util/foreach.h>                                   // for forEachIndexPar...
 #include <inviwo/core/util/formats.h>                                   // for DataVec3Float32
 #include <inviwo/core/util/glmmat.h>                                    // for mat3
 #include <inviwo/core/util/glmvec.h>                                    // for dvec3, size3_t, vec3
+#include <inviwo/core/util/logcentral.h>                                // for LogWarn
 #include <modules/base/algorithm/meshutils.h>                           // for arrow, colorsphere
 #include <modules/base/properties/gaussianproperty.h>                   // for Gaussian1DProperty
+#include <modules/vectorfieldvisualization/algorithms/compactrbf.h>     // for CompactRBF
 
 #include <algorithm>             // for generate
 #include <cmath>                 // for cos, sin, sqrt, M_PI
@@ -75,6 +79,13 @@
 #include <warn/pop>
 
 namespace inviwo {
+
+namespace {
+// The Gaussian kernel solves a dense system, the compactly supported Wendland kernel a sparse one
+constexpr int maxDenseSeeds = 100;
+constexpr int maxSparseSeeds = 100000;
+}  // namespace
+
 const ProcessorInfo RBFVectorFieldGenerator3D::processorInfo_{
     "org.inviwo.RBFBased3DVectorFieldGenerator",  // Class identifier
     "RBF Based 3D Vector Field Generator",        // Display name
@@ -88,7 +99,12 @@ RBFVectorFieldGenerator3D::RBFVectorFieldGenerator3D()
     , volume_("volume")
     , mesh_("mesh")
     , size_("size", "Volume size", size3_t(32, 32, 32), size3_t(1, 1, 1), size3_t(1024, 1024, 1024))
-    , seeds_("seeds", "Number of seeds", 6, 1, 100)
+    , seeds_("seeds", "Number of seeds", 6, 1, maxDenseSeeds)
+    , kernel_("kernel", "Kernel",
+              {{"gaussian", "Gaussian", Kernel::Gaussian},
+               {"wendland", "Wendland", Kernel::Wendland}},
+              0)
+    , support_("support", "Support Radius", 0.5f, 0.001f, 4.0f, 0.001f)
 
     , randomness_("randomness", "Randomness")
     , useSameSeed_("useSameSeed", "Use same seed", true)
@@ -110,9 +126,21 @@ RBFVectorFieldGenerator3D::RBFVectorFieldGenerator3D()
 
     addProperty(size_);
     addProperty(seeds_);
+    addProperty(kernel_);
+    addProperty(support_);
     addProperty(shape_);
     addProperty(gaussian_);
 
+    const auto isKernel = [](Kernel kernel) {
+        return [kernel](const OptionProperty<Kernel>& p) { return p.get() == kernel; };
+    };
+    support_.visibilityDependsOn(kernel_, isKernel(Kernel::Wendland));
+    shape_.visibilityDependsOn(kernel_, isKernel(Kernel::Gaussian));
+    gaussian_.visibilityDependsOn(kernel_, isKernel(Kernel::Gaussian));
+    kernel_.onChange([&]() {
+        seeds_.setMaxValue(kernel_.get() == Kernel::Gaussian ? maxDenseSeeds : maxSparseSeeds);
+    });
+
     addProperty(randomness_);
     randomness_.addProperty(useSameSeed_);
     randomness_.addProperty(seed_);
@@ -162,31 +190,8 @@ void RBFVectorFieldGenerator3D::process() {
         mesh_.setData(mesh);
     }
 
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(seeds_.get(), seeds_.get());
-    Eigen::VectorXd bx = Eigen::VectorXd::Zero(seeds_.get()), by(seeds_.get()), bz(seeds_.get());
-    Eigen::VectorXd xx = Eigen::VectorXd::Zero(seeds_.get()), xy(seeds_.get()), xz(seeds_.get());
-
-    int row = 0;
-    for (auto& a : samples) {
-        int col = 0;
-        for (auto& b : samples) {
-            auto r = glm::distance(a.first, b.first);
-            A(row, col++) = shape_.get() + gaussian_.evaluate(r);
-        }
-        bx(row) = a.second.x;
-        by(row) = a.second.y;
-        bz(row++) = a.second.z;
-    }
-
-    auto solverX = A.llt();
-    auto solverY = A.llt();
-    auto solverZ = A.llt();
-
-    xx = solverX.solve(bx);
-    xy = solverY.solve(by);
-    xz = solverZ.solve(bz);
-
-    auto volume = std::make_shared<Volume>(size_.get(), DataVec3Float32::get());
+    const auto dims = size_.get();
+    auto volume = std::make_shared<Volume>(dims, DataVec3Float32::get());
     volume->dataMap_.dataRange = vec2(0, 1);
     volume->dataMap_.valueRange = vec2(-1, 1);
     volume->setBasis(basis);
@@ -194,27 +199,58 @@ void RBFVectorFieldGenerator3D::process() {
 
     auto data = static_cast<vec3*>(volume->getEditableRepresentation<VolumeRAM>()->getData());
 
-    int i = 0;
-    for (size_t z = 0; z < size_.get().z; z++) {
-        for (size_t y = 0; y < size_.get().y; y++) {
-            for (size_t x = 0; x < size_.get().x; x++) {
-                dvec3 p(x, y, z);
-                p /= size_.get();
-                p *= 2;
-                p -= 1;
-
-                vec3 v(0, 0, 0);
-                int s = 0;
-                for (; s < seeds_.get(); s++) {
-                    double r = glm::distance(p, samples[s].first);
-                    v.x += static_cast<float>(xx(s) * gaussian_.evaluate(r));
-                    v.y += static_cast<float>(xy(s) * gaussian_.evaluate(r));
-                    v.z += static_cast<float>(xz(s) * gaussian_.evaluate(r));
-                }
-
-                data[i++] = v;
+    // Evaluates the field for each voxel in parallel, one row of voxels per job
+    const auto evaluate = [&](auto&& field) {
+        util::forEachIndexParallel(dims.y * dims.z, [&](size_t row) {
+            const size_t y = row % dims.y;
+            const size_t z = row / dims.y;
+            auto* dest = data + row * dims.x;
+            for (size_t x = 0; x < dims.x; x++) {
+                const auto p = dvec3(x, y, z) / dvec3(dims) * 2.0 - 1.0;
+                dest[x] = vec3(field(p));
+            }
+        });
+    };
+
+    if (kernel_.get() == Kernel::Wendland) {
+        std::vector<dvec3> positions(samples.size());
+        std::vector<dvec3> vectors(samples.size());
+        std::transform(samples.begin(), samples.end(), positions.begin(),
+                       [](auto& s) { return s.first; });
+        std::transform(samples.begin(), samples.end(), vectors.begin(),
+                       [](auto& s) { return s.second; });
+
+        const util::CompactRBF<3> rbf(positions, vectors, support_.get());
+        if (rbf.getError() > 1e-6) {
+            LogWarn("RBF solver did not converge (residual: "
+                    << rbf.getError() << "), consider decreasing the support radius");
+        }
+        evaluate(rbf);
+    } else {
+        const auto n = samples.size();
+        Eigen::MatrixXd A(n, n);
+        Eigen::MatrixXd b(n, 3);
+        for (size_t row = 0; row < n; ++row) {
+            const auto& a = samples[row];
+            for (size_t col = 0; col < n; ++col) {
+                auto r = glm::distance(a.first, samples[col].first);
+                A(row, col) = shape_.get() + gaussian_.evaluate(r);
             }
+            b(row, 0) = a.second.x;
+            b(row, 1) = a.second.y;
+            b(row, 2) = a.second.z;
         }
+        // One factorization for all three components
+        const Eigen::MatrixXd w = A.llt().solve(b);
+
+        evaluate([&](const dvec3& p) {
+            dvec3 v(0.0);
+            for (size_t s = 0; s < n; s++) {
+                const auto g = gaussian_.evaluate(glm::distance(p, samples[s].first));
+                v += dvec3(w(s, 0), w(s, 1), w(s, 2)) * g;
+            }
+            return v;
+        });
     }
 
     volume_.setData(volume);
@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/algorithms/compactrbf.h>
+
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+template <size_t N>
+std::pair<std::vector<glm::vec<N, double>>, std::vector<glm::vec<N, double>>> randomSamples(
+    size_t count) {
+    std::mt19937 mt(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<glm::vec<N, double>> centers(count);
+    std::vector<glm::vec<N, double>> values(count);
+    for (size_t j = 0; j < count; ++j) {
+        for (size_t i = 0; i < N; ++i) {
+            centers[j][i] = dist(mt);
+            values[j][i] = dist(mt);
+        }
+    }
+    return {centers, values};
+}
+
+}  // namespace
+
+TEST(CompactRBF, Kernel) {
+    EXPECT_DOUBLE_EQ(1.0, util::CompactRBF<3>::kernel(0.0));
+    EXPECT_DOUBLE_EQ(0.0, util::CompactRBF<3>::kernel(1.0));
+    EXPECT_DOUBLE_EQ(0.0, util::CompactRBF<3>::kernel(1.5));
+    EXPECT_GT(util::CompactRBF<3>::kernel(0.5), 0.0);
+}
+
+TEST(CompactRBF, ReproducesValuesAtCenters2D) {
+    const auto [centers, values] = randomSamples<2>(200);
+    const util::CompactRBF<2> rbf(centers, values, 0.2);
+
+    EXPECT_EQ(centers.size(), rbf.size());
+    EXPECT_LT(rbf.getError(), 1e-8);
+    for (size_t j = 0; j < centers.size(); ++j) {
+        const auto v = rbf(centers[j]);
+        EXPECT_NEAR(values[j].x, v.x, 1e-6) << "center " << j;
+        EXPECT_NEAR(values[j].y, v.y, 1e-6) << "center " << j;
+    }
+}
+
+TEST(CompactRBF, ReproducesValuesAtCenters3D) {
+    const auto [centers, values] = randomSamples<3>(500);
+    const util::CompactRBF<3> rbf(centers, values, 0.3);
+
+    EXPECT_EQ(centers.size(), rbf.size());
+    EXPECT_LT(rbf.getNonZeros(), centers.size() * centers.size());
+    EXPECT_LT(rbf.getError(), 1e-8);
+    for (size_t j = 0; j < centers.size(); ++j) {
+        const auto v = rbf(centers[j]);
+        EXPECT_NEAR(values[j].x, v.x, 1e-6) << "center " << j;
+        EXPECT_NEAR(values[j].y, v.y, 1e-6) << "center " << j;
+        EXPECT_NEAR(values[j].z, v.z, 1e-6) << "center " << j;
+    }
+}
+
+TEST(CompactRBF, ZeroBeyondSupport) {
+    const std::vector<dvec3> centers{{0.0, 0.0, 0.0}, {0.1, 0.0, 0.0}, {0.0, 0.1, 0.0}};
+    const std::vector<dvec3> values{{1.0, 2.0, 3.0}, {-1.0, 0.5, 0.0}, {0.0, 0.0, 1.0}};
+    const util::CompactRBF<3> rbf(centers, values, 0.25);
+
+    // Outside the support of all centers
+    EXPECT_EQ(dvec3(0.0), rbf(dvec3{0.4, 0.0, 0.0}));
+    EXPECT_EQ(dvec3(0.0), rbf(dvec3{0.0, -0.3, 0.0}));
+    EXPECT_EQ(dvec3(0.0), rbf(dvec3{0.0, 0.0, 0.3}));
+    EXPECT_EQ(dvec3(0.0), rbf(dvec3{5.0, -5.0, 5.0}));
+    // Inside the support of the first center only
+    EXPECT_NE(dvec3(0.0), rbf(dvec3{-0.2, -0.1, 0.0}));
+}
+
+TEST(CompactRBF, InvalidInput) {
+    const std::vector<dvec3> centers{{0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}};
+    const std::vector<dvec3> values{{1.0, 0.0, 0.0}};
+
+    EXPECT_THROW(util::CompactRBF<3>({}, {}, 0.5), Exception);
+    EXPECT_THROW(util::CompactRBF<3>(centers, values, 0.5), Exception);
+    EXPECT_THROW(util::CompactRBF<3>(centers, {}, 0.5), Exception);
+    EXPECT_THROW(util::CompactRBF<3>(centers, centers, 0.0), Exception);
+}
+
+}  // namespace inviwo
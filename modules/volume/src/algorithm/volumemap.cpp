@@ -112,6 +112,7 @@ void remap(Volume& volume, const std::vector<int>& src, const std::vector<int>&
         }
     });
 #include <warn/pop>
+    volRep->markModified();
 }
 
 }  // namespace inviwo::util
@@ -57,7 +57,7 @@ const ProcessorInfo VolumeRegionStatistics::processorInfo_{
 const ProcessorInfo VolumeRegionStatistics::getProcessorInfo() const { return processorInfo_; }
 
 VolumeRegionStatistics::VolumeRegionStatistics()
-    : PoolProcessor()
+    : PoolProcessor(pool::Option::Preemptible)
     , volume_("volume")
     , atlas_{"atlas"}
     , dataFrame_{"statistics"}
@@ -69,6 +69,9 @@ VolumeRegionStatistics::VolumeRegionStatistics()
 
     addPorts(volume_, atlas_, dataFrame_);
     addProperties(space_);
+
+    // The statistics are not needed for rendering, let interactive work go first
+    setPriority(ThreadPool::Priority::Background);
 }
 
 auto addColumns(DataFrame& df, std::string_view name, size_t size, Unit unit,
@@ -272,7 +275,10 @@ struct StatsFunctor {
     std::vector<std::vector<double>*> regionCenter;
     std::vector<std::vector<std::vector<double>*>> regionCoM;
 
-    StatsFunctor(const Volume& volume, const Volume& atlas, CoordinateSpace destSpace)
+    const pool::Stop stop;
+
+    StatsFunctor(const Volume& volume, const Volume& atlas, CoordinateSpace destSpace,
+                 pool::Stop aStop)
         : nRegions{static_cast<size_t>(atlas.dataMap_.dataRange.y)}
         , channels{volume.getDataFormat()->getComponents()}
         , df{std::make_shared<DataFrame>(static_cast<uint32_t>(nRegions))}
@@ -284,7 +290,8 @@ struct StatsFunctor {
         , index2dest{volume.getCoordinateTransformer().getMatrix(CoordinateSpace::Index, destSpace)}
         , index2data{volume.getCoordinateTransformer().getMatrix(CoordinateSpace::Index,
                                                                  CoordinateSpace::Data)}
-        , volumeScale{voxelVolume(index2dest)} {
+        , volumeScale{voxelVolume(index2dest)}
+        , stop{aStop} {
 
         const auto& axes = volume.axes;
         const std::array<std::string_view, 3> axesNames = {axes[0].name, axes[1].name,
@@ -341,6 +348,7 @@ struct StatsFunctor {
 
         const util::IndexMapper3D indexMapper(dim);
         util::forEachVoxel(*volumeRep, [&](const size3_t& pos) {
+            if (stop) return;
             const auto p = indexMapper(pos);
             for (size_t c = 0; c < channels; ++c) {
                 const auto region = regionMapper(getRegion(p) - 1, c);
@@ -349,6 +357,7 @@ struct StatsFunctor {
                 stats[region].add(dpos, value);
             }
         });
+        if (stop) return nullptr;
 
         for (auto&& [i, stat] : util::enumerate(stats)) {
             const auto [region, c] = regionMapper(i);
@@ -376,7 +385,7 @@ struct StatsFunctor {
 
 void VolumeRegionStatistics::process() {
     auto calc = [volume = volume_.getData(), atlas = atlas_.getData(),
-                 space = space_.getSelectedValue()]() {
+                 space = space_.getSelectedValue()](pool::Stop stop) {
         if (volume->getDimensions() != atlas->getDimensions()) {
             throw Exception(IVW_CONTEXT_CUSTOM("VolumeRegionStatistics::process"),
                             "Unexpected dimension missmatch. Volume: {}, Atlas: {}",
@@ -390,7 +399,7 @@ void VolumeRegionStatistics::process() {
                 atlas->getDataFormat()->getString());
         }
 
-        StatsFunctor sf{*volume, *atlas, space};
+        StatsFunctor sf{*volume, *atlas, space, stop};
         return wrappingDispatch<std::shared_ptr<DataFrame>>(sf, volume->getWrapping());
     };
 
@@ -55,6 +55,9 @@
 #include <inviwo/core/rendering/meshdrawerfactory.h>
 #include <inviwo/core/rendering/datavisualizermanager.h>
 #include <inviwo/core/resourcemanager/resourcemanager.h>
+#include <inviwo/core/datastructures/representationpool.h>
+#include <inviwo/core/datastructures/representationregistry.h>
+#include <inviwo/core/io/decodedvolumecache.h>
 #include <inviwo/core/util/capabilities.h>
 #include <inviwo/core/util/dialogfactory.h>
 #include <inviwo/core/util/fileobserver.h>
@@ -128,6 +131,7 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string_view dis
         }
     }()}
     , progressCallback_()
+    , representationRegistry_{std::make_unique<RepresentationRegistry>()}
     , pool_(
           0, []() {}, []() { RenderContext::getPtr()->clearContext(); })
     , queue_()
@@ -136,6 +140,8 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string_view dis
         RenderContext::deleteInstance();
     }}
     , resourceManager_{std::make_unique<ResourceManager>()}
+    , representationPool_{std::make_unique<RepresentationPool>()}
+    , decodedVolumeCache_{std::make_unique<DecodedVolumeCache>()}
     , cameraFactory_{std::make_unique<CameraFactory>()}
     , dataReaderFactory_{std::make_unique<DataReaderFactory>()}
     , dataWriterFactory_{std::make_unique<DataWriterFactory>()}
@@ -181,6 +187,37 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string_view dis
         resourceManager_->setEnabled(false);
     }
 
+    const auto updatePoolBudget = [this]() {
+        representationPool_->setBudget(systemSettings_->representationPoolBudget_.get() *
+                                       size_t{1024} * size_t{1024});
+    };
+    updatePoolBudget();
+    systemSettings_->representationPoolBudget_.onChange(updatePoolBudget);
+
+    const auto updateRegistryBudget = [this]() {
+        representationRegistry_->setBudget(systemSettings_->representationMemoryBudget_.get() *
+                                           size_t{1024} * size_t{1024});
+    };
+    updateRegistryBudget();
+    systemSettings_->representationMemoryBudget_.onChange(updateRegistryBudget);
+
+    const auto updateVolumeCache = [this]() {
+        decodedVolumeCache_->setDirectory(systemSettings_->decodedVolumeCacheDirectory_.get());
+        decodedVolumeCache_->setBudget(systemSettings_->decodedVolumeCacheBudget_.get() *
+                                       size_t{1024} * size_t{1024});
+    };
+    updateVolumeCache();
+    systemSettings_->decodedVolumeCacheBudget_.onChange(updateVolumeCache);
+    systemSettings_->decodedVolumeCacheDirectory_.onChange(updateVolumeCache);
+
+    moduleManager_.setLazyRegistration(commandLineParser_->getLazyModuleRegistration());
+    dataReaderFactory_->setLookupCallback([this](std::string_view filePathOrExtension) {
+        moduleManager_.loadDeferredModulesForReader(filePathOrExtension);
+    });
+    dataWriterFactory_->setLookupCallback([this](std::string_view filePathOrExtension) {
+        moduleManager_.loadDeferredModulesForWriter(filePathOrExtension);
+    });
+
     moduleManager_.onModulesDidRegister([this]() {
         if (resourceManager_->isEnabled() && resourceManager_->numberOfResources() > 0) {
             LogWarn(
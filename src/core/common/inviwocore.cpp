@@ -54,6 +54,8 @@
 #include <inviwo/core/util/settings/unitsettings.h>
 
 // Io
+#include <inviwo/core/io/ivmmeshreader.h>
+#include <inviwo/core/io/ivmmeshwriter.h>
 #include <inviwo/core/io/rawvolumereader.h>
 #include <inviwo/core/io/transferfunctionitfreader.h>
 #include <inviwo/core/io/transferfunctionitfwriter.h>
@@ -299,11 +301,13 @@ InviwoCore::InviwoCore(InviwoApplication* app)
 
     // Register Data readers
     registerDataReader(std::make_unique<RawVolumeReader>());
+    registerDataReader(std::make_unique<IvmMeshReader>());
     registerDataReader(std::make_unique<TransferFunctionITFReader>());
     registerDataReader(std::make_unique<TransferFunctionXMLReader>());
     registerDataReader(std::make_unique<IsoValueCollectionIIVReader>());
 
     // Register Data writers
+    registerDataWriter(std::make_unique<IvmMeshWriter>());
     registerDataWriter(std::make_unique<TransferFunctionITFWriter>());
     registerDataWriter(std::make_unique<TransferFunctionXMLWriter>());
     registerDataWriter(std::make_unique<IsoValueCollectionIIVWriter>());
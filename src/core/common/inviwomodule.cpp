@@ -243,6 +243,15 @@ InviwoModule::getRepresentationConverterFactories() const {
 const std::vector<MeshDrawer*> InviwoModule::getDrawers() const { return uniqueToPtr(drawers_); }
 const std::vector<Settings*>& InviwoModule::getSettings() const { return settings_; }
 
+bool InviwoModule::hasOnlyDeferrableRegistrations() const {
+    return cameras_.empty() && capabilities_.empty() && dialogs_.empty() && drawers_.empty() &&
+           metadata_.empty() && inports_.empty() && outports_.empty() && portInspectors_.empty() &&
+           propertyConverters_.empty() && properties_.empty() && propertyWidgets_.empty() &&
+           representationFactoryObjects_.empty() && representationFactories_.empty() &&
+           representationConverters_.empty() && representationConverterFactories_.empty() &&
+           settings_.empty() && dataVisualizers_.empty();
+}
+
 std::string InviwoModule::getDescription() const {
     for (auto& item : app_->getModuleManager().getModuleFactoryObjects()) {
         if (item->name == identifier_) {
@@ -37,11 +37,16 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/chronoutils.h>
+#include <inviwo/core/util/commandlineparser.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/inviwocommondefines.h>
 
 #include <string>
 #include <functional>
+#include <algorithm>
+
+#include <fmt/format.h>
 
 #if WIN32
 #include <windows.h>
@@ -71,7 +76,8 @@ ModuleManager::ModuleManager(InviwoApplication* app)
         // Need to clear the modules in reverse order since the might depend on each other.
         // The destruction order of vector is undefined.
         util::reverse_erase(modules_);
-    }) {}
+    })
+    , mainThread_{std::this_thread::get_id()} {}
 
 ModuleManager::~ModuleManager() = default;
 
@@ -88,26 +94,35 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
 
     for (auto& obj : factoryObjects_) {
         app_->postProgress("Loading module: " + obj->name);
-        if (getModuleByIdentifier(obj->name)) continue;  // already loaded
+        if (findModule(obj->name) || isDeferred(obj->name)) continue;  // already loaded
         if (!checkDependencies(*obj)) continue;
-        try {
-            registerModule(obj->create(app_));
-        } catch (const ModuleInitException& e) {
-            auto dereg = deregisterDependetModules(e.getModulesToDeregister());
-            auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
-                                             joinString(dereg.begin(), dereg.end(), ", ")
-                                       : "");
-            LogError("Failed to register module: " << obj->name << ". Reason:\n"
-                                                   << e.getMessage() << err);
+        if (canDefer(*obj)) {
+            deferred_.push_back(obj.get());
+            hasDeferred_ = true;
+            continue;
         }
+        // Dependencies that were deferred are needed now
+        for (const auto& dep : obj->dependencies) {
+            loadDeferredModule(dep.first);
+        }
+        if (!checkDependencies(*obj)) continue;
+        createModule(*obj);
     }
 
     app_->postProgress("Loading Capabilities");
+    Clock clock;
     for (auto& module : modules_) {
-        for (auto& elem : module->getCapabilities()) {
-            elem->retrieveStaticInfo();
-            elem->printInfo();
-        }
+        retrieveCapabilities(*module);
+    }
+    timings_.push_back({"Capabilities", clock.getElapsedTime()});
+
+    saveManifest();
+    if (!deferred_.empty()) {
+        LogInfo(fmt::format("Deferred construction of {} modules: {}", deferred_.size(),
+                            joinString(getDeferredModules(), ", ")));
+    }
+    if (app_->getCommandLineParser().getLogStartupTiming()) {
+        logRegistrationTimings();
     }
 
     onModulesDidRegister_.invoke();
@@ -153,6 +168,8 @@ void ModuleManager::registerModules(RuntimeModuleLoading,
     // 4. Start observing file if reloadLibrariesWhenChanged
     // 5. Pass module factories to registerModules
 
+    Clock clock;
+
     // Find unique files and directories in specified search paths
     auto librarySearchPaths = util::getLibrarySearchPaths();
     std::set<std::string> libraryFiles;
@@ -259,6 +276,8 @@ void ModuleManager::registerModules(RuntimeModuleLoading,
     auto dependencies = getProtectedDependencies(protected_, modules);
     protected_.insert(dependencies.begin(), dependencies.end());
 
+    timings_.push_back({"Libraries", clock.getElapsedTime()});
+
     registerModules(std::move(modules));
 }
 
@@ -269,6 +288,9 @@ void ModuleManager::unregisterModules() {
     // The destruction order of vector is undefined.
     util::reverse_erase_if(
         modules_, [this](const auto& m) { return !this->isProtected(m->getIdentifier()); });
+    // Protected modules are never deferred
+    deferred_.clear();
+    hasDeferred_ = false;
 
     // Remove module factories
     util::reverse_erase_if(factoryObjects_,
@@ -297,6 +319,16 @@ ModuleManager::getModuleFactoryObjects() const {
 }
 
 InviwoModule* ModuleManager::getModuleByIdentifier(std::string_view identifier) const {
+    if (auto* module = findModule(identifier)) return module;
+    if (isDeferred(identifier)) {
+        // Constructing a deferred module does not change the set of available modules, only when
+        // they are materialized.
+        return const_cast<ModuleManager*>(this)->loadDeferredModule(identifier);
+    }
+    return nullptr;
+}
+
+InviwoModule* ModuleManager::findModule(std::string_view identifier) const {
     const auto it =
         std::find_if(modules_.begin(), modules_.end(), [&](const std::unique_ptr<InviwoModule>& m) {
             return iCaseCmp(m->getIdentifier(), identifier);
@@ -388,7 +420,7 @@ bool ModuleManager::checkDependencies(const InviwoModuleFactoryObject& obj) cons
         const auto& version = dep.second;
 
         if (auto depObj = getFactoryObject(name)) {
-            if (!getModuleByIdentifier(depObj->name)) {
+            if (!findModule(depObj->name) && !isDeferred(depObj->name)) {
                 err << "\nModule dependency: " + depObj->name + " failed to register";
             } else if (!depObj->version.semanticVersionEqual(obj.version)) {
                 err << "\nModule depends on " << depObj->name << " version " << version
@@ -427,6 +459,204 @@ std::vector<std::string> ModuleManager::deregisterDependetModules(
     return deregistered;
 }
 
+void ModuleManager::setLazyRegistration(bool enable) {
+    if (lazy_ == enable) return;
+    if (enable) {
+        manifest_.load(getManifestPath());
+    } else {
+        loadDeferredModules();
+        manifest_.clear();
+    }
+    lazy_ = enable;
+}
+
+bool ModuleManager::isLazyRegistrationEnabled() const { return lazy_; }
+
+std::vector<std::string> ModuleManager::getDeferredModules() const {
+    std::vector<std::string> names;
+    for (const auto* obj : deferred_) {
+        names.push_back(obj->name);
+    }
+    return names;
+}
+
+bool ModuleManager::loadDeferredModulesForProcessor(std::string_view classIdentifier) {
+    if (!lazy_ || !hasDeferred_) return false;
+    if (std::this_thread::get_id() != mainThread_) {
+        return app_
+            ->dispatchFront([&]() { return loadDeferredModulesForProcessor(classIdentifier); })
+            .get();
+    }
+    const auto provides = [&](const ModuleManifest::Entry* entry) {
+        return util::contains(entry->processors, classIdentifier);
+    };
+    const bool listed = util::contains_if(deferred_, [&](const auto* obj) {
+        const auto* entry = manifest_.find(*obj);
+        return entry && provides(entry);
+    });
+    // An unlisted processor might come from a module that changed since the manifest was written
+    return loadDeferredModulesIf([&](const ModuleManifest::Entry* entry) {
+        return !listed || provides(entry);
+    });
+}
+
+bool ModuleManager::loadDeferredModulesForReader(std::string_view filePathOrExtension) {
+    return loadDeferredModulesIf([&](const ModuleManifest::Entry* entry) {
+        return filePathOrExtension.empty()
+                   ? !entry->readerExtensions.empty()
+                   : ModuleManifest::matchesExtension(entry->readerExtensions,
+                                                      filePathOrExtension);
+    });
+}
+
+bool ModuleManager::loadDeferredModulesForWriter(std::string_view filePathOrExtension) {
+    return loadDeferredModulesIf([&](const ModuleManifest::Entry* entry) {
+        return filePathOrExtension.empty()
+                   ? !entry->writerExtensions.empty()
+                   : ModuleManifest::matchesExtension(entry->writerExtensions,
+                                                      filePathOrExtension);
+    });
+}
+
+void ModuleManager::loadDeferredModules() {
+    loadDeferredModulesIf([](const ModuleManifest::Entry*) { return true; });
+}
+
+const std::vector<ModuleManager::Timing>& ModuleManager::getRegistrationTimings() const {
+    return timings_;
+}
+
+void ModuleManager::logRegistrationTimings() const {
+    auto sorted = timings_;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Timing& a, const Timing& b) { return a.duration > b.duration; });
+    Clock::duration total{0};
+    std::string message;
+    for (const auto& timing : sorted) {
+        total += timing.duration;
+        message += fmt::format("\n{:>12} {}", util::durationToString(timing.duration),
+                               timing.name);
+    }
+    LogInfo(fmt::format("Module registration took {}, {} modules constructed, {} deferred:{}",
+                        util::durationToString(total), modules_.size(), deferred_.size(),
+                        message));
+}
+
+bool ModuleManager::isDeferred(std::string_view identifier) const {
+    return util::contains_if(deferred_,
+                             [&](const auto* obj) { return iCaseCmp(obj->name, identifier); });
+}
+
+bool ModuleManager::canDefer(const InviwoModuleFactoryObject& obj) const {
+    if (!lazy_ || isProtected(obj.name)) return false;
+    const auto* entry = manifest_.find(obj);
+    return entry && entry->deferrable &&
+           (!entry->processors.empty() || !entry->readerExtensions.empty() ||
+            !entry->writerExtensions.empty());
+}
+
+InviwoModule* ModuleManager::createModule(InviwoModuleFactoryObject& obj) {
+    Clock clock;
+    try {
+        registerModule(obj.create(app_));
+    } catch (const ModuleInitException& e) {
+        auto dereg = deregisterDependetModules(e.getModulesToDeregister());
+        auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
+                                         joinString(dereg.begin(), dereg.end(), ", ")
+                                   : "");
+        LogError("Failed to register module: " << obj.name << ". Reason:\n"
+                                               << e.getMessage() << err);
+        manifest_.erase(obj.name);
+        return nullptr;
+    }
+    timings_.push_back({obj.name, clock.getElapsedTime()});
+
+    auto* module = modules_.back().get();
+    if (lazy_) manifest_.update(obj, *module);
+    return module;
+}
+
+InviwoModule* ModuleManager::loadDeferredModule(std::string_view identifier) {
+    auto it = util::find_if(deferred_,
+                            [&](const auto* obj) { return iCaseCmp(obj->name, identifier); });
+    if (it == deferred_.end()) return findModule(identifier);
+
+    auto* obj = *it;
+    deferred_.erase(it);
+    hasDeferred_ = !deferred_.empty();
+    for (const auto& dep : obj->dependencies) {
+        loadDeferredModule(dep.first);
+    }
+    // A dependency might have failed to register
+    if (!checkDependencies(*obj)) return nullptr;
+    return createModule(*obj);
+}
+
+bool ModuleManager::loadDeferredModulesIf(
+    const std::function<bool(const ModuleManifest::Entry*)>& predicate) {
+    // Checked before dispatching, most lookups happen when nothing is deferred and should not
+    // have to wait for the main thread.
+    if (!lazy_ || !hasDeferred_) return false;
+
+    // Modules have to be constructed on the main thread, which also owns the list of deferred
+    // modules. Note that this will dead lock if the main thread is waiting for the calling thread.
+    if (std::this_thread::get_id() != mainThread_) {
+        return app_->dispatchFront([&]() { return loadDeferredModulesIf(predicate); }).get();
+    }
+    if (deferred_.empty()) return false;
+
+    std::vector<std::string> toLoad;
+    for (const auto* obj : deferred_) {
+        const auto* entry = manifest_.find(*obj);
+        if (!entry || predicate(entry)) toLoad.push_back(obj->name);
+    }
+    if (toLoad.empty()) return false;
+
+    std::vector<InviwoModule*> existing;
+    for (const auto& module : modules_) existing.push_back(module.get());
+
+    for (const auto& name : toLoad) {
+        app_->postProgress("Loading module: " + name);
+        loadDeferredModule(name);
+    }
+
+    Clock clock;
+    bool loaded = false;
+    for (const auto& module : modules_) {
+        if (!util::contains(existing, module.get())) {
+            retrieveCapabilities(*module);
+            loaded = true;
+        }
+    }
+    timings_.push_back({"Capabilities", clock.getElapsedTime()});
+
+    saveManifest();
+    return loaded;
+}
+
+void ModuleManager::retrieveCapabilities(InviwoModule& module) {
+    for (auto& elem : module.getCapabilities()) {
+        elem->retrieveStaticInfo();
+        elem->printInfo();
+    }
+}
+
+void ModuleManager::saveManifest() {
+    if (!lazy_ || !manifest_.isModified()) return;
+    try {
+        manifest_.save(getManifestPath());
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Warn);
+    } catch (const std::exception& e) {
+        LogWarn(e.what());
+    }
+}
+
+std::string ModuleManager::getManifestPath() const {
+    const auto appname = util::stripIdentifier(app_->getDisplayName());
+    return filesystem::getPath(PathType::Settings, "/" + appname + "_module-manifest.ivs", true);
+}
+
 auto ModuleManager::getProtectedDependencies(
     const IdSet& ptotectedIds,
     const std::vector<std::unique_ptr<InviwoModuleFactoryObject>>& modules) -> IdSet {
@@ -0,0 +1,164 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/modulemanifest.h>
+
+#include <inviwo/core/common/inviwomodule.h>
+#include <inviwo/core/common/inviwomodulefactoryobject.h>
+#include <inviwo/core/common/version.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/io/datawriter.h>
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/processors/processorfactoryobject.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+void ModuleManifest::Entry::serialize(Serializer& s) const {
+    s.serialize("version", version);
+    s.serialize("inviwoCoreVersion", inviwoCoreVersion);
+    s.serialize("processors", processors, "processor");
+    s.serialize("readers", readerExtensions, "extension");
+    s.serialize("writers", writerExtensions, "extension");
+    s.serialize("deferrable", deferrable);
+}
+
+void ModuleManifest::Entry::deserialize(Deserializer& d) {
+    d.deserialize("version", version);
+    d.deserialize("inviwoCoreVersion", inviwoCoreVersion);
+    d.deserialize("processors", processors, "processor");
+    d.deserialize("readers", readerExtensions, "extension");
+    d.deserialize("writers", writerExtensions, "extension");
+    d.deserialize("deferrable", deferrable);
+}
+
+bool ModuleManifest::Entry::operator==(const Entry& rhs) const {
+    return version == rhs.version && inviwoCoreVersion == rhs.inviwoCoreVersion &&
+           processors == rhs.processors && readerExtensions == rhs.readerExtensions &&
+           writerExtensions == rhs.writerExtensions && deferrable == rhs.deferrable;
+}
+
+bool ModuleManifest::Entry::operator!=(const Entry& rhs) const { return !(*this == rhs); }
+
+const ModuleManifest::Entry* ModuleManifest::find(const InviwoModuleFactoryObject& obj) const {
+    auto it = entries_.find(obj.name);
+    if (it == entries_.end()) return nullptr;
+    if (it->second.version != toString(obj.version) ||
+        it->second.inviwoCoreVersion != toString(obj.inviwoCoreVersion)) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void ModuleManifest::update(const InviwoModuleFactoryObject& obj, const InviwoModule& module) {
+    Entry entry;
+    entry.version = toString(obj.version);
+    entry.inviwoCoreVersion = toString(obj.inviwoCoreVersion);
+    entry.deferrable = module.hasOnlyDeferrableRegistrations();
+    for (auto* processor : module.getProcessors()) {
+        entry.processors.push_back(processor->getClassIdentifier());
+    }
+    for (auto* reader : module.getDataReaders()) {
+        for (const auto& ext : reader->getExtensions()) {
+            entry.readerExtensions.push_back(ext.extension_);
+        }
+    }
+    for (auto* writer : module.getDataWriters()) {
+        for (const auto& ext : writer->getExtensions()) {
+            entry.writerExtensions.push_back(ext.extension_);
+        }
+    }
+
+    auto it = entries_.find(obj.name);
+    if (it == entries_.end()) {
+        entries_.emplace(obj.name, std::move(entry));
+        modified_ = true;
+    } else if (it->second != entry) {
+        it->second = std::move(entry);
+        modified_ = true;
+    }
+}
+
+void ModuleManifest::erase(std::string_view moduleName) {
+    if (auto it = entries_.find(moduleName); it != entries_.end()) {
+        entries_.erase(it);
+        modified_ = true;
+    }
+}
+
+void ModuleManifest::clear() {
+    modified_ = modified_ || !entries_.empty();
+    entries_.clear();
+}
+
+bool ModuleManifest::empty() const { return entries_.empty(); }
+
+bool ModuleManifest::isModified() const { return modified_; }
+
+void ModuleManifest::load(std::string_view filePath) {
+    entries_.clear();
+    modified_ = false;
+    if (!filesystem::fileExists(filePath)) return;
+
+    // A broken manifest is not critical, the modules will just be registered eagerly.
+    try {
+        Deserializer d(filePath);
+        deserialize(d);
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Warn);
+        entries_.clear();
+    } catch (const std::exception& e) {
+        LogWarn(e.what());
+        entries_.clear();
+    }
+    modified_ = false;
+}
+
+void ModuleManifest::save(std::string_view filePath) {
+    Serializer s(filePath);
+    serialize(s);
+    s.writeFile();
+    modified_ = false;
+}
+
+void ModuleManifest::serialize(Serializer& s) const { s.serialize("modules", entries_, "module"); }
+
+void ModuleManifest::deserialize(Deserializer& d) { d.deserialize("modules", entries_, "module"); }
+
+bool ModuleManifest::matchesExtension(const std::vector<std::string>& extensions,
+                                      std::string_view filePathOrExtension) {
+    return std::any_of(extensions.begin(), extensions.end(), [&](const std::string& ext) {
+        return util::iCaseEndsWith(filePathOrExtension, ext);
+    });
+}
+
+}  // namespace inviwo
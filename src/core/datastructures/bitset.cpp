@@ -89,28 +89,26 @@ bool BitSet::BitSetIterator::operator!=(const BitSetIterator& rhs) const {
     return it_->operator!=(*rhs.it_);
 }
 
-BitSet::BitSet() : roaring_(std::make_unique<roaring::Roaring>()) {}
+BitSet::BitSet() : roaring_(std::make_shared<roaring::Roaring>()) {}
 
 BitSet::BitSet(util::span<const uint32_t> span) : BitSet() { addMany(span.size(), span.data()); }
 
 BitSet::BitSet(const std::vector<bool>& v) : BitSet() { add(v); }
 
 BitSet::BitSet(const roaring::Roaring& roaring)
-    : roaring_(std::make_unique<roaring::Roaring>(roaring)) {}
+    : roaring_(std::make_shared<roaring::Roaring>(roaring)) {}
 
 BitSet::BitSet(roaring::Roaring&& roaring)
-    : roaring_(std::make_unique<roaring::Roaring>(std::move(roaring))) {}
+    : roaring_(std::make_shared<roaring::Roaring>(std::move(roaring))) {}
 
-BitSet::BitSet(const BitSet& rhs) : roaring_(std::make_unique<roaring::Roaring>(*rhs.roaring_)) {}
+BitSet::BitSet(const BitSet& rhs) : roaring_(rhs.roaring_) {}
 
 BitSet::BitSet(BitSet&& rhs) noexcept : roaring_(std::move(rhs.roaring_)) {}
 
 BitSet::~BitSet() = default;
 
 BitSet& BitSet::operator=(const BitSet& rhs) {
-    if (this != &rhs) {
-        *roaring_ = *rhs.roaring_;
-    }
+    roaring_ = rhs.roaring_;
     return *this;
 }
 
@@ -129,7 +127,13 @@ size_t BitSet::size() const { return static_cast<size_t>(roaring_->cardinality()
 
 bool BitSet::empty() const { return roaring_->isEmpty(); }
 
-void BitSet::clear() { roaring::api::roaring_bitmap_clear(&roaring_->roaring); }
+void BitSet::clear() {
+    if (roaring_.use_count() > 1) {
+        roaring_ = std::make_shared<roaring::Roaring>();
+    } else {
+        roaring::api::roaring_bitmap_clear(&roaring_->roaring);
+    }
+}
 
 bool BitSet::isSubsetOf(const BitSet& b) const { return roaring_->isSubset(*(b.roaring_)); }
 
@@ -156,17 +160,17 @@ void BitSet::add(const std::vector<bool>& v) {
     }
 }
 
-bool BitSet::addChecked(uint32_t v) { return roaring_->addChecked(v); }
+bool BitSet::addChecked(uint32_t v) { return mutableRoaring().addChecked(v); }
 
-void BitSet::addRange(uint32_t min, uint32_t max) { roaring_->addRange(min, max); }
+void BitSet::addRange(uint32_t min, uint32_t max) { mutableRoaring().addRange(min, max); }
 
 void BitSet::addRangeClosed(uint32_t min, uint32_t max) {
-    roaring::api::roaring_bitmap_add_range_closed(&roaring_->roaring, min, max);
+    roaring::api::roaring_bitmap_add_range_closed(&mutableRoaring().roaring, min, max);
 }
 
-void BitSet::remove(uint32_t v) { roaring_->remove(v); }
+void BitSet::remove(uint32_t v) { mutableRoaring().remove(v); }
 
-bool BitSet::removeChecked(uint32_t v) { return roaring_->removeChecked(v); }
+bool BitSet::removeChecked(uint32_t v) { return mutableRoaring().removeChecked(v); }
 
 uint32_t BitSet::max() const { return roaring_->maximum(); }
 
@@ -178,13 +182,15 @@ bool BitSet::containsRange(uint32_t min, uint32_t max) const {
     return roaring_->containsRange(min, max);
 }
 
-void BitSet::flip(uint32_t v) { roaring_->flip(v, v + 1); }
+void BitSet::flip(uint32_t v) { mutableRoaring().flip(v, v + 1); }
 
-void BitSet::flipRange(uint32_t min, uint32_t max) { roaring_->flip(min, max); }
+void BitSet::flipRange(uint32_t min, uint32_t max) { mutableRoaring().flip(min, max); }
 
 size_t BitSet::rank(uint32_t v) const { return roaring_->rank(v); }
 
-bool BitSet::operator==(const BitSet& b) const { return roaring_->operator==(*b.roaring_); }
+bool BitSet::operator==(const BitSet& b) const {
+    return roaring_ == b.roaring_ || roaring_->operator==(*b.roaring_);
+}
 
 bool BitSet::operator!=(const BitSet& b) const { return !operator==(b); }
 
@@ -211,7 +217,7 @@ double BitSet::jaccardIndex(const BitSet& b) const {
 }
 
 BitSet& BitSet::operator&=(const BitSet& b) {
-    roaring_->operator&=(*(b.roaring_));
+    mutableRoaring().operator&=(*(b.roaring_));
     return *this;
 }
 
@@ -222,7 +228,7 @@ BitSet BitSet::operator&(const BitSet& b) const {
 }
 
 BitSet& BitSet::operator-=(const BitSet& b) {
-    roaring_->operator-=(*(b.roaring_));
+    mutableRoaring().operator-=(*(b.roaring_));
     return *this;
 }
 
@@ -233,7 +239,7 @@ BitSet BitSet::operator-(const BitSet& b) const {
 }
 
 BitSet& BitSet::operator|=(const BitSet& b) {
-    roaring_->operator|=(*(b.roaring_));
+    mutableRoaring().operator|=(*(b.roaring_));
     return *this;
 }
 
@@ -244,7 +250,7 @@ BitSet BitSet::operator|(const BitSet& b) const {
 }
 
 BitSet& BitSet::operator^=(const BitSet& b) {
-    roaring_->operator^=(*(b.roaring_));
+    mutableRoaring().operator^=(*(b.roaring_));
     return *this;
 }
 
@@ -288,17 +294,17 @@ void BitSet::readData(std::istream& is) {
         is >> numBytes;
         std::vector<char> buf(numBytes);
         is.read(buf.data(), numBytes);
-        *roaring_ = roaring::Roaring::read(buf.data(), true);
+        roaring_ = std::make_shared<roaring::Roaring>(roaring::Roaring::read(buf.data(), true));
     } catch (std::runtime_error&) {
         throw Exception("Error reading BitSet", IVW_CONTEXT);
     }
 }
 
-void BitSet::optimize() { roaring_->runOptimize(); }
+void BitSet::optimize() { mutableRoaring().runOptimize(); }
 
-void BitSet::removeRLECompression() { roaring_->removeRunCompression(); }
+void BitSet::removeRLECompression() { mutableRoaring().removeRunCompression(); }
 
-size_t BitSet::shrinkToFit() { return roaring_->shrinkToFit(); }
+size_t BitSet::shrinkToFit() { return mutableRoaring().shrinkToFit(); }
 
 void BitSet::serialize(Serializer& s) const {
     std::vector<char> buf(getSizeInBytes());
@@ -312,11 +318,18 @@ void BitSet::deserialize(Deserializer& d) {
     d.deserialize("bitset", str);
 
     str = util::base64_decode(str);
-    *roaring_ = roaring::Roaring::read(str.data(), true);
+    roaring_ = std::make_shared<roaring::Roaring>(roaring::Roaring::read(str.data(), true));
 }
 
-void BitSet::addSingle(uint32_t v) { roaring_->add(v); }
+void BitSet::addSingle(uint32_t v) { mutableRoaring().add(v); }
+
+void BitSet::addMany(size_t size, const uint32_t* data) { mutableRoaring().addMany(size, data); }
 
-void BitSet::addMany(size_t size, const uint32_t* data) { roaring_->addMany(size, data); }
+roaring::Roaring& BitSet::mutableRoaring() {
+    if (roaring_.use_count() > 1) {
+        roaring_ = std::make_shared<roaring::Roaring>(*roaring_);
+    }
+    return *roaring_;
+}
 
 }  // namespace inviwo
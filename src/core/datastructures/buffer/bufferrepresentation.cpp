@@ -41,4 +41,6 @@ BufferUsage BufferRepresentation::getBufferUsage() const { return usage_; }
 
 BufferTarget BufferRepresentation::getBufferTarget() const { return target_; }
 
+size_t BufferRepresentation::getResidentBytes() const { return getSize() * getSizeOfElement(); }
+
 }  // namespace inviwo
\ No newline at end of file
@@ -29,6 +29,7 @@
 
 #include <inviwo/core/datastructures/histogram.h>
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <functional>
 
@@ -92,6 +93,20 @@ NormalizedHistogram::NormalizedHistogram(dvec2 dataRange, std::vector<double> co
     }
 }
 
+NormalizedHistogram::NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min,
+                                         double max, double mean, double standardDeviation,
+                                         util::QuantileSketch sketch)
+    : NormalizedHistogram(dataRange, std::move(counts), min, max, mean, standardDeviation) {
+    quantiles_ = std::move(sketch);
+    if (!quantiles_.empty()) {
+        std::vector<double> qs(stats_.percentiles.size());
+        for (size_t i = 0; i < qs.size(); ++i) {
+            qs[i] = static_cast<double>(i) / static_cast<double>(qs.size() - 1);
+        }
+        stats_.percentiles = quantiles_.quantiles(qs);
+    }
+}
+
 double NormalizedHistogram::getMaximumBinValue() const { return maximumBinCount_; }
 
 std::vector<double>& NormalizedHistogram::getData() { return data_; }
@@ -102,6 +117,72 @@ double& NormalizedHistogram::operator[](size_t i) { return data_[i]; }
 
 const double& NormalizedHistogram::operator[](size_t i) const { return data_[i]; }
 
+HistogramAccumulator::HistogramAccumulator(dvec2 dataRange, size_t bins, bool quantiles)
+    : dataRange_{dataRange}, bins_{bins}, quantiles_{quantiles} {}
+
+void HistogramAccumulator::merge(const HistogramAccumulator& other) {
+    if (channels_.empty()) {
+        *this = other;
+        return;
+    }
+    count_ += other.count_;
+    for (size_t i = 0; i < std::min(channels_.size(), other.channels_.size()); ++i) {
+        auto& channel = channels_[i];
+        const auto& rhs = other.channels_[i];
+        std::transform(channel.counts.begin(), channel.counts.end(), rhs.counts.begin(),
+                       channel.counts.begin(), std::plus<>{});
+        channel.sum += rhs.sum;
+        channel.sum2 += rhs.sum2;
+    }
+    mergeExtrema(other);
+}
+
+void HistogramAccumulator::subtract(const HistogramAccumulator& other) {
+    count_ -= std::min(count_, other.count_);
+    for (size_t i = 0; i < std::min(channels_.size(), other.channels_.size()); ++i) {
+        auto& channel = channels_[i];
+        const auto& rhs = other.channels_[i];
+        std::transform(channel.counts.begin(), channel.counts.end(), rhs.counts.begin(),
+                       channel.counts.begin(), std::minus<>{});
+        channel.sum -= rhs.sum;
+        channel.sum2 -= rhs.sum2;
+    }
+}
+
+void HistogramAccumulator::clearExtrema() {
+    for (auto& channel : channels_) {
+        channel.min = std::numeric_limits<double>::max();
+        channel.max = std::numeric_limits<double>::lowest();
+        channel.sketch = util::QuantileSketch{channel.sketch.getK()};
+    }
+}
+
+void HistogramAccumulator::mergeExtrema(const HistogramAccumulator& other) {
+    for (size_t i = 0; i < std::min(channels_.size(), other.channels_.size()); ++i) {
+        auto& channel = channels_[i];
+        const auto& rhs = other.channels_[i];
+        channel.min = std::min(channel.min, rhs.min);
+        channel.max = std::max(channel.max, rhs.max);
+        channel.sketch.merge(rhs.sketch);
+    }
+}
+
+std::vector<NormalizedHistogram> HistogramAccumulator::toHistograms() const {
+    std::vector<NormalizedHistogram> histograms;
+    const auto count = static_cast<double>(count_);
+    for (const auto& channel : channels_) {
+        const auto mean = channel.sum / count;
+        const auto stddev = std::sqrt((count * channel.sum2 - channel.sum * channel.sum) /
+                                      (count * (count - 1.0)));
+        histograms.emplace_back(dataRange_, channel.counts, channel.min, channel.max, mean, stddev,
+                                channel.sketch);
+    }
+    return histograms;
+}
+
+HistogramContainer::HistogramContainer(std::vector<NormalizedHistogram> histograms)
+    : histograms_{std::move(histograms)} {}
+
 size_t HistogramContainer::size() const { return histograms_.size(); }
 
 bool HistogramContainer::empty() const { return histograms_.empty(); }
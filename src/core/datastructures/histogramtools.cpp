@@ -30,11 +30,97 @@
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/brickiterator.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <glm/gtx/component_wise.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
+
 namespace inviwo {
 
+BrickedHistogram::BrickedHistogram(const VolumeRAM& volumeRam, dvec2 dataRange, size_t bins)
+    : dataRange_{dataRange}
+    , bins_{volumeRam.dispatch<size_t>([&](auto vr) {
+        return HistogramAccumulator::binsFor<util::PrecisionValueType<decltype(vr)>>(dataRange,
+                                                                                    bins);
+    })}
+    , dims_{volumeRam.getDimensions()}
+    , regionSize_{VolumeRAM::modificationBrickSize}
+    , regions_{(dims_ + regionSize_ - size_t{1}) / regionSize_}
+    , total_{dataRange_, bins_, true} {
+
+    while (glm::compMul(regions_) > maxRegions) {
+        regionSize_ *= 2;
+        regions_ = (dims_ + regionSize_ - size_t{1}) / regionSize_;
+    }
+
+    regionHistograms_.resize(glm::compMul(regions_));
+    util::forEachIndexParallel(regionHistograms_.size(), [&](size_t region) {
+        regionHistograms_[region] = calculate(volumeRam, region);
+    });
+    for (const auto& region : regionHistograms_) {
+        total_.merge(region);
+    }
+}
+
+void BrickedHistogram::update(const VolumeRAM& volumeRam,
+                              const std::vector<size_t>& modifiedBricks) {
+    const auto bricks =
+        (dims_ + VolumeRAM::modificationBrickSize - size_t{1}) / VolumeRAM::modificationBrickSize;
+    const auto bricksPerRegion = regionSize_ / VolumeRAM::modificationBrickSize;
+
+    std::vector<size_t> modified;
+    for (auto brick : modifiedBricks) {
+        const size3_t pos{brick % bricks.x, (brick / bricks.x) % bricks.y,
+                          brick / (bricks.x * bricks.y)};
+        const auto region = pos / bricksPerRegion;
+        modified.push_back(region.x + regions_.x * (region.y + regions_.y * region.z));
+    }
+    std::sort(modified.begin(), modified.end());
+    modified.erase(std::unique(modified.begin(), modified.end()), modified.end());
+
+    std::vector<HistogramAccumulator> updated(modified.size());
+    util::forEachIndexParallel(modified.size(),
+                               [&](size_t i) { updated[i] = calculate(volumeRam, modified[i]); });
+
+    for (size_t i = 0; i < modified.size(); ++i) {
+        auto& region = regionHistograms_[modified[i]];
+        total_.subtract(region);
+        region = std::move(updated[i]);
+        total_.merge(region);
+    }
+}
+
+HistogramContainer BrickedHistogram::getHistograms() const {
+    // The counts and sums of total_ are kept up to date by update(), but the extrema and
+    // quantiles can not be subtracted, those are combined from the regions.
+    auto histograms = total_;
+    histograms.clearExtrema();
+    for (const auto& region : regionHistograms_) {
+        histograms.mergeExtrema(region);
+    }
+    return HistogramContainer{histograms.toHistograms()};
+}
+
+HistogramAccumulator BrickedHistogram::calculate(const VolumeRAM& volumeRam,
+                                                 size_t region) const {
+    const size3_t pos{region % regions_.x, (region / regions_.x) % regions_.y,
+                      region / (regions_.x * regions_.y)};
+    const auto offset = pos * regionSize_;
+    const auto extent = glm::min(offset + regionSize_, dims_) - offset;
+
+    HistogramAccumulator accumulator{dataRange_, bins_, true};
+    volumeRam.dispatch<void>([&](auto vr) {
+        auto it = util::BrickIterator{vr->getDataTyped(), dims_, offset, extent};
+        accumulator.add(it, it.end());
+    });
+    return accumulator;
+}
+
 void HistogramCalculationState::whenDone(std::function<void(const HistogramContainer&)> callback) {
     if (auto container = container_.lock(); container && done) {
         callback(*container);
@@ -51,33 +137,134 @@ HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
 HistogramSupplier& HistogramSupplier::operator=(const HistogramSupplier& that) {
     if (this != &that) {
         histograms_ = std::make_shared<HistogramContainer>(*that.histograms_);
+        incremental_.reset();
     }
     return *this;
 }
 
+struct HistogramSupplier::Incremental {
+    Incremental(std::weak_ptr<const VolumeRAM> aVolumeRam, dvec2 aDataRange, size_t aBins)
+        : dataRange{aDataRange}, bins{aBins}, volumeRam{aVolumeRam} {}
+
+    // Constant, can be read from the calculations on the pool
+    const dvec2 dataRange;
+    const size_t bins;
+
+    // Only accessed from the thread calling startCalculation
+    std::weak_ptr<const VolumeRAM> volumeRam;
+    size_t version = 0;
+
+    // Shared with the calculations on the pool
+    std::mutex mutex;
+    std::unique_ptr<BrickedHistogram> histogram;
+};
+
 std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const {
-    if (!calculation_ || calculation_->getBins() != bins ||
-        calculation_->getDataRange() != dataRange) {
 
+    const auto version = volumeRam->getModificationVersion();
+    const bool sameSource = incremental_ && incremental_->volumeRam.lock() == volumeRam &&
+                            incremental_->bins == bins && incremental_->dataRange == dataRange;
+
+    if (calculation_ && sameSource && incremental_->version == version) {
+        return calculation_;
+    }
+
+    std::vector<size_t> modifiedBricks;
+    if (sameSource) {
+        modifiedBricks = volumeRam->getModifiedBricks(incremental_->version);
+    } else {
         histograms_ = std::make_shared<HistogramContainer>();
-        calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
+        incremental_ = std::make_shared<Incremental>(volumeRam, dataRange, bins);
+    }
+    incremental_->version = version;
+    // The current histograms are kept until the updated ones are done
+    calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
 
-        dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
+    enqueueCalculation(calculation_, incremental_, std::move(volumeRam), std::move(modifiedBricks));
+
+    return calculation_;
+}
+
+void HistogramSupplier::enqueueCalculation(std::shared_ptr<HistogramCalculationState> state,
+                                           std::shared_ptr<Incremental> incremental,
+                                           std::shared_ptr<const VolumeRAM> volumeRam,
+                                           std::vector<size_t> modifiedBricks) {
+    // Histograms are not time critical, don't let them delay the processing of the network. When
+    // the thread pool needs the worker for interactive work the calculation is stopped and queued
+    // again.
+    auto preempted = std::make_shared<std::atomic<bool>>(false);
+    ThreadPool::TaskInfo info{ThreadPool::Priority::Background};
+    info.preempt = [stop = state->stop_, preempted]() {
+        *preempted = true;
+        *stop = true;
+    };
+
+    util::getThreadPool().enqueue(
+        std::move(info),
+        [weakState = std::weak_ptr<HistogramCalculationState>(state), stop = state->stop_,
+         preempted, incremental, volumeRam, modifiedBricks = std::move(modifiedBricks)]() {
+            const auto resume = [&]() {
+                if (!*preempted) return;
+                if (auto s = weakState.lock()) {
+                    *stop = false;
+                    // The modified bricks have already been applied
+                    enqueueCalculation(s, incremental, volumeRam, {});
+                }
+            };
+
+            const auto dataRange = incremental->dataRange;
+            const auto bins = incremental->bins;
+            std::optional<HistogramContainer> histograms;
+            {
+                // Updates are always applied, even if the calculation has been stopped, since later
+                // calculations only know about the bricks modified after they were started.
+                std::scoped_lock lock{incremental->mutex};
+                auto& histogram = incremental->histogram;
+                if (histogram && histogram->getDimensions() == volumeRam->getDimensions()) {
+                    if (!modifiedBricks.empty()) histogram->update(*volumeRam, modifiedBricks);
+                } else if (volumeRam->getModificationVersion() > 0) {
+                    // The volume is being edited, keep the regions around for the next edits
+                    histogram = std::make_unique<BrickedHistogram>(*volumeRam, dataRange, bins);
+                } else {
+                    // Volumes that are never edited don't need the per region histograms
+                    histogram.reset();
+                }
+                if (*stop) return resume();
+                if (histogram) histograms = histogram->getHistograms();
+            }
+            if (!histograms) {
+                histograms = volumeRam->dispatch<std::optional<HistogramContainer>>(
+                    [&](auto vr) -> std::optional<HistogramContainer> {
+                        using T = util::PrecisionValueType<decltype(vr)>;
+                        HistogramAccumulator accumulator{
+                            dataRange, HistogramAccumulator::binsFor<T>(dataRange, bins), true};
+                        const auto dims = vr->getDimensions();
+                        const auto sliceSize = dims.x * dims.y;
+                        const auto* data = vr->getDataTyped();
+                        // Process a slice at a time to react to preemption
+                        for (size_t z = 0; z < dims.z; ++z) {
+                            if (*stop) return std::nullopt;
+                            accumulator.add(data + z * sliceSize, data + (z + 1) * sliceSize);
+                        }
+                        return HistogramContainer{accumulator.toHistograms()};
+                    });
+            }
+            if (*stop || !histograms) return resume();
+            dispatchFrontAndForget([hist = std::move(*histograms), weakState]() mutable {
                 if (auto s = weakState.lock()) {
                     done(s, std::move(hist));
                 }
             });
         });
+}
+
+bool HistogramSupplier::histogramsOutdated(const VolumeRAM& volumeRam) const {
+    if (incremental_ && incremental_->volumeRam.lock().get() == &volumeRam) {
+        return incremental_->version != volumeRam.getModificationVersion();
     }
-    return calculation_;
+    // Histograms copied from another volume are only trusted for data that was never modified
+    return hasHistograms() && volumeRam.getModificationVersion() > 0;
 }
 
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
@@ -79,4 +79,6 @@ void LayerDisk::setWrapping(const Wrapping2D& wrapping) { wrapping_ = wrapping;
 
 Wrapping2D LayerDisk::getWrapping() const { return wrapping_; }
 
+size_t LayerDisk::getResidentBytes() const { return 0; }
+
 }  // namespace inviwo
@@ -37,4 +37,9 @@ LayerRepresentation::LayerRepresentation(LayerType type, const DataFormatBase* f
 
 LayerType LayerRepresentation::getLayerType() const { return layerType_; }
 
+size_t LayerRepresentation::getResidentBytes() const {
+    const auto& dims = getDimensions();
+    return dims.x * dims.y * getDataFormat()->getSize();
+}
+
 }  // namespace inviwo
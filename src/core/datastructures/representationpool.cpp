@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/representationpool.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+RepresentationPool::RepresentationPool(size_t budget) : budget_{budget} {}
+
+std::shared_ptr<void> RepresentationPool::reuse(std::type_index type, size3_t dims) {
+    std::scoped_lock lock{mutex_};
+    ++clock_;
+    // The pool holds the only reference when use_count is 1. New references can only be made
+    // through the pool, i.e. under the lock, so the check can not race with other users.
+    const auto [begin, end] = entries_.equal_range(makeKey(type, dims));
+    auto it = std::find_if(begin, end, [](const auto& item) {
+        return item.second.repr.use_count() == 1;
+    });
+    if (it == end) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    it->second.lastUse = clock_;
+    return it->second.repr;
+}
+
+void RepresentationPool::track(std::shared_ptr<void> repr, std::type_index type, size3_t dims,
+                               size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    if (bytes > budget_) return;
+
+    entries_.emplace(makeKey(type, dims), Entry{std::move(repr), bytes, clock_});
+    stats_.bytesHeld += bytes;
+    stats_.highWaterMark = std::max(stats_.highWaterMark, stats_.bytesHeld);
+    trim();
+}
+
+void RepresentationPool::trim() {
+    while (stats_.bytesHeld > budget_) {
+        auto lru = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->second.repr.use_count() != 1) continue;
+            if (lru == entries_.end() || it->second.lastUse < lru->second.lastUse) lru = it;
+        }
+        if (lru == entries_.end()) break;
+
+        stats_.bytesHeld -= lru->second.bytes;
+        ++stats_.evictions;
+        entries_.erase(lru);
+    }
+}
+
+void RepresentationPool::setBudget(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    budget_ = bytes;
+    trim();
+}
+
+size_t RepresentationPool::getBudget() const {
+    std::scoped_lock lock{mutex_};
+    return budget_;
+}
+
+RepresentationPool::Stats RepresentationPool::getStats() const {
+    std::scoped_lock lock{mutex_};
+    auto stats = stats_;
+    stats.bytesIdle = 0;
+    for (const auto& [key, entry] : entries_) {
+        if (entry.repr.use_count() == 1) stats.bytesIdle += entry.bytes;
+    }
+    return stats;
+}
+
+void RepresentationPool::clear() {
+    std::scoped_lock lock{mutex_};
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.repr.use_count() == 1) {
+            stats_.bytesHeld -= it->second.bytes;
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+RepresentationPool* util::getRepresentationPool() {
+    if (InviwoApplication::isInitialized()) {
+        return InviwoApplication::getPtr()->getRepresentationPool();
+    }
+    return nullptr;
+}
+
+}  // namespace inviwo
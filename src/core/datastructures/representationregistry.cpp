@@ -0,0 +1,190 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/representationregistry.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/demangle.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace inviwo {
+
+namespace {
+
+thread_local std::string currentSource;  // NOLINT
+
+}  // namespace
+
+RepresentationRegistry::Scope::Scope(std::string_view source)
+    : previous_{std::exchange(currentSource, std::string{source})} {}
+
+RepresentationRegistry::Scope::~Scope() { currentSource = std::move(previous_); }
+
+RepresentationRegistry::RepresentationRegistry(size_t budget) : budget_{budget} {}
+
+void RepresentationRegistry::add(const void* owner, EvictFunction evict, const void* repr,
+                                 std::type_index kind, size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    auto& entry = owners_[owner];
+    entry.evict = evict;
+    ++clock_;
+    auto it = std::find_if(entry.reprs.begin(), entry.reprs.end(),
+                           [&](const Entry& item) { return item.repr == repr; });
+    if (it != entry.reprs.end()) {
+        totalBytes_ = totalBytes_ - it->bytes + bytes;
+        it->bytes = bytes;
+        it->lastUse = clock_;
+    } else {
+        entry.reprs.push_back(Entry{repr, kind, currentSource, bytes, clock_});
+        totalBytes_ += bytes;
+    }
+}
+
+void RepresentationRegistry::touch(const void* owner, const void* repr, size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    auto oit = owners_.find(owner);
+    if (oit == owners_.end()) return;
+    auto& reprs = oit->second.reprs;
+    auto it = std::find_if(reprs.begin(), reprs.end(),
+                           [&](const Entry& item) { return item.repr == repr; });
+    if (it == reprs.end()) return;
+    totalBytes_ = totalBytes_ - it->bytes + bytes;
+    it->bytes = bytes;
+    it->lastUse = ++clock_;
+}
+
+void RepresentationRegistry::remove(const void* owner, const void* repr) {
+    std::scoped_lock lock{mutex_};
+    auto oit = owners_.find(owner);
+    if (oit == owners_.end()) return;
+    auto& reprs = oit->second.reprs;
+    auto it = std::find_if(reprs.begin(), reprs.end(),
+                           [&](const Entry& item) { return item.repr == repr; });
+    if (it == reprs.end()) return;
+    totalBytes_ -= it->bytes;
+    reprs.erase(it);
+    if (reprs.empty()) owners_.erase(oit);
+}
+
+void RepresentationRegistry::removeOwner(const void* owner) {
+    std::scoped_lock lock{mutex_};
+    auto oit = owners_.find(owner);
+    if (oit == owners_.end()) return;
+    for (const auto& entry : oit->second.reprs) {
+        totalBytes_ -= entry.bytes;
+    }
+    owners_.erase(oit);
+}
+
+void RepresentationRegistry::setBudget(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    budget_ = bytes;
+}
+
+size_t RepresentationRegistry::getBudget() const {
+    std::scoped_lock lock{mutex_};
+    return budget_;
+}
+
+size_t RepresentationRegistry::getTotalBytes() const {
+    std::scoped_lock lock{mutex_};
+    return totalBytes_;
+}
+
+RepresentationRegistry::Stats RepresentationRegistry::getStats() const {
+    std::scoped_lock lock{mutex_};
+    Stats stats;
+    stats.budget = budget_;
+    stats.evictions = evictions_;
+    stats.evictedBytes = evictedBytes_;
+
+    const auto add = [](Usage& usage, size_t bytes) {
+        usage.bytes += bytes;
+        ++usage.count;
+    };
+    for (const auto& item : owners_) {
+        for (const auto& entry : item.second.reprs) {
+            add(stats.total, entry.bytes);
+            add(stats.kinds[util::parseTypeIdName(entry.kind.name())], entry.bytes);
+            add(stats.processors[entry.source], entry.bytes);
+        }
+    }
+    return stats;
+}
+
+size_t RepresentationRegistry::enforceBudget() {
+    std::scoped_lock lock{mutex_};
+    if (budget_ == 0 || totalBytes_ <= budget_) return 0;
+
+    struct Candidate {
+        const void* owner;
+        const void* repr;
+        size_t lastUse;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& item : owners_) {
+        if (!item.second.evict) continue;
+        for (const auto& entry : item.second.reprs) {
+            if (entry.bytes > 0) candidates.push_back({item.first, entry.repr, entry.lastUse});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.lastUse < b.lastUse; });
+
+    // The owners only try to lock their own mutex in the evict function, holding the registry
+    // lock here can therefore not dead lock with a thread holding an owner lock and calling in.
+    size_t released = 0;
+    for (const auto& candidate : candidates) {
+        if (totalBytes_ <= budget_) break;
+
+        auto oit = owners_.find(candidate.owner);
+        if (!oit->second.evict(candidate.owner, candidate.repr)) continue;
+
+        auto& reprs = oit->second.reprs;
+        auto it = std::find_if(reprs.begin(), reprs.end(),
+                               [&](const Entry& item) { return item.repr == candidate.repr; });
+        totalBytes_ -= it->bytes;
+        released += it->bytes;
+        ++evictions_;
+        reprs.erase(it);
+        if (reprs.empty()) owners_.erase(oit);
+    }
+    evictedBytes_ += released;
+    return released;
+}
+
+RepresentationRegistry* util::getRepresentationRegistry() {
+    if (InviwoApplication::isInitialized()) {
+        return InviwoApplication::getPtr()->getRepresentationRegistry();
+    }
+    return nullptr;
+}
+
+}  // namespace inviwo
@@ -216,6 +216,11 @@ std::shared_ptr<HistogramCalculationState> Volume::calculateHistograms(size_t bi
                                                dataMap_.dataRange, bins);
 }
 
+bool Volume::hasOutdatedHistograms() const {
+    return hasValidRepresentation<VolumeRAM>() &&
+           HistogramSupplier::histogramsOutdated(*getRepresentation<VolumeRAM>());
+}
+
 template class IVW_CORE_TMPL_INST DataReaderType<Volume>;
 template class IVW_CORE_TMPL_INST DataWriterType<Volume>;
 template class IVW_CORE_TMPL_INST DataReaderType<VolumeSequence>;
@@ -36,6 +36,47 @@ VolumeRAM::VolumeRAM(const DataFormatBase* format) : VolumeRepresentation(format
 
 std::type_index VolumeRAM::getTypeIndex() const { return std::type_index(typeid(VolumeRAM)); }
 
+void VolumeRAM::markModified(const size3_t& offset, const size3_t& extent) {
+    const auto dims = getDimensions();
+    const auto bricks = (dims + modificationBrickSize - size_t{1}) / modificationBrickSize;
+    if (bricks != modificationBricks_) {
+        modificationBricks_ = bricks;
+        brickVersions_.assign(bricks.x * bricks.y * bricks.z, 0);
+    }
+    if (glm::any(glm::equal(extent, size3_t{0})) || glm::any(glm::equal(dims, size3_t{0}))) {
+        return;
+    }
+
+    ++modificationVersion_;
+    const auto maxPos = dims - size_t{1};
+    const auto first = glm::min(offset, maxPos) / modificationBrickSize;
+    const auto last = glm::min(offset + extent - size_t{1}, maxPos) / modificationBrickSize;
+    for (size_t z = first.z; z <= last.z; ++z) {
+        for (size_t y = first.y; y <= last.y; ++y) {
+            for (size_t x = first.x; x <= last.x; ++x) {
+                brickVersions_[x + bricks.x * (y + bricks.y * z)] = modificationVersion_;
+            }
+        }
+    }
+}
+
+void VolumeRAM::markModified() { markModified(size3_t{0}, getDimensions()); }
+
+std::vector<size_t> VolumeRAM::getModifiedBricks(size_t version) const {
+    std::vector<size_t> bricks;
+    if (version >= modificationVersion_) return bricks;
+    for (size_t i = 0; i < brickVersions_.size(); ++i) {
+        if (brickVersions_[i] > version) bricks.push_back(i);
+    }
+    return bricks;
+}
+
+void VolumeRAM::resetModifications() {
+    modificationVersion_ = 0;
+    modificationBricks_ = size3_t{0};
+    brickVersions_.clear();
+}
+
 struct VolumeRamCreationDispatcher {
     using type = std::shared_ptr<VolumeRAM>;
     template <typename Result, typename T>
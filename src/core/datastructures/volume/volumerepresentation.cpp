@@ -35,4 +35,9 @@ namespace inviwo {
 VolumeRepresentation::VolumeRepresentation(const DataFormatBase* format)
     : DataRepresentation(format) {}
 
+size_t VolumeRepresentation::getResidentBytes() const {
+    const auto& dims = getDimensions();
+    return dims.x * dims.y * dims.z * getDataFormat()->getSize();
+}
+
 }  // namespace inviwo
@@ -29,9 +29,14 @@
 
 #include <inviwo/core/io/bytereaderutil.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <fmt/format.h>
 
 namespace inviwo {
@@ -64,4 +69,57 @@ void util::readBytesIntoBuffer(std::string_view file, size_t offset, size_t byte
     }
 }
 
+void util::readBytesIntoBuffer(std::string_view file, size_t offset, size3_t dims,
+                               const DiskRegion& region, bool littleEndian, size_t elementSize,
+                               void* dest) {
+    auto fin = filesystem::ifstream(file, std::ios::in | std::ios::binary);
+    OnScopeExit close([&fin]() { fin.close(); });
+    if (!fin.good()) {
+        throw DataReaderException(IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"),
+                                  "Error: Could not read from file: {}", file);
+    }
+
+    const auto out = region.getOutputDimensions();
+    const size_t rowBytes = out.x * elementSize;
+    // Consecutive full rows are read at once
+    const bool contiguous = region.stride.x == 1 && region.stride.y == 1 && out.x == dims.x;
+    const size_t rowsPerRead = contiguous ? out.y : 1;
+    // Bytes spanned by one row of the region in the file
+    const size_t span = ((out.x - 1) * region.stride.x + 1) * elementSize;
+    std::vector<char> row(region.stride.x > 1 ? span : 0);
+
+    auto* dst = static_cast<char*>(dest);
+    for (size_t z = 0; z < out.z; ++z) {
+        for (size_t y = 0; y < out.y; y += rowsPerRead) {
+            const size3_t pos{region.offset.x, region.offset.y + y * region.stride.y,
+                              region.offset.z + z * region.stride.z};
+            const size_t index = (pos.z * dims.y + pos.y) * dims.x + pos.x;
+            fin.seekg(static_cast<std::streamoff>(offset + index * elementSize));
+
+            if (region.stride.x == 1) {
+                fin.read(dst, static_cast<std::streamsize>(rowBytes * rowsPerRead));
+            } else {
+                fin.read(row.data(), static_cast<std::streamsize>(span));
+                for (size_t x = 0; x < out.x; ++x) {
+                    std::memcpy(dst + x * elementSize,
+                                row.data() + x * region.stride.x * elementSize, elementSize);
+                }
+            }
+            if (!fin) {
+                throw DataReaderException(IVW_CONTEXT_CUSTOM("readBytesIntoBuffer"),
+                                          "Error: Unexpected end of file: {}", file);
+            }
+            dst += rowBytes * rowsPerRead;
+        }
+    }
+
+    if (!littleEndian && elementSize > 1) {
+        auto* data = static_cast<char*>(dest);
+        const size_t bytes = out.x * out.y * out.z * elementSize;
+        for (size_t i = 0; i < bytes; i += elementSize) {
+            std::reverse(data + i, data + i + elementSize);
+        }
+    }
+}
+
 }  // namespace inviwo
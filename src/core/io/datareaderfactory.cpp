@@ -59,11 +59,13 @@ bool DataReaderFactory::unRegisterObject(DataReader* reader) {
 }
 
 std::unique_ptr<DataReader> DataReaderFactory::create(const FileExtension& key) const {
+    lookup(key.extension_);
     return std::unique_ptr<DataReader>(
         util::map_find_or_null(map_, key, [](DataReader* o) { return o->clone(); }));
 }
 
 std::unique_ptr<DataReader> DataReaderFactory::create(std::string_view key) const {
+    lookup(key);
     for (auto& elem : map_) {
         if (iCaseCmp(elem.first.extension_, key)) {
             return std::unique_ptr<DataReader>(elem.second->clone());
@@ -73,12 +75,24 @@ std::unique_ptr<DataReader> DataReaderFactory::create(std::string_view key) cons
 }
 
 bool DataReaderFactory::hasKey(std::string_view key) const {
+    lookup(key);
     for (auto& elem : map_) {
         if (iCaseCmp(elem.first.extension_, key)) return true;
     }
     return false;
 }
 
-bool DataReaderFactory::hasKey(const FileExtension& key) const { return util::has_key(map_, key); }
+bool DataReaderFactory::hasKey(const FileExtension& key) const {
+    lookup(key.extension_);
+    return util::has_key(map_, key);
+}
+
+void DataReaderFactory::setLookupCallback(std::function<void(std::string_view)> callback) {
+    lookupCallback_ = std::move(callback);
+}
+
+void DataReaderFactory::lookup(std::string_view filePathOrExtension) const {
+    if (lookupCallback_) lookupCallback_(filePathOrExtension);
+}
 
 }  // namespace inviwo
@@ -62,6 +62,7 @@ bool DataWriterFactory::unRegisterObject(DataWriter* writer) {
 }
 
 std::unique_ptr<DataWriter> DataWriterFactory::create(std::string_view key) const {
+    lookup(key);
     for (auto& elem : map_) {
         if (iCaseCmp(elem.first.extension_, key)) {
             return std::unique_ptr<DataWriter>(elem.second->clone());
@@ -71,17 +72,30 @@ std::unique_ptr<DataWriter> DataWriterFactory::create(std::string_view key) cons
 }
 
 std::unique_ptr<DataWriter> DataWriterFactory::create(const FileExtension& key) const {
+    lookup(key.extension_);
     return std::unique_ptr<DataWriter>(
         util::map_find_or_null(map_, key, [](DataWriter* o) { return o->clone(); }));
 }
 
-bool DataWriterFactory::hasKey(const FileExtension& key) const { return util::has_key(map_, key); }
+bool DataWriterFactory::hasKey(const FileExtension& key) const {
+    lookup(key.extension_);
+    return util::has_key(map_, key);
+}
 
 bool DataWriterFactory::hasKey(std::string_view key) const {
+    lookup(key);
     for (auto& elem : map_) {
         if (iCaseCmp(elem.first.extension_, key)) return true;
     }
     return false;
 }
 
+void DataWriterFactory::setLookupCallback(std::function<void(std::string_view)> callback) {
+    lookupCallback_ = std::move(callback);
+}
+
+void DataWriterFactory::lookup(std::string_view filePathOrExtension) const {
+    if (lookupCallback_) lookupCallback_(filePathOrExtension);
+}
+
 }  // namespace inviwo
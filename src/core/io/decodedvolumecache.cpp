@@ -0,0 +1,583 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/decodedvolumecache.h>
+
+#include <inviwo/core/common/factoryutil.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/unitsystem.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/serialization/deserializer.h>
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/metadata/metadatamap.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+
+#include <fmt/format.h>
+#include <glm/gtx/component_wise.hpp>
+#include <units/units.hpp>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::string_view headerExtension = ".ivc";
+constexpr std::string_view rawExtension = ".raw";
+
+std::filesystem::path toPath(std::string_view path) { return std::filesystem::u8path(path); }
+
+// Several threads, or processes sharing the directory, might write the same entry at once
+std::string tempPath(std::string_view path) {
+    return fmt::format("{}.{}.tmp", path, util::randomString());
+}
+
+/*
+ * Reads the raw data of a cache entry and keeps the entry in use. Every copy of the VolumeDisk
+ * clones the loader and with it the pin, so the raw file stays as long as anything can read it.
+ */
+class CachedVolumeRAMLoader : public RawVolumeRAMLoader {
+public:
+    CachedVolumeRAMLoader(std::string_view rawFile, std::shared_ptr<const void> pin)
+        : RawVolumeRAMLoader(std::string{rawFile}, 0, true), pin_{std::move(pin)} {}
+    virtual CachedVolumeRAMLoader* clone() const override {
+        return new CachedVolumeRAMLoader(*this);
+    }
+
+private:
+    std::shared_ptr<const void> pin_;
+};
+
+// The state of the source file the entry was decoded from
+struct SourceStamp {
+    size_t size = 0;
+    std::int64_t time = 0;
+
+    static SourceStamp get(std::string_view sourceFile) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(toPath(sourceFile), ec);
+        return {ec ? size_t{0} : static_cast<size_t>(size),
+                static_cast<std::int64_t>(filesystem::fileModificationTime(sourceFile))};
+    }
+    bool operator==(const SourceStamp& rhs) const { return size == rhs.size && time == rhs.time; }
+};
+
+void writeSourceHeader(Serializer& s, std::string_view sourceFile, std::string_view settings) {
+    const auto stamp = SourceStamp::get(sourceFile);
+    s.serialize("Source", std::string{sourceFile});
+    s.serialize("Settings", std::string{settings});
+    s.serialize("SourceSize", stamp.size);
+    s.serialize("SourceTime", stamp.time);
+}
+
+void writeDataHeader(Serializer& s, const VolumeRAM& ram) {
+    s.serialize("Format", std::string{ram.getDataFormat()->getString()});
+    s.serialize("Dimension", ram.getDimensions());
+    s.serialize("SwizzleMask", ram.getSwizzleMask());
+    s.serialize("Interpolation", ram.getInterpolation());
+    s.serialize("Wrapping", ram.getWrapping());
+}
+
+void writeVolumeHeader(Serializer& s, const Volume& volume) {
+    s.serialize("HasVolume", true);
+    s.serialize("BasisAndOffset", volume.getModelMatrix());
+    s.serialize("WorldTransform", volume.getWorldMatrix());
+    s.serialize("DataRange", volume.dataMap_.dataRange);
+    s.serialize("ValueRange", volume.dataMap_.valueRange);
+    s.serialize("ValueName", volume.dataMap_.valueAxis.name);
+    s.serialize("ValueUnit", units::to_string(volume.dataMap_.valueAxis.unit));
+    for (size_t i = 0; i < 3; ++i) {
+        s.serialize(fmt::format("Axis{}Name", i + 1), volume.axes[i].name);
+        s.serialize(fmt::format("Axis{}Unit", i + 1), units::to_string(volume.axes[i].unit));
+    }
+    volume.getMetaDataMap()->serialize(s);
+}
+
+struct Header {
+    std::string source;
+    std::string settings;
+    SourceStamp stamp;
+    const DataFormatBase* format = nullptr;
+    size3_t dimensions{0};
+    SwizzleMask swizzleMask{swizzlemasks::rgba};
+    InterpolationType interpolation{InterpolationType::Linear};
+    Wrapping3D wrapping{wrapping3d::clampAll};
+    bool hasVolume = false;
+    bool hasFile = false;
+
+    explicit Header(Deserializer& d) {
+        d.deserialize("Source", source);
+        d.deserialize("Settings", settings);
+        d.deserialize("SourceSize", stamp.size);
+        d.deserialize("SourceTime", stamp.time);
+        d.deserialize("HasFile", hasFile);
+        if (hasFile) return;
+
+        std::string formatStr;
+        d.deserialize("Format", formatStr);
+        format = DataFormatBase::get(formatStr);
+        d.deserialize("Dimension", dimensions);
+        d.deserialize("SwizzleMask", swizzleMask);
+        d.deserialize("Interpolation", interpolation);
+        d.deserialize("Wrapping", wrapping);
+        d.deserialize("HasVolume", hasVolume);
+    }
+
+    bool matches(std::string_view sourceFile, std::string_view aSettings) const {
+        return (format || hasFile) && source == sourceFile && settings == aSettings &&
+               stamp == SourceStamp::get(sourceFile);
+    }
+};
+
+std::shared_ptr<Volume> readVolume(Deserializer& d, const Header& header, std::string_view rawFile,
+                                   std::shared_ptr<const void> pin) {
+    auto volume = std::make_shared<Volume>(header.dimensions, header.format, header.swizzleMask,
+                                           header.interpolation, header.wrapping);
+    mat4 basisAndOffset = volume->getModelMatrix();
+    mat4 worldTransform = volume->getWorldMatrix();
+    d.deserialize("BasisAndOffset", basisAndOffset);
+    d.deserialize("WorldTransform", worldTransform);
+    volume->setModelMatrix(basisAndOffset);
+    volume->setWorldMatrix(worldTransform);
+
+    d.deserialize("DataRange", volume->dataMap_.dataRange);
+    d.deserialize("ValueRange", volume->dataMap_.valueRange);
+    d.deserialize("ValueName", volume->dataMap_.valueAxis.name);
+
+    std::string unit;
+    d.deserialize("ValueUnit", unit);
+    if (!unit.empty()) volume->dataMap_.valueAxis.unit = units::unit_from_string(unit);
+    for (size_t i = 0; i < 3; ++i) {
+        d.deserialize(fmt::format("Axis{}Name", i + 1), volume->axes[i].name);
+        unit.clear();
+        d.deserialize(fmt::format("Axis{}Unit", i + 1), unit);
+        if (!unit.empty()) volume->axes[i].unit = units::unit_from_string(unit);
+    }
+    volume->getMetaDataMap()->deserialize(d);
+
+    auto disk =
+        std::make_shared<VolumeDisk>(header.source, header.dimensions, header.format,
+                                     header.swizzleMask, header.interpolation, header.wrapping);
+    disk->setLoader(new CachedVolumeRAMLoader(rawFile, std::move(pin)));
+    volume->addRepresentation(disk);
+    return volume;
+}
+
+void registerFactories(Deserializer& d) {
+    if (InviwoApplication::isInitialized()) {
+        d.registerFactory(util::getMetaDataFactory());
+    }
+}
+
+}  // namespace
+
+bool DecodedVolumeCache::Entry::inUse() const { return readers > 0 || !pin.expired(); }
+
+std::shared_ptr<const void> DecodedVolumeCache::Entry::lock() {
+    auto res = pin.lock();
+    if (!res) {
+        res = std::make_shared<char>();
+        pin = res;
+    }
+    return res;
+}
+
+DecodedVolumeCache::DecodedVolumeCache(std::string_view directory, size_t budget)
+    : directory_{directory}, budget_{budget} {}
+
+std::string DecodedVolumeCache::entryName(std::string_view sourceFile,
+                                          std::string_view settings) const {
+    const auto key = fmt::format("{}\n{}", sourceFile, settings);
+    return fmt::format("{:016x}", std::hash<std::string>{}(key));
+}
+
+std::string DecodedVolumeCache::headerPath(const std::string& name) const {
+    return fmt::format("{}/{}{}", directory_, name, headerExtension);
+}
+
+std::string DecodedVolumeCache::rawPath(const std::string& name) const {
+    return fmt::format("{}/{}{}", directory_, name, rawExtension);
+}
+
+std::shared_ptr<Volume> DecodedVolumeCache::load(std::string_view sourceFile,
+                                                 std::string_view settings) {
+    std::scoped_lock lock{mutex_};
+    if (budget_ == 0 || directory_.empty()) return nullptr;
+    scan();
+
+    const auto name = entryName(sourceFile, settings);
+    auto it = entries_.find(name);
+    if (it == entries_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    try {
+        Deserializer d(headerPath(name));
+        registerFactories(d);
+        const Header header{d};
+        if (!header.hasVolume || !header.matches(sourceFile, settings)) {
+            if (!it->second.inUse()) remove(name);
+            ++stats_.misses;
+            return nullptr;
+        }
+        auto volume = readVolume(d, header, rawPath(name), it->second.lock());
+        touch(name);
+        ++stats_.hits;
+        return volume;
+    } catch (const Exception& e) {
+        LogWarn("Removing invalid cache entry for '" << sourceFile << "': " << e.getMessage());
+        if (!it->second.inUse()) remove(name);
+        ++stats_.misses;
+        return nullptr;
+    }
+}
+
+std::shared_ptr<VolumeRAM> DecodedVolumeCache::loadRepresentation(
+    std::string_view sourceFile, std::string_view settings, const VolumeRepresentation& src) {
+
+    const auto name = entryName(sourceFile, settings);
+    {
+        std::scoped_lock lock{mutex_};
+        if (budget_ == 0 || directory_.empty()) return nullptr;
+        scan();
+
+        auto it = entries_.find(name);
+        if (it == entries_.end()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        try {
+            Deserializer d(headerPath(name));
+            const Header header{d};
+            if (!header.matches(sourceFile, settings) ||
+                header.dimensions != src.getDimensions() ||
+                header.format != src.getDataFormat()) {
+                if (!it->second.inUse()) remove(name);
+                ++stats_.misses;
+                return nullptr;
+            }
+        } catch (const Exception& e) {
+            LogWarn("Removing invalid cache entry for '" << sourceFile << "': " << e.getMessage());
+            if (!it->second.inUse()) remove(name);
+            ++stats_.misses;
+            return nullptr;
+        }
+        // Keep the entry while reading the data without holding the lock
+        ++it->second.readers;
+        touch(name);
+        ++stats_.hits;
+    }
+    util::OnScopeExit done{[&]() {
+        std::scoped_lock lock{mutex_};
+        if (auto it = entries_.find(name); it != entries_.end()) --it->second.readers;
+    }};
+
+    const auto bytes = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+    auto data = std::make_unique<char[]>(bytes);
+    try {
+        util::readBytesIntoBuffer(rawPath(name), 0, bytes, true, src.getDataFormat()->getSize(),
+                                  data.get());
+    } catch (const Exception& e) {
+        LogWarn("Could not read cached data of '" << sourceFile << "': " << e.getMessage());
+        return nullptr;
+    }
+    auto ram = createVolumeRAM(src.getDimensions(), src.getDataFormat(), data.get(),
+                               src.getSwizzleMask(), src.getInterpolation(), src.getWrapping());
+    data.release();
+    return ram;
+}
+
+std::pair<std::string, std::shared_ptr<const void>> DecodedVolumeCache::loadFile(
+    std::string_view sourceFile, std::string_view settings) {
+    std::scoped_lock lock{mutex_};
+    if (budget_ == 0 || directory_.empty()) return {};
+    scan();
+
+    const auto name = entryName(sourceFile, settings);
+    auto it = entries_.find(name);
+    if (it == entries_.end()) {
+        ++stats_.misses;
+        return {};
+    }
+
+    try {
+        Deserializer d(headerPath(name));
+        const Header header{d};
+        if (!header.hasFile || !header.matches(sourceFile, settings)) {
+            if (!it->second.inUse()) remove(name);
+            ++stats_.misses;
+            return {};
+        }
+    } catch (const Exception& e) {
+        LogWarn("Removing invalid cache entry for '" << sourceFile << "': " << e.getMessage());
+        if (!it->second.inUse()) remove(name);
+        ++stats_.misses;
+        return {};
+    }
+    touch(name);
+    ++stats_.hits;
+    return {rawPath(name), it->second.lock()};
+}
+
+void DecodedVolumeCache::storeFile(std::string_view sourceFile, std::string_view settings,
+                                   const std::function<void(std::ostream&)>& writer) {
+    write(sourceFile, settings, 0, writer, [&](Serializer& s) {
+        writeSourceHeader(s, sourceFile, settings);
+        s.serialize("HasFile", true);
+    });
+}
+
+void DecodedVolumeCache::store(std::string_view sourceFile, std::string_view settings,
+                               const Volume& volume) {
+    if (!isEnabled()) return;
+    const auto* ram = volume.getRepresentation<VolumeRAM>();
+    const auto bytes = glm::compMul(ram->getDimensions()) * ram->getDataFormat()->getSize();
+    write(
+        sourceFile, settings, bytes,
+        [&](std::ostream& out) { out.write(static_cast<const char*>(ram->getData()), bytes); },
+        [&](Serializer& s) {
+            writeSourceHeader(s, sourceFile, settings);
+            writeDataHeader(s, *ram);
+            writeVolumeHeader(s, volume);
+        });
+}
+
+void DecodedVolumeCache::store(std::string_view sourceFile, std::string_view settings,
+                               const VolumeRAM& ram) {
+    const auto bytes = glm::compMul(ram.getDimensions()) * ram.getDataFormat()->getSize();
+    write(
+        sourceFile, settings, bytes,
+        [&](std::ostream& out) { out.write(static_cast<const char*>(ram.getData()), bytes); },
+        [&](Serializer& s) {
+            writeSourceHeader(s, sourceFile, settings);
+            writeDataHeader(s, ram);
+        });
+}
+
+void DecodedVolumeCache::write(std::string_view sourceFile, std::string_view settings,
+                               size_t bytes, const std::function<void(std::ostream&)>& writeData,
+                               const std::function<void(Serializer&)>& writeHeader) {
+    const auto name = entryName(sourceFile, settings);
+    std::string header;
+    std::string raw;
+    {
+        std::scoped_lock lock{mutex_};
+        if (budget_ == 0 || directory_.empty() || bytes > budget_) return;
+        scan();
+        if (auto it = entries_.find(name); it != entries_.end()) {
+            if (it->second.inUse()) return;
+            remove(name);
+        }
+        header = headerPath(name);
+        raw = rawPath(name);
+    }
+
+    // Write to temporary files and move them in place, other processes sharing the directory
+    // must never see a partial entry
+    const auto tmpHeader = tempPath(header);
+    const auto tmpRaw = tempPath(raw);
+    try {
+        if (auto out = filesystem::ofstream(tmpRaw, std::ios::out | std::ios::binary)) {
+            writeData(out);
+            if (!out) throw Exception("Could not write raw data", IVW_CONTEXT);
+        } else {
+            throw Exception("Could not open " + tmpRaw, IVW_CONTEXT);
+        }
+        // The size of file entries is only known once written
+        bytes = static_cast<size_t>(std::filesystem::file_size(toPath(tmpRaw)));
+        if (bytes > getBudget()) {
+            std::error_code ec;
+            std::filesystem::remove(toPath(tmpRaw), ec);
+            return;
+        }
+        Serializer s(tmpHeader);
+        writeHeader(s);
+        s.writeFile();
+
+        std::filesystem::rename(toPath(tmpRaw), toPath(raw));
+        std::filesystem::rename(toPath(tmpHeader), toPath(header));
+    } catch (const std::exception& e) {
+        LogWarn("Could not cache decoded data of '" << sourceFile << "': " << e.what());
+        std::error_code ec;
+        std::filesystem::remove(toPath(tmpRaw), ec);
+        std::filesystem::remove(toPath(tmpHeader), ec);
+        return;
+    }
+
+    std::scoped_lock lock{mutex_};
+    auto& entry = entries_[name];
+    stats_.bytesHeld -= entry.bytes;
+    entry.bytes = bytes;
+    entry.lastUse = ++clock_;
+    stats_.bytesHeld += bytes;
+    ++stats_.stores;
+    trim();
+}
+
+bool DecodedVolumeCache::isEnabled() const {
+    std::scoped_lock lock{mutex_};
+    return budget_ > 0 && !directory_.empty();
+}
+
+void DecodedVolumeCache::setBudget(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    budget_ = bytes;
+    if (budget_ > 0 && !directory_.empty()) {
+        scan();
+        trim();
+    }
+}
+
+size_t DecodedVolumeCache::getBudget() const {
+    std::scoped_lock lock{mutex_};
+    return budget_;
+}
+
+void DecodedVolumeCache::setDirectory(std::string_view directory) {
+    std::scoped_lock lock{mutex_};
+    if (directory_ == directory) return;
+    directory_ = directory;
+    entries_.clear();
+    stats_.bytesHeld = 0;
+    scanned_ = false;
+}
+
+std::string DecodedVolumeCache::getDirectory() const {
+    std::scoped_lock lock{mutex_};
+    return directory_;
+}
+
+auto DecodedVolumeCache::getStats() const -> Stats {
+    std::scoped_lock lock{mutex_};
+    return stats_;
+}
+
+void DecodedVolumeCache::clear() {
+    std::scoped_lock lock{mutex_};
+    if (directory_.empty()) return;
+    scan();
+    std::vector<std::string> unused;
+    for (const auto& [name, entry] : entries_) {
+        if (!entry.inUse()) unused.push_back(name);
+    }
+    for (const auto& name : unused) remove(name);
+}
+
+void DecodedVolumeCache::scan() {
+    if (scanned_) return;
+    scanned_ = true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(toPath(directory_), ec);
+    if (ec) {
+        LogWarn("Could not create cache directory '" << directory_ << "': " << ec.message());
+        return;
+    }
+
+    // Pick up entries from earlier sessions, ordered by the last use recorded on disk
+    struct Found {
+        std::string name;
+        size_t bytes;
+        std::filesystem::file_time_type time;
+    };
+    std::vector<Found> found;
+    for (const auto& item : std::filesystem::directory_iterator(toPath(directory_), ec)) {
+        const auto& path = item.path();
+        if (path.extension().u8string() != headerExtension) continue;
+        const auto name = path.stem().u8string();
+        const auto raw = toPath(rawPath(name));
+        std::error_code rawEc;
+        const auto bytes = std::filesystem::file_size(raw, rawEc);
+        const auto time = std::filesystem::last_write_time(raw, rawEc);
+        if (rawEc) continue;
+        found.push_back({name, static_cast<size_t>(bytes), time});
+    }
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) { return a.time < b.time; });
+    for (auto& item : found) {
+        auto& entry = entries_[item.name];
+        entry.bytes = item.bytes;
+        entry.lastUse = ++clock_;
+        stats_.bytesHeld += item.bytes;
+    }
+}
+
+void DecodedVolumeCache::touch(const std::string& name) {
+    entries_[name].lastUse = ++clock_;
+    // Record the use on disk as well, it orders the entries found by scan() in later sessions
+    std::error_code ec;
+    std::filesystem::last_write_time(toPath(rawPath(name)),
+                                     std::filesystem::file_time_type::clock::now(), ec);
+}
+
+void DecodedVolumeCache::remove(const std::string& name) {
+    std::error_code ec;
+    std::filesystem::remove(toPath(headerPath(name)), ec);
+    std::filesystem::remove(toPath(rawPath(name)), ec);
+    if (auto it = entries_.find(name); it != entries_.end()) {
+        stats_.bytesHeld -= it->second.bytes;
+        entries_.erase(it);
+    }
+}
+
+void DecodedVolumeCache::trim() {
+    while (stats_.bytesHeld > budget_) {
+        auto lru = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->second.inUse()) continue;
+            if (lru == entries_.end() || it->second.lastUse < lru->second.lastUse) lru = it;
+        }
+        if (lru == entries_.end()) break;
+        remove(lru->first);
+        ++stats_.evictions;
+    }
+}
+
+DecodedVolumeCache* util::getDecodedVolumeCache() {
+    if (InviwoApplication::isInitialized()) {
+        return InviwoApplication::getPtr()->getDecodedVolumeCache();
+    }
+    return nullptr;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,197 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/ivmmeshreader.h>
+
+#include <inviwo/core/common/factoryutil.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/ivmmeshformat.h>
+#include <inviwo/core/io/serialization/deserializer.h>
+#include <inviwo/core/metadata/metadatamap.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/glmmat.h>
+#include <inviwo/core/util/sourcecontext.h>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+IvmMeshReader::IvmMeshReader() : DataReaderType<Mesh>() {
+    addExtension(FileExtension("ivm", "Inviwo binary mesh"));
+}
+
+IvmMeshReader* IvmMeshReader::clone() const { return new IvmMeshReader(*this); }
+
+std::shared_ptr<Mesh> IvmMeshReader::readData(std::string_view filePath) {
+    auto f = open(filePath, std::ios_base::in | std::ios_base::binary);
+    return util::readIvmMesh(f);
+}
+
+namespace {
+
+template <typename T>
+T readValue(std::istream& is) {
+    T value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+// The sizes and offsets come from the file, check them before allocating anything
+size_t checkBlock(const ivm::DataBlock& block, size_t elementSize, size_t dataStart,
+                  size_t streamSize) {
+    const auto available = streamSize > dataStart ? streamSize - dataStart : size_t{0};
+    if (block.offset > available || block.size > (available - block.offset) / elementSize) {
+        throw DataReaderException(IVW_CONTEXT_CUSTOM("util::readIvmMesh"),
+                                  "Invalid ivm mesh data block, {} elements at offset {} exceed "
+                                  "the {} bytes of data",
+                                  block.size, block.offset, available);
+    }
+    return block.size * elementSize;
+}
+
+void readBlock(std::istream& is, size_t dataStart, const ivm::DataBlock& block, size_t bytes,
+               void* dest) {
+    is.seekg(dataStart + block.offset);
+    is.read(static_cast<char*>(dest), bytes);
+    if (!is) {
+        throw DataReaderException("Unexpected end of ivm mesh data",
+                                  IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+}
+
+}  // namespace
+
+std::shared_ptr<Mesh> util::readIvmMesh(std::istream& is, std::string_view key) {
+    is.seekg(0, std::ios_base::end);
+    const auto end = is.tellg();
+    is.seekg(0, std::ios_base::beg);
+    if (!is || end == std::streampos(-1)) {
+        throw DataReaderException("Could not determine the size of the ivm mesh",
+                                  IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+    const auto streamSize = static_cast<size_t>(end);
+
+    std::array<char, ivm::magic.size()> magic{};
+    is.read(magic.data(), magic.size());
+    if (!is || magic != ivm::magic) {
+        throw DataReaderException("Not an ivm mesh", IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+    const auto version = readValue<std::uint32_t>(is);
+    if (version > ivm::version) {
+        throw DataReaderException(IVW_CONTEXT_CUSTOM("util::readIvmMesh"),
+                                  "Unsupported ivm mesh version {}", version);
+    }
+    if (readValue<std::uint32_t>(is) != ivm::byteOrderMark) {
+        throw DataReaderException("The ivm mesh was written with a different byte order",
+                                  IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+    const auto headerSize = static_cast<size_t>(readValue<std::uint64_t>(is));
+    if (!is || headerSize > streamSize - std::min(streamSize, ivm::preambleSize)) {
+        throw DataReaderException(IVW_CONTEXT_CUSTOM("util::readIvmMesh"),
+                                  "Invalid ivm mesh header size {} for a file of {} bytes",
+                                  headerSize, streamSize);
+    }
+    std::string header(headerSize, '\0');
+    is.read(header.data(), headerSize);
+    if (!is) {
+        throw DataReaderException("Unexpected end of ivm mesh header",
+                                  IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+    const size_t dataStart = ivm::align(ivm::preambleSize + headerSize);
+
+    std::stringstream headerStream{header};
+    Deserializer d(headerStream, "");
+    if (InviwoApplication::isInitialized()) {
+        d.registerFactory(util::getMetaDataFactory());
+    }
+
+    std::string storedKey;
+    d.deserialize("Key", storedKey);
+    if (!key.empty() && storedKey != key) {
+        throw DataReaderException("The key of the ivm mesh does not match",
+                                  IVW_CONTEXT_CUSTOM("util::readIvmMesh"));
+    }
+
+    Mesh::MeshInfo defaultInfo;
+    d.deserialize("DrawType", defaultInfo.dt);
+    d.deserialize("ConnectivityType", defaultInfo.ct);
+    auto mesh = std::make_shared<Mesh>(defaultInfo);
+
+    mat4 modelMatrix = mesh->getModelMatrix();
+    mat4 worldMatrix = mesh->getWorldMatrix();
+    d.deserialize("ModelMatrix", modelMatrix);
+    d.deserialize("WorldMatrix", worldMatrix);
+    mesh->setModelMatrix(modelMatrix);
+    mesh->setWorldMatrix(worldMatrix);
+    mesh->getMetaDataMap()->deserialize(d);
+
+    std::vector<ivm::BufferEntry> buffers;
+    std::vector<ivm::IndexEntry> indices;
+    d.deserialize("Buffers", buffers, "Buffer");
+    d.deserialize("Indices", indices, "Index");
+
+    for (const auto& entry : buffers) {
+        const auto* format = DataFormatBase::get(entry.format);
+        if (!format || format->getId() == DataFormatId::NotSpecialized) {
+            throw DataReaderException(IVW_CONTEXT_CUSTOM("util::readIvmMesh"),
+                                      "Unsupported buffer format '{}' in ivm mesh", entry.format);
+        }
+        const auto bytes = checkBlock(entry.data, format->getSize(), dataStart, streamSize);
+        auto ram = createBufferRAM(entry.data.size, format, entry.usage);
+        readBlock(is, dataStart, entry.data, bytes, ram->getData());
+
+        auto buffer = ram->dispatch<std::shared_ptr<BufferBase>>([&](auto brprecision) {
+            using Precision = std::remove_pointer_t<decltype(brprecision)>;
+            using Buff = Buffer<typename Precision::type, Precision::target>;
+            return std::shared_ptr<BufferBase>{std::make_shared<Buff>(
+                std::shared_ptr<Precision>{ram, brprecision})};
+        });
+        mesh->addBuffer(Mesh::BufferInfo{entry.type, entry.location}, buffer);
+    }
+
+    for (const auto& entry : indices) {
+        const auto bytes =
+            checkBlock(entry.data, sizeof(std::uint32_t), dataStart, streamSize);
+        auto ram = std::make_shared<IndexBufferRAM>(entry.data.size);
+        readBlock(is, dataStart, entry.data, bytes, ram->getData());
+        mesh->addIndices(Mesh::MeshInfo{entry.dt, entry.ct}, std::make_shared<IndexBuffer>(ram));
+    }
+
+    return mesh;
+}
+
+}  // namespace inviwo
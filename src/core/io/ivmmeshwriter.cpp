@@ -0,0 +1,133 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/ivmmeshwriter.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/io/ivmmeshformat.h>
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/metadata/metadatamap.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/sourcecontext.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+IvmMeshWriter::IvmMeshWriter() : DataWriterType<Mesh>() {
+    addExtension(FileExtension("ivm", "Inviwo binary mesh"));
+}
+
+IvmMeshWriter* IvmMeshWriter::clone() const { return new IvmMeshWriter(*this); }
+
+void IvmMeshWriter::writeData(const Mesh* data, std::string_view filePath) const {
+    auto f = open(filePath, std::ios_base::out | std::ios_base::binary);
+    util::writeIvmMesh(*data, f);
+}
+
+std::unique_ptr<std::vector<unsigned char>> IvmMeshWriter::writeDataToBuffer(
+    const Mesh* data, std::string_view /*fileExtension*/) const {
+    std::stringstream ss(std::ios_base::out | std::ios_base::binary);
+    util::writeIvmMesh(*data, ss);
+    auto stringdata = std::move(ss).str();
+    return std::make_unique<std::vector<unsigned char>>(stringdata.begin(), stringdata.end());
+}
+
+void util::writeIvmMesh(const Mesh& mesh, std::ostream& os, std::string_view key) {
+    // Lay out the data blocks first, the header needs their offsets
+    std::vector<const BufferRAM*> blocks;
+    size_t dataSize = 0;
+    const auto addBlock = [&](const BufferBase& buffer) {
+        const auto* ram = buffer.getRepresentation<BufferRAM>();
+        if (!ram) {
+            throw DataWriterException("Could not get a RAM representation of a mesh buffer",
+                                      IVW_CONTEXT_CUSTOM("util::writeIvmMesh"));
+        }
+        blocks.push_back(ram);
+        const ivm::DataBlock block{ram->getSize(), dataSize};
+        dataSize = ivm::align(dataSize + ram->getSize() * ram->getDataFormat()->getSize());
+        return block;
+    };
+
+    std::vector<ivm::BufferEntry> buffers;
+    for (const auto& [info, buffer] : mesh.getBuffers()) {
+        const auto block = addBlock(*buffer);
+        buffers.push_back({info.type, info.location, buffer->getDataFormat()->getString(),
+                           buffer->getBufferUsage(), block});
+    }
+    std::vector<ivm::IndexEntry> indices;
+    for (const auto& [info, buffer] : mesh.getIndexBuffers()) {
+        indices.push_back({info.dt, info.ct, addBlock(*buffer)});
+    }
+
+    Serializer s{""};
+    if (!key.empty()) s.serialize("Key", std::string{key});
+    s.serialize("ModelMatrix", mesh.getModelMatrix());
+    s.serialize("WorldMatrix", mesh.getWorldMatrix());
+    s.serialize("DrawType", mesh.getDefaultMeshInfo().dt);
+    s.serialize("ConnectivityType", mesh.getDefaultMeshInfo().ct);
+    s.serialize("Buffers", buffers, "Buffer");
+    s.serialize("Indices", indices, "Index");
+    mesh.getMetaDataMap()->serialize(s);
+
+    std::stringstream headerStream;
+    s.writeFile(headerStream);
+    const auto header = std::move(headerStream).str();
+
+    const std::uint64_t headerSize = header.size();
+    os.write(ivm::magic.data(), ivm::magic.size());
+    os.write(reinterpret_cast<const char*>(&ivm::version), sizeof(ivm::version));
+    os.write(reinterpret_cast<const char*>(&ivm::byteOrderMark), sizeof(ivm::byteOrderMark));
+    os.write(reinterpret_cast<const char*>(&headerSize), sizeof(headerSize));
+    os.write(header.data(), header.size());
+
+    const std::vector<char> padding(ivm::alignment, 0);
+    size_t pos = ivm::preambleSize + header.size();
+    const auto pad = [&]() {
+        const auto next = ivm::align(pos);
+        os.write(padding.data(), next - pos);
+        pos = next;
+    };
+    pad();
+    for (const auto* ram : blocks) {
+        const auto bytes = ram->getSize() * ram->getDataFormat()->getSize();
+        os.write(static_cast<const char*>(ram->getData()), bytes);
+        pos += bytes;
+        pad();
+    }
+    if (!os) {
+        throw DataWriterException("Error writing ivm mesh",
+                                  IVW_CONTEXT_CUSTOM("util::writeIvmMesh"));
+    }
+}
+
+}  // namespace inviwo
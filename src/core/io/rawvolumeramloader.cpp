@@ -72,4 +72,16 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
     volumeDst->setInterpolation(src.getInterpolation());
     volumeDst->setWrapping(src.getWrapping());
 }
+
+bool RawVolumeRAMLoader::supportsRegions() const { return true; }
+
+std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRegionRepresentation(
+    const VolumeRepresentation& src, const DiskRegion& region) const {
+    auto volumeRAM = createVolumeRAM(region.getOutputDimensions(), src.getDataFormat(), nullptr,
+                                     src.getSwizzleMask(), src.getInterpolation(),
+                                     src.getWrapping());
+    util::readBytesIntoBuffer(rawFile_, offset_, src.getDimensions(), region, littleEndian_,
+                              src.getDataFormat()->getSize(), volumeRAM->getData());
+    return volumeRAM;
+}
 }  // namespace inviwo
@@ -39,6 +39,9 @@
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/properties/compositeproperty.h>
 
+#include <unordered_set>
+#include <utility>
+
 namespace inviwo {
 
 namespace {
@@ -202,4 +205,30 @@ void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
     }
 }
 
+void LinkEvaluator::evaluateLinksFromProperties(const std::vector<Property*>& modifiedProperties) {
+    NetworkLock lock(network_);
+
+    std::unordered_map<Property*, size_t> order;
+    for (size_t i = 0; i < modifiedProperties.size(); ++i) {
+        order[modifiedProperties[i]] = i;
+    }
+
+    std::vector<ConvertableLink> links;
+    std::unordered_set<std::pair<Property*, Property*>> added;
+    for (size_t i = 0; i < modifiedProperties.size(); ++i) {
+        auto* property = modifiedProperties[i];
+        if (util::contains(visited_, property)) continue;
+        for (auto& link : getTriggerdLinksForProperty(property)) {
+            auto it = order.find(link.dst_);
+            if (it != order.end() && it->second > i) continue;
+            if (added.emplace(link.src_, link.dst_).second) links.push_back(link);
+        }
+    }
+
+    VisitedHelper helper(visited_, links);
+    for (auto& link : links) {
+        link.converter_->convert(link.src_, link.dst_);
+    }
+}
+
 }  // namespace inviwo
@@ -45,6 +45,7 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <utility>
 
 namespace inviwo {
 
@@ -132,6 +133,10 @@ std::shared_ptr<Processor> ProcessorNetwork::removeProcessor(Processor* processo
 
     rendercontext::activateDefault();
     removeProcessorHelper(processor);
+    removePendingChanges([&](Property* p) {
+        auto owner = p->getOwner();
+        return owner && owner->getProcessor() == processor;
+    });
 
     // remove processor itself
     notifyObserversProcessorNetworkWillRemoveProcessor(processor);
@@ -281,6 +286,8 @@ void ProcessorNetwork::onWillRemoveProperty(Property* property, size_t /*index*/
     auto toDelete =
         util::copy_if(links_, [&](const PropertyLink& link) { return link.involves(property); });
     for (auto& link : toDelete) removeLink(link);
+
+    removePendingChanges([&](Property* p) { return p == property; });
 }
 
 bool ProcessorNetwork::isLinked(const PropertyLink& link) const {
@@ -332,6 +339,108 @@ bool ProcessorNetwork::isInvalidating() const { return !processorsInvalidating_.
 
 bool ProcessorNetwork::isLinking() const { return linkEvaluator_.isLinking(); }
 
+void ProcessorNetwork::beginTransaction() {
+    lock();
+    ++transactions_;
+}
+
+void ProcessorNetwork::endTransaction() {
+    if (transactions_ == 0) return;
+    util::OnScopeExit onExit{[this]() {
+        --transactions_;
+        unlock();
+    }};
+    if (transactions_ == 1) commitTransaction();
+}
+
+bool ProcessorNetwork::isInTransaction() const { return transactions_ != 0; }
+
+bool ProcessorNetwork::deferPropertyModified(Property* property) {
+    if (transactions_ == 0) return false;
+
+    // Changes caused by link evaluation are already covered by the link cache of their source
+    const bool evaluateLinks = !linkEvaluator_.isLinking();
+    if (auto it = pendingIndex_.find(property); it != pendingIndex_.end()) {
+        pendingChanges_[it->second].evaluateLinks |= evaluateLinks;
+    } else {
+        pendingIndex_.emplace(property, pendingChanges_.size());
+        pendingChanges_.push_back({property, evaluateLinks});
+    }
+    return true;
+}
+
+void ProcessorNetwork::commitTransaction() {
+    NetworkLock lock(this);
+    util::OnScopeExit onExit{[this]() {
+        pendingChanges_.clear();
+        pendingIndex_.clear();
+        committingChanges_.clear();
+    }};
+
+    // Callbacks, links, and invalidations can modify more properties, those end up in
+    // pendingChanges_ again and are committed in the next round.
+    while (!pendingChanges_.empty()) {
+        committingChanges_ = std::exchange(pendingChanges_, {});
+        pendingIndex_.clear();
+
+        for (auto& change : committingChanges_) {
+            if (change.property) change.property->onChangeCallback_.invokeAll();
+        }
+
+        std::vector<Property*> sources;
+        for (auto& change : committingChanges_) {
+            if (change.property && change.evaluateLinks) sources.push_back(change.property);
+        }
+        if (!sources.empty()) linkEvaluator_.evaluateLinksFromProperties(sources);
+
+        // Invalidate each owner once, with the highest level requested by its properties
+        std::vector<std::pair<PropertyOwner*, size_t>> invalidations;
+        for (size_t i = 0; i < committingChanges_.size(); ++i) {
+            auto property = committingChanges_[i].property;
+            if (!property) continue;
+            auto owner = property->getOwner();
+            if (!owner) continue;
+
+            if (auto processor = owner->getProcessor()) {
+                processor->notifyObserversAboutPropertyChange(property);
+            }
+            const auto level = property->getInvalidationLevel();
+            if (level == InvalidationLevel::Valid) continue;
+            auto it = std::find_if(invalidations.begin(), invalidations.end(),
+                                   [&](const auto& item) { return item.first == owner; });
+            if (it == invalidations.end()) {
+                invalidations.emplace_back(owner, i);
+            } else if (auto current = committingChanges_[it->second].property;
+                       !current || level > current->getInvalidationLevel()) {
+                it->second = i;
+            }
+        }
+        for (auto& [owner, i] : invalidations) {
+            if (auto property = committingChanges_[i].property) {
+                owner->invalidate(property->getInvalidationLevel(), property);
+            }
+        }
+
+        for (auto& change : committingChanges_) {
+            if (change.property) change.property->updateWidgets();
+        }
+    }
+
+    notifyObserversProcessorNetworkChanged();
+}
+
+void ProcessorNetwork::removePendingChanges(const std::function<bool(Property*)>& predicate) {
+    for (auto& change : committingChanges_) {
+        if (change.property && predicate(change.property)) change.property = nullptr;
+    }
+    for (auto& change : pendingChanges_) {
+        if (change.property && predicate(change.property)) {
+            pendingIndex_.erase(change.property);
+            change.property = nullptr;
+        }
+    }
+}
+
 void ProcessorNetwork::onProcessorInvalidationBegin(Processor* p) {
     util::push_back_unique(processorsInvalidating_, p);
 }
@@ -364,6 +473,8 @@ void ProcessorNetwork::onProcessorFinishBackgroundWork(Processor* p, size_t jobs
 }
 
 void ProcessorNetwork::onAboutPropertyChange(Property* modifiedProperty) {
+    // Within a transaction the links are evaluated in one go by commitTransaction
+    if (transactions_ > 0) return;
     if (modifiedProperty) linkEvaluator_.evaluateLinksFromProperty(modifiedProperty);
     notifyObserversProcessorNetworkChanged();
 }
@@ -35,6 +35,8 @@
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/datastructures/representationregistry.h>
 
 namespace inviwo {
 
@@ -43,7 +45,8 @@ ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processor
     , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
     , needsSorting_(true)
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , outputCache_{} {
 
     processorNetwork_->addObserver(this);
 }
@@ -52,6 +55,12 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+ProcessorOutputCache& ProcessorNetworkEvaluator::getOutputCache() { return outputCache_; }
+
+const ProcessorOutputCache& ProcessorNetworkEvaluator::getOutputCache() const {
+    return outputCache_;
+}
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -97,6 +106,8 @@ void ProcessorNetworkEvaluator::requestEvaluate() {
 void ProcessorNetworkEvaluator::evaluate() {
     // lock processor network to avoid concurrent evaluation
     NetworkLock lock(processorNetwork_);
+    // the user is waiting for the result, let work dispatched from here skip the queue
+    ThreadPool::PriorityScope priority{ThreadPool::Priority::Interactive};
 
     if (needsSorting_) {
         processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
@@ -109,15 +120,20 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
+            // account the memory of new representations to the processor creating them
+            RepresentationRegistry::Scope attribution{processor->getIdentifier()};
             if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                // re-initialize resources (e.g., shaders) if necessary
+                if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                    processor->notifyObserversAboutToInitializeResources(processor);
+                    try {
                         processor->initializeResources();
+                    } catch (...) {
+                        processor->notifyObserversFinishedInitializeResources(processor);
+                        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+                        continue;
                     }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    continue;
+                    processor->notifyObserversFinishedInitializeResources(processor);
                 }
 
                 try {
@@ -134,8 +150,11 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
+                    // reuse earlier outputs if possible, otherwise do the actual processing
+                    if (!processor->getOutputMemoization() || !outputCache_.restore(processor)) {
+                        processor->process();
+                        outputCache_.processed(processor);
+                    }
 
                     // Set processor as valid only if we still are ready.
                     // Callbacks might have made our inports invalid, if so abort
@@ -158,6 +177,12 @@ void ProcessorNetworkEvaluator::evaluate() {
         }
     }
 
+    // No processor is running here, release representations if over the memory budget unless
+    // background jobs might be using them
+    if (processorNetwork_->runningBackgroundJobs() == 0) {
+        if (auto registry = util::getRepresentationRegistry()) registry->enforceBudget();
+    }
+
     notifyObserversProcessorNetworkEvaluationEnd();
 }
 
@@ -174,6 +199,7 @@ void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p)
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
+    outputCache_.remove(p);
     needsSorting_ = true;
 }
 
@@ -0,0 +1,216 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/processoroutputcache.h>
+
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/ports/inport.h>
+#include <inviwo/core/ports/outport.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/zip.h>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+namespace inviwo {
+
+ProcessorOutputCache::ProcessorOutputCache(size_t budget, size_t capacity)
+    : budget_{budget}
+    , capacity_{capacity}
+    , bytes_{0}
+    , entries_{}
+    , pending_{}
+    , versions_{}
+    , hits_{0}
+    , misses_{0} {}
+
+bool ProcessorOutputCache::restore(Processor* processor) {
+    pending_.erase(processor);
+    auto key = makeKey(processor);
+    if (!key) return false;
+
+    const auto it = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& entry) {
+        return entry.processor == processor &&
+               entry.outputs.size() == processor->getOutports().size() &&
+               matches(entry.key, *key);
+    });
+    if (it == entries_.end()) {
+        ++misses_;
+        pending_.emplace(processor, std::move(*key));
+        return false;
+    }
+
+    // Make sure no running background job overwrites the restored outputs
+    if (auto pool = dynamic_cast<PoolProcessor*>(processor)) pool->stopJobs();
+
+    entries_.splice(entries_.begin(), entries_, it);
+    for (auto&& [outport, data] : util::zip(processor->getOutports(), it->outputs)) {
+        outport->setSharedData(data);
+        track(outport, false);
+    }
+    ++hits_;
+    return true;
+}
+
+void ProcessorOutputCache::store(Processor* processor) {
+    const auto pit = pending_.find(processor);
+    if (pit == pending_.end()) return;
+
+    std::vector<std::shared_ptr<const void>> outputs;
+    size_t bytes = 0;
+    for (auto* outport : processor->getOutports()) {
+        auto data = outport->getSharedData();
+        if (!data && outport->hasData()) return;  // the port does not support caching
+        outputs.push_back(std::move(data));
+        bytes += outport->getResidentBytes();
+        track(outport, false);
+    }
+
+    auto key = std::move(pit->second);
+    pending_.erase(pit);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        it = (it->processor == processor && matches(it->key, key)) ? erase(it) : std::next(it);
+    }
+    if (bytes > budget_) return;
+
+    entries_.push_front(Entry{processor, std::move(key), std::move(outputs), bytes});
+    bytes_ += bytes;
+    shrink();
+}
+
+void ProcessorOutputCache::processed(Processor* processor) {
+    for (auto* outport : processor->getOutports()) {
+        track(outport, true);
+    }
+    if (processor->getOutputMemoization() && !dynamic_cast<PoolProcessor*>(processor)) {
+        store(processor);
+    }
+}
+
+void ProcessorOutputCache::remove(const Processor* processor) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        it = it->processor == processor ? erase(it) : std::next(it);
+    }
+    pending_.erase(processor);
+    for (auto* outport : processor->getOutports()) {
+        versions_.erase(outport);
+    }
+}
+
+void ProcessorOutputCache::clear() {
+    entries_.clear();
+    pending_.clear();
+    bytes_ = 0;
+}
+
+void ProcessorOutputCache::setBudget(size_t bytes) {
+    budget_ = bytes;
+    shrink();
+}
+
+size_t ProcessorOutputCache::getBudget() const { return budget_; }
+
+size_t ProcessorOutputCache::getBytes() const { return bytes_; }
+
+void ProcessorOutputCache::setCapacity(size_t capacity) {
+    capacity_ = capacity;
+    shrink();
+}
+
+size_t ProcessorOutputCache::getCapacity() const { return capacity_; }
+
+size_t ProcessorOutputCache::size() const { return entries_.size(); }
+
+size_t ProcessorOutputCache::getHits() const { return hits_; }
+
+size_t ProcessorOutputCache::getMisses() const { return misses_; }
+
+std::optional<ProcessorOutputCache::Key> ProcessorOutputCache::makeKey(Processor* processor) {
+    Key key;
+    for (auto* inport : processor->getInports()) {
+        for (auto* outport : inport->getConnectedOutports()) {
+            auto data = outport->getSharedData();
+            if (!data && outport->hasData()) return std::nullopt;  // can not identify the data
+
+            const auto it = versions_.find(outport);
+            const size_t version =
+                (it != versions_.end() && it->second.first == data.get()) ? it->second.second : 0;
+            key.inputs.push_back(Input{data, data.get(), version});
+        }
+    }
+
+    // Only the properties, the meta data, like the position of the processor, does not matter.
+    Serializer serializer("");
+    processor->PropertyOwner::serialize(serializer);
+    std::stringstream ss;
+    serializer.writeFile(ss);
+    key.state = std::move(ss).str();
+    key.hash = std::hash<std::string>{}(key.state);
+
+    return key;
+}
+
+bool ProcessorOutputCache::matches(const Key& a, const Key& b) {
+    if (a.hash != b.hash || a.inputs.size() != b.inputs.size()) return false;
+    for (auto&& [ia, ib] : util::zip(a.inputs, b.inputs)) {
+        // Compare the owners as well, a new object might reuse the address of a released one.
+        if (ia.ptr != ib.ptr || ia.version != ib.version || ia.data.owner_before(ib.data) ||
+            ib.data.owner_before(ia.data)) {
+            return false;
+        }
+    }
+    return a.state == b.state;
+}
+
+void ProcessorOutputCache::track(const Outport* outport, bool processed) {
+    const auto* data = outport->getSharedData().get();
+    auto& [ptr, version] = versions_[outport];
+    if (ptr == data) {
+        // The same object after processing, it might have been modified in place.
+        if (processed) ++version;
+    } else {
+        ptr = data;
+        version = 0;
+    }
+}
+
+auto ProcessorOutputCache::erase(std::list<Entry>::iterator it) -> std::list<Entry>::iterator {
+    bytes_ -= it->bytes;
+    return entries_.erase(it);
+}
+
+void ProcessorOutputCache::shrink() {
+    while (!entries_.empty() && (entries_.size() > capacity_ || bytes_ > budget_)) {
+        erase(std::prev(entries_.end()));
+    }
+}
+
+}  // namespace inviwo
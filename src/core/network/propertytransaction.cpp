@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/propertytransaction.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/properties/property.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/logcentral.h>
+
+namespace inviwo {
+
+PropertyTransaction::PropertyTransaction(PropertyTransaction&& rhs) noexcept
+    : network_(rhs.network_) {
+    rhs.network_ = nullptr;
+}
+PropertyTransaction& PropertyTransaction::operator=(PropertyTransaction&& that) {
+    PropertyTransaction transaction(std::move(that));
+    std::swap(network_, transaction.network_);
+    return *this;
+}
+
+PropertyTransaction::PropertyTransaction()
+    : network_(InviwoApplication::getPtr()->getProcessorNetwork()) {
+    if (network_) network_->beginTransaction();
+}
+
+PropertyTransaction::PropertyTransaction(ProcessorNetwork* network) : network_(network) {
+    if (network_) network_->beginTransaction();
+}
+
+PropertyTransaction::PropertyTransaction(Processor* processor)
+    : PropertyTransaction(processor ? processor->getNetwork() : nullptr) {}
+
+PropertyTransaction::PropertyTransaction(Property* property)
+    : PropertyTransaction(
+          property ? (property->getOwner() ? property->getOwner()->getProcessor() : nullptr)
+                   : nullptr) {}
+
+PropertyTransaction::~PropertyTransaction() {
+    if (!network_) return;
+    // Committing invokes on change callbacks, which might throw. Don't let that escape a destructor
+    try {
+        network_->endTransaction();
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+    } catch (const std::exception& e) {
+        LogErrorCustom("PropertyTransaction", e.what());
+    }
+}
+
+}  // namespace inviwo
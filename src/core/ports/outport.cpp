@@ -54,6 +54,12 @@ bool Outport::isConnected() const { return !(connectedInports_.empty()); }
 
 bool Outport::isReady() const { return isReady_; }
 
+std::shared_ptr<const void> Outport::getSharedData() const { return nullptr; }
+
+bool Outport::setSharedData(std::shared_ptr<const void>) { return false; }
+
+size_t Outport::getResidentBytes() const { return 0; }
+
 bool Outport::isConnectedTo(const Inport* port) const {
     return util::contains(connectedInports_, port);
 }
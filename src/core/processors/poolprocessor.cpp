@@ -29,6 +29,7 @@
 
 #include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/stdfuture.h>
@@ -69,6 +70,8 @@ PoolProcessor::PoolProcessor(pool::Options options, const std::string& identifie
                              const std::string& displayName)
     : Processor(identifier, displayName)
     , options_{options}
+    , priority_{ThreadPool::Priority::Normal}
+    , concurrencyLimit_{0}
     , states_{}
     , notifyRemainingJobsFinish_{[this]() {
         auto running = std::accumulate(states_.begin(), states_.end(), size_t{0},
@@ -102,6 +105,9 @@ void PoolProcessor::stopJobs() {
     for (auto& state : states_) {
         state->stop = true;
     }
+    for (auto& submission : queue_) {
+        submission.state->stop = true;
+    }
 }
 
 bool PoolProcessor::hasJobs() { return !states_.empty(); }
@@ -110,11 +116,31 @@ void PoolProcessor::submit(Submission& job) {
     job.setupProgress();
     states_.push_back(job.state);
     notifyObserversStartBackgroundWork(this, job.tasks.size());
+
+    ThreadPool::TaskInfo info{priority_, this, concurrencyLimit_};
+    if (preemptible()) {
+        info.preempt = [state = std::weak_ptr<pool::detail::State>(job.state)]() {
+            if (auto s = state.lock()) {
+                s->preempted = true;
+                s->stop = true;
+            }
+        };
+    }
     for (auto& task : job.tasks) {
-        util::getThreadPool(getInviwoApplication()).enqueueRaw(std::move(task));
+        util::getThreadPool(getInviwoApplication()).enqueueRaw(std::move(task), info);
     }
 }
 
+void PoolProcessor::setPriority(ThreadPool::Priority priority) { priority_ = priority; }
+
+ThreadPool::Priority PoolProcessor::getPriority() const { return priority_; }
+
+void PoolProcessor::setConcurrencyLimit(size_t maxConcurrentJobs) {
+    concurrencyLimit_ = maxConcurrentJobs;
+}
+
+size_t PoolProcessor::getConcurrencyLimit() const { return concurrencyLimit_; }
+
 void PoolProcessor::invalidate(InvalidationLevel invalidationLevel, Property* source) {
     if (delayInvalidation()) {
         notifyObserversInvalidationBegin(this);
@@ -156,6 +182,13 @@ void PoolProcessor::newResults(const std::vector<Outport*>& outports) {
                               // outport ourself.
     }
     notifyObserversInvalidationEnd(this);
+
+    // With KeepOldResults we can not tell which state the results belong to
+    if (getOutputMemoization() && !keepOldJobs()) {
+        if (auto app = getInviwoApplication(); app && app->getProcessorNetworkEvaluator()) {
+            app->getProcessorNetworkEvaluator()->getOutputCache().store(this);
+        }
+    }
 }
 
 void PoolProcessor::progress(pool::detail::State* state, float progress) {
@@ -58,7 +58,8 @@ Processor::Processor(std::string_view identifier, std::string_view displayName)
                 [this]() { return inports_.empty(); }}
     , identifier_(identifier)
     , displayName_{displayName}
-    , network_(nullptr) {
+    , network_(nullptr)
+    , outputMemoization_(false) {
 
     util::validateIdentifier(identifier_, "Processor", IVW_CONTEXT);
 
@@ -304,6 +305,10 @@ bool Processor::isSink() const { return isSink_; }
 
 bool Processor::isReady() const { return isReady_; }
 
+void Processor::setOutputMemoization(bool enable) { outputMemoization_ = enable; }
+
+bool Processor::getOutputMemoization() const { return outputMemoization_; }
+
 bool Processor::allInportsAreReady() const {
     return util::all_of(inports_, [](Inport* p) { return p->isReady() || p->isOptional(); });
 }
@@ -75,9 +75,15 @@ bool ProcessorFactory::registerObject(ProcessorFactoryObject* processor) {
 }
 
 std::unique_ptr<Processor> ProcessorFactory::create(std::string_view key) const {
+    if (!Parent::hasKey(key)) {
+        app_->getModuleManager().loadDeferredModulesForProcessor(key);
+    }
     return Parent::create(key, app_);
 }
 
-bool ProcessorFactory::hasKey(std::string_view key) const { return Parent::hasKey(key); }
+bool ProcessorFactory::hasKey(std::string_view key) const {
+    if (Parent::hasKey(key)) return true;
+    return app_->getModuleManager().loadDeferredModulesForProcessor(key) && Parent::hasKey(key);
+}
 
 }  // namespace inviwo
@@ -35,6 +35,7 @@
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networkvisitor.h>
 #include <inviwo/core/io/serialization/serialization.h>
 
@@ -183,6 +184,15 @@ void Property::updateWidgets() {
 bool Property::hasWidgets() const { return !propertyWidgets_.empty(); }
 
 Property& Property::propertyModified() {
+    // Within a property transaction the change is committed when the transaction ends
+    auto processor = owner_ ? owner_->getProcessor() : nullptr;
+    if (auto network = processor ? processor->getNetwork() : nullptr) {
+        if (network->deferPropertyModified(this)) {
+            setModified();
+            return *this;
+        }
+    }
+
     NetworkLock lock(this);
     onChangeCallback_.invokeAll();
     setModified();
@@ -33,7 +33,7 @@
 #include <inviwo/core/metadata/containermetadata.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/filesystem.h>
-#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/propertytransaction.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/properties/propertyfactory.h>
 #include <inviwo/core/metadata/metadatafactory.h>
@@ -52,7 +52,7 @@ PropertyPresetManager::PropertyPresetManager(InviwoApplication* app) : app_{app}
 bool PropertyPresetManager::loadPreset(const std::string& name, Property* property,
                                        PropertyPresetType type) const {
     auto apply = [this](Property* p, const std::string& data) {
-        NetworkLock lock(p);
+        PropertyTransaction transaction(p);
         std::stringstream ss;
         ss << data;
         auto d = app_->getWorkspaceManager()->createWorkspaceDeserializer(ss, "");
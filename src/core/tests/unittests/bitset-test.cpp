@@ -224,4 +224,31 @@ TEST(bitset, iterators) {
     }
 }
 
+TEST(bitset, copyOnWrite) {
+    BitSet a(1, 2, 3);
+    BitSet b = a;
+    BitSet c;
+    c = a;
+    EXPECT_EQ(a, b);
+
+    b.add(4);
+    EXPECT_EQ(BitSet(1, 2, 3), a);
+    EXPECT_EQ(BitSet(1, 2, 3, 4), b);
+
+    c -= BitSet(1);
+    EXPECT_EQ(BitSet(1, 2, 3), a);
+    EXPECT_EQ(BitSet(2, 3), c);
+
+    BitSet d = a;
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(3, a.size());
+
+    BitSet e = a;
+    a |= a;
+    a.flip(1);
+    EXPECT_EQ(BitSet(2, 3), a);
+    EXPECT_EQ(BitSet(1, 2, 3), e);
+}
+
 }  // namespace inviwo
@@ -33,9 +33,14 @@
 #include <warn/pop>
 
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/dataformatconversion.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
 
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 namespace inviwo {
 
@@ -208,4 +213,54 @@ CONV_TEST(signed_long_long2unsigned_long_long, signed long long, unsigned long l
 
 CONV_TEST(signed_long_long2signed_long_long, signed long long, signed long long)
 
-}  // namespace inviwo
\ No newline at end of file
+TEST(DataFormatConversion, Cast) {
+    const std::vector<float> src{-1.5f, 0.0f, 1.7f, 200.9f};
+    std::vector<int> dst(src.size());
+    util::convertValues(src.data(), dst.data(), src.size());
+    EXPECT_EQ((std::vector<int>{-1, 0, 1, 200}), dst);
+}
+
+TEST(DataFormatConversion, Map) {
+    const std::vector<unsigned short> src{0, 1000, 65535};
+    std::vector<unsigned char> dst(src.size());
+    util::convertValues(src.data(), dst.data(), src.size(),
+                        util::LinearMap::fromRanges({0.0, 65535.0}, {0.0, 255.0}));
+    EXPECT_EQ((std::vector<unsigned char>{0, 4, 255}), dst);
+
+    // Values outside the range of the destination type are clamped, NaN becomes the lowest value
+    const std::vector<double> values{-10.0, 0.5, 1.5, std::numeric_limits<double>::quiet_NaN()};
+    std::vector<unsigned char> clamped(values.size());
+    util::convertValues(values.data(), clamped.data(), values.size(),
+                        util::LinearMap::fromRanges({0.0, 1.0}, {0.0, 255.0}));
+    EXPECT_EQ((std::vector<unsigned char>{0, 128, 255, 0}), clamped);
+}
+
+TEST(DataFormatConversion, Vectors) {
+    const std::vector<ivec3> src{{0, 5, 10}, {10, 0, 5}};
+    std::vector<vec3> dst(src.size());
+    util::convertValues(src.data(), dst.data(), src.size(),
+                        util::LinearMap::fromRanges({0.0, 10.0}, {0.0, 1.0}));
+    EXPECT_EQ(vec3(0.0f, 0.5f, 1.0f), dst[0]);
+    EXPECT_EQ(vec3(1.0f, 0.0f, 0.5f), dst[1]);
+}
+
+TEST(DataFormatConversion, VolumeRAM) {
+    VolumeRAMPrecision<glm::u8vec2> src(size3_t{40, 30, 20});
+    auto data = src.getDataTyped();
+    for (size_t i = 0; i < 40 * 30 * 20; ++i) {
+        data[i] = glm::u8vec2(i % 256, 255 - i % 256);
+    }
+    auto dst = util::convertVolumeRAM(src, DataVec2Float32::get(),
+                                      util::LinearMap::fromRanges({0.0, 255.0}, {0.0, 1.0}));
+    ASSERT_EQ(DataVec2Float32::get(), dst->getDataFormat());
+    EXPECT_EQ(src.getDimensions(), dst->getDimensions());
+    const auto dstData = static_cast<const vec2*>(dst->getData());
+    for (size_t i = 0; i < 40 * 30 * 20; ++i) {
+        EXPECT_FLOAT_EQ(static_cast<float>(data[i].x) / 255.0f, dstData[i].x);
+        EXPECT_FLOAT_EQ(static_cast<float>(data[i].y) / 255.0f, dstData[i].y);
+    }
+
+    EXPECT_THROW(util::convertVolumeRAM(src, DataFloat32::get()), Exception);
+}
+
+}  // namespace inviwo
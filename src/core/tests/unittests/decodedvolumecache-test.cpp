@@ -0,0 +1,221 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/decodedvolumecache.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/testutil/tempdirectory.h>
+
+#include <cstring>
+#include <numeric>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+struct DecodedVolumeCacheTest : ::testing::Test {
+    DecodedVolumeCacheTest() : dir{tmp.string()}, source{dir + "/source.dat"} {
+        filesystem::ofstream(source) << "compressed data";
+    }
+
+    static std::shared_ptr<Volume> makeVolume() {
+        auto ram = std::make_shared<VolumeRAMPrecision<unsigned short>>(size3_t{4, 5, 6});
+        auto data = ram->getDataTyped();
+        std::iota(data, data + 4 * 5 * 6, static_cast<unsigned short>(0));
+        auto volume = std::make_shared<Volume>(ram);
+        volume->setOffset(vec3{1.0f, 2.0f, 3.0f});
+        volume->dataMap_.dataRange = dvec2{0.0, 119.0};
+        volume->axes[0].name = "depth";
+        return volume;
+    }
+
+    TempDirectory tmp;
+    std::string dir;
+    std::string source;
+};
+
+}  // namespace
+
+TEST_F(DecodedVolumeCacheTest, StoreAndLoadVolume) {
+    DecodedVolumeCache cache{dir + "/cache", 1024 * 1024};
+    EXPECT_FALSE(cache.load(source));
+
+    const auto volume = makeVolume();
+    cache.store(source, {}, *volume);
+    EXPECT_FALSE(cache.load(source, "other settings"));
+
+    auto cached = cache.load(source);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(volume->getDimensions(), cached->getDimensions());
+    EXPECT_EQ(volume->getDataFormat(), cached->getDataFormat());
+    EXPECT_EQ(volume->getOffset(), cached->getOffset());
+    EXPECT_EQ(volume->dataMap_.dataRange, cached->dataMap_.dataRange);
+    EXPECT_EQ("depth", cached->axes[0].name);
+    ASSERT_TRUE(cached->getRepresentation<VolumeDisk>());
+    EXPECT_EQ(source, cached->getRepresentation<VolumeDisk>()->getSourceFile());
+
+    const auto* ram = cached->getRepresentation<VolumeRAM>();
+    const auto* data = static_cast<const unsigned short*>(ram->getData());
+    for (unsigned short i = 0; i < 4 * 5 * 6; ++i) {
+        EXPECT_EQ(i, data[i]);
+    }
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(1u, stats.stores);
+    EXPECT_EQ(sizeof(unsigned short) * 4 * 5 * 6, stats.bytesHeld);
+}
+
+TEST_F(DecodedVolumeCacheTest, LoadRepresentation) {
+    const auto volume = makeVolume();
+    const auto* ram = volume->getRepresentation<VolumeRAM>();
+    {
+        DecodedVolumeCache cache{dir + "/cache", 1024 * 1024};
+        cache.store(source, "t=1", *ram);
+    }
+
+    // A new cache instance picks up the entries on disk
+    DecodedVolumeCache cache{dir + "/cache", 1024 * 1024};
+    EXPECT_EQ(sizeof(unsigned short) * 4 * 5 * 6, cache.getStats().bytesHeld);
+    EXPECT_FALSE(cache.load(source, "t=1"));
+
+    auto cached = cache.loadRepresentation(source, "t=1", *ram);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(0, std::memcmp(ram->getData(), cached->getData(),
+                             sizeof(unsigned short) * 4 * 5 * 6));
+
+    const VolumeRAMPrecision<unsigned short> other{size3_t{4, 5, 5}};
+    EXPECT_FALSE(cache.loadRepresentation(source, "t=1", other));
+}
+
+TEST_F(DecodedVolumeCacheTest, StoreAndLoadFile) {
+    DecodedVolumeCache cache{dir + "/cache", 1024};
+    EXPECT_TRUE(cache.loadFile(source, "mesh").first.empty());
+
+    cache.storeFile(source, "mesh", [](std::ostream& os) { os << "converted data"; });
+    EXPECT_TRUE(cache.loadFile(source, "other settings").first.empty());
+
+    const auto [file, pin] = cache.loadFile(source, "mesh");
+    ASSERT_FALSE(file.empty());
+    EXPECT_TRUE(pin);
+    auto in = filesystem::ifstream(file);
+    std::string content;
+    std::getline(in, content);
+    EXPECT_EQ("converted data", content);
+
+    // Files larger than the budget are not stored
+    cache.storeFile(source, "large", [](std::ostream& os) { os << std::string(2048, 'x'); });
+    EXPECT_TRUE(cache.loadFile(source, "large").first.empty());
+    EXPECT_EQ(1u, cache.getStats().stores);
+}
+
+TEST_F(DecodedVolumeCacheTest, ChangedSourceInvalidates) {
+    DecodedVolumeCache cache{dir + "/cache", 1024 * 1024};
+    cache.store(source, {}, *makeVolume());
+
+    filesystem::ofstream(source) << "changed compressed data";
+    EXPECT_FALSE(cache.load(source));
+    EXPECT_EQ(0u, cache.getStats().bytesHeld);
+}
+
+TEST_F(DecodedVolumeCacheTest, EvictLeastRecentlyUsed) {
+    const auto bytes = sizeof(unsigned short) * 4 * 5 * 6;
+    DecodedVolumeCache cache{dir + "/cache", 2 * bytes};
+    const auto volume = makeVolume();
+
+    cache.store(source, "a", *volume);
+    cache.store(source, "b", *volume);
+    {
+        // Use "a" so that "b" is the least recently used
+        const auto a = cache.load(source, "a");
+        ASSERT_TRUE(a);
+    }
+    cache.store(source, "c", *volume);
+
+    EXPECT_EQ(1u, cache.getStats().evictions);
+    EXPECT_EQ(2 * bytes, cache.getStats().bytesHeld);
+    EXPECT_TRUE(cache.load(source, "a"));
+    EXPECT_FALSE(cache.load(source, "b"));
+    EXPECT_TRUE(cache.load(source, "c"));
+
+    cache.setBudget(0);
+    EXPECT_FALSE(cache.isEnabled());
+}
+
+TEST_F(DecodedVolumeCacheTest, VolumesInUseAreKept) {
+    const auto bytes = sizeof(unsigned short) * 4 * 5 * 6;
+    DecodedVolumeCache cache{dir + "/cache", bytes};
+    const auto volume = makeVolume();
+
+    cache.store(source, "a", *volume);
+    const auto a = cache.load(source, "a");
+    ASSERT_TRUE(a);
+
+    // Over budget, but "a" is in use so the new entry is evicted instead
+    cache.store(source, "b", *volume);
+    EXPECT_EQ(1u, cache.getStats().evictions);
+    EXPECT_FALSE(cache.load(source, "b"));
+    EXPECT_TRUE(a->getRepresentation<VolumeRAM>());
+}
+
+TEST_F(DecodedVolumeCacheTest, CopiesOfVolumesKeepEntries) {
+    const auto bytes = sizeof(unsigned short) * 4 * 5 * 6;
+    DecodedVolumeCache cache{dir + "/cache", bytes};
+    const auto volume = makeVolume();
+
+    cache.store(source, "a", *volume);
+    std::unique_ptr<Volume> copy;
+    {
+        const auto a = cache.load(source, "a");
+        ASSERT_TRUE(a);
+        copy.reset(a->clone());
+    }
+
+    // The copy has not read the data yet, its VolumeDisk still needs the entry
+    cache.store(source, "b", *volume);
+    EXPECT_FALSE(cache.load(source, "b"));
+    const auto* ram = copy->getRepresentation<VolumeRAM>();
+    ASSERT_TRUE(ram);
+    EXPECT_EQ(119, static_cast<const unsigned short*>(ram->getData())[119]);
+
+    copy.reset();
+    cache.store(source, "b", *volume);
+    EXPECT_TRUE(cache.load(source, "b"));
+}
+
+}  // namespace inviwo
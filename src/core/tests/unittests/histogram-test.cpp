@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/brickiterator.h>
+
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace {
+
+void expectSameHistograms(const HistogramContainer& expected, const HistogramContainer& result) {
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].getData(), result[i].getData());
+        EXPECT_EQ(expected[i].getMaximumBinValue(), result[i].getMaximumBinValue());
+        EXPECT_DOUBLE_EQ(expected[i].stats_.min, result[i].stats_.min);
+        EXPECT_DOUBLE_EQ(expected[i].stats_.max, result[i].stats_.max);
+        EXPECT_NEAR(expected[i].stats_.mean, result[i].stats_.mean, 1e-9);
+        EXPECT_NEAR(expected[i].stats_.standardDeviation, result[i].stats_.standardDeviation,
+                    1e-9);
+    }
+}
+
+HistogramContainer fullHistograms(const VolumeRAMPrecision<float>& ram, dvec2 range, size_t bins) {
+    const auto data = ram.getDataTyped();
+    return HistogramContainer(range, bins, data, data + glm::compMul(ram.getDimensions()));
+}
+
+}  // namespace
+
+TEST(VolumeRAM, ModifiedBricks) {
+    VolumeRAMPrecision<float> ram(size3_t{70, 50, 40});
+    EXPECT_EQ(0u, ram.getModificationVersion());
+    EXPECT_TRUE(ram.getModifiedBricks(0).empty());
+
+    ram.markModified(size3_t{33, 0, 0}, size3_t{1, 1, 1});
+    EXPECT_EQ(1u, ram.getModificationVersion());
+    EXPECT_EQ(std::vector<size_t>{1}, ram.getModifiedBricks(0));
+
+    // Spans bricks (1,0,0) to (2,1,0) in a 3x2x2 grid
+    ram.markModified(size3_t{40, 20, 10}, size3_t{30, 20, 10});
+    EXPECT_EQ((std::vector<size_t>{1, 2, 4, 5}), ram.getModifiedBricks(0));
+    EXPECT_EQ((std::vector<size_t>{1, 2, 4, 5}), ram.getModifiedBricks(1));
+    EXPECT_TRUE(ram.getModifiedBricks(2).empty());
+
+    ram.markModified();
+    EXPECT_EQ(12u, ram.getModifiedBricks(2).size());
+}
+
+TEST(BrickedHistogram, Update) {
+    const dvec2 range{0.0, 1.0};
+    const size_t bins = 64;
+
+    VolumeRAMPrecision<float> ram(size3_t{70, 50, 40});
+    auto data = ram.getDataTyped();
+    for (size_t i = 0; i < glm::compMul(ram.getDimensions()); ++i) {
+        data[i] = static_cast<float>((i * 37) % 1000) / 1000.0f;
+    }
+
+    BrickedHistogram histogram(ram, range, bins);
+    expectSameHistograms(fullHistograms(ram, range, bins), histogram.getHistograms());
+
+    // The quantiles are computed along with the histograms
+    const auto sketch = histogram.getHistograms()[0].quantiles_;
+    EXPECT_EQ(glm::compMul(ram.getDimensions()), sketch.count());
+    EXPECT_NEAR(0.5, sketch.quantile(0.5), 0.02);
+
+    const size3_t offset{10, 35, 5};
+    const size3_t extent{30, 10, 20};
+    auto it = util::BrickIterator{data, ram.getDimensions(), offset, extent};
+    for (auto& v : it) v = 0.995f;
+    ram.markModified(offset, extent);
+
+    histogram.update(ram, ram.getModifiedBricks(0));
+    expectSameHistograms(fullHistograms(ram, range, bins), histogram.getHistograms());
+
+    // 6000 of the 140000 values are now 0.995, which moves the upper quantiles
+    const auto updated = histogram.getHistograms()[0].quantiles_;
+    EXPECT_EQ(glm::compMul(ram.getDimensions()), updated.count());
+    EXPECT_NEAR(0.995, updated.quantile(0.98), 0.005);
+}
+
+TEST(HistogramAccumulator, MergeSubtract) {
+    const std::vector<int> a{1, 2, 3, 4, 5};
+    const std::vector<int> b{5, 6, 7, 8, 9, 10};
+    const dvec2 range{0.0, 10.0};
+    const auto bins = HistogramAccumulator::binsFor<int>(range, 100);
+    EXPECT_EQ(11u, bins);
+
+    HistogramAccumulator accA{range, bins};
+    accA.add(a.begin(), a.end());
+    HistogramAccumulator accB{range, bins};
+    accB.add(b.begin(), b.end());
+
+    auto total = accA;
+    total.merge(accB);
+    EXPECT_EQ(11u, total.getCount());
+    EXPECT_EQ(2.0, total.getChannels()[0].counts[5]);
+    EXPECT_EQ(1.0, total.getChannels()[0].min);
+    EXPECT_EQ(10.0, total.getChannels()[0].max);
+
+    total.subtract(accB);
+    EXPECT_EQ(5u, total.getCount());
+    EXPECT_EQ(1.0, total.getChannels()[0].counts[5]);
+    EXPECT_EQ(0.0, total.getChannels()[0].counts[10]);
+    EXPECT_DOUBLE_EQ(15.0, total.getChannels()[0].sum);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/ivmmeshreader.h>
+#include <inviwo/core/io/ivmmeshwriter.h>
+#include <inviwo/core/io/ivmmeshformat.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/metadata/metadata.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace inviwo {
+
+TEST(IvmMesh, RoundTrip) {
+    Mesh mesh{DrawType::Lines, ConnectivityType::Strip};
+    mesh.setModelMatrix(mat4{2.0f});
+    mesh.setMetaData<StringMetaData>("source", "test");
+
+    mesh.addBuffer(BufferType::PositionAttrib,
+                   util::makeBuffer<vec3>({vec3{0.0f}, vec3{1.0f}, vec3{2.0f}}));
+    mesh.addBuffer(Mesh::BufferInfo{BufferType::ColorAttrib, 7},
+                   util::makeBuffer<vec4>({vec4{0.1f}, vec4{0.2f}, vec4{0.3f}}));
+    mesh.addBuffer(BufferType::IndexAttrib, util::makeBuffer<std::uint16_t>({4, 5, 6}));
+    mesh.addIndices({DrawType::Triangles, ConnectivityType::None},
+                    util::makeIndexBuffer({0, 1, 2}));
+    mesh.addIndices({DrawType::Points, ConnectivityType::None}, util::makeIndexBuffer({2}));
+
+    std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    util::writeIvmMesh(mesh, ss);
+    ss.seekg(0);
+    const auto copy = util::readIvmMesh(ss);
+
+    EXPECT_EQ(mesh.getModelMatrix(), copy->getModelMatrix());
+    EXPECT_EQ(DrawType::Lines, copy->getDefaultMeshInfo().dt);
+    EXPECT_EQ(ConnectivityType::Strip, copy->getDefaultMeshInfo().ct);
+    ASSERT_TRUE(copy->getMetaData<StringMetaData>("source"));
+    EXPECT_EQ("test", copy->getMetaData<StringMetaData>("source")->get());
+
+    ASSERT_EQ(mesh.getNumberOfBuffers(), copy->getNumberOfBuffers());
+    for (size_t i = 0; i < mesh.getNumberOfBuffers(); ++i) {
+        EXPECT_EQ(mesh.getBufferInfo(i).type, copy->getBufferInfo(i).type);
+        EXPECT_EQ(mesh.getBufferInfo(i).location, copy->getBufferInfo(i).location);
+        EXPECT_EQ(mesh.getBuffer(i)->getDataFormat(), copy->getBuffer(i)->getDataFormat());
+        EXPECT_TRUE(*mesh.getBuffer(i) == *copy->getBuffer(i));
+    }
+
+    ASSERT_EQ(mesh.getNumberOfIndicies(), copy->getNumberOfIndicies());
+    for (size_t i = 0; i < mesh.getNumberOfIndicies(); ++i) {
+        EXPECT_EQ(mesh.getIndexMeshInfo(i).dt, copy->getIndexMeshInfo(i).dt);
+        EXPECT_EQ(mesh.getIndexMeshInfo(i).ct, copy->getIndexMeshInfo(i).ct);
+        EXPECT_TRUE(*mesh.getIndices(i) == *copy->getIndices(i));
+    }
+}
+
+TEST(IvmMesh, InvalidData) {
+    std::stringstream ss("not a mesh");
+    EXPECT_THROW(util::readIvmMesh(ss), DataReaderException);
+}
+
+namespace {
+
+std::string writeMesh(std::string_view key = {}) {
+    Mesh mesh;
+    mesh.addBuffer(BufferType::PositionAttrib,
+                   util::makeBuffer<vec3>({vec3{0.0f}, vec3{1.0f}, vec3{2.0f}}));
+    mesh.addIndices({DrawType::Triangles, ConnectivityType::None},
+                    util::makeIndexBuffer({0, 1, 2}));
+    std::stringstream ss(std::ios_base::out | std::ios_base::binary);
+    util::writeIvmMesh(mesh, ss, key);
+    return std::move(ss).str();
+}
+
+}  // namespace
+
+TEST(IvmMesh, Key) {
+    std::stringstream ss(writeMesh("key"), std::ios_base::in | std::ios_base::binary);
+    EXPECT_TRUE(util::readIvmMesh(ss, "key"));
+    EXPECT_THROW(util::readIvmMesh(ss, "other key"), DataReaderException);
+
+    std::stringstream noKey(writeMesh(), std::ios_base::in | std::ios_base::binary);
+    EXPECT_THROW(util::readIvmMesh(noKey, "key"), DataReaderException);
+}
+
+TEST(IvmMesh, InvalidSizes) {
+    const auto data = writeMesh();
+
+    // The data of the last block is cut off
+    std::stringstream truncated(data.substr(0, data.size() - 2 * ivm::alignment),
+                                std::ios_base::in | std::ios_base::binary);
+    EXPECT_THROW(util::readIvmMesh(truncated), DataReaderException);
+
+    // A header size larger than the file
+    auto corrupt = data;
+    const std::uint64_t headerSize = std::uint64_t{1} << 40;
+    std::memcpy(corrupt.data() + ivm::preambleSize - sizeof(headerSize), &headerSize,
+                sizeof(headerSize));
+    std::stringstream ss(corrupt, std::ios_base::in | std::ios_base::binary);
+    EXPECT_THROW(util::readIvmMesh(ss), DataReaderException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/modulemanifest.h>
+#include <inviwo/core/io/serialization/serialization.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+TEST(ModuleManifestTest, EntryRoundTrip) {
+    ModuleManifest::Entry entry;
+    entry.version = "1.2.3";
+    entry.inviwoCoreVersion = "0.9.11";
+    entry.processors = {"org.inviwo.VolumeSource", "org.inviwo.ImageSource"};
+    entry.readerExtensions = {"dat", "ivf"};
+    entry.writerExtensions = {"png"};
+    entry.deferrable = true;
+
+    std::stringstream ss;
+    Serializer serializer("");
+    serializer.serialize("Entry", entry);
+    serializer.writeFile(ss);
+
+    ModuleManifest::Entry loaded;
+    Deserializer deserializer(ss, "");
+    deserializer.deserialize("Entry", loaded);
+
+    EXPECT_EQ(entry, loaded);
+    loaded.processors.pop_back();
+    EXPECT_NE(entry, loaded);
+    loaded = entry;
+    loaded.deferrable = false;
+    EXPECT_NE(entry, loaded);
+}
+
+TEST(ModuleManifestTest, MatchesExtension) {
+    const std::vector<std::string> extensions{"nii.gz", "tif"};
+
+    EXPECT_TRUE(ModuleManifest::matchesExtension(extensions, "tif"));
+    EXPECT_TRUE(ModuleManifest::matchesExtension(extensions, "/data/image.TIF"));
+    EXPECT_TRUE(ModuleManifest::matchesExtension(extensions, "/data/brain.nii.gz"));
+    EXPECT_FALSE(ModuleManifest::matchesExtension(extensions, "/data/archive.gz"));
+    EXPECT_FALSE(ModuleManifest::matchesExtension(extensions, "png"));
+    EXPECT_FALSE(ModuleManifest::matchesExtension({}, "tif"));
+}
+
+TEST(ModuleManifestTest, EmptyManifestRoundTrip) {
+    ModuleManifest manifest;
+    EXPECT_TRUE(manifest.empty());
+    EXPECT_FALSE(manifest.isModified());
+
+    std::stringstream ss;
+    Serializer serializer("");
+    manifest.serialize(serializer);
+    serializer.writeFile(ss);
+
+    ModuleManifest loaded;
+    Deserializer deserializer(ss, "");
+    loaded.deserialize(deserializer);
+    EXPECT_TRUE(loaded.empty());
+}
+
+}  // namespace inviwo
@@ -41,6 +41,7 @@
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 
 #include <functional>
 
@@ -256,4 +257,74 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, OutputMemoization) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto at = createA();
+    auto a = at.get();
+    auto value = static_cast<IntProperty*>(
+        a->addProperty(std::make_unique<IntProperty>("value", "Value", 0, 0, 10)));
+    a->setOutputMemoization(true);
+    Instrument ai(*a);
+    a->onProcess = [func = a->onProcess, value](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])
+            ->setData(std::make_shared<int>(value->get()));
+    };
+
+    auto bt = createB();
+    auto b = bt.get();
+    Instrument bi(*b);
+
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    ai.reset();
+    bi.reset();
+
+    const auto data = [b]() {
+        return static_cast<DataInport<int>*>(b->getInports()[0])->getData();
+    };
+    const auto first = data();
+
+    {
+        SCOPED_TRACE("New state");
+        value->set(1);
+        ai.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+        EXPECT_EQ(*data(), 1);
+    }
+    const auto second = data();
+
+    {
+        SCOPED_TRACE("Restore first state");
+        value->set(0);
+        ai.checkAndReset(0, 0, 0);
+        bi.checkAndReset(0, 1, 0);
+        EXPECT_EQ(data(), first);
+        EXPECT_TRUE(a->isValid());
+    }
+    {
+        SCOPED_TRACE("Restore second state");
+        value->set(1);
+        ai.checkAndReset(0, 0, 0);
+        bi.checkAndReset(0, 1, 0);
+        EXPECT_EQ(data(), second);
+    }
+    {
+        SCOPED_TRACE("Invalidate without state change");
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        ai.checkAndReset(0, 0, 0);
+        EXPECT_EQ(evaluator.getOutputCache().getHits(), 3);
+    }
+    {
+        SCOPED_TRACE("Capacity");
+        evaluator.getOutputCache().setCapacity(1);
+        EXPECT_EQ(evaluator.getOutputCache().size(), 1);
+        value->set(0);
+        ai.checkAndReset(0, 1, 0);
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,173 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/util/networkprofiler.h>
+
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+struct ProfiledProcessor : Processor {
+    ProfiledProcessor(const std::string& id) : Processor(id, id) {}
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {
+        for (auto* outport : getOutports()) {
+            static_cast<DataOutport<int>*>(outport)->setData(std::make_shared<int>(0));
+        }
+    }
+};
+
+const ProcessorInfo ProfiledProcessor::processorInfo_{
+    "org.inviwo.ProfiledProcessor",  // Class identifier
+    "ProfiledProcessor",             // Display name
+    "Testing",                       // Category
+    CodeState::Stable,               // Code state
+    Tags::CPU,                       // Tags
+};
+
+}  // namespace
+
+TEST(NetworkProfiler, Runs) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto at = std::make_unique<ProfiledProcessor>("a");
+    at->addPort(std::make_unique<DataOutport<int>>("out"));
+    auto bt = std::make_unique<ProfiledProcessor>("b");
+    bt->addPort(std::make_unique<DataInport<int>>("in"));
+    auto* a = at.get();
+    auto* b = bt.get();
+    network.addProcessor(std::move(at));
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    size_t allocations = 0;
+    NetworkProfiler profiler{&network, &evaluator,
+                             NetworkProfiler::MemorySource{
+                                 [&]() {
+                                     ++allocations;
+                                     return NetworkProfiler::MemoryCounters{allocations, 0, 0, 0};
+                                 },
+                                 []() {}}};
+
+    // Not recorded outside of a run
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_TRUE(profiler.getRuns().empty());
+
+    profiler.beginRun("output");
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    profiler.endRun();
+
+    profiler.beginRun("resources");
+    a->invalidate(InvalidationLevel::InvalidResources);
+    profiler.endRun();
+
+    const auto& runs = profiler.getRuns();
+    ASSERT_EQ(runs.size(), 2);
+    EXPECT_EQ(runs[0].label, "output");
+    EXPECT_EQ(runs[0].evaluations, 1);
+    ASSERT_EQ(runs[0].processors.size(), 2);
+    EXPECT_EQ(runs[0].processors[0].identifier, "a");
+    EXPECT_EQ(runs[0].processors[0].classIdentifier, "org.inviwo.ProfiledProcessor");
+    EXPECT_EQ(runs[0].processors[1].identifier, "b");
+    for (const auto& rec : runs[0].processors) {
+        EXPECT_EQ(rec.process.calls, 1);
+        EXPECT_EQ(rec.initializeResources.calls, 0);
+        // One sample is taken before and one after the call
+        EXPECT_GT(rec.process.allocations, 0);
+    }
+
+    ASSERT_EQ(runs[1].processors.size(), 2);
+    EXPECT_EQ(runs[1].processors[0].initializeResources.calls, 1);
+    EXPECT_EQ(runs[1].processors[0].process.calls, 1);
+    EXPECT_EQ(runs[1].processors[1].initializeResources.calls, 0);
+
+    std::stringstream csv;
+    profiler.writeCSV(csv);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(csv, line)) ++lines;
+    EXPECT_EQ(lines, 1 + 2 * 3);
+
+    std::stringstream json;
+    profiler.writeJSON(json, {{"workspace", "test"}});
+    EXPECT_NE(json.str().find("\"label\": \"resources\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"workspace\": \"test\""), std::string::npos);
+}
+
+TEST(NetworkProfiler, NestedCalls) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto* a = network.addProcessor(std::make_unique<ProfiledProcessor>("a"));
+    auto* b = network.addProcessor(std::make_unique<ProfiledProcessor>("b"));
+
+    size_t live = 0;
+    NetworkProfiler profiler{
+        &network, &evaluator,
+        NetworkProfiler::MemorySource{
+            [&]() { return NetworkProfiler::MemoryCounters{0, 0, live, live}; }, []() {}}};
+
+    // A process notification within an initializeResources of another processor
+    profiler.beginRun("nested");
+    profiler.onProcessorAboutToInitializeResources(a);
+    live = 100;
+    profiler.onProcessorAboutToProcess(b);
+    live = 150;
+    profiler.onProcessorFinishedProcess(b);
+    profiler.onProcessorFinishedInitializeResources(a);
+    profiler.endRun();
+
+    const auto& run = profiler.getRuns().front();
+    ASSERT_EQ(run.processors.size(), 2);
+    EXPECT_EQ(run.processors[0].initializeResources.calls, 1);
+    EXPECT_EQ(run.processors[0].initializeResources.peakBytes, 150);
+    EXPECT_EQ(run.processors[1].process.calls, 1);
+    EXPECT_EQ(run.processors[1].process.peakBytes, 50);
+}
+
+}  // namespace inviwo
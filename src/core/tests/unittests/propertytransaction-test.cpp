@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/propertytransaction.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+namespace {
+
+struct TransactionProcessor : Processor {
+    TransactionProcessor(const std::string& id) : Processor(id, id) {
+        addProperties(value1, value2);
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void invalidate(InvalidationLevel invalidationLevel,
+                            Property* modifiedProperty = nullptr) override {
+        if (modifiedProperty) ++invalidations;
+        Processor::invalidate(invalidationLevel, modifiedProperty);
+    }
+
+    IntProperty value1{"value1", "Value1", 0, 0, 100};
+    IntProperty value2{"value2", "Value2", 0, 0, 100};
+    int invalidations = 0;
+};
+
+const ProcessorInfo TransactionProcessor::processorInfo_{
+    "org.inviwo.TransactionProcessor",  // Class identifier
+    "TransactionProcessor",             // Display name
+    "Testing",                          // Category
+    CodeState::Stable,                  // Code state
+    Tags::CPU,                          // Tags
+};
+
+}  // namespace
+
+TEST(PropertyTransaction, DefersAndCoalescesChanges) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto pa = network.addProcessor(std::make_shared<TransactionProcessor>("a"));
+    auto pb = network.addProcessor(std::make_shared<TransactionProcessor>("b"));
+    network.addLink(&pa->value1, &pb->value1);
+
+    int onChangeA = 0;
+    int onChangeB = 0;
+    auto cba = pa->value1.onChangeScoped([&]() { ++onChangeA; });
+    auto cbb = pb->value1.onChangeScoped([&]() { ++onChangeB; });
+    pa->invalidations = 0;
+    pb->invalidations = 0;
+
+    {
+        PropertyTransaction transaction(&network);
+        EXPECT_TRUE(network.isInTransaction());
+        EXPECT_TRUE(network.islocked());
+        for (int i = 1; i <= 10; ++i) pa->value1.set(i);
+        pa->value2.set(5);
+
+        EXPECT_EQ(0, onChangeA);
+        EXPECT_EQ(0, pb->value1.get());
+        EXPECT_EQ(0, pa->invalidations);
+    }
+
+    EXPECT_FALSE(network.isInTransaction());
+    EXPECT_FALSE(network.islocked());
+    EXPECT_EQ(1, onChangeA);
+    EXPECT_EQ(1, onChangeB);
+    EXPECT_EQ(10, pb->value1.get());
+    EXPECT_EQ(1, pa->invalidations);
+    EXPECT_EQ(1, pb->invalidations);
+}
+
+TEST(PropertyTransaction, LastSetWinsForBidirectionalLinks) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto pa = network.addProcessor(std::make_shared<TransactionProcessor>("a"));
+    auto pb = network.addProcessor(std::make_shared<TransactionProcessor>("b"));
+    network.addLink(&pa->value1, &pb->value1);
+    network.addLink(&pb->value1, &pa->value1);
+
+    {
+        PropertyTransaction transaction(&network);
+        pa->value1.set(3);
+        pb->value1.set(7);
+    }
+    EXPECT_EQ(7, pa->value1.get());
+    EXPECT_EQ(7, pb->value1.get());
+}
+
+TEST(PropertyTransaction, NestedTransactions) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto pa = network.addProcessor(std::make_shared<TransactionProcessor>("a"));
+    int onChange = 0;
+    auto cb = pa->value1.onChangeScoped([&]() { ++onChange; });
+
+    {
+        PropertyTransaction outer(&network);
+        {
+            PropertyTransaction inner(&network);
+            pa->value1.set(1);
+        }
+        EXPECT_EQ(0, onChange);
+        pa->value1.set(2);
+    }
+    EXPECT_EQ(1, onChange);
+}
+
+TEST(PropertyTransaction, RemovedProcessorIsDropped) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    auto pa = network.addProcessor(std::make_shared<TransactionProcessor>("a"));
+
+    PropertyTransaction transaction(&network);
+    pa->value1.set(1);
+    network.removeProcessor(pa);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/quantilesketch.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+TEST(QuantileSketch, Exact) {
+    util::QuantileSketch sketch;
+    for (int i = 1; i <= 100; ++i) sketch.add(static_cast<double>(i));
+
+    EXPECT_EQ(100u, sketch.count());
+    EXPECT_DOUBLE_EQ(1.0, sketch.quantile(0.0));
+    EXPECT_DOUBLE_EQ(50.0, sketch.quantile(0.5));
+    EXPECT_DOUBLE_EQ(100.0, sketch.quantile(1.0));
+    EXPECT_DOUBLE_EQ(0.25, sketch.rank(25.0));
+
+    sketch.add(std::nan(""));
+    EXPECT_EQ(100u, sketch.count());
+}
+
+TEST(QuantileSketch, Approximate) {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    BufferRAMPrecision<double> buffer(1'000'000);
+    auto& values = buffer.getDataContainer();
+    std::generate(values.begin(), values.end(), [&]() { return dist(gen); });
+
+    const auto sketches = util::quantileSketches(buffer);
+    ASSERT_EQ(1u, sketches.size());
+    const auto& sketch = sketches.front();
+    EXPECT_EQ(values.size(), sketch.count());
+    EXPECT_LT(sketch.size(), 10'000u);
+
+    std::sort(values.begin(), values.end());
+    for (auto q : {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99}) {
+        const auto rank = sketch.rank(values[static_cast<size_t>(q * (values.size() - 1))]);
+        EXPECT_NEAR(q, rank, 0.02) << "quantile " << q;
+    }
+    EXPECT_DOUBLE_EQ(values.front(), sketch.min());
+    EXPECT_DOUBLE_EQ(values.back(), sketch.max());
+}
+
+TEST(QuantileSketch, Merge) {
+    util::QuantileSketch a;
+    util::QuantileSketch b;
+    for (int i = 0; i < 10000; ++i) {
+        a.add(static_cast<double>(i));
+        b.add(static_cast<double>(i + 10000));
+    }
+    a.merge(b);
+    EXPECT_EQ(20000u, a.count());
+    EXPECT_NEAR(10000.0, a.quantile(0.5), 400.0);
+    EXPECT_DOUBLE_EQ(19999.0, a.max());
+}
+
+TEST(QuantileSketch, RobustRange) {
+    util::QuantileSketch a;
+    util::QuantileSketch b;
+    for (int i = 1; i <= 100; ++i) {
+        a.add(static_cast<double>(i));
+        b.add(static_cast<double>(i + 50));
+    }
+    a.add(1e9);
+
+    const auto range = util::robustRange({a, b}, 0.05);
+    EXPECT_DOUBLE_EQ(6.0, range.x);
+    EXPECT_DOUBLE_EQ(145.0, range.y);
+    EXPECT_DOUBLE_EQ(1e9, util::robustRange({a}, 0.0).y);
+
+    EXPECT_THROW(util::robustRange({a}, 0.5), RangeException);
+    EXPECT_THROW(util::robustRange({util::QuantileSketch{}}), Exception);
+}
+
+}  // namespace inviwo
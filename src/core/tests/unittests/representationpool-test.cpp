@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/representationpool.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+namespace inviwo {
+
+TEST(RepresentationPool, Reuse) {
+    RepresentationPool pool{1024 * 1024};
+
+    auto a = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    auto b = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    EXPECT_NE(a.get(), b.get());
+
+    const auto* ptr = a.get();
+    a.reset();
+    auto c = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    EXPECT_EQ(ptr, c.get());
+
+    // Different type or dimensions are never reused
+    c.reset();
+    auto d = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 4});
+    auto e = pool.get<VolumeRAMPrecision<int>>(size3_t{8, 8, 8});
+    EXPECT_NE(ptr, d.get());
+
+    const auto stats = pool.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(4u, stats.misses);
+    EXPECT_EQ(sizeof(float) * 512 * 2 + sizeof(float) * 256 + sizeof(int) * 512, stats.bytesHeld);
+    EXPECT_EQ(sizeof(float) * 512, stats.bytesIdle);
+}
+
+TEST(RepresentationPool, ResetOnReuse) {
+    RepresentationPool pool{1024 * 1024};
+
+    auto a = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    a->setValid(false);
+    a->markModified(size3_t{0}, size3_t{4});
+    const auto* ptr = a.get();
+    a.reset();
+
+    auto b = pool.get<VolumeRAMPrecision<float>>(size3_t{8, 8, 8});
+    ASSERT_EQ(ptr, b.get());
+    EXPECT_TRUE(b->isValid());
+    EXPECT_EQ(nullptr, b->getOwner());
+    EXPECT_EQ(0u, b->getModificationVersion());
+    EXPECT_TRUE(b->getModifiedBricks(0).empty());
+}
+
+TEST(RepresentationPool, Budget) {
+    RepresentationPool pool{sizeof(double) * 1000 * 2};
+
+    auto a = pool.get<BufferRAMPrecision<double>>(size_t{1000});
+    auto b = pool.get<BufferRAMPrecision<double>>(size_t{1000});
+    a.reset();
+    b.reset();
+    // Over budget, the least recently used idle buffer is evicted
+    auto c = pool.get<BufferRAMPrecision<double>>(size_t{500});
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_EQ(sizeof(double) * 1500, stats.bytesHeld);
+    EXPECT_EQ(sizeof(double) * 2500, stats.highWaterMark);
+
+    pool.clear();
+    stats = pool.getStats();
+    EXPECT_EQ(sizeof(double) * 500, stats.bytesHeld);
+
+    // A budget of zero disables pooling
+    c.reset();
+    pool.setBudget(0);
+    EXPECT_EQ(0u, pool.getStats().bytesHeld);
+    auto d = pool.get<BufferRAMPrecision<double>>(size_t{500});
+    EXPECT_EQ(0u, pool.getStats().bytesHeld);
+}
+
+}  // namespace inviwo
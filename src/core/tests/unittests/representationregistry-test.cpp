@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/representationregistry.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<const void*> evicted;
+const void* pinned = nullptr;
+
+bool evictUnlessPinned(const void*, const void* repr) {
+    if (repr == pinned) return false;
+    evicted.push_back(repr);
+    return true;
+}
+
+class CountingLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    explicit CountingLoader(int* loads) : loads_{loads} {}
+    virtual CountingLoader* clone() const override { return new CountingLoader(*this); }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        ++*loads_;
+        return std::make_shared<VolumeRAMPrecision<float>>(src.getDimensions());
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {
+        ++*loads_;
+    }
+
+private:
+    int* loads_;
+};
+
+}  // namespace
+
+TEST(RepresentationRegistry, Accounting) {
+    RepresentationRegistry registry;
+    int owner = 0;
+    int a = 0;
+    int b = 0;
+    {
+        RepresentationRegistry::Scope scope{"processor"};
+        registry.add(&owner, evictUnlessPinned, &a, typeid(int), 100);
+    }
+    registry.add(&owner, evictUnlessPinned, &b, typeid(float), 50);
+    EXPECT_EQ(150u, registry.getTotalBytes());
+
+    // Adding again only updates the size
+    registry.add(&owner, evictUnlessPinned, &b, typeid(float), 60);
+    registry.touch(&owner, &a, 200);
+    EXPECT_EQ(260u, registry.getTotalBytes());
+
+    // Touching does not add representations
+    int c = 0;
+    registry.touch(&owner, &c, 10);
+    EXPECT_EQ(260u, registry.getTotalBytes());
+
+    const auto stats = registry.getStats();
+    EXPECT_EQ(2u, stats.total.count);
+    EXPECT_EQ(200u, stats.kinds.at("int").bytes);
+    EXPECT_EQ(200u, stats.processors.at("processor").bytes);
+    EXPECT_EQ(60u, stats.processors.at("").bytes);
+
+    registry.remove(&owner, &a);
+    EXPECT_EQ(60u, registry.getTotalBytes());
+    registry.removeOwner(&owner);
+    EXPECT_EQ(0u, registry.getTotalBytes());
+}
+
+TEST(RepresentationRegistry, Budget) {
+    RepresentationRegistry registry;
+    int owner = 0;
+    int a = 0;
+    int b = 0;
+    int c = 0;
+    registry.add(&owner, evictUnlessPinned, &a, typeid(int), 100);
+    registry.add(&owner, evictUnlessPinned, &b, typeid(int), 100);
+    registry.add(&owner, evictUnlessPinned, &c, typeid(int), 100);
+    registry.touch(&owner, &a, 100);
+
+    // A budget of zero disables eviction
+    evicted.clear();
+    EXPECT_EQ(0u, registry.enforceBudget());
+
+    // Least recently used first, skipping the ones that can not be evicted
+    pinned = &b;
+    registry.setBudget(150);
+    EXPECT_EQ(200u, registry.enforceBudget());
+    EXPECT_EQ((std::vector<const void*>{&c, &a}), evicted);
+    EXPECT_EQ(100u, registry.getTotalBytes());
+
+    const auto stats = registry.getStats();
+    EXPECT_EQ(2u, stats.evictions);
+    EXPECT_EQ(200u, stats.evictedBytes);
+    pinned = nullptr;
+
+    // Owners without an evict function are only accounted for
+    int other = 0;
+    registry.add(&other, nullptr, &a, typeid(int), 100);
+    evicted.clear();
+    registry.setBudget(50);
+    EXPECT_EQ(100u, registry.enforceBudget());
+    EXPECT_EQ((std::vector<const void*>{&b}), evicted);
+    EXPECT_EQ(100u, registry.getTotalBytes());
+}
+
+TEST(RepresentationRegistry, RegenerateFromDisk) {
+    auto registry = util::getRepresentationRegistry();
+    ASSERT_NE(nullptr, registry);
+    const auto budget = registry->getBudget();
+
+    int loads = 0;
+    auto disk = std::make_shared<VolumeDisk>(size3_t{8, 8, 8}, DataFloat32::get());
+    disk->setLoader(new CountingLoader(&loads));
+    Volume volume(disk);
+    volume.getRepresentation<VolumeRAM>();
+    EXPECT_EQ(1, loads);
+
+    registry->setBudget(1);
+    EXPECT_GE(registry->enforceBudget(), sizeof(float) * 512);
+    EXPECT_FALSE(volume.hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE(volume.hasRepresentation<VolumeDisk>());
+
+    // Representations referenced outside of the volume are kept
+    auto ram = volume.getRepresentationShared<VolumeRAM>();
+    EXPECT_EQ(2, loads);
+    registry->enforceBudget();
+    EXPECT_TRUE(volume.hasRepresentation<VolumeRAM>());
+
+    registry->setBudget(budget);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,139 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Occupies the single worker of a pool until released
+struct Blocker {
+    Blocker(ThreadPool& pool) {
+        auto gate = release.get_future().share();
+        pool.enqueueRaw([this, gate]() {
+            started.set_value();
+            gate.wait();
+        });
+        started.get_future().wait();
+    }
+    std::promise<void> started;
+    std::promise<void> release;
+};
+
+}  // namespace
+
+TEST(ThreadPool, PriorityOrder) {
+    ThreadPool pool(1);
+    Blocker blocker(pool);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    const auto add = [&](int i) {
+        std::scoped_lock lock{mutex};
+        order.push_back(i);
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.push_back(pool.enqueue(ThreadPool::Priority::Background, add, 3));
+    futures.push_back(pool.enqueue(ThreadPool::Priority::Normal, add, 2));
+    futures.push_back(pool.enqueue(ThreadPool::Priority::Interactive, add, 1));
+    EXPECT_EQ(pool.getQueueSize(), 3);
+    EXPECT_EQ(pool.getStats(ThreadPool::Priority::Background).queued, 1);
+
+    blocker.release.set_value();
+    for (auto& future : futures) future.get();
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(ThreadPool, InheritPriority) {
+    ThreadPool pool(2);
+    auto future = pool.enqueue(ThreadPool::Priority::Background, [&]() {
+        return pool.enqueue([]() { return ThreadPool::currentPriority(); }).get();
+    });
+    EXPECT_EQ(future.get(), ThreadPool::Priority::Background);
+
+    ThreadPool::PriorityScope scope{ThreadPool::Priority::Interactive};
+    EXPECT_EQ(ThreadPool::currentPriority(), ThreadPool::Priority::Interactive);
+}
+
+TEST(ThreadPool, ConcurrencyLimit) {
+    ThreadPool pool(4);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    const int owner = 0;
+
+    std::vector<std::promise<void>> done(8);
+    for (auto& promise : done) {
+        pool.enqueueRaw(
+            [&]() {
+                const int current = ++running;
+                int max = maxRunning;
+                while (current > max && !maxRunning.compare_exchange_weak(max, current)) {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                --running;
+                promise.set_value();
+            },
+            ThreadPool::TaskInfo{ThreadPool::Priority::Normal, &owner, 2});
+    }
+    for (auto& promise : done) promise.get_future().wait();
+    EXPECT_LE(maxRunning.load(), 2);
+}
+
+TEST(ThreadPool, PreemptBackground) {
+    ThreadPool pool(1);
+    std::atomic<bool> stop{false};
+    std::promise<void> started;
+    pool.enqueueRaw(
+        [&]() {
+            started.set_value();
+            while (!stop) std::this_thread::yield();
+        },
+        ThreadPool::TaskInfo{ThreadPool::Priority::Background, nullptr, 0,
+                             [&]() { stop = true; }});
+    started.get_future().wait();
+
+    auto future = pool.enqueue(ThreadPool::Priority::Interactive, []() { return 1; });
+    EXPECT_EQ(future.get(), 1);
+    EXPECT_EQ(pool.getStats(ThreadPool::Priority::Background).preempted, 1);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/volumeutils.h>
+#include <inviwo/testutil/tempdirectory.h>
+
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+const size3_t dims{4, 5, 6};
+constexpr size_t header = 16;
+
+struct VolumeRegionTest : ::testing::Test {
+    VolumeRegionTest() : rawFile{tmp.string() + "/volume.raw"} {
+        std::vector<unsigned short> data(dims.x * dims.y * dims.z);
+        std::iota(data.begin(), data.end(), static_cast<unsigned short>(0));
+        auto out = filesystem::ofstream(rawFile, std::ios::binary);
+        const std::vector<char> skip(header, 'x');
+        out.write(skip.data(), skip.size());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(data[0]));
+    }
+
+    std::shared_ptr<Volume> makeDiskVolume() const {
+        auto disk = std::make_shared<VolumeDisk>(rawFile, dims, DataUInt16::get());
+        disk->setLoader(new RawVolumeRAMLoader(rawFile, header, true));
+        return std::make_shared<Volume>(disk);
+    }
+
+    static std::shared_ptr<Volume> makeRAMVolume() {
+        auto ram = std::make_shared<VolumeRAMPrecision<unsigned short>>(dims);
+        auto data = ram->getDataTyped();
+        std::iota(data, data + dims.x * dims.y * dims.z, static_cast<unsigned short>(0));
+        return std::make_shared<Volume>(ram);
+    }
+
+    static void expectRegion(const VolumeRAM& ram, const DiskRegion& region) {
+        const auto out = region.getOutputDimensions();
+        ASSERT_EQ(out, ram.getDimensions());
+        const auto* data = static_cast<const unsigned short*>(ram.getData());
+        for (size_t z = 0; z < out.z; ++z) {
+            for (size_t y = 0; y < out.y; ++y) {
+                for (size_t x = 0; x < out.x; ++x) {
+                    const auto pos = region.offset + size3_t{x, y, z} * region.stride;
+                    EXPECT_EQ(pos.x + dims.x * (pos.y + dims.y * pos.z), *data++);
+                }
+            }
+        }
+    }
+
+    TempDirectory tmp;
+    std::string rawFile;
+};
+
+}  // namespace
+
+TEST(DiskRegionTest, OutputDimensions) {
+    const DiskRegion region{size3_t{1, 0, 2}, size3_t{4, 5, 3}, size3_t{2, 1, 3}};
+    EXPECT_EQ(size3_t(2, 5, 1), region.getOutputDimensions());
+    EXPECT_TRUE(region.isValidFor(size3_t{5, 5, 5}));
+    EXPECT_FALSE(region.isValidFor(size3_t{4, 5, 5}));
+    EXPECT_FALSE((DiskRegion{size3_t{0}, size3_t{1, 0, 1}}.isValidFor(size3_t{5, 5, 5})));
+}
+
+TEST_F(VolumeRegionTest, ReadFromDisk) {
+    const auto volume = makeDiskVolume();
+    EXPECT_TRUE(util::canReadVolumeRegion(*volume));
+
+    const DiskRegion region{size3_t{1, 2, 1}, size3_t{3, 3, 4}, size3_t{2, 1, 3}};
+    const auto ram = util::readVolumeRegion(*volume, region);
+    ASSERT_TRUE(ram);
+    expectRegion(*ram, region);
+    EXPECT_EQ(wrapping3d::clampAll, ram->getWrapping());
+
+    // Reading a region does not load the whole volume
+    EXPECT_FALSE(volume->hasValidRepresentation<VolumeRAM>());
+    EXPECT_TRUE(util::canReadVolumeRegion(*volume));
+}
+
+TEST_F(VolumeRegionTest, ReadFromRAM) {
+    const auto volume = makeRAMVolume();
+    EXPECT_FALSE(util::canReadVolumeRegion(*volume));
+
+    const DiskRegion region{size3_t{0, 1, 5}, size3_t{4, 4, 1}, size3_t{3, 2, 1}};
+    const auto ram = util::readVolumeRegion(*volume, region);
+    ASSERT_TRUE(ram);
+    expectRegion(*ram, region);
+}
+
+TEST_F(VolumeRegionTest, SameResultFromDiskAndRAM) {
+    const DiskRegion region{size3_t{0, 0, 3}, size3_t{4, 5, 1}};
+    const auto fromDisk = util::readVolumeRegion(*makeDiskVolume(), region);
+    const auto fromRAM = util::readVolumeRegion(*makeRAMVolume(), region);
+    expectRegion(*fromDisk, region);
+    expectRegion(*fromRAM, region);
+}
+
+TEST_F(VolumeRegionTest, InvalidRegionThrows) {
+    const auto volume = makeDiskVolume();
+    EXPECT_THROW(util::readVolumeRegion(*volume, DiskRegion{size3_t{2}, size3_t{3}}), Exception);
+    EXPECT_THROW(util::readVolumeRegion(*volume, DiskRegion{size3_t{0}, size3_t{0}}), Exception);
+}
+
+}  // namespace inviwo
@@ -69,7 +69,11 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     , helpQuiet_("h", "help", "")
     , versionQuiet_("v", "version", "")
     , disableResourceManager_("", "no-resource-manager",
-                              "Pass this flag to disable the resource manager") {
+                              "Pass this flag to disable the resource manager")
+    , lazyModules_("", "lazy-modules",
+                   "Only construct modules when their processors, readers or writers are first "
+                   "requested, using a manifest cached from previous runs")
+    , startupTiming_("", "startup-timing", "Log the time spent registering each module") {
     cmdQuiet_.add(workspace_);
     cmdQuiet_.add(outputPath_);
     cmdQuiet_.add(quitAfterStartup_);
@@ -79,6 +83,8 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmdQuiet_.add(helpQuiet_);
     cmdQuiet_.add(versionQuiet_);
     cmdQuiet_.add(disableResourceManager_);
+    cmdQuiet_.add(lazyModules_);
+    cmdQuiet_.add(startupTiming_);
     cmdQuiet_.add(wildcard_);
 
     cmd_.add(workspace_);
@@ -88,6 +94,8 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmd_.add(logfile_);
     cmd_.add(logConsole_);
     cmd_.add(disableResourceManager_);
+    cmd_.add(lazyModules_);
+    cmd_.add(startupTiming_);
 
     parse(Mode::Quiet);
 }
@@ -186,6 +194,10 @@ bool CommandLineParser::getDisableResourceManager() const {
     return disableResourceManager_.isSet();
 }
 
+bool CommandLineParser::getLazyModuleRegistration() const { return lazyModules_.isSet(); }
+
+bool CommandLineParser::getLogStartupTiming() const { return startupTiming_.isSet(); }
+
 int CommandLineParser::getARGC() const { return argc_; }
 
 char** CommandLineParser::getARGV() const { return argv_; }
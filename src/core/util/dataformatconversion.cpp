@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/dataformatconversion.h>
+
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/sourcecontext.h>
+
+#include <fmt/format.h>
+
+namespace inviwo {
+
+namespace {
+
+template <size_t N>
+struct WithComponents {
+    template <typename Format>
+    struct Filter : std::integral_constant<bool, Format::comp == N> {};
+};
+
+void checkComponents(const DataFormatBase* src, const DataFormatBase* dst) {
+    if (src->getComponents() != dst->getComponents()) {
+        throw Exception(fmt::format("Can not convert {} to {}, the number of components differ",
+                                    src->getString(), dst->getString()),
+                        IVW_CONTEXT_CUSTOM("util::convert"));
+    }
+}
+
+/**
+ * Dispatches over the source and the destination, the destination only over the formats with
+ * the same number of components as the source.
+ */
+template <typename Repr>
+void convert(const Repr& src, Repr& dst, size_t count, std::optional<util::LinearMap> map) {
+    src.template dispatch<void>([&](const auto* srcTyped) {
+        using S = util::PrecisionValueType<decltype(srcTyped)>;
+        dst.template dispatch<void, WithComponents<util::extent_v<S>>::template Filter>(
+            [&](auto* dstTyped) {
+                util::convertValuesParallel(srcTyped->getDataTyped(), dstTyped->getDataTyped(),
+                                            count, map);
+            });
+    });
+}
+
+}  // namespace
+
+std::shared_ptr<VolumeRAM> util::convertVolumeRAM(const VolumeRAM& src,
+                                                  const DataFormatBase* format,
+                                                  std::optional<LinearMap> map) {
+    checkComponents(src.getDataFormat(), format);
+    const auto dims = src.getDimensions();
+    auto dst = createVolumeRAM(dims, format, nullptr, src.getSwizzleMask(),
+                               src.getInterpolation(), src.getWrapping());
+    convert(src, *dst, dims.x * dims.y * dims.z, map);
+    return dst;
+}
+
+std::shared_ptr<LayerRAM> util::convertLayerRAM(const LayerRAM& src, const DataFormatBase* format,
+                                                std::optional<LinearMap> map) {
+    checkComponents(src.getDataFormat(), format);
+    const auto dims = src.getDimensions();
+    auto dst = createLayerRAM(dims, src.getLayerType(), format, src.getSwizzleMask(),
+                              src.getInterpolation(), src.getWrapping());
+    convert(src, *dst, dims.x * dims.y, map);
+    return dst;
+}
+
+std::shared_ptr<BufferRAM> util::convertBufferRAM(const BufferRAM& src,
+                                                  const DataFormatBase* format,
+                                                  std::optional<LinearMap> map) {
+    checkComponents(src.getDataFormat(), format);
+    auto dst =
+        createBufferRAM(src.getSize(), format, src.getBufferUsage(), src.getBufferTarget());
+    convert(src, *dst, src.getSize(), map);
+    return dst;
+}
+
+}  // namespace inviwo
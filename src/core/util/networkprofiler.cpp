@@ -0,0 +1,342 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/networkprofiler.h>
+
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/zip.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+double ms(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+std::string jsonString(std::string_view str) {
+    std::string res = "\"";
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                res += "\\\"";
+                break;
+            case '\\':
+                res += "\\\\";
+                break;
+            case '\n':
+                res += "\\n";
+                break;
+            case '\t':
+                res += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    res += fmt::format("\\u{:04x}", static_cast<int>(c));
+                } else {
+                    res += c;
+                }
+        }
+    }
+    res += '"';
+    return res;
+}
+
+std::string csvString(std::string_view str) {
+    std::string res = "\"";
+    for (const char c : str) {
+        if (c == '"') res += '"';
+        res += c;
+    }
+    res += '"';
+    return res;
+}
+
+std::string jsonMeasurement(const NetworkProfiler::Measurement& m) {
+    return fmt::format(
+        R"({{"calls": {}, "time_ms": {}, "allocations": {}, "allocated_bytes": {}, )"
+        R"("peak_bytes": {}}})",
+        m.calls, ms(m.time), m.allocations, m.allocatedBytes, m.peakBytes);
+}
+
+}  // namespace
+
+NetworkProfiler::NetworkProfiler(ProcessorNetwork* network, ProcessorNetworkEvaluator* evaluator,
+                                 MemorySource memory)
+    : network_{network}, evaluator_{evaluator}, memory_{std::move(memory)} {
+
+    network_->addObserver(this);
+    evaluator_->addObserver(this);
+    network_->forEachProcessor([&](Processor* p) { p->ProcessorObservable::addObserver(this); });
+}
+
+NetworkProfiler::~NetworkProfiler() {
+    network_->forEachProcessor(
+        [&](Processor* p) { p->ProcessorObservable::removeObserver(this); });
+    evaluator_->removeObserver(this);
+    network_->removeObserver(this);
+}
+
+void NetworkProfiler::beginRun(std::string_view label) {
+    if (running_) endRun();
+
+    runs_.emplace_back().label = label;
+    running_ = true;
+    recordIndex_.clear();
+    backgroundJobs_.clear();
+    backgroundStart_.clear();
+    if (memory_) {
+        runs_.back().peakBytes = sampleAndReset().liveBytes;
+    }
+    runStart_ = Clock::clock::now();
+}
+
+void NetworkProfiler::endRun() {
+    if (!running_) return;
+
+    const auto now = Clock::clock::now();
+    auto& run = runs_.back();
+    run.time = now - runStart_;
+    for (const auto& [p, start] : backgroundStart_) record(p).background += now - start;
+    if (memory_) run.peakBytes = std::max(run.peakBytes, memory_.sample().peakBytes);
+
+    running_ = false;
+    recordIndex_.clear();
+    backgroundJobs_.clear();
+    backgroundStart_.clear();
+    active_.clear();
+}
+
+bool NetworkProfiler::isRunning() const { return running_; }
+
+const std::vector<NetworkProfiler::Run>& NetworkProfiler::getRuns() const { return runs_; }
+
+void NetworkProfiler::clear() {
+    endRun();
+    runs_.clear();
+}
+
+void NetworkProfiler::onProcessorNetworkDidAddProcessor(Processor* p) {
+    p->ProcessorObservable::addObserver(this);
+}
+
+void NetworkProfiler::onProcessorNetworkWillRemoveProcessor(Processor* p) {
+    p->ProcessorObservable::removeObserver(this);
+    // The pointer might be reused by a new processor
+    recordIndex_.erase(p);
+    backgroundJobs_.erase(p);
+    backgroundStart_.erase(p);
+    util::erase_remove_if(active_, [p](const Active& active) { return active.processor == p; });
+}
+
+void NetworkProfiler::onProcessorBackgroundJobsChanged(Processor* p, int diff, int) {
+    if (!running_) return;
+
+    // A processor counts as busy from its first job being started to its last one finishing
+    auto& jobs = backgroundJobs_[p];
+    if (jobs <= 0 && diff > 0) backgroundStart_[p] = Clock::clock::now();
+    jobs += diff;
+    if (jobs <= 0) {
+        if (auto it = backgroundStart_.find(p); it != backgroundStart_.end()) {
+            record(p).background += Clock::clock::now() - it->second;
+            backgroundStart_.erase(it);
+        }
+        backgroundJobs_.erase(p);
+    }
+}
+
+void NetworkProfiler::onProcessorNetworkEvaluationBegin() {
+    if (running_) ++runs_.back().evaluations;
+}
+
+void NetworkProfiler::onProcessorAboutToInitializeResources(Processor* p) { start(p); }
+
+void NetworkProfiler::onProcessorFinishedInitializeResources(Processor* p) {
+    finish(p, &ProcessorRecord::initializeResources);
+}
+
+void NetworkProfiler::onProcessorAboutToProcess(Processor* p) { start(p); }
+
+void NetworkProfiler::onProcessorFinishedProcess(Processor* p) {
+    finish(p, &ProcessorRecord::process);
+}
+
+NetworkProfiler::ProcessorRecord& NetworkProfiler::record(Processor* p) {
+    auto& processors = runs_.back().processors;
+    auto [it, inserted] = recordIndex_.try_emplace(p, processors.size());
+    if (inserted) {
+        auto& rec = processors.emplace_back();
+        rec.identifier = p->getIdentifier();
+        rec.classIdentifier = p->getClassIdentifier();
+    }
+    return processors[it->second];
+}
+
+void NetworkProfiler::start(Processor* p) {
+    if (!running_) return;
+    record(p);
+    MemoryCounters counters;
+    if (memory_) counters = sampleAndReset();
+    // Calls can nest, e.g. a processor evaluating the network from within process
+    active_.push_back(Active{p, Clock::clock::now(), counters});
+}
+
+void NetworkProfiler::finish(Processor* p, Measurement ProcessorRecord::*measurement) {
+    const auto end = Clock::clock::now();
+    if (!running_) return;
+    const auto it = std::find_if(active_.rbegin(), active_.rend(),
+                                 [p](const Active& active) { return active.processor == p; });
+    if (it == active_.rend()) return;
+    const auto active = *it;
+    // Also drop nested calls that never finished
+    active_.erase(std::next(it).base(), active_.end());
+
+    // The measurements of a call include its nested calls
+    auto& m = record(p).*measurement;
+    ++m.calls;
+    m.time += end - active.start;
+    if (memory_) {
+        const auto counters = memory_.sample();
+        const auto& before = active.counters;
+        m.allocations += counters.allocations - before.allocations;
+        m.allocatedBytes += counters.allocatedBytes - before.allocatedBytes;
+        const auto peak = std::max(counters.peakBytes, active.peakBytes);
+        if (peak > before.liveBytes) {
+            m.peakBytes = std::max(m.peakBytes, peak - before.liveBytes);
+        }
+        auto& run = runs_.back();
+        run.peakBytes = std::max(run.peakBytes, counters.peakBytes);
+    }
+}
+
+NetworkProfiler::MemoryCounters NetworkProfiler::sampleAndReset() {
+    // Fold the peak since the last reset into the run before it is lost
+    const auto peak = memory_.sample().peakBytes;
+    auto& run = runs_.back();
+    run.peakBytes = std::max(run.peakBytes, peak);
+    for (auto& active : active_) active.peakBytes = std::max(active.peakBytes, peak);
+    memory_.resetPeak();
+    return memory_.sample();
+}
+
+void NetworkProfiler::writeJSON(
+    std::ostream& os, const std::vector<std::pair<std::string, std::string>>& context) const {
+    os << "{\n  \"context\": {";
+    for (auto&& [i, item] : util::enumerate(context)) {
+        os << (i == 0 ? "\n" : ",\n") << "    " << jsonString(item.first) << ": "
+           << jsonString(item.second);
+    }
+    os << (context.empty() ? "},\n" : "\n  },\n");
+
+    os << "  \"runs\": [";
+    for (auto&& [i, run] : util::enumerate(runs_)) {
+        os << (i == 0 ? "\n" : ",\n");
+        os << fmt::format(
+            "    {{\"label\": {}, \"time_ms\": {}, \"evaluations\": {}, \"peak_bytes\": {}, "
+            "\"processors\": [",
+            jsonString(run.label), ms(run.time), run.evaluations, run.peakBytes);
+        for (auto&& [j, rec] : util::enumerate(run.processors)) {
+            os << (j == 0 ? "\n" : ",\n");
+            os << fmt::format(
+                "      {{\"identifier\": {}, \"class\": {}, \"initialize_resources\": {}, "
+                "\"process\": {}, \"background_ms\": {}}}",
+                jsonString(rec.identifier), jsonString(rec.classIdentifier),
+                jsonMeasurement(rec.initializeResources), jsonMeasurement(rec.process),
+                ms(rec.background));
+        }
+        os << (run.processors.empty() ? "]}" : "\n    ]}");
+    }
+    os << (runs_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+void NetworkProfiler::writeCSV(std::ostream& os) const {
+    os << "name,iterations,real_time,time_unit,init_time,background_time,allocations,"
+          "allocated_bytes,peak_bytes,label\n";
+    for (auto&& [i, run] : util::enumerate(runs_)) {
+        os << fmt::format("{},{},{},ms,,,,,{},{}\n", csvString(fmt::format("network/{}", i)),
+                          run.evaluations, ms(run.time), run.peakBytes, csvString(run.label));
+        for (const auto& rec : run.processors) {
+            const auto& init = rec.initializeResources;
+            const auto& proc = rec.process;
+            os << fmt::format("{},{},{},ms,{},{},{},{},{},{}\n",
+                              csvString(fmt::format("{}/{}", rec.identifier, i)), proc.calls,
+                              ms(proc.time), ms(init.time), ms(rec.background),
+                              init.allocations + proc.allocations,
+                              init.allocatedBytes + proc.allocatedBytes,
+                              std::max(init.peakBytes, proc.peakBytes), csvString(run.label));
+        }
+    }
+}
+
+void NetworkProfiler::writeSummary(std::ostream& os) const {
+    struct Total {
+        std::string_view identifier;
+        size_t runs = 0;
+        Clock::duration process{0};
+        Clock::duration maxProcess{0};
+        Clock::duration init{0};
+        Clock::duration background{0};
+    };
+    std::vector<Total> totals;
+    std::unordered_map<std::string_view, size_t> index;
+    for (const auto& run : runs_) {
+        for (const auto& rec : run.processors) {
+            auto [it, inserted] = index.try_emplace(rec.identifier, totals.size());
+            if (inserted) totals.push_back(Total{rec.identifier});
+            auto& t = totals[it->second];
+            ++t.runs;
+            t.process += rec.process.time;
+            t.maxProcess = std::max(t.maxProcess, rec.process.time);
+            t.init += rec.initializeResources.time;
+            t.background += rec.background;
+        }
+    }
+    std::stable_sort(totals.begin(), totals.end(), [](const Total& a, const Total& b) {
+        return a.process + a.init > b.process + b.init;
+    });
+
+    os << fmt::format("{:40} {:>6} {:>12} {:>12} {:>12} {:>12}\n", "Processor", "Runs",
+                      "Process (ms)", "Max (ms)", "Init (ms)", "Bkgnd (ms)");
+    for (const auto& t : totals) {
+        const auto n = static_cast<double>(t.runs);
+        os << fmt::format("{:40} {:>6} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n", t.identifier,
+                          t.runs, ms(t.process) / n, ms(t.maxProcess), ms(t.init) / n,
+                          ms(t.background) / n);
+    }
+}
+
+}  // namespace inviwo
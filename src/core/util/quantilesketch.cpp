@@ -0,0 +1,258 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/quantilesketch.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/glmcomp.h>
+#include <inviwo/core/util/glmutils.h>
+#include <inviwo/core/util/sourcecontext.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace util {
+
+QuantileSketch::QuantileSketch(size_t k) : k_{std::max<size_t>(k, 8)}, levels_(1), offsets_(1) {}
+
+size_t QuantileSketch::capacity(size_t level) const {
+    constexpr double c = 2.0 / 3.0;
+    const auto depth = static_cast<double>(levels_.size() - 1 - level);
+    return std::max<size_t>(2, static_cast<size_t>(std::ceil(k_ * std::pow(c, depth))));
+}
+
+size_t QuantileSketch::size() const {
+    size_t size = 0;
+    for (const auto& level : levels_) size += level.size();
+    return size;
+}
+
+void QuantileSketch::add(double value) {
+    if (std::isnan(value)) return;
+
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    ++count_;
+
+    levels_[0].push_back(value);
+    if (levels_[0].size() >= capacity(0)) compress();
+}
+
+void QuantileSketch::compress() {
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        if (levels_[h].size() < capacity(h)) continue;
+
+        if (h + 1 == levels_.size()) {
+            levels_.emplace_back();
+            offsets_.push_back(false);
+        }
+
+        auto& level = levels_[h];
+        std::sort(level.begin(), level.end());
+
+        // With an odd number of items one is left behind to keep the total weight.
+        const bool odd = level.size() % 2 == 1;
+        const double leftover = odd ? level.back() : 0.0;
+        const size_t pairs = level.size() / 2;
+
+        auto& next = levels_[h + 1];
+        const size_t offset = offsets_[h] ? 1 : 0;
+        offsets_[h] = !offsets_[h];
+        for (size_t i = 0; i < pairs; ++i) {
+            next.push_back(level[2 * i + offset]);
+        }
+
+        level.clear();
+        if (odd) level.push_back(leftover);
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.empty()) return;
+
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+
+    if (levels_.size() < other.levels_.size()) {
+        levels_.resize(other.levels_.size());
+        offsets_.resize(other.levels_.size(), false);
+    }
+    for (size_t h = 0; h < other.levels_.size(); ++h) {
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    compress();
+}
+
+std::vector<std::pair<double, uint64_t>> QuantileSketch::weighted() const {
+    std::vector<std::pair<double, uint64_t>> items;
+    items.reserve(size());
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        const uint64_t weight = uint64_t{1} << h;
+        for (auto value : levels_[h]) items.emplace_back(value, weight);
+    }
+    std::sort(items.begin(), items.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    return items;
+}
+
+double QuantileSketch::quantile(double q) const { return quantiles({q}).front(); }
+
+std::vector<double> QuantileSketch::quantiles(const std::vector<double>& qs) const {
+    for (auto q : qs) {
+        if (q < 0.0 || q > 1.0) {
+            throw RangeException("Quantile must be between 0 and 1",
+                                 IVW_CONTEXT_CUSTOM("QuantileSketch::quantiles"));
+        }
+    }
+    std::vector<double> result(qs.size(), std::numeric_limits<double>::quiet_NaN());
+    if (empty()) return result;
+
+    const auto items = weighted();
+    uint64_t total = 0;
+    for (const auto& item : items) total += item.second;
+
+    std::vector<size_t> order(qs.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return qs[a] < qs[b]; });
+
+    uint64_t accumulated = 0;
+    size_t i = 0;
+    for (auto o : order) {
+        const auto q = qs[o];
+        if (q == 0.0) {
+            result[o] = min_;
+            continue;
+        } else if (q == 1.0) {
+            result[o] = max_;
+            continue;
+        }
+        const auto target = q * static_cast<double>(total);
+        while (i < items.size() && static_cast<double>(accumulated + items[i].second) < target) {
+            accumulated += items[i].second;
+            ++i;
+        }
+        result[o] = i < items.size() ? items[i].first : max_;
+    }
+    return result;
+}
+
+double QuantileSketch::rank(double value) const {
+    if (empty()) return 0.0;
+    uint64_t below = 0;
+    uint64_t total = 0;
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        const uint64_t weight = uint64_t{1} << h;
+        for (auto v : levels_[h]) {
+            total += weight;
+            if (v <= value) below += weight;
+        }
+    }
+    return static_cast<double>(below) / static_cast<double>(total);
+}
+
+namespace {
+
+template <typename T>
+std::vector<QuantileSketch> sketchParallel(const T* data, size_t size, size_t k) {
+    constexpr size_t extent = util::extent<T>::value;
+    constexpr size_t chunkSize = 1 << 16;
+
+    const size_t numChunks = (size + chunkSize - 1) / chunkSize;
+    std::vector<std::vector<QuantileSketch>> chunks(
+        numChunks, std::vector<QuantileSketch>(extent, QuantileSketch{k}));
+
+    util::forEachIndexParallel(numChunks, [&](size_t chunk) {
+        auto& sketches = chunks[chunk];
+        const auto end = std::min(size, (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; ++i) {
+            for (size_t c = 0; c < extent; ++c) {
+                sketches[c].add(static_cast<double>(util::glmcomp(data[i], c)));
+            }
+        }
+    });
+
+    std::vector<QuantileSketch> result(extent, QuantileSketch{k});
+    for (const auto& sketches : chunks) {
+        for (size_t c = 0; c < extent; ++c) {
+            result[c].merge(sketches[c]);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+std::vector<QuantileSketch> quantileSketches(const VolumeRAM& volume, size_t k) {
+    return volume.dispatch<std::vector<QuantileSketch>>([k](auto vr) {
+        return sketchParallel(vr->getDataTyped(), glm::compMul(vr->getDimensions()), k);
+    });
+}
+
+std::vector<QuantileSketch> quantileSketches(const LayerRAM& layer, size_t k) {
+    return layer.dispatch<std::vector<QuantileSketch>>([k](auto lr) {
+        return sketchParallel(lr->getDataTyped(), glm::compMul(lr->getDimensions()), k);
+    });
+}
+
+std::vector<QuantileSketch> quantileSketches(const BufferRAM& buffer, size_t k) {
+    return buffer.dispatch<std::vector<QuantileSketch>>(
+        [k](auto br) { return sketchParallel(br->getDataTyped(), br->getSize(), k); });
+}
+
+dvec2 robustRange(const std::vector<QuantileSketch>& sketches, double outlierFraction) {
+    if (outlierFraction < 0.0 || outlierFraction >= 0.5) {
+        throw RangeException("Outlier fraction must be in [0 0.5)",
+                             IVW_CONTEXT_CUSTOM("util::robustRange"));
+    }
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    for (const auto& sketch : sketches) {
+        if (sketch.empty()) continue;
+        const auto q = sketch.quantiles({outlierFraction, 1.0 - outlierFraction});
+        range.x = std::min(range.x, q[0]);
+        range.y = std::max(range.y, q[1]);
+    }
+    if (range.x > range.y) {
+        throw Exception("No values to compute a range from",
+                        IVW_CONTEXT_CUSTOM("util::robustRange"));
+    }
+    return range;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -29,6 +29,8 @@
 
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/algorithm/markdown.h>
+#include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/logstream.h>
 #include <inviwo/core/util/stringconversion.h>
 
@@ -53,6 +55,26 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , logStackTraceProperty_("logStackTraceProperty", "Error stack trace log", false)
     , runtimeModuleReloading_("runtimeModuleReloding", "Runtime Module Reloading", false)
     , enableResourceManager_("enableResourceManager", "Enable Resource Manager", false)
+    , representationPoolBudget_("representationPoolBudget", "Representation Pool Budget (MB)",
+                                "Memory the representation pool may hold for reuse of RAM "
+                                "representations, 0 disables the pool"_help,
+                                0, {0, ConstraintBehavior::Immutable},
+                                {65536, ConstraintBehavior::Ignore})
+    , representationMemoryBudget_(
+          "representationMemoryBudget", "Representation Memory Budget (MB)",
+          "Memory all data representations may use before representations that can be "
+          "regenerated, like RAM copies of volumes on disk, are released after network "
+          "evaluation, 0 disables the eviction"_help,
+          0, {0, ConstraintBehavior::Immutable}, {262144, ConstraintBehavior::Ignore})
+    , decodedVolumeCacheBudget_("decodedVolumeCacheBudget", "Decoded Volume Cache (MB)",
+                                "Disk space used to cache decoded data of compressed volume "
+                                "formats, like pvm and nii.gz, and meshes imported with "
+                                "Assimp, 0 disables the cache"_help,
+                                0, {0, ConstraintBehavior::Immutable},
+                                {262144, ConstraintBehavior::Ignore})
+    , decodedVolumeCacheDirectory_("decodedVolumeCacheDirectory", "Decoded Volume Cache Directory",
+                                   "A local directory for the decoded volume cache"_help,
+                                   filesystem::getInviwoUserSettingsPath() + "/cache/volumes")
     , breakOnMessage_{"breakOnMessage",
                       "Break on Message",
                       {MessageBreakLevel::Off, MessageBreakLevel::Error, MessageBreakLevel::Warn,
@@ -66,8 +88,10 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperties(workspaceAuthor_, maxNumRecentFiles_, poolSize_, enablePortInspectors_,
                   portInspectorSize_, enableTouchProperty_, enableGesturesProperty_,
                   enablePickingProperty_, enableSoundProperty_, logStackTraceProperty_,
-                  runtimeModuleReloading_, enableResourceManager_, breakOnMessage_,
-                  breakOnException_, stackTraceInException_, redirectCout_, redirectCerr_);
+                  runtimeModuleReloading_, enableResourceManager_, representationPoolBudget_,
+                  representationMemoryBudget_, decodedVolumeCacheBudget_,
+                  decodedVolumeCacheDirectory_, breakOnMessage_, breakOnException_,
+                  stackTraceInException_, redirectCout_, redirectCerr_);
 
     logStackTraceProperty_.onChange(
         [this]() { LogCentral::getPtr()->setLogStacktrace(logStackTraceProperty_.get()); });
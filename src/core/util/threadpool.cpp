@@ -32,8 +32,18 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/threadutil.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
+namespace {
+
+thread_local ThreadPool::Priority threadPriority = ThreadPool::Priority::Normal;
+
+constexpr size_t index(ThreadPool::Priority priority) { return static_cast<size_t>(priority); }
+
+}  // namespace
+
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
@@ -72,9 +82,26 @@ size_t ThreadPool::getSize() const { return workers.size(); }
 
 size_t ThreadPool::getQueueSize() {
     std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
+    size_t size = 0;
+    for (auto& queue : tasks) size += queue.size();
+    return size;
+}
+
+ThreadPool::Stats ThreadPool::getStats(Priority priority) {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    auto stats = stats_[index(priority)];
+    stats.queued = tasks[index(priority)].size();
+    return stats;
+}
+
+ThreadPool::Priority ThreadPool::currentPriority() { return threadPriority; }
+
+ThreadPool::PriorityScope::PriorityScope(Priority priority) : previous_{threadPriority} {
+    threadPriority = priority;
 }
 
+ThreadPool::PriorityScope::~PriorityScope() { threadPriority = previous_; }
+
 ThreadPool::~ThreadPool() {
     for (auto& worker : workers) worker->state = State::Abort;
     condition.notify_all();
@@ -89,35 +116,120 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
         pool.onThreadStart_();
         util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
 
+        // Only change between Free and Working, never overwrite a Stop or Abort request
+        const auto transition = [this](State from, State to) {
+            state.compare_exchange_strong(from, to);
+        };
+
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
+            Task task;
+            transition(State::Working, State::Free);
             {
                 std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
+                bool found = false;
+                pool.condition.wait(lock, [&] {
+                    if (state == State::Abort) return true;
+                    found = pool.takeTask(task);
+                    return found || (state == State::Stop && pool.empty());
                 });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
+                if (!found) break;
+                priority = task.info.priority;
+                preempt = std::move(task.info.preempt);
+                ++pool.busy_;
             }
-            state = State::Working;
+            transition(State::Free, State::Working);
+            threadPriority = task.info.priority;
             try {
-                task();
+                task.func();
             } catch (...) {  // Make sure we don't leak any exceptions.
             }
+            threadPriority = Priority::Normal;
+            pool.finishTask(*this, task);
         }
         state = State::Done;
     }} {}
 
+bool ThreadPool::takeTask(Task& task) {
+    for (auto& queue : tasks) {
+        const auto it = std::find_if(queue.begin(), queue.end(), [&](const Task& item) {
+            if (item.info.maxConcurrent == 0) return true;
+            const auto running = ownerRunning_.find(item.info.owner);
+            return running == ownerRunning_.end() || running->second < item.info.maxConcurrent;
+        });
+        if (it == queue.end()) continue;
+
+        task = std::move(*it);
+        queue.erase(it);
+
+        if (task.info.maxConcurrent != 0) ++ownerRunning_[task.info.owner];
+
+        auto& stats = stats_[index(task.info.priority)];
+        const std::chrono::duration<double> wait = Clock::now() - task.enqueued;
+        ++stats.running;
+        stats.totalWait += wait;
+        stats.maxWait = std::max(stats.maxWait, wait);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::finishTask(Worker& worker, const Task& task) {
+    bool releasedOwner = false;
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        --busy_;
+        worker.preempt = nullptr;
+        auto& stats = stats_[index(task.info.priority)];
+        --stats.running;
+        ++stats.completed;
+        if (task.info.maxConcurrent != 0) {
+            if (auto it = ownerRunning_.find(task.info.owner); it != ownerRunning_.end()) {
+                if (--it->second == 0) ownerRunning_.erase(it);
+                releasedOwner = true;
+            }
+        }
+    }
+    // Tasks of the owner might be waiting, while the other workers are asleep
+    if (releasedOwner) condition.notify_all();
+}
+
+bool ThreadPool::empty() const {
+    return std::all_of(tasks.begin(), tasks.end(), [](auto& queue) { return queue.empty(); });
+}
+
+void ThreadPool::push(Task task) {
+    std::function<void()> preempt;
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        const auto priority = task.info.priority;
+        tasks[index(priority)].push_back(std::move(task));
+
+        // All workers are busy, ask one background task to stop to make room for interactive work
+        if (priority == Priority::Interactive && busy_ >= workers.size()) {
+            for (auto& worker : workers) {
+                if (worker->priority == Priority::Background && worker->preempt) {
+                    preempt = std::move(worker->preempt);
+                    worker->preempt = nullptr;
+                    ++stats_[index(Priority::Background)].preempted;
+                    break;
+                }
+            }
+        }
+    }
+    condition.notify_one();
+    if (preempt) preempt();
+}
+
 void ThreadPool::enqueueRaw(std::function<void()> task) {
+    enqueueRaw(std::move(task), TaskInfo{currentPriority()});
+}
+
+void ThreadPool::enqueueRaw(std::function<void()> task, TaskInfo info) {
     if (workers.empty()) {
         task();  // No worker threads, just run the task.
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        push(Task{std::move(task), std::move(info), Clock::now()});
     }
-    condition.notify_one();
 }
 
 }  // namespace inviwo
@@ -29,6 +29,12 @@
 
 #include <inviwo/core/util/volumeutils.h>
 #include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
@@ -98,6 +104,63 @@ double voxelVolume(const Volume& volume) {
     return glm::dot(glm::cross(a, b), c);
 }
 
+bool canReadVolumeRegion(const Volume& volume) {
+    return !volume.hasValidRepresentation<VolumeRAM>() &&
+           volume.hasValidRepresentation<VolumeDisk>() &&
+           volume.getRepresentation<VolumeDisk>()->supportsRegions();
+}
+
+std::shared_ptr<VolumeRAM> readVolumeRegion(const Volume& volume, const DiskRegion& region) {
+    const auto dims = volume.getDimensions();
+    if (!region.isValidFor(dims)) {
+        throw Exception("Region is empty or outside of the volume",
+                        IVW_CONTEXT_CUSTOM("readVolumeRegion"));
+    }
+
+    std::shared_ptr<VolumeRAM> result;
+    if (canReadVolumeRegion(volume)) {
+        result = std::dynamic_pointer_cast<VolumeRAM>(
+            volume.getRepresentation<VolumeDisk>()->createRepresentation(region));
+        if (!result) {
+            throw Exception("Loader did not create a VolumeRAM",
+                            IVW_CONTEXT_CUSTOM("readVolumeRegion"));
+        }
+    } else {
+        const auto out = region.getOutputDimensions();
+        result = volume.getRepresentation<VolumeRAM>()
+                     ->dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+                         [&](const auto* vrprecision) -> std::shared_ptr<VolumeRAM> {
+                             using T = util::PrecisionValueType<decltype(vrprecision)>;
+                             auto res = std::make_shared<VolumeRAMPrecision<T>>(
+                                 out, vrprecision->getSwizzleMask(),
+                                 vrprecision->getInterpolation(), vrprecision->getWrapping());
+                             const T* src = vrprecision->getDataTyped();
+                             T* dst = res->getDataTyped();
+                             const util::IndexMapper3D index(dims);
+                             for (size_t z = 0; z < out.z; ++z) {
+                                 for (size_t y = 0; y < out.y; ++y) {
+                                     const T* row = src + index(region.offset +
+                                                                size3_t{0, y, z} * region.stride);
+                                     for (size_t x = 0; x < out.x; ++x) {
+                                         dst[x] = row[x * region.stride.x];
+                                     }
+                                     dst += out.x;
+                                 }
+                             }
+                             return res;
+                         });
+    }
+
+    auto wrapping = result->getWrapping();
+    for (int i = 0; i < 3; ++i) {
+        if (region.dimensions[i] != dims[i] || region.stride[i] != 1) {
+            wrapping[i] = Wrapping::Clamp;
+        }
+    }
+    result->setWrapping(wrapping);
+    return result;
+}
+
 }  // namespace util
 
 }  // namespace inviwo
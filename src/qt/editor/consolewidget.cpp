@@ -267,10 +267,29 @@ ConsoleWidget::ConsoleWidget(InviwoMainWindow* parent)
     statusBar->addWidget(threadPoolInfo_);
     auto timer = new QTimer(this);
     connect(timer, &QTimer::timeout, threadPoolInfo_, [this]() {
-        const auto threads = mainwindow_->getInviwoApplication()->getThreadPool().getSize();
-        const auto queueSize = mainwindow_->getInviwoApplication()->getThreadPool().getQueueSize();
+        auto& pool = mainwindow_->getInviwoApplication()->getThreadPool();
+        const auto threads = pool.getSize();
+        const auto queueSize = pool.getQueueSize();
         threadPoolInfo_->setText(
             QString("Pool: %1 Queued Jobs / %2 Threads").arg(queueSize, 3).arg(threads, 2));
+
+        QString tooltip{"<table><tr><th></th><th>Queued</th><th>Running</th><th>Done</th>"
+                        "<th>Mean Wait</th><th>Max Wait</th></tr>"};
+        for (auto [name, priority] : {std::pair{"Interactive", ThreadPool::Priority::Interactive},
+                                      std::pair{"Normal", ThreadPool::Priority::Normal},
+                                      std::pair{"Background", ThreadPool::Priority::Background}}) {
+            const auto stats = pool.getStats(priority);
+            tooltip.append(QString("<tr><td>%1</td><td>%2</td><td>%3</td><td>%4</td>"
+                                   "<td>%5 ms</td><td>%6 ms</td></tr>")
+                               .arg(QString{name})
+                               .arg(stats.queued)
+                               .arg(stats.running)
+                               .arg(stats.completed)
+                               .arg(stats.meanWait().count() * 1000.0, 0, 'f', 1)
+                               .arg(stats.maxWait.count() * 1000.0, 0, 'f', 1));
+        }
+        tooltip.append("</table>");
+        threadPoolInfo_->setToolTip(tooltip);
     });
     timer->start(1000);
 
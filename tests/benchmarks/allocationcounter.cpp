@@ -0,0 +1,141 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>  // for _msize
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>  // for malloc_size
+#else
+#include <malloc.h>  // for malloc_usable_size
+#endif
+
+namespace inviwo {
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> allocatedBytes{0};
+std::atomic<size_t> liveBytes{0};
+std::atomic<size_t> peakBytes{0};
+
+// The size of a block is taken from the allocator instead of being stored with the block. Memory
+// allocated by another module with its own operator new, i.e. a DLL on Windows, can then be
+// freed here as well. Such blocks were never added to the live bytes, hence the subtraction
+// saturates at zero.
+size_t blockSize(void* ptr) noexcept {
+#if defined(_WIN32)
+    return _msize(ptr);
+#elif defined(__APPLE__)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+void* allocate(size_t size) noexcept {
+    auto* ptr = std::malloc(size);
+    if (!ptr) return nullptr;
+    const auto bytes = blockSize(ptr);
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const auto live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    return ptr;
+}
+
+void* allocateOrThrow(size_t size) {
+    if (size == 0) size = 1;
+    while (true) {
+        if (auto* ptr = allocate(size)) return ptr;
+        if (auto handler = std::get_new_handler()) {
+            handler();
+        } else {
+            throw std::bad_alloc{};
+        }
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    if (!ptr) return;
+    const auto bytes = blockSize(ptr);
+    auto live = liveBytes.load(std::memory_order_relaxed);
+    while (!liveBytes.compare_exchange_weak(live, live > bytes ? live - bytes : 0,
+                                            std::memory_order_relaxed)) {
+    }
+    std::free(ptr);
+}
+
+}  // namespace
+
+allocationcounter::Counters allocationcounter::get() {
+    return {allocations.load(std::memory_order_relaxed),
+            allocatedBytes.load(std::memory_order_relaxed),
+            liveBytes.load(std::memory_order_relaxed), peakBytes.load(std::memory_order_relaxed)};
+}
+
+void allocationcounter::resetPeak() {
+    peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+}  // namespace inviwo
+
+// Over aligned allocations use the default implementations, they are neither counted nor mixed
+// with the functions below.
+void* operator new(std::size_t size) { return inviwo::allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return inviwo::allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return inviwo::allocateOrThrow(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return inviwo::allocateOrThrow(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept { inviwo::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { inviwo::deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { inviwo::deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { inviwo::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { inviwo::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { inviwo::deallocate(ptr); }
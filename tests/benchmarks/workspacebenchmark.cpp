@@ -0,0 +1,300 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <inviwo/core/common/defaulttohighperformancegpu.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/inviwocommondefines.h>
+#include <inviwo/core/moduleregistration.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/util/buildinfo.h>
+#include <inviwo/core/util/commandlineparser.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/networkprofiler.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include "allocationcounter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+struct Sweep {
+    Property* property;
+    double from;
+    double to;
+};
+
+/**
+ * Parse a sweep given as "<processor>.<property>:<from>:<to>"
+ */
+std::optional<Sweep> parseSweep(ProcessorNetwork* network, std::string_view arg) {
+    const auto toPos = arg.rfind(':');
+    if (toPos == std::string_view::npos || toPos == 0) return std::nullopt;
+    const auto fromPos = arg.rfind(':', toPos - 1);
+    if (fromPos == std::string_view::npos) return std::nullopt;
+
+    auto* property = network->getProperty(arg.substr(0, fromPos));
+    if (!property) return std::nullopt;
+    try {
+        return Sweep{property, std::stod(std::string{arg.substr(fromPos + 1, toPos - fromPos - 1)}),
+                     std::stod(std::string{arg.substr(toPos + 1)})};
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+template <typename... Ts>
+bool setOrdinal(Property* property, double value) {
+    return (... || [&]() {
+        if (auto* p = dynamic_cast<OrdinalProperty<Ts>*>(property)) {
+            if constexpr (std::is_integral_v<Ts>) {
+                p->set(static_cast<Ts>(std::llround(value)));
+            } else {
+                p->set(static_cast<Ts>(value));
+            }
+            return true;
+        }
+        return false;
+    }());
+}
+
+bool setValue(Property* property, double value) {
+    if (setOrdinal<float, double, int, size_t, glm::i64>(property, value)) return true;
+    if (auto* p = dynamic_cast<BaseOptionProperty*>(property)) {
+        return p->setSelectedIndex(static_cast<size_t>(std::max(0ll, std::llround(value))));
+    }
+    return false;
+}
+
+bool write(const std::string& file, const std::function<void(std::ostream&)>& writer) {
+    std::ofstream os(file);
+    if (!os) return false;
+    writer(os);
+    return static_cast<bool>(os);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    LogCentral logger;
+    LogCentral::init(&logger);
+    auto consoleLogger = std::make_shared<ConsoleLogger>();
+    logger.registerLogger(consoleLogger);
+
+    InviwoApplication inviwoApp(argc, argv, "Inviwo-Benchmark");
+    inviwoApp.setProgressCallback([](std::string m) {
+        LogCentral::getPtr()->log("InviwoApplication", LogLevel::Info, LogAudience::User, "", "", 0,
+                                  m);
+    });
+
+    // Initialize all modules
+    inviwoApp.registerModules(inviwo::getModuleList());
+
+    auto& cmdparser = inviwoApp.getCommandLineParser();
+    TCLAP::ValueArg<size_t> iterationsArg("", "iterations", "Number of measured evaluations",
+                                          false, 10, "count");
+    TCLAP::ValueArg<size_t> warmupArg("", "warmup", "Number of evaluations before measuring",
+                                      false, 1, "count");
+    TCLAP::ValueArg<std::string> sweepArg(
+        "", "sweep",
+        "Sweep a property linearly over the measured evaluations. Only the property change "
+        "invalidates the network in this case. Supports scalar ordinal properties and option "
+        "properties (by index)",
+        false, "", "<processor>.<property>:<from>:<to>");
+    TCLAP::SwitchArg resourcesArg(
+        "", "resources",
+        "Invalidate resources, not just outputs, of all processors in each evaluation to "
+        "include initializeResources in the measurements");
+    TCLAP::ValueArg<std::string> jsonArg("", "json", "Write the measurements as JSON", false, "",
+                                         "file");
+    TCLAP::ValueArg<std::string> csvArg("", "csv", "Write the measurements as CSV", false, "",
+                                        "file");
+    cmdparser.add(&iterationsArg);
+    cmdparser.add(&warmupArg);
+    cmdparser.add(&sweepArg);
+    cmdparser.add(&resourcesArg);
+    cmdparser.add(&jsonArg);
+    cmdparser.add(&csvArg);
+
+    cmdparser.parse(inviwo::CommandLineParser::Mode::Normal);
+
+    if (!cmdparser.getLoadWorkspaceFromArg()) {
+        LogErrorCustom("bm-workspace", "No workspace given, use -w <workspace>");
+        return 1;
+    }
+    const auto workspace = cmdparser.getWorkspacePath();
+
+    auto* network = inviwoApp.getProcessorNetwork();
+    try {
+        NetworkLock lock(network);
+        inviwoApp.getWorkspaceManager()->load(workspace, [&](ExceptionContext ec) {
+            try {
+                throw;
+            } catch (const IgnoreException& e) {
+                util::log(e.getContext(),
+                          "Incomplete network loading " + workspace + " due to " + e.getMessage(),
+                          LogLevel::Error);
+            }
+        });
+    } catch (const Exception& e) {
+        util::log(e.getContext(),
+                  "Unable to load network " + workspace + " due to " + e.getMessage(),
+                  LogLevel::Error);
+        return 1;
+    }
+
+    cmdparser.processCallbacks();  // run any command line callbacks from modules.
+
+    std::optional<Sweep> sweep;
+    if (sweepArg.isSet()) {
+        sweep = parseSweep(network, sweepArg.getValue());
+        if (!sweep) {
+            LogErrorCustom("bm-workspace", "Invalid sweep: " << sweepArg.getValue());
+            return 1;
+        }
+    }
+
+    // Background jobs deliver their results through the front queue, which can trigger new
+    // evaluations that dispatch new jobs. Keep going until the network is idle.
+    const auto settle = [&]() {
+        while (true) {
+            inviwoApp.waitForPool();
+            if (network->runningBackgroundJobs() == 0 && inviwoApp.processFront() == 0) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    const auto level = resourcesArg.getValue() ? InvalidationLevel::InvalidResources
+                                               : InvalidationLevel::InvalidOutput;
+    const auto evaluate = [&](std::optional<double> value) {
+        {
+            NetworkLock lock(network);
+            if (value) {
+                if (!setValue(sweep->property, *value)) {
+                    throw Exception("Unsupported property type for sweep: " +
+                                        sweep->property->getClassIdentifier(),
+                                    IVW_CONTEXT_CUSTOM("bm-workspace"));
+                }
+                // Setting the current value again does not invalidate anything, like in the first
+                // run after the warmup. Invalidate explicitly so that every run is measured.
+                if (!sweep->property->isModified()) sweep->property->propertyModified();
+            } else {
+                network->forEachProcessor([&](Processor* p) { p->invalidate(level); });
+            }
+        }
+        settle();
+    };
+
+    settle();  // Let the initial evaluation after loading finish
+
+    const NetworkProfiler::MemorySource memory{
+        []() {
+            const auto c = allocationcounter::get();
+            return NetworkProfiler::MemoryCounters{c.allocations, c.allocatedBytes, c.liveBytes,
+                                                   c.peakBytes};
+        },
+        []() { allocationcounter::resetPeak(); }};
+    NetworkProfiler profiler{network, inviwoApp.getProcessorNetworkEvaluator(), memory};
+
+    const auto iterations = iterationsArg.getValue();
+    try {
+        for (size_t i = 0; i < warmupArg.getValue(); ++i) {
+            evaluate(sweep ? std::optional<double>{sweep->from} : std::nullopt);
+        }
+        for (size_t i = 0; i < iterations; ++i) {
+            std::optional<double> value;
+            if (sweep) {
+                const auto t = iterations > 1 ? static_cast<double>(i) / (iterations - 1) : 0.0;
+                value = sweep->from + t * (sweep->to - sweep->from);
+            }
+            profiler.beginRun(value ? toString(*value) : toString(i));
+            evaluate(value);
+            profiler.endRun();
+        }
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        return 1;
+    }
+
+    const auto buildInfo = util::getBuildInfo();
+    std::vector<std::pair<std::string, std::string>> context{
+        {"workspace", workspace},
+        {"version", toString(build::version)},
+        {"configuration", buildInfo.configuration},
+        {"compiler", buildInfo.compiler + " " + buildInfo.compilerVersion},
+        {"build_date", buildInfo.getDate()},
+        {"pool_size", toString(inviwoApp.getPoolSize())},
+        {"iterations", toString(iterations)},
+        {"warmup", toString(warmupArg.getValue())},
+        {"invalidation", resourcesArg.getValue() ? "resources" : "output"}};
+    if (sweepArg.isSet()) context.emplace_back("sweep", sweepArg.getValue());
+    for (const auto& [name, hash] : buildInfo.githashes) {
+        context.emplace_back("git_" + name, hash);
+    }
+
+    profiler.writeSummary(std::cout);
+
+    int ret = 0;
+    if (jsonArg.isSet() &&
+        !write(jsonArg.getValue(), [&](std::ostream& os) { profiler.writeJSON(os, context); })) {
+        LogErrorCustom("bm-workspace", "Unable to write " << jsonArg.getValue());
+        ret = 1;
+    }
+    if (csvArg.isSet() &&
+        !write(csvArg.getValue(), [&](std::ostream& os) { profiler.writeCSV(os); })) {
+        LogErrorCustom("bm-workspace", "Unable to write " << csvArg.getValue());
+        ret = 1;
+    }
+    return ret;
+}
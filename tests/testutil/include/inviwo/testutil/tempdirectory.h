@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace inviwo {
+
+/**
+ * \brief A temporary directory for the files of a single test
+ * The name contains the name of the running test and a random suffix, so tests running
+ * concurrently, also in different processes, never share a directory. The directory is created
+ * on construction and removed, with all its content, on destruction.
+ */
+class TempDirectory {
+public:
+    TempDirectory() : path_{makePath()} { std::filesystem::create_directories(path_); }
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    const std::filesystem::path& path() const { return path_; }
+    std::string string() const { return path_.u8string(); }
+
+private:
+    static std::filesystem::path makePath() {
+        std::string name = "inviwo-test";
+        if (const auto* info = ::testing::UnitTest::GetInstance()->current_test_info()) {
+            name.append("-").append(info->test_suite_name()).append("-").append(info->name());
+        }
+        std::replace_if(
+            name.begin(), name.end(),
+            [](unsigned char c) { return !std::isalnum(c) && c != '-'; }, '_');
+        std::random_device rd;
+        name.append("-").append(std::to_string(rd())).append(std::to_string(rd()));
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    std::filesystem::path path_;
+};
+
+}  // namespace inviwo
@@ -8,7 +8,9 @@ import matplotlib.pyplot as plt
 
 logging.basicConfig(format='[%(levelname)s] %(message)s')
 
-METRICS = ['real_time', 'cpu_time', 'bytes_per_second', 'items_per_second']
+METRICS = ['real_time', 'cpu_time', 'bytes_per_second', 'items_per_second',
+           # additional metrics written by bm-workspace --csv
+           'init_time', 'background_time', 'allocations', 'allocated_bytes', 'peak_bytes']
 TRANSFORMS = {'' : lambda x: x, 'inverse': lambda x: 1.0 / x }
 
 
@@ -42,6 +44,9 @@ def parse_args():
     parser.add_argument(
         '-r', metavar='RELATIVE_TO', type=str, default=None,
         dest='relative_to', help='plot metrics relative to this label')
+    parser.add_argument(
+        '-s', metavar='SKIPROWS', type=int, default=8, dest='skiprows',
+        help='number of context lines before the csv header, use 0 for bm-workspace output')
     parser.add_argument(
         '--xlabel', type=str, default='input size', help='label of the x-axis')
     parser.add_argument(
@@ -69,7 +74,7 @@ def parse_input_size(name):
 def read_data(args):
     """Read and process dataframe using commandline args"""
     try:
-        data = pd.read_csv(args.file, usecols=['name', args.metric], skiprows=8)
+        data = pd.read_csv(args.file, usecols=['name', args.metric], skiprows=args.skiprows)
     except ValueError:
         msg = 'Could not parse the benchmark data. Did you forget "--benchmark_format=csv"?'
         logging.error(msg)
@@ -77,7 +82,7 @@ def read_data(args):
 
     if args.extra:
     	try:   
-            extra = [pd.read_csv(e, usecols=['name', args.metric], skiprows=8) for e in args.extra]
+            extra = [pd.read_csv(e, usecols=['name', args.metric], skiprows=args.skiprows) for e in args.extra]
             data = pd.concat([data, *extra], ignore_index=True)
             
     	except ValueError: